@@ -69,6 +69,10 @@ function(ax_link_cxx_prebuilt APP_NAME AX_ROOT_DIR AX_PREBUILT_DIR)
         target_compile_definitions(${APP_NAME} PRIVATE AX_USE_SSE=1)
     endif()
 
+    if (AX_ENABLE_3D_PHYSICS_MT)
+        target_compile_definitions(${APP_NAME} PRIVATE BT_THREADSAFE=1)
+    endif()
+
     if (BUILD_SHARED_LIBS)
         target_compile_definitions(${APP_NAME} PRIVATE AX_DLLIMPORT=1)
     endif()
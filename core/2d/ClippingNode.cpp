@@ -180,7 +180,7 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
 
     auto afterDrawStencilCmd = renderer->nextCallbackCommand();
     afterDrawStencilCmd->init(_globalZOrder);
-    afterDrawStencilCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterDrawStencil, _stencilStateManager);
+    afterDrawStencilCmd->setCallback(renderer->getFrameArena(), [this] { _stencilStateManager->onAfterDrawStencil(); });
     renderer->addCommand(afterDrawStencilCmd);
 
     bool visibleByCamera = isVisitableByVisitingCamera();
@@ -224,7 +224,7 @@ void ClippingNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32
 
     auto _afterVisitCmd = renderer->nextCallbackCommand();
     _afterVisitCmd->init(_globalZOrder);
-    _afterVisitCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterVisit, _stencilStateManager);
+    _afterVisitCmd->setCallback(renderer->getFrameArena(), [this] { _stencilStateManager->onAfterVisit(); });
     renderer->addCommand(_afterVisitCmd);
 
     renderer->popGroup();
@@ -94,14 +94,14 @@ void ClippingRectangleNode::visit(Renderer* renderer, const Mat4& parentTransfor
 {
     auto beforeVisitCmdScissor = renderer->nextCallbackCommand();
     beforeVisitCmdScissor->init(_globalZOrder);
-    beforeVisitCmdScissor->func = AX_CALLBACK_0(ClippingRectangleNode::onBeforeVisitScissor, this);
+    beforeVisitCmdScissor->setCallback(renderer->getFrameArena(), [this] { onBeforeVisitScissor(); });
     renderer->addCommand(beforeVisitCmdScissor);
 
     Node::visit(renderer, parentTransform, parentFlags);
 
     auto afterVisitCmdScissor = renderer->nextCallbackCommand();
     afterVisitCmdScissor->init(_globalZOrder);
-    afterVisitCmdScissor->func = AX_CALLBACK_0(ClippingRectangleNode::onAfterVisitScissor, this);
+    afterVisitCmdScissor->setCallback(renderer->getFrameArena(), [this] { onAfterVisitScissor(); });
     renderer->addCommand(afterVisitCmdScissor);
 }
 
@@ -103,6 +103,7 @@ DrawNode::~DrawNode()
     freeShaderInternal(_customCommandTriangle);
     freeShaderInternal(_customCommandPoint);
     freeShaderInternal(_customCommandLine);
+    freeShaderInternal(_customCommandBatchTriangle);
 }
 
 DrawNode* DrawNode::create(float defaultLineWidth)
@@ -190,6 +191,10 @@ void DrawNode::updateShader()
 
     updateShaderInternal(_customCommandLine, backend::ProgramType::POSITION_COLOR_LENGTH_TEXTURE,
                          CustomCommand::DrawType::ARRAY, CustomCommand::PrimitiveType::LINE);
+
+    updateShaderInternal(_customCommandBatchTriangle, backend::ProgramType::POSITION_COLOR_LENGTH_TEXTURE,
+                         CustomCommand::DrawType::ELEMENT, CustomCommand::PrimitiveType::TRIANGLE);
+    setBatchVertexLayout(_customCommandBatchTriangle);
 }
 
 void DrawNode::updateShaderInternal(CustomCommand& cmd,
@@ -213,6 +218,46 @@ void DrawNode::setVertexLayout(CustomCommand& cmd)
     programState->validateSharedVertexLayout(backend::VertexLayoutType::DrawNode);
 }
 
+void DrawNode::setBatchVertexLayout(CustomCommand& cmd)
+{
+    // the shared DrawNode layout is valid at this point, so the program state gets its own layout
+    auto* programState = cmd.getPipelineDescriptor().programState;
+    auto* program      = programState->getProgram();
+    auto* vertexLayout = programState->getMutableVertexLayout();
+
+    vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_POSITION,
+                            program->getAttributeLocation(backend::Attribute::POSITION),
+                            backend::VertexFormat::FLOAT3, 0, false);
+    vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_TEXCOORD,
+                            program->getAttributeLocation(backend::Attribute::TEXCOORD),
+                            backend::VertexFormat::FLOAT2, offsetof(V3F_C4B_T2F, texCoords), false);
+    vertexLayout->setAttrib(backend::ATTRIBUTE_NAME_COLOR, program->getAttributeLocation(backend::Attribute::COLOR),
+                            backend::VertexFormat::UBYTE4, offsetof(V3F_C4B_T2F, colors), true);
+    vertexLayout->setStride(sizeof(V3F_C4B_T2F));
+}
+
+void DrawNode::updateBatchTriangles()
+{
+    if (!_dirtyTriangle)
+        return;
+
+    _batchVertices.resize(_bufferCountTriangle);
+    for (int i = 0; i < _bufferCountTriangle; ++i)
+    {
+        auto& src     = _bufferTriangle[i];
+        auto& dst     = _batchVertices[i];
+        dst.vertices  = Vec3(src.vertices.x, src.vertices.y, 0.0f);
+        dst.colors    = src.colors;
+        dst.texCoords = src.texCoords;
+    }
+
+    // the triangles are not indexed, the indices are only grown since they never change
+    for (auto i = _batchIndices.size(); i < static_cast<size_t>(_bufferCountTriangle); ++i)
+        _batchIndices.emplace_back(static_cast<unsigned short>(i));
+
+    _dirtyTriangle = false;
+}
+
 void DrawNode::freeShaderInternal(CustomCommand& cmd)
 {   
     auto& pipelinePS = cmd.getPipelineDescriptor().programState;
@@ -256,7 +301,20 @@ void DrawNode::updateUniforms(const Mat4& transform, CustomCommand& cmd)
 
 void DrawNode::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
-    if (_bufferCountTriangle)
+    if (_bufferCountTriangle > 0 && _bufferCountTriangle < Renderer::VBO_SIZE)
+    {
+        // transformed on the CPU and merged with the neighbouring commands sharing the material
+        updateBatchTriangles();
+        updateBlendState(_customCommandBatchTriangle);
+        updateUniforms(Mat4::IDENTITY, _customCommandBatchTriangle);
+        _customCommandBatchTriangle.init(_globalZOrder, transform, 0);
+        _customCommandBatchTriangle.setBatchTriangles(
+            TrianglesCommand::Triangles(_batchVertices.data(), _batchIndices.data(), _bufferCountTriangle,
+                                        _bufferCountTriangle),
+            nullptr);
+        renderer->addCommand(&_customCommandBatchTriangle);
+    }
+    else if (_bufferCountTriangle)
     {
         updateBlendState(_customCommandTriangle);
         updateUniforms(transform, _customCommandTriangle);
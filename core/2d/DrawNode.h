@@ -424,6 +424,8 @@ protected:
     void freeShaderInternal(CustomCommand& cmd);
 
     void setVertexLayout(CustomCommand& cmd);
+    void setBatchVertexLayout(CustomCommand& cmd);
+    void updateBatchTriangles();
 
     void updateBlendState(CustomCommand& cmd);
     void updateUniforms(const Mat4& transform, CustomCommand& cmd);
@@ -448,6 +450,11 @@ protected:
     CustomCommand _customCommandPoint;
     CustomCommand _customCommandLine;
 
+    // triangles submitted through the renderer's triangle batch, converted to V3F_C4B_T2F when dirty
+    CustomCommand _customCommandBatchTriangle;
+    std::vector<V3F_C4B_T2F> _batchVertices;
+    std::vector<unsigned short> _batchIndices;
+
     bool _dirtyTriangle     = false;
     bool _dirtyPoint        = false;
     bool _dirtyLine         = false;
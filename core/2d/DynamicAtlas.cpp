@@ -0,0 +1,509 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/DynamicAtlas.h"
+
+#include <algorithm>
+#include <atomic>
+#include "2d/ProtectedNode.h"
+#include "2d/Sprite.h"
+#include "2d/SpriteFrame.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/format.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/Texture2D.h"
+#include "renderer/TextureCache.h"
+
+NS_AX_BEGIN
+
+namespace
+{
+// the edge pixels of an image are repeated this far around it
+constexpr int PADDING = 1;
+
+DynamicAtlas* s_sharedDynamicAtlas = nullptr;
+
+bool canPack(Image* image, int maxImageSize, int pageSize)
+{
+    auto format = image->getPixelFormat();
+    if (format != backend::PixelFormat::RGBA8 && format != backend::PixelFormat::RGB8)
+        return false;
+
+    int width  = image->getWidth();
+    int height = image->getHeight();
+    return width > 0 && height > 0 && width <= maxImageSize && height <= maxImageSize &&
+           width + 2 * PADDING <= pageSize && height + 2 * PADDING <= pageSize;
+}
+
+// opaque images look the same with and without premultiplied alpha
+bool acceptsImage(bool premultipliedAlpha, Image* image)
+{
+    return image->getPixelFormat() == backend::PixelFormat::RGB8 ||
+           image->hasPremultipliedAlpha() == premultipliedAlpha;
+}
+
+/** Copies an image to (x, y) of a RGBA8 buffer, with the padding around it */
+void blitPadded(Image* image, uint8_t* buffer, int bufferWidth, int x, int y)
+{
+    const int width         = image->getWidth();
+    const int height        = image->getHeight();
+    const int bytesPerPixel = image->getPixelFormat() == backend::PixelFormat::RGBA8 ? 4 : 3;
+    const uint8_t* pixels   = image->getData();
+
+    for (int row = -PADDING; row < height + PADDING; ++row)
+    {
+        auto source = pixels + static_cast<size_t>(std::clamp(row, 0, height - 1)) * width * bytesPerPixel;
+        auto target = buffer + (static_cast<size_t>(y + PADDING + row) * bufferWidth + x) * 4;
+        for (int column = -PADDING; column < width + PADDING; ++column, target += 4)
+        {
+            auto pixel = source + std::clamp(column, 0, width - 1) * bytesPerPixel;
+            target[0]  = pixel[0];
+            target[1]  = pixel[1];
+            target[2]  = pixel[2];
+            target[3]  = bytesPerPixel == 4 ? pixel[3] : 0xFF;
+        }
+    }
+}
+}  // namespace
+
+struct DynamicAtlas::Page
+{
+    ~Page()
+    {
+        AX_SAFE_RELEASE(texture);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+        AX_SAFE_RELEASE(pixels);
+#endif
+    }
+
+    Texture2D* texture = nullptr;
+    AtlasPacker packer;
+    bool premultipliedAlpha = false;
+    /// The full paths of the images on the page.
+    std::vector<std::string> files;
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    /// The pixels of the page, to restore the texture after the context is lost.
+    /// VolatileTextureMgr retains them too, they stay valid as long as a sprite keeps the texture of an evicted page.
+    Image* pixels = nullptr;
+#endif
+};
+
+/** Image files added by addImagesAsync, decoded and packed on the job system */
+struct DynamicAtlas::AsyncBatch
+{
+    struct Item
+    {
+        std::string fullPath;
+        Image* image = nullptr;
+        /// The index into pages, -1 if the image can't be packed.
+        int page = -1;
+        int x    = 0;
+        int y    = 0;
+    };
+
+    struct PackedPage
+    {
+        AtlasPacker packer;
+        bool premultipliedAlpha;
+        std::vector<uint8_t> pixels;
+    };
+
+    ~AsyncBatch()
+    {
+        for (auto&& item : items)
+            AX_SAFE_RELEASE(item.image);
+    }
+
+    /** Packs the decoded images into new pages, the tallest first since the skyline wastes less space then */
+    void pack()
+    {
+        std::vector<Item*> packable;
+        for (auto&& item : items)
+        {
+            if (item.image && canPack(item.image, maxImageSize, pageSize))
+                packable.emplace_back(&item);
+        }
+        std::stable_sort(packable.begin(), packable.end(),
+                         [](Item* a, Item* b) { return a->image->getHeight() > b->image->getHeight(); });
+
+        for (auto item : packable)
+        {
+            int width    = item->image->getWidth() + 2 * PADDING;
+            int height   = item->image->getHeight() + 2 * PADDING;
+            size_t index = 0;
+            for (; index < pages.size(); ++index)
+            {
+                auto& page = pages[index];
+                if (acceptsImage(page.premultipliedAlpha, item->image) &&
+                    page.packer.insert(width, height, item->x, item->y))
+                    break;
+            }
+            if (index == pages.size())
+            {
+                pages.emplace_back(PackedPage{AtlasPacker(pageSize, pageSize), item->image->hasPremultipliedAlpha(),
+                                              std::vector<uint8_t>(static_cast<size_t>(pageSize) * pageSize * 4)});
+                pages.back().packer.insert(width, height, item->x, item->y);
+            }
+
+            item->page = static_cast<int>(index);
+            blitPadded(item->image, pages[index].pixels.data(), pageSize, item->x, item->y);
+        }
+    }
+
+    std::vector<Item> items;
+    std::vector<PackedPage> pages;
+    std::atomic<size_t> pendingDecodes{0};
+    /// The done callbacks not run yet, only touched on the axmol thread.
+    size_t pendingCallbacks = 0;
+    int pageSize            = 0;
+    int maxImageSize        = 0;
+    std::function<void()> callback;
+};
+
+DynamicAtlas* DynamicAtlas::getInstance()
+{
+    if (!s_sharedDynamicAtlas)
+        s_sharedDynamicAtlas = new DynamicAtlas();
+    return s_sharedDynamicAtlas;
+}
+
+void DynamicAtlas::destroyInstance()
+{
+    AX_SAFE_DELETE(s_sharedDynamicAtlas);
+}
+
+DynamicAtlas::DynamicAtlas() {}
+
+DynamicAtlas::~DynamicAtlas()
+{
+    removeAllPages();
+}
+
+SpriteFrame* DynamicAtlas::addImage(std::string_view filename)
+{
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+    if (fullPath.empty())
+        return nullptr;
+
+    auto it = _frames.find(fullPath);
+    if (it != _frames.end())
+        return it->second;
+
+    if (_rejected.find(fullPath) != _rejected.end())
+        return nullptr;
+
+    SpriteFrame* frame = nullptr;
+    auto image         = new Image();
+    if (image->initWithImageFile(fullPath))
+    {
+        if (canPack(image, _maxImageSize, _pageSize))
+            frame = packImage(fullPath, image);
+        else
+            _rejected.emplace(fullPath);
+    }
+    image->release();
+    return frame;
+}
+
+SpriteFrame* DynamicAtlas::packImage(std::string_view fullPath, Image* image)
+{
+    int width  = image->getWidth() + 2 * PADDING;
+    int height = image->getHeight() + 2 * PADDING;
+    int x = 0, y = 0;
+
+    Page* page = nullptr;
+    for (auto&& candidate : _pages)
+    {
+        if (acceptsImage(candidate->premultipliedAlpha, image) && candidate->packer.insert(width, height, x, y))
+        {
+            page = candidate.get();
+            break;
+        }
+    }
+
+    if (!page)
+    {
+        if (reservePages(1) == 0)
+            return nullptr;
+
+        page = addPage(AtlasPacker(_pageSize, _pageSize), image->hasPremultipliedAlpha(), {});
+        page->packer.insert(width, height, x, y);
+    }
+
+    std::vector<uint8_t> block(static_cast<size_t>(width) * height * 4);
+    blitPadded(image, block.data(), width, 0, 0);
+    page->texture->updateWithSubData(block.data(), x, y, width, height);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    blitPadded(image, page->pixels->getData(), page->packer.getWidth(), x, y);
+#endif
+
+    return addFrame(fullPath, page, x + PADDING, y + PADDING, image->getWidth(), image->getHeight());
+}
+
+void DynamicAtlas::addImagesAsync(const std::vector<std::string>& filenames, std::function<void()> callback)
+{
+    auto batch          = std::make_shared<AsyncBatch>();
+    batch->pageSize     = _pageSize;
+    batch->maxImageSize = _maxImageSize;
+    batch->callback     = std::move(callback);
+
+    auto fileUtils = FileUtils::getInstance();
+    hlookup::string_set added;
+    for (auto&& filename : filenames)
+    {
+        auto fullPath = fileUtils->fullPathForFilename(filename);
+        if (fullPath.empty() || _frames.find(fullPath) != _frames.end() ||
+            _rejected.find(fullPath) != _rejected.end() || !added.emplace(fullPath).second)
+            continue;
+
+        batch->items.emplace_back().fullPath = std::move(fullPath);
+    }
+
+    if (batch->items.empty())
+    {
+        if (batch->callback)
+            batch->callback();
+        return;
+    }
+
+    // every image is decoded by its own job, the job decoding the last one packs them all
+    batch->pendingDecodes   = batch->items.size();
+    batch->pendingCallbacks = batch->items.size();
+    auto jobSystem          = Director::getInstance()->getJobSystem();
+    for (size_t i = 0; i < batch->items.size(); ++i)
+    {
+        auto decode = [batch, i]() {
+            auto& item = batch->items[i];
+            auto image = new Image();
+            if (image->initWithImageFileThreadSafe(item.fullPath))
+                item.image = image;
+            else
+                image->release();
+
+            if (--batch->pendingDecodes == 0)
+                batch->pack();
+        };
+        auto done = [batch]() {
+            if (--batch->pendingCallbacks != 0)
+                return;
+
+            if (s_sharedDynamicAtlas)
+                s_sharedDynamicAtlas->onImagesPacked(batch);
+            else if (batch->callback)
+                batch->callback();
+        };
+        jobSystem->enqueue(std::move(decode), std::move(done));
+    }
+}
+
+void DynamicAtlas::onImagesPacked(const std::shared_ptr<AsyncBatch>& batch)
+{
+    auto pageCount = reservePages(batch->pages.size());
+    if (pageCount < batch->pages.size())
+        AXLOGW("DynamicAtlas: {} pages exceed the page limit, their images aren't packed",
+               batch->pages.size() - pageCount);
+
+    std::vector<Page*> pages;
+    for (size_t i = 0; i < pageCount; ++i)
+    {
+        auto& packed = batch->pages[i];
+        pages.emplace_back(addPage(std::move(packed.packer), packed.premultipliedAlpha, std::move(packed.pixels)));
+    }
+
+    for (auto&& item : batch->items)
+    {
+        if (!item.image)
+            continue;
+
+        if (item.page < 0)
+            _rejected.emplace(item.fullPath);
+        // an image packed by addImage meanwhile keeps its frame, the spot in the new page stays unused
+        else if (static_cast<size_t>(item.page) < pages.size() && _frames.find(item.fullPath) == _frames.end())
+            addFrame(item.fullPath, pages[item.page], item.x + PADDING, item.y + PADDING, item.image->getWidth(),
+                     item.image->getHeight());
+    }
+
+    if (batch->callback)
+        batch->callback();
+}
+
+DynamicAtlas::Page* DynamicAtlas::addPage(AtlasPacker packer, bool premultipliedAlpha, std::vector<uint8_t> pixels)
+{
+    int width  = packer.getWidth();
+    int height = packer.getHeight();
+    if (pixels.empty())
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+
+    auto page                = std::make_unique<Page>();
+    page->packer             = std::move(packer);
+    page->premultipliedAlpha = premultipliedAlpha;
+    page->texture            = new Texture2D();
+    page->texture->initWithData(pixels.data(), static_cast<ssize_t>(pixels.size()), backend::PixelFormat::RGBA8,
+                                width, height, premultipliedAlpha);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    page->pixels = new Image();
+    page->pixels->initWithRawData(pixels.data(), static_cast<ssize_t>(pixels.size()), width, height, 8,
+                                  premultipliedAlpha);
+    VolatileTextureMgr::addImage(page->texture, page->pixels);
+#endif
+
+    _pages.emplace_back(std::move(page));
+    return _pages.back().get();
+}
+
+SpriteFrame* DynamicAtlas::addFrame(std::string_view fullPath, Page* page, int x, int y, int width, int height)
+{
+    auto size  = Vec2(static_cast<float>(width), static_cast<float>(height));
+    auto frame = SpriteFrame::createWithTexture(page->texture, Rect(Vec2(static_cast<float>(x), y), size), false,
+                                                Vec2::ZERO, size);
+    frame->retain();
+    _frames.emplace(fullPath, frame);
+    page->files.emplace_back(fullPath);
+    return frame;
+}
+
+SpriteFrame* DynamicAtlas::getSpriteFrame(std::string_view filename) const
+{
+    auto it = _frames.find(FileUtils::getInstance()->fullPathForFilename(filename));
+    return it != _frames.end() ? it->second : nullptr;
+}
+
+bool DynamicAtlas::isPageUsed(const Page* page) const
+{
+    // retained by the atlas and each of its frames only
+    return page->texture->getReferenceCount() > 1 + page->files.size();
+}
+
+size_t DynamicAtlas::reservePages(size_t count)
+{
+    auto maxPageCount = static_cast<size_t>((std::max)(_maxPageCount, 0));
+    if (_pages.size() + count > maxPageCount)
+        removeUnusedPages();
+    return _pages.size() < maxPageCount ? (std::min)(count, maxPageCount - _pages.size()) : 0;
+}
+
+void DynamicAtlas::removeUnusedPages()
+{
+    for (auto it = _pages.begin(); it != _pages.end();)
+    {
+        auto page = it->get();
+        if (isPageUsed(page))
+        {
+            ++it;
+            continue;
+        }
+
+        for (auto&& file : page->files)
+        {
+            auto frameIt = _frames.find(file);
+            if (frameIt != _frames.end())
+            {
+                frameIt->second->release();
+                _frames.erase(frameIt);
+            }
+        }
+        it = _pages.erase(it);
+    }
+}
+
+void DynamicAtlas::removeAllPages()
+{
+    for (auto&& frame : _frames)
+        frame.second->release();
+    _frames.clear();
+    _pages.clear();
+    _rejected.clear();
+}
+
+int DynamicAtlas::remapSprites(Node* root)
+{
+    // the own textures of the packed images which are still loaded
+    std::unordered_map<Texture2D*, SpriteFrame*> frames;
+    auto textureCache = Director::getInstance()->getTextureCache();
+    for (auto&& frame : _frames)
+    {
+        if (auto texture = textureCache->getTextureForKey(frame.first))
+            frames.emplace(texture, frame.second);
+    }
+
+    int count = 0;
+    if (root && !frames.empty())
+        remapNode(root, frames, count);
+    return count;
+}
+
+void DynamicAtlas::remapNode(Node* node, const std::unordered_map<Texture2D*, SpriteFrame*>& frames, int& count)
+{
+    auto sprite = dynamic_cast<Sprite*>(node);
+    if (sprite && !sprite->getBatchNode() &&
+        (sprite->_renderMode == Sprite::RenderMode::QUAD || sprite->_renderMode == Sprite::RenderMode::SLICE9))
+    {
+        auto it = frames.find(sprite->getTexture());
+        if (it != frames.end())
+        {
+            auto frame = it->second;
+            auto rect  = sprite->getTextureRect();
+            if (rect.origin.isZero() && rect.size.equals(frame->getRect().size) && !sprite->isTextureRectRotated())
+            {
+                sprite->setSpriteFrame(frame);
+            }
+            else
+            {
+                // a part of the image, the frame of the whole image doesn't describe it
+                if (sprite->_spriteFrame && sprite->_spriteFrame->getTexture() != frame->getTexture())
+                    AX_SAFE_RELEASE_NULL(sprite->_spriteFrame);
+
+                rect.origin += frame->getRect().origin;
+                sprite->setTexture(frame->getTexture());
+                sprite->setTextureRect(rect, sprite->isTextureRectRotated(), sprite->_originalContentSize);
+            }
+            ++count;
+        }
+    }
+
+    for (auto&& child : node->getChildren())
+        remapNode(child, frames, count);
+
+    if (auto protectedNode = dynamic_cast<ProtectedNode*>(node))
+    {
+        for (auto&& child : protectedNode->getProtectedChildren())
+            remapNode(child, frames, count);
+    }
+}
+
+std::string DynamicAtlas::getDescription() const
+{
+    std::string description = fmt::format("DynamicAtlas: {} pages, {} images\n", _pages.size(), _frames.size());
+    for (auto&& page : _pages)
+    {
+        fmt::format_to(std::back_inserter(description), "  {}x{} page: {} images, {:.1f}% occupied{}\n",
+                       page->packer.getWidth(), page->packer.getHeight(), page->files.size(),
+                       page->packer.getOccupancy() * 100, isPageUsed(page.get()) ? "" : ", unused");
+    }
+    return description;
+}
+
+NS_AX_END
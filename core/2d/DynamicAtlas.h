@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _AX_DYNAMIC_ATLAS_H_
+#define _AX_DYNAMIC_ATLAS_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "base/hlookup.h"
+#include "platform/PlatformMacros.h"
+#include "renderer/AtlasPacker.h"
+
+NS_AX_BEGIN
+
+class Image;
+class Node;
+class Sprite;
+class SpriteFrame;
+class Texture2D;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @brief Packs small image files into shared texture pages at runtime.
+ *
+ * Sprites drawing their own small textures can't be batched by the renderer, a sprite drawing a frame of a page
+ * batches with all the other sprites drawing the same page. While enabled, Sprite::create(file) and
+ * Sprite::initWithFile take a frame of a page for RGBA8 images up to the maximum image size, larger or
+ * compressed images keep their own texture.
+ *
+ * Pages are RGBA8 textures filled with AtlasPacker, every image is extruded by one pixel so linear filtering doesn't
+ * pick up the neighbours. A page is evicted once none of its frames is used anymore, by removeUnusedPages or when a
+ * new page would exceed the page limit.
+ * All methods must be called on the axmol thread, addImagesAsync decodes and packs on the job system.
+ */
+class AX_DLL DynamicAtlas
+{
+public:
+    /** Returns the shared instance of the dynamic atlas. */
+    static DynamicAtlas* getInstance();
+
+    /** Destroys the dynamic atlas, sprites keep the pages they draw alive. */
+    static void destroyInstance();
+
+    /** Whether Sprite::create(file) packs images, disabled by default. */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    bool isEnabled() const { return _enabled; }
+
+    /** The width and height of new pages in pixels, 2048 by default. */
+    void setPageSize(int pageSize) { _pageSize = pageSize; }
+    int getPageSize() const { return _pageSize; }
+
+    /** Images wider or higher than this many pixels aren't packed, 256 by default. */
+    void setMaxImageSize(int maxImageSize) { _maxImageSize = maxImageSize; }
+    int getMaxImageSize() const { return _maxImageSize; }
+
+    /** The number of pages kept at most, unused pages are evicted to stay below it. 4 by default. */
+    void setMaxPageCount(int maxPageCount) { _maxPageCount = maxPageCount; }
+    int getMaxPageCount() const { return _maxPageCount; }
+
+    /**
+     * Loads and packs an image file.
+     * @return The frame of the image, nullptr if the image can't be packed.
+     */
+    SpriteFrame* addImage(std::string_view filename);
+
+    /**
+     * Decodes image files in parallel and packs them into new pages on the job system.
+     * The pages are uploaded and the frames become available on the axmol thread, then the callback is called.
+     * Images which were packed already or can't be packed are skipped.
+     */
+    void addImagesAsync(const std::vector<std::string>& filenames, std::function<void()> callback = nullptr);
+
+    /** Returns the frame of a packed image file, nullptr if the image isn't packed. */
+    SpriteFrame* getSpriteFrame(std::string_view filename) const;
+
+    /**
+     * Moves the sprites below root which draw the own texture of a packed image file to the frame of the image,
+     * so sprites created before the image was packed batch as well. Polygon sprites and sprites drawn by a
+     * SpriteBatchNode are left alone.
+     * @return The number of sprites moved.
+     */
+    int remapSprites(Node* root);
+
+    /** Evicts the pages none of whose frames is used by a sprite or retained otherwise. */
+    void removeUnusedPages();
+
+    /** Evicts all pages and forgets all packed images, sprites keep the pages they draw alive. */
+    void removeAllPages();
+
+    size_t getPageCount() const { return _pages.size(); }
+
+    /** Returns a description of the pages, their occupancy and frame count. */
+    std::string getDescription() const;
+
+protected:
+    struct Page;
+    struct AsyncBatch;
+
+    DynamicAtlas();
+    ~DynamicAtlas();
+
+    SpriteFrame* packImage(std::string_view fullPath, Image* image);
+    Page* addPage(AtlasPacker packer, bool premultipliedAlpha, std::vector<uint8_t> pixels);
+    SpriteFrame* addFrame(std::string_view fullPath, Page* page, int x, int y, int width, int height);
+    bool isPageUsed(const Page* page) const;
+    /** Evicts unused pages if count more pages would exceed the limit, returns how many pages may be added. */
+    size_t reservePages(size_t count);
+    void onImagesPacked(const std::shared_ptr<AsyncBatch>& batch);
+    void remapNode(Node* node, const std::unordered_map<Texture2D*, SpriteFrame*>& frames, int& count);
+
+    std::vector<std::unique_ptr<Page>> _pages;
+    /// The frames of the packed images, by full path.
+    hlookup::string_map<SpriteFrame*> _frames;
+    /// Full paths of the images decoded and found unsuitable, they aren't decoded again.
+    hlookup::string_set _rejected;
+
+    int _pageSize     = 2048;
+    int _maxImageSize = 256;
+    int _maxPageCount = 4;
+    bool _enabled     = false;
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
+
+#endif  // _AX_DYNAMIC_ATLAS_H_
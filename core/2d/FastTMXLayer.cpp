@@ -127,34 +127,25 @@ FastTMXLayer::~FastTMXLayer()
         AX_SAFE_RELEASE(e.second->getPipelineDescriptor().programState);
         delete e.second;
     }
+
+    releaseChunks();
 }
 
 void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    if (_chunkSize > 0)
+    {
+        drawChunks(renderer, transform, flags);
+        return;
+    }
+
     updateTotalQuads();
 
     auto cam = Camera::getVisitingCamera();
     if (flags != 0 || _dirty || _quadsDirty || !_cameraPositionDirty.fuzzyEquals(cam->getPosition(), _tileSet->_tileSize.x) ||
         _cameraZoomDirty != cam->getZoom())
     {
-        _cameraPositionDirty = cam->getPosition();
-        auto zoom            = _cameraZoomDirty = cam->getZoom();
-        Vec2 s               = _director->getVisibleSize();
-        const Vec2& anchor   = getAnchorPoint();
-        auto rect            = Rect(cam->getPositionX() - s.width * zoom * (anchor.x == 0.0f ? 0.5f : anchor.x),
-                                    cam->getPositionY() - s.height * zoom * (anchor.y == 0.0f ? 0.5f : anchor.y),
-                                    s.width * zoom, s.height * zoom);
-
-        rect.origin.x -= _tileSet->_tileSize.x;
-        rect.origin.y -= _tileSet->_tileSize.y;
-        rect.size.x += s.x * zoom / 2 + _tileSet->_tileSize.x * zoom;
-        rect.size.y += s.y * zoom / 2 + _tileSet->_tileSize.y * zoom;
-
-        Mat4 inv = transform;
-        inv.inverse();
-        rect = RectApplyTransform(rect, inv);
-
-        updateTiles(rect);
+        updateTiles(getCulledRect(transform));
         updateIndexBuffer();
         updatePrimitives();
         _dirty = false;
@@ -174,7 +165,28 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
     }
 }
 
-void FastTMXLayer::updateTiles(const Rect& culledRect)
+Rect FastTMXLayer::getCulledRect(const Mat4& transform)
+{
+    auto cam             = Camera::getVisitingCamera();
+    _cameraPositionDirty = cam->getPosition();
+    auto zoom            = _cameraZoomDirty = cam->getZoom();
+    Vec2 s               = _director->getVisibleSize();
+    const Vec2& anchor   = getAnchorPoint();
+    auto rect            = Rect(cam->getPositionX() - s.width * zoom * (anchor.x == 0.0f ? 0.5f : anchor.x),
+                                cam->getPositionY() - s.height * zoom * (anchor.y == 0.0f ? 0.5f : anchor.y),
+                                s.width * zoom, s.height * zoom);
+
+    rect.origin.x -= _tileSet->_tileSize.x;
+    rect.origin.y -= _tileSet->_tileSize.y;
+    rect.size.x += s.x * zoom / 2 + _tileSet->_tileSize.x * zoom;
+    rect.size.y += s.y * zoom / 2 + _tileSet->_tileSize.y * zoom;
+
+    Mat4 inv = transform;
+    inv.inverse();
+    return RectApplyTransform(rect, inv);
+}
+
+void FastTMXLayer::getVisibleTileRange(const Rect& culledRect, int& xBegin, int& xEnd, int& yBegin, int& yEnd)
 {
     Rect visibleTiles        = Rect(culledRect.origin, culledRect.size * _director->getContentScaleFactor());
     Vec2 mapTileSize         = AX_SIZE_PIXELS_TO_POINTS(_mapTileSize);
@@ -224,6 +236,19 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
         // AXASSERT(0, "TMX invalid value");
     }
 
+    yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
+    yEnd =
+        static_cast<int>(std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
+    xBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.x - tilesOverX));
+    xEnd =
+        static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
+}
+
+void FastTMXLayer::updateTiles(const Rect& culledRect)
+{
+    int xBegin = 0, xEnd = 0, yBegin = 0, yEnd = 0;
+    getVisibleTileRange(culledRect, xBegin, xEnd, yBegin, yEnd);
+
     _indicesVertexZNumber.clear();
 
     for (const auto& iter : _indicesVertexZOffsets)
@@ -231,13 +256,6 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
         _indicesVertexZNumber[iter.first] = iter.second;
     }
 
-    int yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
-    int yEnd =
-        static_cast<int>(std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
-    int xBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.x - tilesOverX));
-    int xEnd =
-        static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
-
     for (int y = yBegin; y < yEnd; ++y)
     {
         for (int x = xBegin; x < xEnd; ++x)
@@ -449,30 +467,7 @@ void FastTMXLayer::updatePrimitives()
 
             command->setIndexDrawInfo(start * 6, iter.second * 6);
 
-            auto& pipelineDescriptor = command->getPipelineDescriptor();
-
-            if (_useAutomaticVertexZ)
-            {
-                AX_SAFE_RELEASE(pipelineDescriptor.programState);
-                auto* program =
-                    backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
-                auto programState               = new backend::ProgramState(program);
-                pipelineDescriptor.programState = programState;
-                _alphaValueLocation             = pipelineDescriptor.programState->getUniformLocation("u_alpha_value");
-                pipelineDescriptor.programState->setUniform(_alphaValueLocation, &_alphaFuncValue,
-                                                            sizeof(_alphaFuncValue));
-            }
-            else
-            {
-                AX_SAFE_RELEASE(pipelineDescriptor.programState);
-                auto* program     = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
-                auto programState = new backend::ProgramState(program);
-                pipelineDescriptor.programState = programState;
-            }
-
-            _mvpMatrixLocaiton = pipelineDescriptor.programState->getUniformLocation("u_MVPMatrix");
-            _textureLocation   = pipelineDescriptor.programState->getUniformLocation("u_tex0");
-            pipelineDescriptor.programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+            setupTileProgramState(command);
             command->init(_globalZOrder, blendfunc);
 
             _customCommands[iter.first] = command;
@@ -484,6 +479,32 @@ void FastTMXLayer::updatePrimitives()
     }
 }
 
+void FastTMXLayer::setupTileProgramState(CustomCommand* command)
+{
+    auto& pipelineDescriptor = command->getPipelineDescriptor();
+
+    if (_useAutomaticVertexZ)
+    {
+        AX_SAFE_RELEASE(pipelineDescriptor.programState);
+        auto* program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST);
+        auto programState               = new backend::ProgramState(program);
+        pipelineDescriptor.programState = programState;
+        _alphaValueLocation             = pipelineDescriptor.programState->getUniformLocation("u_alpha_value");
+        pipelineDescriptor.programState->setUniform(_alphaValueLocation, &_alphaFuncValue, sizeof(_alphaFuncValue));
+    }
+    else
+    {
+        AX_SAFE_RELEASE(pipelineDescriptor.programState);
+        auto* program     = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_COLOR);
+        auto programState = new backend::ProgramState(program);
+        pipelineDescriptor.programState = programState;
+    }
+
+    _mvpMatrixLocaiton = pipelineDescriptor.programState->getUniformLocation("u_MVPMatrix");
+    _textureLocation   = pipelineDescriptor.programState->getUniformLocation("u_tex0");
+    pipelineDescriptor.programState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+}
+
 void FastTMXLayer::setOpacity(uint8_t opacity)
 {
     Node::setOpacity(opacity);
@@ -494,24 +515,13 @@ void FastTMXLayer::updateTotalQuads()
 {
     if (_quadsDirty)
     {
-        Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-        Vec2 texSize  = _tileSet->_imageSize;
         _tileToQuadIndex.clear();
         _totalQuads.resize(int(_layerSize.width * _layerSize.height));
         _indices.resize(6 * int(_layerSize.width * _layerSize.height));
         _tileToQuadIndex.resize(int(_layerSize.width * _layerSize.height), -1);
         _indicesVertexZOffsets.clear();
 
-        auto color = Color4B::WHITE;
-        color.a    = getDisplayedOpacity();
-
-        if (_texture->hasPremultipliedAlpha())
-        {
-            auto alpha = color.a / 255.0f;
-            color.r    = static_cast<uint8_t>(color.r * alpha);
-            color.g    = static_cast<uint8_t>(color.g * alpha);
-            color.b    = static_cast<uint8_t>(color.b * alpha);
-        }
+        auto color = getTileColor();
 
         int quadIndex = 0;
         for (int y = 0; y < _layerSize.height; ++y)
@@ -526,15 +536,7 @@ void FastTMXLayer::updateTotalQuads()
 
                 _tileToQuadIndex[tileIndex] = quadIndex;
 
-                auto& quad = _totalQuads[quadIndex];
-
-                Vec3 nodePos(float(x), float(y), 0);
-                _tileToNodeTransform.transformPoint(&nodePos);
-
-                float left, right, top, bottom, z;
-
                 int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
-                z         = (float)zPos;
                 auto iter = _indicesVertexZOffsets.find(zPos);
                 if (iter == _indicesVertexZOffsets.end())
                 {
@@ -544,83 +546,8 @@ void FastTMXLayer::updateTotalQuads()
                 {
                     iter->second++;
                 }
-                // vertices
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.height;
-                    bottom = nodePos.y + tileSize.width;
-                    top    = nodePos.y;
-                }
-                else
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.width;
-                    bottom = nodePos.y + tileSize.height;
-                    top    = nodePos.y;
-                }
-
-                if (tileGID & kTMXTileVerticalFlag)
-                    std::swap(top, bottom);
-                if (tileGID & kTMXTileHorizontalFlag)
-                    std::swap(left, right);
-
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    // FIXME: not working correctly
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = left;
-                    quad.br.vertices.y = top;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = right;
-                    quad.tl.vertices.y = bottom;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-                else
-                {
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = right;
-                    quad.br.vertices.y = bottom;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = left;
-                    quad.tl.vertices.y = top;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
 
-                // texcoords
-                Rect tileTexture = _tileSet->getRectForGID(tileGID);
-                left             = (tileTexture.origin.x / texSize.width);
-                right            = left + (tileTexture.size.width / texSize.width);
-                bottom           = (tileTexture.origin.y / texSize.height);
-                top              = bottom + (tileTexture.size.height / texSize.height);
-
-                // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
-                float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
-                float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
-
-                quad.bl.texCoords.u = left + ptx;
-                quad.bl.texCoords.v = bottom + pty;
-                quad.br.texCoords.u = right - ptx;
-                quad.br.texCoords.v = bottom + pty;
-                quad.tl.texCoords.u = left + ptx;
-                quad.tl.texCoords.v = top - pty;
-                quad.tr.texCoords.u = right - ptx;
-                quad.tr.texCoords.v = top - pty;
-
-                quad.bl.colors = color;
-                quad.br.colors = color;
-                quad.tl.colors = color;
-                quad.tr.colors = color;
+                setupTileQuad(_totalQuads[quadIndex], x, y, tileGID, (float)zPos, color);
 
                 ++quadIndex;
             }
@@ -638,6 +565,291 @@ void FastTMXLayer::updateTotalQuads()
     }
 }
 
+Color4B FastTMXLayer::getTileColor() const
+{
+    auto color = Color4B::WHITE;
+    color.a    = getDisplayedOpacity();
+
+    if (_texture->hasPremultipliedAlpha())
+    {
+        auto alpha = color.a / 255.0f;
+        color.r    = static_cast<uint8_t>(color.r * alpha);
+        color.g    = static_cast<uint8_t>(color.g * alpha);
+        color.b    = static_cast<uint8_t>(color.b * alpha);
+    }
+    return color;
+}
+
+void FastTMXLayer::setupTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, float z, const Color4B& color)
+{
+    Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    Vec2 texSize  = _tileSet->_imageSize;
+
+    Vec3 nodePos(float(x), float(y), 0);
+    _tileToNodeTransform.transformPoint(&nodePos);
+
+    float left, right, top, bottom;
+
+    // vertices
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.height;
+        bottom = nodePos.y + tileSize.width;
+        top    = nodePos.y;
+    }
+    else
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.width;
+        bottom = nodePos.y + tileSize.height;
+        top    = nodePos.y;
+    }
+
+    if (tileGID & kTMXTileVerticalFlag)
+        std::swap(top, bottom);
+    if (tileGID & kTMXTileHorizontalFlag)
+        std::swap(left, right);
+
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        // FIXME: not working correctly
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = left;
+        quad.br.vertices.y = top;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = right;
+        quad.tl.vertices.y = bottom;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+    else
+    {
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = right;
+        quad.br.vertices.y = bottom;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = left;
+        quad.tl.vertices.y = top;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+
+    // texcoords
+    Rect tileTexture = _tileSet->getRectForGID(tileGID);
+    left             = (tileTexture.origin.x / texSize.width);
+    right            = left + (tileTexture.size.width / texSize.width);
+    bottom           = (tileTexture.origin.y / texSize.height);
+    top              = bottom + (tileTexture.size.height / texSize.height);
+
+    // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
+    float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
+    float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
+
+    quad.bl.texCoords.u = left + ptx;
+    quad.bl.texCoords.v = bottom + pty;
+    quad.br.texCoords.u = right - ptx;
+    quad.br.texCoords.v = bottom + pty;
+    quad.tl.texCoords.u = left + ptx;
+    quad.tl.texCoords.v = top - pty;
+    quad.tr.texCoords.u = right - ptx;
+    quad.tr.texCoords.v = top - pty;
+
+    quad.bl.colors = color;
+    quad.br.colors = color;
+    quad.tl.colors = color;
+    quad.tr.colors = color;
+}
+
+// chunked mode
+void FastTMXLayer::setChunkSize(int chunkSize)
+{
+    // the chunk quads are drawn with 16-bit indices
+    chunkSize = std::clamp(chunkSize, 0, 128);
+    if (chunkSize == _chunkSize)
+        return;
+
+    releaseChunks();
+    _chunkSize = chunkSize;
+
+    if (_chunkSize > 0)
+    {
+        // the quads of the whole layer are not needed anymore
+        _totalQuads = {};
+        _indices    = {};
+        _tileToQuadIndex = {};
+        _indicesVertexZOffsets.clear();
+        _indicesVertexZNumber.clear();
+        for (auto&& e : _customCommands)
+        {
+            AX_SAFE_RELEASE(e.second->getPipelineDescriptor().programState);
+            delete e.second;
+        }
+        _customCommands.clear();
+        AX_SAFE_RELEASE_NULL(_vertexBuffer);
+        AX_SAFE_RELEASE_NULL(_indexBuffer);
+
+        _chunkCountX = ((int)_layerSize.width + _chunkSize - 1) / _chunkSize;
+        _chunkCountY = ((int)_layerSize.height + _chunkSize - 1) / _chunkSize;
+
+        std::vector<unsigned short> indices(6 * _chunkSize * _chunkSize);
+        for (int i = 0; i < _chunkSize * _chunkSize; ++i)
+        {
+            indices[6 * i + 0] = static_cast<unsigned short>(i * 4 + 0);
+            indices[6 * i + 1] = static_cast<unsigned short>(i * 4 + 1);
+            indices[6 * i + 2] = static_cast<unsigned short>(i * 4 + 2);
+            indices[6 * i + 3] = static_cast<unsigned short>(i * 4 + 3);
+            indices[6 * i + 4] = static_cast<unsigned short>(i * 4 + 2);
+            indices[6 * i + 5] = static_cast<unsigned short>(i * 4 + 1);
+        }
+        auto indexBufferSize = sizeof(unsigned short) * indices.size();
+        _chunkIndexBuffer    = backend::DriverBase::getInstance()->newBuffer(indexBufferSize, backend::BufferType::INDEX,
+                                                                             backend::BufferUsage::STATIC);
+        _chunkIndexBuffer->updateData(indices.data(), indexBufferSize);
+    }
+
+    _quadsDirty = true;
+    _dirty      = true;
+}
+
+void FastTMXLayer::drawChunks(Renderer* renderer, const Mat4& transform, uint32_t flags)
+{
+    if (_quadsDirty)
+    {
+        for (auto&& chunk : _chunks)
+            chunk.second.dirty = true;
+        _quadsDirty = false;
+    }
+
+    auto cam = Camera::getVisitingCamera();
+    if (flags != 0 || _dirty || !_cameraPositionDirty.fuzzyEquals(cam->getPosition(), _tileSet->_tileSize.x) ||
+        _cameraZoomDirty != cam->getZoom())
+    {
+        int xBegin = 0, xEnd = 0, yBegin = 0, yEnd = 0;
+        getVisibleTileRange(getCulledRect(transform), xBegin, xEnd, yBegin, yEnd);
+
+        _chunkBeginX = xBegin / _chunkSize;
+        _chunkBeginY = yBegin / _chunkSize;
+        _chunkEndX   = xEnd > xBegin ? (xEnd + _chunkSize - 1) / _chunkSize : _chunkBeginX;
+        _chunkEndY   = yEnd > yBegin ? (yEnd + _chunkSize - 1) / _chunkSize : _chunkBeginY;
+
+        // evict the chunks far away from the camera
+        for (auto it = _chunks.begin(); it != _chunks.end();)
+        {
+            int chunkX = it->first % _chunkCountX;
+            int chunkY = it->first / _chunkCountX;
+            if (chunkX < _chunkBeginX - _chunkEvictMargin || chunkX >= _chunkEndX + _chunkEvictMargin ||
+                chunkY < _chunkBeginY - _chunkEvictMargin || chunkY >= _chunkEndY + _chunkEvictMargin)
+            {
+                releaseChunk(it->second);
+                it = _chunks.erase(it);
+            }
+            else
+                ++it;
+        }
+        _dirty = false;
+    }
+
+    const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    Mat4 finalMat             = projectionMat * _modelViewTransform;
+    for (int chunkY = _chunkBeginY; chunkY < _chunkEndY; ++chunkY)
+    {
+        for (int chunkX = _chunkBeginX; chunkX < _chunkEndX; ++chunkX)
+        {
+            auto chunk = getChunk(chunkX, chunkY);
+            if (chunk->quadCount == 0)
+                continue;
+
+            auto programState = chunk->command->getPipelineDescriptor().programState;
+            programState->setUniform(_mvpMatrixLocaiton, finalMat.m, sizeof(finalMat.m));
+            renderer->addCommand(chunk->command);
+        }
+    }
+}
+
+FastTMXLayer::TileChunk* FastTMXLayer::getChunk(int chunkX, int chunkY)
+{
+    auto& chunk = _chunks[getChunkIndexByPos(chunkX, chunkY)];
+    if (chunk.dirty)
+        updateChunk(&chunk, chunkX, chunkY);
+    return &chunk;
+}
+
+void FastTMXLayer::updateChunk(TileChunk* chunk, int chunkX, int chunkY)
+{
+    auto color = getTileColor();
+    int xBegin = chunkX * _chunkSize;
+    int yBegin = chunkY * _chunkSize;
+    int xEnd   = std::min(xBegin + _chunkSize, (int)_layerSize.width);
+    int yEnd   = std::min(yBegin + _chunkSize, (int)_layerSize.height);
+
+    _chunkQuads.resize(_chunkSize * _chunkSize);
+    int quadCount = 0;
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        for (int x = xBegin; x < xEnd; ++x)
+        {
+            uint32_t tileGID = _tiles[getTileIndexByPos(x, y)];
+            if (tileGID == 0)
+                continue;
+
+            float z = (float)getVertexZForPos(Vec2((float)x, (float)y));
+            setupTileQuad(_chunkQuads[quadCount++], x, y, tileGID, z, color);
+        }
+    }
+
+    chunk->dirty = false;
+    if (quadCount == 0)
+    {
+        chunk->quadCount = 0;
+        return;
+    }
+
+    if (!chunk->command)
+    {
+        chunk->command = new CustomCommand();
+        chunk->command->setIndexBuffer(_chunkIndexBuffer, CustomCommand::IndexFormat::U_SHORT);
+        setupTileProgramState(chunk->command);
+        auto blendfunc =
+            _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+        chunk->command->init(_globalZOrder, blendfunc);
+    }
+
+    // the vertex buffer only grows, a chunk is rebuilt when its tiles are modified
+    if (quadCount > chunk->quadCount || !chunk->command->getVertexBuffer())
+        chunk->command->createVertexBuffer(sizeof(V3F_C4B_T2F), quadCount * 4, CustomCommand::BufferUsage::STATIC);
+    chunk->command->updateVertexBuffer(_chunkQuads.data(), sizeof(V3F_C4B_T2F_Quad) * quadCount);
+    chunk->command->setIndexDrawInfo(0, quadCount * 6);
+    chunk->quadCount = quadCount;
+}
+
+void FastTMXLayer::releaseChunk(TileChunk& chunk)
+{
+    if (chunk.command)
+    {
+        AX_SAFE_RELEASE(chunk.command->getPipelineDescriptor().programState);
+        delete chunk.command;
+        chunk.command = nullptr;
+    }
+}
+
+void FastTMXLayer::releaseChunks()
+{
+    for (auto&& chunk : _chunks)
+        releaseChunk(chunk.second);
+    _chunks.clear();
+    _chunkQuads = {};
+    AX_SAFE_RELEASE_NULL(_chunkIndexBuffer);
+}
+
 // removing / getting tiles
 Sprite* FastTMXLayer::getTileAt(const Vec2& tileCoordinate)
 {
@@ -777,8 +989,20 @@ void FastTMXLayer::setFlaggedTileGIDByIndex(int index, uint32_t gid)
     if (gid == _tiles[index])
         return;
     _tiles[index] = gid;
-    _quadsDirty   = true;
     _dirty        = true;
+    if (_chunkSize > 0)
+    {
+        // only rebuild the chunk of the tile
+        int x   = index % (int)_layerSize.width;
+        int y   = index / (int)_layerSize.width;
+        auto it = _chunks.find(getChunkIndexByPos(x / _chunkSize, y / _chunkSize));
+        if (it != _chunks.end())
+            it->second.dirty = true;
+    }
+    else
+    {
+        _quadsDirty = true;
+    }
 }
 
 void FastTMXLayer::removeChild(Node* node, bool cleanup)
@@ -804,6 +1028,10 @@ Value FastTMXLayer::getProperty(std::string_view propertyName) const
 
 void FastTMXLayer::parseInternalProperties()
 {
+    auto chunkSize = getProperty("ax_chunk_size");
+    if (!chunkSize.isNull())
+        setChunkSize(chunkSize.asInt());
+
     auto vertexz = getProperty("cc_vertexz");
     if (vertexz.isNull())
         return;
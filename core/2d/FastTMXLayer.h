@@ -301,10 +301,38 @@ public:
                                                      TMXLayerInfo* layerInfo,
                                                      TMXMapInfo* mapInfo);
 
+    /** Enables the chunked mode for very large layers.
+     * The layer is split into chunks of chunkSize x chunkSize tiles with their own vertex buffer, a chunk is built
+     * when it becomes visible and evicted when it is far away from the camera, so the quads of the whole layer are
+     * never allocated. It can be enabled by the layer property "ax_chunk_size" too.
+     *
+     * @param chunkSize The chunk size in tiles, up to 128, 0 disables the chunked mode.
+     */
+    void setChunkSize(int chunkSize);
+
+    int getChunkSize() const { return _chunkSize; }
+
+    /** Sets how many chunks around the visible ones are kept before being evicted, 2 by default. */
+    void setChunkEvictMargin(int margin) { _chunkEvictMargin = margin; }
+
+    int getChunkEvictMargin() const { return _chunkEvictMargin; }
+
+    /** Returns the number of chunks which are built currently. */
+    int getLoadedChunkCount() const { return static_cast<int>(_chunks.size()); }
+
 protected:
+    struct TileChunk
+    {
+        CustomCommand* command = nullptr;
+        int quadCount          = 0;
+        bool dirty             = true;
+    };
+
     virtual void setOpacity(uint8_t opacity) override;
 
     void updateTiles(const Rect& culledRect);
+    Rect getCulledRect(const Mat4& transform);
+    void getVisibleTileRange(const Rect& culledRect, int& xBegin, int& xEnd, int& yBegin, int& yEnd);
     Vec2 calculateLayerOffset(const Vec2& offset);
 
     /* The layer recognizes some special properties, like cc_vertexz */
@@ -326,6 +354,17 @@ protected:
     void updateVertexBuffer();
     void updateIndexBuffer();
     void updatePrimitives();
+    void setupTileProgramState(CustomCommand* command);
+    Color4B getTileColor() const;
+    void setupTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, float z, const Color4B& color);
+
+    // chunked mode
+    void drawChunks(Renderer* renderer, const Mat4& transform, uint32_t flags);
+    TileChunk* getChunk(int chunkX, int chunkY);
+    void updateChunk(TileChunk* chunk, int chunkX, int chunkY);
+    void releaseChunk(TileChunk& chunk);
+    void releaseChunks();
+    int getChunkIndexByPos(int chunkX, int chunkY) const { return chunkX + chunkY * _chunkCountX; }
 
     //! name of the layer
     std::string _layerName;
@@ -386,6 +425,20 @@ protected:
     float _alphaFuncValue = 0.f;
     std::unordered_map<int, CustomCommand*> _customCommands;
 
+    /** data for the chunked mode */
+    int _chunkSize        = 0;
+    int _chunkEvictMargin = 2;
+    int _chunkCountX      = 0;
+    int _chunkCountY      = 0;
+    int _chunkBeginX      = 0;
+    int _chunkEndX        = 0;
+    int _chunkBeginY      = 0;
+    int _chunkEndY        = 0;
+    std::unordered_map<int /*chunk index*/, TileChunk> _chunks;
+    std::vector<V3F_C4B_T2F_Quad> _chunkQuads;
+    /** all the chunks share the indices, the quads of a chunk are drawn in order */
+    backend::Buffer* _chunkIndexBuffer = nullptr;
+
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
     backend::UniformLocation _alphaValueLocation;
@@ -281,6 +281,18 @@ void FastTMXTiledMap::setTileAnimEnabled(bool enabled)
     }
 }
 
+void FastTMXTiledMap::setChunkSize(int chunkSize)
+{
+    for (auto&& child : _children)
+    {
+        FastTMXLayer* layer = dynamic_cast<FastTMXLayer*>(child);
+        if (layer)
+        {
+            layer->setChunkSize(chunkSize);
+        }
+    }
+}
+
 TMXTilesetInfo* FastTMXTiledMap::getTilesetInfo(std::string_view tsxNameString)
 {
     if (_mapInfo == nullptr)
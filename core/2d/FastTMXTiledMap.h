@@ -204,6 +204,11 @@ public:
      */
     void setTileAnimEnabled(bool enabled);
 
+    /** Enables the chunked mode of all the layers, for very large maps.
+     *  @see FastTMXLayer::setChunkSize
+     */
+    void setChunkSize(int chunkSize);
+
     AX_DEPRECATED_ATTRIBUTE int getLayerNum() const { return getLayerCount(); }
 
     int getLayerCount() const { return _layerCount; }
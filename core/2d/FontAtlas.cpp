@@ -32,6 +32,7 @@
 #endif
 #include <algorithm>
 #include "2d/FontFreeType.h"
+#include "2d/LabelLayoutCache.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/EventListenerCustom.h"
@@ -191,6 +192,8 @@ FontAtlas::~FontAtlas()
     }
 #endif
 
+    LabelLayoutCache::removeLayoutsForAtlas(this);
+
     _font->release();
     releaseTextures();
 
@@ -32,6 +32,7 @@
 #include "2d/Font.h"
 #include "2d/FontAtlasCache.h"
 #include "2d/FontAtlas.h"
+#include "2d/LabelLayoutCache.h"
 #include "2d/Sprite.h"
 #include "2d/SpriteBatchNode.h"
 #include "2d/DrawNode.h"
@@ -1119,18 +1120,26 @@ bool Label::alignText()
 
         _reusedLetter->setBatchNode(_batchNodes.at(0));
 
-        _lengthOfString    = 0;
-        _textDesiredHeight = 0.f;
-        _linesWidth.clear();
-        if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
-        {
-            multilineTextWrapByWord();
-        }
-        else
+        // a repeated string reuses the cached line breaks and letter positions, only the quads are rebuilt
+        if (!applyCachedLayout())
         {
-            multilineTextWrapByChar();
+            computeHorizontalKernings(_utf32Text);
+
+            _lengthOfString    = 0;
+            _textDesiredHeight = 0.f;
+            _linesWidth.clear();
+            if (_maxLineWidth > 0.f && !_lineBreakWithoutSpaces)
+            {
+                multilineTextWrapByWord();
+            }
+            else
+            {
+                multilineTextWrapByChar();
+            }
+            computeAlignmentOffset();
+
+            storeCachedLayout();
         }
-        computeAlignmentOffset();
 
         if (_overflow == Overflow::SHRINK)
         {
@@ -1177,6 +1186,99 @@ bool Label::computeHorizontalKernings(const std::u32string& stringToRender)
         return true;
 }
 
+bool Label::isLayoutCacheable() const
+{
+    // shrink overflow changes the font size while laying out, so it can't be reused
+    return LabelLayoutCache::isEnabled() && _overflow != Overflow::SHRINK;
+}
+
+void Label::buildLayoutCacheKey(std::string& key)
+{
+    updateFontScale();
+
+    struct LayoutParams
+    {
+        FontAtlas* atlas;
+        float fontScale;
+        float contentScaleFactor;
+        float lineHeight;
+        float lineSpacing;
+        float additionalKerning;
+        float maxLineWidth;
+        float labelWidth;
+        float labelHeight;
+        int hAlignment;
+        int vAlignment;
+        int overflow;
+        bool enableWrap;
+        bool lineBreakWithoutSpaces;
+    } params;
+    memset(&params, 0, sizeof(params));  // padding bytes are part of the key
+    params.atlas                  = _fontAtlas;
+    params.fontScale              = _fontScale;
+    params.contentScaleFactor     = AX_CONTENT_SCALE_FACTOR();
+    params.lineHeight             = _lineHeight;
+    params.lineSpacing            = _lineSpacing;
+    params.additionalKerning      = _additionalKerning;
+    params.maxLineWidth           = _maxLineWidth;
+    params.labelWidth             = _labelWidth;
+    params.labelHeight            = _labelHeight;
+    params.hAlignment             = static_cast<int>(_hAlignment);
+    params.vAlignment             = static_cast<int>(_vAlignment);
+    params.overflow               = static_cast<int>(_overflow);
+    params.enableWrap             = _enableWrap;
+    params.lineBreakWithoutSpaces = _lineBreakWithoutSpaces;
+
+    key.assign(reinterpret_cast<const char*>(&params), sizeof(params));
+    key.append(_utf8Text);
+}
+
+bool Label::applyCachedLayout()
+{
+    if (!isLayoutCacheable())
+        return false;
+
+    buildLayoutCacheKey(_layoutCacheKey);
+    auto layout = LabelLayoutCache::findLayout(_layoutCacheKey);
+    if (!layout)
+        return false;
+
+    _lettersInfo.assign(layout->lettersInfo.begin(), layout->lettersInfo.end());
+    _linesWidth        = layout->linesWidth;
+    _linesOffsetX      = layout->linesOffsetX;
+    _numberOfLines     = layout->numberOfLines;
+    _lengthOfString    = layout->lengthOfString;
+    _textDesiredHeight = layout->textDesiredHeight;
+    _letterOffsetY     = layout->letterOffsetY;
+    _tailoredTopY      = layout->tailoredTopY;
+    _tailoredBottomY   = layout->tailoredBottomY;
+    setContentSize(layout->contentSize);
+
+    return true;
+}
+
+void Label::storeCachedLayout()
+{
+    if (!isLayoutCacheable())
+        return;
+
+    LabelLayoutCache::Layout layout;
+    layout.atlas = _fontAtlas;
+    layout.lettersInfo.assign(_lettersInfo.begin(),
+                              _lettersInfo.begin() + (std::min)(static_cast<size_t>(_lengthOfString), _lettersInfo.size()));
+    layout.linesWidth        = _linesWidth;
+    layout.linesOffsetX      = _linesOffsetX;
+    layout.numberOfLines     = _numberOfLines;
+    layout.lengthOfString    = _lengthOfString;
+    layout.textDesiredHeight = _textDesiredHeight;
+    layout.letterOffsetY     = _letterOffsetY;
+    layout.tailoredTopY      = _tailoredTopY;
+    layout.tailoredBottomY   = _tailoredBottomY;
+    layout.contentSize       = _contentSize;
+
+    LabelLayoutCache::addLayout(_layoutCacheKey, std::move(layout));
+}
+
 bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
 {
     auto wordWidth       = this->_linesWidth[lineIndex];
@@ -1688,13 +1790,7 @@ void Label::updateContent()
 
     if (_fontAtlas)
     {
-        std::u32string utf32String;
-        if (StringUtils::UTF8ToUTF32(_utf8Text, utf32String))
-        {
-            _utf32Text = utf32String;
-        }
-
-        computeHorizontalKernings(_utf32Text);
+        // _utf32Text is kept in sync by setString, the kernings are computed by alignText on layout cache miss
         updateFinished = alignText();
     }
     else
@@ -1805,12 +1901,21 @@ void Label::updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customComman
     customCommand.setIndexDrawInfo(0, (unsigned int)(textureAtlas->getTotalQuads() * 6));
 }
 
+bool Label::isTextBatchable(TextureAtlas* textureAtlas) const
+{
+    return _currentLabelType == LabelType::TTF && !_shadowEnabled &&
+           (_currLabelEffect != LabelEffect::OUTLINE || _useDistanceField) &&
+           textureAtlas->getTotalQuads() * 4 < Renderer::VBO_SIZE;
+}
+
 void Label::updateEffectUniforms(BatchCommand& batch,
                                  TextureAtlas* textureAtlas,
                                  Renderer* renderer,
                                  const Mat4& transform)
 {
-    updateBuffer(textureAtlas, batch.textCommand);
+    const bool batchText = isTextBatchable(textureAtlas);
+    if (!batchText)
+        updateBuffer(textureAtlas, batch.textCommand);
 
     auto& matrixProjection = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
 
@@ -1924,7 +2029,21 @@ void Label::updateEffectUniforms(BatchCommand& batch,
         }
     }
 
-    batch.textCommand.init(_globalZOrder);
+    if (batchText)
+    {
+        // the quads are transformed on the CPU, labels sharing the atlas and the uniforms become one draw call
+        auto totalQuads = static_cast<unsigned int>(textureAtlas->getTotalQuads());
+        batch.textCommand.init(_globalZOrder, transform, 0);
+        batch.textCommand.setBatchTriangles(
+            TrianglesCommand::Triangles(reinterpret_cast<V3F_C4B_T2F*>(textureAtlas->getQuads()),
+                                        textureAtlas->getIndices(), totalQuads * 4, totalQuads * 6),
+            textureAtlas->getTexture()->getBackendTexture());
+    }
+    else
+    {
+        batch.textCommand.resetBatchTriangles();
+        batch.textCommand.init(_globalZOrder);
+    }
     renderer->addCommand(&batch.textCommand);
 }
 
@@ -2006,8 +2125,9 @@ void Label::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
                     programState->setUniform(_textColorLocation, &textColor, sizeof(Vec4));
                     programState->setTexture(textureAtlas->getTexture()->getBackendTexture());
                 }
-                batch.textCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixMVP.m,
-                                                                                   sizeof(matrixMVP.m));
+                auto& textMVP = isTextBatchable(textureAtlas) ? matrixProjection : matrixMVP;
+                batch.textCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, textMVP.m,
+                                                                                   sizeof(textMVP.m));
                 batch.outLineCommand.getPipelineDescriptor().programState->setUniform(_mvpMatrixLocation, matrixMVP.m,
                                                                                       sizeof(matrixMVP.m));
                 updateEffectUniforms(batch, textureAtlas, renderer, transform);
@@ -783,6 +783,11 @@ protected:
     void computeAlignmentOffset();
     bool computeHorizontalKernings(const std::u32string& stringToRender);
 
+    bool isLayoutCacheable() const;
+    void buildLayoutCacheKey(std::string& key);
+    bool applyCachedLayout();
+    void storeCachedLayout();
+
     void recordLetterInfo(const ax::Vec2& point, char32_t utf32Char, int letterIndex, int lineIndex);
     void recordPlaceholderInfo(int letterIndex, char32_t utf16Char);
 
@@ -819,6 +824,8 @@ protected:
                               Renderer* renderer,
                               const Mat4& transform);
     void updateBuffer(TextureAtlas* textureAtlas, CustomCommand& customCommand);
+    // Whether the text command alone draws the label and can join the renderer's triangle batch.
+    bool isTextBatchable(TextureAtlas* textureAtlas) const;
 
     void updateBatchCommand(BatchCommand& batch);
     
@@ -904,6 +911,7 @@ protected:
 
     std::u32string _utf32Text;
     std::string _utf8Text;
+    std::string _layoutCacheKey;
 
     std::string _bmFontPath;
     std::string _bmSubTextureKey;
@@ -937,6 +945,8 @@ protected:
     backend::UniformLocation _effectTypeLocation;
 
 private:
+    friend class LabelLayoutCache;
+
     AX_DISALLOW_COPY_AND_ASSIGN(Label);
 };
 
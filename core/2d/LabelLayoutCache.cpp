@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "2d/LabelLayoutCache.h"
+
+NS_AX_BEGIN
+
+LabelLayoutCache::LayoutList LabelLayoutCache::_layouts;
+hlookup::string_map<LabelLayoutCache::LayoutList::iterator> LabelLayoutCache::_layoutMap;
+size_t LabelLayoutCache::_capacity = 256;
+LabelLayoutCache::Stats LabelLayoutCache::_stats;
+
+void LabelLayoutCache::setCapacity(size_t capacity)
+{
+    _capacity = capacity;
+    while (_layouts.size() > _capacity)
+        evictLayout(std::prev(_layouts.end()));
+}
+
+void LabelLayoutCache::purgeCachedData()
+{
+    _layoutMap.clear();
+    _layouts.clear();
+    _stats.entries = 0;
+}
+
+void LabelLayoutCache::removeLayoutsForAtlas(FontAtlas* atlas)
+{
+    for (auto it = _layouts.begin(); it != _layouts.end();)
+    {
+        auto next = std::next(it);
+        if (it->second.atlas == atlas)
+        {
+            _layoutMap.erase(it->first);
+            _layouts.erase(it);
+        }
+        it = next;
+    }
+    _stats.entries = _layouts.size();
+}
+
+void LabelLayoutCache::resetStats()
+{
+    _stats         = Stats{};
+    _stats.entries = _layouts.size();
+}
+
+const LabelLayoutCache::Layout* LabelLayoutCache::findLayout(std::string_view key)
+{
+    auto it = _layoutMap.find(key);
+    if (it == _layoutMap.end())
+    {
+        ++_stats.misses;
+        return nullptr;
+    }
+
+    ++_stats.hits;
+    auto layoutIt = it->second;
+    if (layoutIt != _layouts.begin())
+        _layouts.splice(_layouts.begin(), _layouts, layoutIt);
+    return &layoutIt->second;
+}
+
+void LabelLayoutCache::addLayout(std::string_view key, Layout&& layout)
+{
+    if (_capacity == 0)
+        return;
+
+    auto it = _layoutMap.find(key);
+    if (it != _layoutMap.end())
+    {
+        _layouts.erase(it->second);
+        _layoutMap.erase(it);
+    }
+
+    while (_layouts.size() >= _capacity)
+        evictLayout(std::prev(_layouts.end()));
+
+    _layouts.emplace_front(std::string{key}, std::move(layout));
+    _layoutMap.emplace(_layouts.front().first, _layouts.begin());
+    _stats.entries = _layouts.size();
+}
+
+void LabelLayoutCache::evictLayout(LayoutList::iterator it)
+{
+    _layoutMap.erase(it->first);
+    _layouts.erase(it);
+    ++_stats.evictions;
+    _stats.entries = _layouts.size();
+}
+
+NS_AX_END
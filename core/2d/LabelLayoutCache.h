@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _AX_LABEL_LAYOUT_CACHE_H_
+#define _AX_LABEL_LAYOUT_CACHE_H_
+
+#include <list>
+#include "2d/Label.h"
+
+NS_AX_BEGIN
+
+class FontAtlas;
+
+/**
+ * @brief A shared LRU cache of Label text layouts.
+ *
+ * Labels whose text changes every frame (scores, timers, damage numbers) usually cycle
+ * through a small set of strings. The result of wrapping & aligning a string (letter
+ * positions, line breaks and line offsets) is stored per (text, font atlas, dimensions,
+ * overflow, alignment, spacing), so a repeated string skips the utf32 conversion, kerning and
+ * wrapping, only the quads are rebuilt from the cached letter positions.
+ *
+ * Labels with Overflow::SHRINK are never cached, since their layout changes the font size.
+ * The cache should be accessed from the main thread only.
+ */
+class AX_DLL LabelLayoutCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits      = 0;
+        uint64_t misses    = 0;
+        uint64_t evictions = 0;
+        size_t entries     = 0;
+
+        float getHitRate() const { return (hits + misses) ? static_cast<float>(hits) / (hits + misses) : 0.f; }
+    };
+
+    /** Set the max number of cached layouts, 256 by default, 0 disables the cache. */
+    static void setCapacity(size_t capacity);
+    static size_t getCapacity() { return _capacity; }
+
+    static bool isEnabled() { return _capacity > 0; }
+
+    /** Removes all cached layouts. */
+    static void purgeCachedData();
+
+    /** Removes the cached layouts of the specified font atlas, called when the atlas is destroyed. */
+    static void removeLayoutsForAtlas(FontAtlas* atlas);
+
+    static const Stats& getStats() { return _stats; }
+    static void resetStats();
+
+protected:
+    friend class Label;
+
+    struct Layout
+    {
+        FontAtlas* atlas = nullptr;
+        std::vector<Label::LetterInfo> lettersInfo;
+        std::vector<float> linesWidth;
+        std::vector<float> linesOffsetX;
+        int numberOfLines       = 0;
+        int lengthOfString      = 0;
+        float textDesiredHeight = 0.f;
+        float letterOffsetY     = 0.f;
+        float tailoredTopY      = 0.f;
+        float tailoredBottomY   = 0.f;
+        Vec2 contentSize;
+    };
+
+    /** Returns the cached layout and marks it as most recently used, or nullptr. */
+    static const Layout* findLayout(std::string_view key);
+    static void addLayout(std::string_view key, Layout&& layout);
+
+private:
+    using LayoutList = std::list<std::pair<std::string, Layout>>;
+
+    static void evictLayout(LayoutList::iterator it);
+
+    static LayoutList _layouts;
+    static hlookup::string_map<LayoutList::iterator> _layoutMap;
+    static size_t _capacity;
+    static Stats _stats;
+};
+
+NS_AX_END
+
+#endif
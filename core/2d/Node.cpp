@@ -32,7 +32,6 @@ THE SOFTWARE.
 
 #include <algorithm>
 #include <string>
-#include <regex>
 
 #include "xxhash.h"
 #include "base/Director.h"
@@ -43,6 +42,7 @@ THE SOFTWARE.
 #include "2d/ActionManager.h"
 #include "2d/Scene.h"
 #include "2d/Component.h"
+#include "2d/NodeQuery.h"
 #include "renderer/Material.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
@@ -64,7 +64,9 @@ NS_AX_BEGIN
 // FIXME:: Yes, nodes might have a sort problem once every 30 days if the game runs at 60 FPS and each frame sprites are
 // reordered.
 std::uint32_t Node::s_globalOrderOfArrival = 0;
+std::uint32_t Node::s_hierarchyVersion     = 0;
 int Node::__attachedNodeCount              = 0;
+const std::function<void()> Node::s_emptyCallback;
 
 // MARK: Constructor, Destructor, Init
 
@@ -86,7 +88,6 @@ Node::Node()
     , _contentSizeDirty(true)
     , _transformDirty(true)
     , _inverseDirty(true)
-    , _additionalTransform(nullptr)
     , _additionalTransformDirty(false)
     , _transformUpdated(true)
     // children (lazy allocs)
@@ -97,21 +98,13 @@ Node::Node()
     , _parent(nullptr)
     // "whole screen" objects. like Scenes and Layers, should set _ignoreAnchorPointForPosition to true
     , _tag(Node::INVALID_TAG)
-    , _name()
     , _hashOfName(0)
-    // userData is always inited as nil
-    , _userData(nullptr)
-    , _userObject(nullptr)
+    , _hierarchyVersion(0)
     , _running(false)
     , _visible(true)
     , _ignoreAnchorPointForPosition(false)
     , _reorderChildDirty(false)
     , _isTransitionFinished(false)
-#if AX_ENABLE_SCRIPT_BINDING
-    , _scriptHandler(0)
-    , _updateScriptHandler(0)
-#endif
-    , _componentContainer(nullptr)
     , _displayedOpacity(255)
     , _realOpacity(255)
     , _displayedColor(Color3B::WHITE)
@@ -120,10 +113,10 @@ Node::Node()
     , _cascadeOpacityEnabled(false)
     , _childFollowCameraMask(false)
     , _cameraMask(1)
-    , _onEnterCallback(nullptr)
-    , _onExitCallback(nullptr)
-    , _onEnterTransitionDidFinishCallback(nullptr)
-    , _onExitTransitionDidStartCallback(nullptr)
+    , _subtreeCameraMask(1)
+    , _subtreeCameraMaskDirty(false)
+    // lazy alloc
+    , _coldData(nullptr)
 #if defined(AX_ENABLE_PHYSICS)
     , _physicsBody(nullptr)
 #endif
@@ -161,16 +154,17 @@ Node::~Node()
     AX_SAFE_DELETE(_childrenIndexer);
 
 #if AX_ENABLE_SCRIPT_BINDING
-    if (_updateScriptHandler)
+    if (_coldData && _coldData->updateScriptHandler)
     {
-        ScriptEngineManager::getInstance()->getScriptEngine()->removeScriptHandler(_updateScriptHandler);
+        ScriptEngineManager::getInstance()->getScriptEngine()->removeScriptHandler(_coldData->updateScriptHandler);
     }
 #endif
 
     // User object has to be released before others, since userObject may have a weak reference of this node
     // It may invoke `node->stopAllActions();` while `_actionManager` is null if the next line is after
     // `AX_SAFE_RELEASE_NULL(_actionManager)`.
-    AX_SAFE_RELEASE_NULL(_userObject);
+    if (_coldData)
+        AX_SAFE_RELEASE_NULL(_coldData->userObject);
 
     for (auto&& child : _children)
     {
@@ -179,7 +173,8 @@ Node::~Node()
 
     removeAllComponents();
 
-    AX_SAFE_DELETE(_componentContainer);
+    if (_coldData)
+        AX_SAFE_DELETE(_coldData->componentContainer);
 
     stopAllActions();
     unscheduleAllCallbacks();
@@ -197,7 +192,9 @@ Node::~Node()
              "onExit() implementations?");
     AX_SAFE_RELEASE(_eventDispatcher);
 
-    delete[] _additionalTransform;
+    if (_coldData)
+        delete[] _coldData->additionalTransform;
+    AX_SAFE_DELETE(_coldData);
     AX_SAFE_RELEASE(_programState);
 }
 
@@ -671,6 +668,19 @@ bool Node::isRunning() const
 /// parent setter
 void Node::setParent(Node* parent)
 {
+    if (_parent != parent)
+    {
+        if (_parent)
+        {
+            _parent->markSubtreeCameraMaskDirty();
+            _parent->markHierarchyChanged();
+        }
+        if (parent)
+        {
+            parent->markSubtreeCameraMaskDirty();
+            parent->markHierarchyChanged();
+        }
+    }
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
@@ -707,13 +717,16 @@ void Node::setTag(int tag)
 
 std::string_view Node::getName() const
 {
-    return _name;
+    return _coldData ? std::string_view{_coldData->name} : std::string_view{};
 }
 
 void Node::setName(std::string_view name)
 {
     updateParentChildrenIndexer(name);
-    _name = name;
+    if (_coldData || !name.empty())
+        getColdData().name = name;
+    if (_parent)
+        _parent->markHierarchyChanged();
 }
 
 void Node::updateParentChildrenIndexer(int tag)
@@ -733,7 +746,7 @@ void Node::updateParentChildrenIndexer(std::string_view name)
     auto parentChildrenIndexer = getParentChildrenIndexer();
     if (parentChildrenIndexer)
     {
-        auto oldHash = AX_HASH_NODE_NAME(_name);
+        auto oldHash = AX_HASH_NODE_NAME(getName());
         if (oldHash != newHash)
             parentChildrenIndexer->erase(oldHash);
         (*parentChildrenIndexer)[newHash] = this;
@@ -760,24 +773,29 @@ NodeIndexerMap_t* Node::getParentChildrenIndexer()
 /// userData setter
 void Node::setUserData(void* userData)
 {
-    _userData = userData;
+    if (_coldData || userData)
+        getColdData().userData = userData;
 }
 
 void Node::setUserObject(Object* userObject)
 {
+    if (!_coldData && !userObject)
+        return;
+
+    auto& coldData = getColdData();
 #if AX_ENABLE_GC_FOR_NATIVE_OBJECTS
     auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
     if (sEngine)
     {
         if (userObject)
             sEngine->retainScriptObject(this, userObject);
-        if (_userObject)
-            sEngine->releaseScriptObject(this, _userObject);
+        if (coldData.userObject)
+            sEngine->releaseScriptObject(this, coldData.userObject);
     }
 #endif  // AX_ENABLE_GC_FOR_NATIVE_OBJECTS
     AX_SAFE_RETAIN(userObject);
-    AX_SAFE_RELEASE(_userObject);
-    _userObject = userObject;
+    AX_SAFE_RELEASE(coldData.userObject);
+    coldData.userObject = userObject;
 }
 
 Scene* Node::getScene() const
@@ -841,7 +859,7 @@ Node* Node::getChildByName(std::string_view name) const
     for (const auto& child : _children)
     {
         // Different strings may have the same hash code, but can use it to compare first for speed
-        if (child->_hashOfName == hash && child->_name.compare(name) == 0)
+        if (child->_hashOfName == hash && child->getName() == name)
             return child;
     }
     return nullptr;
@@ -852,116 +870,7 @@ void Node::enumerateChildren(std::string_view name, std::function<bool(Node*)> c
     AXASSERT(!name.empty(), "Invalid name");
     AXASSERT(callback != nullptr, "Invalid callback function");
 
-    size_t length = name.length();
-
-    size_t subStrStartPos = 0;       // sub string start index
-    size_t subStrlength   = length;  // sub string length
-
-    // Starts with '//'?
-    bool searchRecursively = false;
-    if (length > 2 && name[0] == '/' && name[1] == '/')
-    {
-        searchRecursively = true;
-        subStrStartPos    = 2;
-        subStrlength -= 2;
-    }
-
-    // End with '/..'?
-    bool searchFromParent = false;
-    if (length > 3 && name[length - 3] == '/' && name[length - 2] == '.' && name[length - 1] == '.')
-    {
-        searchFromParent = true;
-        subStrlength -= 3;
-    }
-
-    // Remove '//', '/..' if exist
-    auto newName = name.substr(subStrStartPos, subStrlength);
-
-    const Node* target = this;
-
-    if (searchFromParent)
-    {
-        if (nullptr == _parent)
-        {
-            return;
-        }
-        target = _parent;
-    }
-
-    if (searchRecursively)
-    {
-        // name is '//xxx'
-        target->doEnumerateRecursive(target, newName, callback);
-    }
-    else
-    {
-        // name is xxx
-        target->doEnumerate(std::string{newName}, callback);
-    }
-}
-
-bool Node::doEnumerateRecursive(const Node* node, std::string_view name, std::function<bool(Node*)> callback) const
-{
-    bool ret = false;
-
-    if (node->doEnumerate(std::string{name}, callback))
-    {
-        // search itself
-        ret = true;
-    }
-    else
-    {
-        // search its children
-        for (const auto& child : node->getChildren())
-        {
-            if (doEnumerateRecursive(child, name, callback))
-            {
-                ret = true;
-                break;
-            }
-        }
-    }
-
-    return ret;
-}
-
-bool Node::doEnumerate(std::string name, std::function<bool(Node*)> callback) const
-{
-    // name may be xxx/yyy, should find its parent
-    size_t pos             = name.find('/');
-    std::string searchName = name;
-    bool needRecursive     = false;
-    if (pos != name.npos)
-    {
-        searchName = name.substr(0, pos);
-        name.erase(0, pos + 1);
-        needRecursive = true;
-    }
-
-    bool ret = false;
-    for (const auto& child : getChildren())
-    {
-        if (std::regex_match(child->_name, std::regex(searchName)))
-        {
-            if (!needRecursive)
-            {
-                // terminate enumeration if callback return true
-                if (callback(child))
-                {
-                    ret = true;
-                    break;
-                }
-            }
-            else
-            {
-                ret = child->doEnumerate(name, callback);
-                if (ret)
-                    break;
-            }
-        }
-    }
-
-    return ret;
+    NodeQuery::get(name)->evaluate(this, callback);
 }
 
 /* "add" logic MUST only be on this method
@@ -1049,13 +958,13 @@ void Node::addChildHelper(Node* child, int localZOrder, int tag, std::string_vie
 void Node::addChild(Node* child, int zOrder)
 {
     AXASSERT(child != nullptr, "Argument must be non-nil");
-    this->addChild(child, zOrder, child->_name);
+    this->addChild(child, zOrder, child->getName());
 }
 
 void Node::addChild(Node* child)
 {
     AXASSERT(child != nullptr, "Argument must be non-nil");
-    this->addChild(child, child->getLocalZOrder(), child->_name);
+    this->addChild(child, child->getLocalZOrder(), child->getName());
 }
 
 void Node::removeFromParent()
@@ -1208,6 +1117,7 @@ void Node::sortAllChildren()
         sortNodes(_children);
         _reorderChildDirty = false;
         _eventDispatcher->setDirtyForNode(this);
+        markHierarchyChanged();
     }
 }
 
@@ -1268,6 +1178,25 @@ bool Node::isVisitableByVisitingCamera() const
     return visibleByCamera;
 }
 
+bool Node::isSubtreeVisitableByVisitingCamera() const
+{
+    auto camera = Camera::getVisitingCamera();
+    return camera ? ((unsigned short)camera->getCameraFlag() & getSubtreeCameraMask()) != 0 : true;
+}
+
+bool Node::shouldVisitChild(Node* child, uint32_t flags) const
+{
+    if (child->isSubtreeVisitableByVisitingCamera())
+        return true;
+
+    // the child misses the dirty flags of this frame, make its next visit recompute them
+    if (flags & FLAGS_TRANSFORM_DIRTY)
+        child->_transformUpdated = true;
+    if ((flags & FLAGS_CONTENT_SIZE_DIRTY) && child->_usingNormalizedPosition)
+        child->_normalizedPositionDirty = true;
+    return false;
+}
+
 void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
     // quick return if not visible. children won't be drawn.
@@ -1297,7 +1226,10 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
             auto node = _children.at(i);
 
             if (node && node->_localZOrder < 0)
-                node->visit(renderer, _modelViewTransform, flags);
+            {
+                if (shouldVisitChild(node, flags))
+                    node->visit(renderer, _modelViewTransform, flags);
+            }
             else
                 break;
         }
@@ -1306,7 +1238,10 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
             this->draw(renderer, _modelViewTransform, flags);
 
         for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-            (*it)->visit(renderer, _modelViewTransform, flags);
+        {
+            if (shouldVisitChild(*it, flags))
+                (*it)->visit(renderer, _modelViewTransform, flags);
+        }
     }
     else if (visibleByCamera)
     {
@@ -1335,12 +1270,12 @@ void Node::onEnter()
         ++__attachedNodeCount;
     }
 
-    if (_onEnterCallback)
-        _onEnterCallback();
+    if (_coldData && _coldData->onEnterCallback)
+        _coldData->onEnterCallback();
 
-    if (_componentContainer && !_componentContainer->isEmpty())
+    if (_coldData && _coldData->componentContainer && !_coldData->componentContainer->isEmpty())
     {
-        _componentContainer->onEnter();
+        _coldData->componentContainer->onEnter();
     }
 
     _isTransitionFinished = false;
@@ -1359,8 +1294,8 @@ void Node::onEnter()
 
 void Node::onEnterTransitionDidFinish()
 {
-    if (_onEnterTransitionDidFinishCallback)
-        _onEnterTransitionDidFinishCallback();
+    if (_coldData && _coldData->onEnterTransitionDidFinishCallback)
+        _coldData->onEnterTransitionDidFinishCallback();
 
     _isTransitionFinished = true;
     for (const auto& child : _children)
@@ -1373,8 +1308,8 @@ void Node::onEnterTransitionDidFinish()
 
 void Node::onExitTransitionDidStart()
 {
-    if (_onExitTransitionDidStartCallback)
-        _onExitTransitionDidStartCallback();
+    if (_coldData && _coldData->onExitTransitionDidStartCallback)
+        _coldData->onExitTransitionDidStartCallback();
 
     for (const auto& child : _children)
         child->onExitTransitionDidStart();
@@ -1391,12 +1326,12 @@ void Node::onExit()
         --__attachedNodeCount;
     }
 
-    if (_onExitCallback)
-        _onExitCallback();
+    if (_coldData && _coldData->onExitCallback)
+        _coldData->onExitCallback();
 
-    if (_componentContainer && !_componentContainer->isEmpty())
+    if (_coldData && _coldData->componentContainer && !_coldData->componentContainer->isEmpty())
     {
-        _componentContainer->onExit();
+        _coldData->componentContainer->onExit();
     }
 
     this->pause();
@@ -1526,7 +1461,7 @@ void Node::scheduleUpdateWithPriorityLua(int nHandler, int priority)
     unscheduleUpdate();
 
 #if AX_ENABLE_SCRIPT_BINDING
-    _updateScriptHandler = nHandler;
+    getColdData().updateScriptHandler = nHandler;
 #endif
 
     _scheduler->scheduleUpdate(this, priority, !_running);
@@ -1537,10 +1472,10 @@ void Node::unscheduleUpdate()
     _scheduler->unscheduleUpdate(this);
 
 #if AX_ENABLE_SCRIPT_BINDING
-    if (_updateScriptHandler)
+    if (_coldData && _coldData->updateScriptHandler)
     {
-        ScriptEngineManager::getInstance()->getScriptEngine()->removeScriptHandler(_updateScriptHandler);
-        _updateScriptHandler = 0;
+        ScriptEngineManager::getInstance()->getScriptEngine()->removeScriptHandler(_coldData->updateScriptHandler);
+        _coldData->updateScriptHandler = 0;
     }
 #endif
 }
@@ -1629,18 +1564,18 @@ void Node::pause()
 void Node::update(float fDelta)
 {
 #if AX_ENABLE_SCRIPT_BINDING
-    if (0 != _updateScriptHandler)
+    if (_coldData && 0 != _coldData->updateScriptHandler)
     {
         // only lua use
-        SchedulerScriptData data(_updateScriptHandler, fDelta);
+        SchedulerScriptData data(_coldData->updateScriptHandler, fDelta);
         ScriptEvent event(kScheduleEvent, &data);
         ScriptEngineManager::sendEventToLua(event);
     }
 #endif
 
-    if (_componentContainer && !_componentContainer->isEmpty())
+    if (_coldData && _coldData->componentContainer && !_coldData->componentContainer->isEmpty())
     {
-        _componentContainer->visit(fDelta);
+        _coldData->componentContainer->visit(fDelta);
     }
 }
 
@@ -1777,19 +1712,19 @@ const Mat4& Node::getNodeToParentTransform() const
         }
     }
 
-    if (_additionalTransform)
+    if (auto additionalTransform = _coldData ? _coldData->additionalTransform : nullptr)
     {
         // This is needed to support both Node::setNodeToParentTransform() and Node::setAdditionalTransform()
         // at the same time. The scenario is this:
         // at some point setNodeToParentTransform() is called.
         // and later setAdditionalTransform() is called every time. And since _transform
-        // is being overwritten everyframe, _additionalTransform[1] is used to have a copy
-        // of the last "_transform without _additionalTransform"
+        // is being overwritten everyframe, additionalTransform[1] is used to have a copy
+        // of the last "_transform without additionalTransform"
         if (_transformDirty)
-            _additionalTransform[1] = _transform;
+            additionalTransform[1] = _transform;
 
         if (_transformUpdated)
-            _transform = _additionalTransform[1] * _additionalTransform[0];
+            _transform = additionalTransform[1] * additionalTransform[0];
     }
 
     _transformDirty = _additionalTransformDirty = false;
@@ -1803,9 +1738,9 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transformDirty   = false;
     _transformUpdated = true;
 
-    if (_additionalTransform)
-        // _additionalTransform[1] has a copy of lastest transform
-        _additionalTransform[1] = transform;
+    if (_coldData && _coldData->additionalTransform)
+        // additionalTransform[1] has a copy of lastest transform
+        _coldData->additionalTransform[1] = transform;
 }
 
 void Node::setAdditionalTransform(const AffineTransform& additionalTransform)
@@ -1819,22 +1754,25 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
 {
     if (additionalTransform == nullptr)
     {
-        if (_additionalTransform)
-            _transform = _additionalTransform[1];
-        delete[] _additionalTransform;
-        _additionalTransform = nullptr;
+        if (_coldData && _coldData->additionalTransform)
+        {
+            _transform = _coldData->additionalTransform[1];
+            delete[] _coldData->additionalTransform;
+            _coldData->additionalTransform = nullptr;
+        }
     }
     else
     {
-        if (!_additionalTransform)
+        auto& coldData = getColdData();
+        if (!coldData.additionalTransform)
         {
-            _additionalTransform = new Mat4[2];
+            coldData.additionalTransform = new Mat4[2];
 
-            // _additionalTransform[1] is used as a backup for _transform
-            _additionalTransform[1] = _transform;
+            // additionalTransform[1] is used as a backup for _transform
+            coldData.additionalTransform[1] = _transform;
         }
 
-        _additionalTransform[0] = *additionalTransform;
+        coldData.additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
 }
@@ -1958,8 +1896,8 @@ void Node::updateTransform()
 
 Component* Node::getComponent(std::string_view name)
 {
-    if (_componentContainer)
-        return _componentContainer->get(name);
+    if (_coldData && _coldData->componentContainer)
+        return _coldData->componentContainer->get(name);
 
     return nullptr;
 }
@@ -1967,13 +1905,14 @@ Component* Node::getComponent(std::string_view name)
 bool Node::addComponent(Component* component)
 {
     // lazy alloc
-    if (!_componentContainer)
-        _componentContainer = new ComponentContainer(this);
+    auto& coldData = getColdData();
+    if (!coldData.componentContainer)
+        coldData.componentContainer = new ComponentContainer(this);
 
     // should enable schedule update, then all components can receive this call back
     scheduleUpdate();
 
-    const auto added = _componentContainer->add(component);
+    const auto added = coldData.componentContainer->add(component);
     if (added && _running)
         component->onEnter();
 
@@ -1982,17 +1921,17 @@ bool Node::addComponent(Component* component)
 
 bool Node::removeComponent(std::string_view name)
 {
-    if (_componentContainer)
-        return _componentContainer->remove(name);
+    if (_coldData && _coldData->componentContainer)
+        return _coldData->componentContainer->remove(name);
 
     return false;
 }
 
 bool Node::removeComponent(Component* component)
 {
-    if (_componentContainer)
+    if (_coldData && _coldData->componentContainer)
     {
-        return _componentContainer->remove(component);
+        return _coldData->componentContainer->remove(component);
     }
 
     return false;
@@ -2000,8 +1939,8 @@ bool Node::removeComponent(Component* component)
 
 void Node::removeAllComponents()
 {
-    if (_componentContainer)
-        _componentContainer->removeAll();
+    if (_coldData && _coldData->componentContainer)
+        _coldData->componentContainer->removeAll();
 }
 
 // MARK: Opacity and Color
@@ -2230,6 +2169,39 @@ void Node::setCameraMask(unsigned short mask, bool applyChildren)
             child->setCameraMask(mask, applyChildren);
         }
     }
+    markSubtreeCameraMaskDirty();
+}
+
+unsigned short Node::getSubtreeCameraMask() const
+{
+    if (_subtreeCameraMaskDirty)
+    {
+        _subtreeCameraMask      = computeSubtreeCameraMask();
+        _subtreeCameraMaskDirty = false;
+    }
+    return _subtreeCameraMask;
+}
+
+unsigned short Node::computeSubtreeCameraMask() const
+{
+    unsigned short mask = _cameraMask;
+    for (const auto& child : _children)
+        mask |= child->getSubtreeCameraMask();
+    return mask;
+}
+
+void Node::markSubtreeCameraMaskDirty()
+{
+    // ancestors of a dirty node are dirty already
+    for (Node* node = this; node && !node->_subtreeCameraMaskDirty; node = node->_parent)
+        node->_subtreeCameraMaskDirty = true;
+}
+
+void Node::markHierarchyChanged()
+{
+    auto version = ++s_hierarchyVersion;
+    for (Node* node = this; node; node = node->_parent)
+        node->_hierarchyVersion = version;
 }
 
 int Node::getAttachedNodeCount()
@@ -833,6 +833,9 @@ public:
      * following arguments: `node` A node that matches the name And returns a boolean result. Your callback can return
      * `true` to terminate the enumeration.
      *
+     * The search string is compiled once and cached, see `NodeQuery` to keep a query, use globs, a name index or to
+     * cache the result.
+     *
      * @since v3.2
      */
     virtual void enumerateChildren(std::string_view name, std::function<bool(Node* node)> callback) const;
@@ -997,6 +1000,15 @@ public:
      */
     virtual void setName(std::string_view name);
 
+    /** Returns the hash of the name, 0 if the name is empty. */
+    uint64_t getNameHash() const { return _hashOfName; }
+
+    /**
+     * Returns a version which changes whenever a node is added, removed, renamed or reordered below this node.
+     * Caches of the hierarchy, like `NodeQuery` results, compare it to find out whether they are stale.
+     */
+    std::uint32_t getHierarchyVersion() const { return _hierarchyVersion; }
+
     /**
      * Returns a custom user data pointer.
      *
@@ -1005,11 +1017,11 @@ public:
      * @return A custom user data pointer.
      * @lua NA
      */
-    virtual void* getUserData() { return _userData; }
+    virtual void* getUserData() { return _coldData ? _coldData->userData : nullptr; }
     /**
      * @lua NA
      */
-    virtual const void* getUserData() const { return _userData; }
+    virtual const void* getUserData() const { return _coldData ? _coldData->userData : nullptr; }
 
     /**
      * Sets a custom user data pointer.
@@ -1031,11 +1043,11 @@ public:
      * @return A user assigned Object.
      * @lua NA
      */
-    virtual Object* getUserObject() { return _userObject; }
+    virtual Object* getUserObject() { return _coldData ? _coldData->userObject : nullptr; }
     /**
      * @lua NA
      */
-    virtual const Object* getUserObject() const { return _userObject; }
+    virtual const Object* getUserObject() const { return _coldData ? _coldData->userObject : nullptr; }
 
     /**
      * Returns a user assigned Object.
@@ -1759,29 +1771,35 @@ public:
      * Set the callback of event onEnter.
      * @param callback A std::function<void()> callback.
      */
-    void setOnEnterCallback(const std::function<void()>& callback) { _onEnterCallback = callback; }
+    void setOnEnterCallback(const std::function<void()>& callback) { getColdData().onEnterCallback = callback; }
     /**
      * Get the callback of event onEnter.
      * @return A std:function<void()> callback.
      */
-    const std::function<void()>& getOnEnterCallback() const { return _onEnterCallback; }
+    const std::function<void()>& getOnEnterCallback() const
+    {
+        return _coldData ? _coldData->onEnterCallback : s_emptyCallback;
+    }
     /**
      * Set the callback of event onExit.
      * @param callback A std::function<void()> callback.
      */
-    void setOnExitCallback(const std::function<void()>& callback) { _onExitCallback = callback; }
+    void setOnExitCallback(const std::function<void()>& callback) { getColdData().onExitCallback = callback; }
     /**
      * Get the callback of event onExit.
      * @return A std::function<void()>.
      */
-    const std::function<void()>& getOnExitCallback() const { return _onExitCallback; }
+    const std::function<void()>& getOnExitCallback() const
+    {
+        return _coldData ? _coldData->onExitCallback : s_emptyCallback;
+    }
     /**
      * Set the callback of event EnterTransitionDidFinish.
      * @param callback A std::function<void()> callback.
      */
     void setOnEnterTransitionDidFinishCallback(const std::function<void()>& callback)
     {
-        _onEnterTransitionDidFinishCallback = callback;
+        getColdData().onEnterTransitionDidFinishCallback = callback;
     }
     /**
      * Get the callback of event EnterTransitionDidFinish.
@@ -1789,7 +1807,7 @@ public:
      */
     const std::function<void()>& getOnEnterTransitionDidFinishCallback() const
     {
-        return _onEnterTransitionDidFinishCallback;
+        return _coldData ? _coldData->onEnterTransitionDidFinishCallback : s_emptyCallback;
     }
     /**
      * Set the callback of event ExitTransitionDidStart.
@@ -1797,7 +1815,7 @@ public:
      */
     void setOnExitTransitionDidStartCallback(const std::function<void()>& callback)
     {
-        _onExitTransitionDidStartCallback = callback;
+        getColdData().onExitTransitionDidStartCallback = callback;
     }
     /**
      * Get the callback of event ExitTransitionDidStart.
@@ -1805,7 +1823,7 @@ public:
      */
     const std::function<void()>& getOnExitTransitionDidStartCallback() const
     {
-        return _onExitTransitionDidStartCallback;
+        return _coldData ? _coldData->onExitTransitionDidStartCallback : s_emptyCallback;
     }
 
     /**
@@ -1821,6 +1839,13 @@ public:
      */
     virtual void setCameraMask(unsigned short mask, bool applyChildren = true);
 
+    /**
+     * Returns the union of the camera masks of this node and all of its descendants.
+     * It is updated lazily when a camera mask changes or a child is added or removed, and is used by visit()
+     * to skip whole subtrees which have nothing to draw for the visiting camera.
+     */
+    unsigned short getSubtreeCameraMask() const;
+
     /**
      * Should addChild() make the child follow it's parent's mask?
      * If applyChildren is true, then it will modify the camera mask of its children recursively when a child is added.
@@ -1884,12 +1909,25 @@ protected:
     virtual void disableCascadeColor();
     virtual void updateColor() {}
 
-    bool doEnumerate(std::string name, std::function<bool(Node*)> callback) const;
-    bool doEnumerateRecursive(const Node* node, std::string_view name, std::function<bool(Node*)> callback) const;
-
     // check whether this camera mask is visible by the current visiting camera
     bool isVisitableByVisitingCamera() const;
 
+    // check whether this node or any of its descendants is visible by the current visiting camera
+    bool isSubtreeVisitableByVisitingCamera() const;
+
+    /// Marks the subtree camera mask of this node and its ancestors dirty.
+    void markSubtreeCameraMaskDirty();
+
+    /// Changes the hierarchy version of this node and its ancestors.
+    void markHierarchyChanged();
+
+    /// Computes the subtree camera mask, subclasses with extra children (eg: ProtectedNode) should add theirs.
+    virtual unsigned short computeSubtreeCameraMask() const;
+
+    /** Returns whether the child should be visited by the current visiting camera. A skipped child is flagged
+     * so that the dirty flags it missed are applied the next time it is visited. */
+    bool shouldVisitChild(Node* child, uint32_t flags) const;
+
     // update quaternion from Rotation3D
     void updateRotationQuat();
     // update Rotation3D from quaternion
@@ -1904,6 +1942,39 @@ private:
     NodeIndexerMap_t* getParentChildrenIndexer();
 
 protected:
+    /**
+     * The state most nodes never use, allocated by getColdData() when it's first set so that it doesn't take up
+     * the cache lines visit() walks through.
+     */
+    struct ColdData
+    {
+        std::string name;  ///< a string label, an user defined string to identify this node
+
+        void* userData     = nullptr;  ///< A user assigned void pointer, Can be point to any cpp object
+        Object* userObject = nullptr;  ///< A user assigned Object
+
+        ComponentContainer* componentContainer = nullptr;  ///< Dictionary of components
+
+        Mat4* additionalTransform = nullptr;  ///< two transforms needed by additional transforms
+
+#if AX_ENABLE_SCRIPT_BINDING
+        int scriptHandler       = 0;  ///< script handler for onEnter() & onExit(), used in Javascript and Lua binding.
+        int updateScriptHandler = 0;  ///< script handler for update() callback per frame, invoked from lua & javascript
+#endif
+
+        std::function<void()> onEnterCallback;
+        std::function<void()> onExitCallback;
+        std::function<void()> onEnterTransitionDidFinishCallback;
+        std::function<void()> onExitTransitionDidStartCallback;
+    };
+
+    ColdData& getColdData()
+    {
+        if (!_coldData)
+            _coldData = new ColdData();
+        return *_coldData;
+    }
+
     float _rotationX;  ///< rotation on the X-axis
     float _rotationY;  ///< rotation on the Y-axis
 
@@ -1932,9 +2003,7 @@ protected:
 
     Mat4 _modelViewTransform;  ///< ModelView transform of the Node.
     // "cache" variables are allowed to be mutable
-    mutable Mat4 _transform;             ///< transform
-    mutable Mat4 _inverse;               ///< inverse transform
-    mutable Mat4* _additionalTransform;  ///< two transforms needed by additional transforms
+    mutable Mat4 _transform;  ///< transform
 
 #if AX_LITTLE_ENDIAN
     union
@@ -1958,28 +2027,7 @@ protected:
     };
 #endif
 
-    float _globalZOrder;  ///< Global order used to sort the node
-
-    static std::uint32_t s_globalOrderOfArrival;
-
-    Vector<Node*> _children;             ///< array of children nodes
-    NodeIndexerMap_t* _childrenIndexer;  ///< The children indexer for fast find child
-    Node* _parent;                       ///< weak reference to parent node
-    Director* _director;                 // cached director pointer to improve rendering performance
-    int _tag;                            ///< a tag. Can be any number you assigned just to identify this node
-
-    std::string _name;     ///< a string label, an user defined string to identify this node
-    uint64_t _hashOfName;  ///< hash value of _name, used for speed in getChildByName
-
-    void* _userData;   ///< A user assigned void pointer, Can be point to any cpp object
-    Object* _userObject;  ///< A user assigned Object
-
-    Scheduler* _scheduler;  ///< scheduler used to schedule timers and updates
-
-    ActionManager* _actionManager;  ///< a pointer to ActionManager singleton, which is used to handle all the actions
-
-    EventDispatcher* _eventDispatcher;  ///< event dispatcher used to dispatch all kinds of events
-
+    // visit() reads the flags, the director and the children after the transforms, keep them on the same cache line
     bool _reorderChildDirty;             ///< children order dirty flag
     bool _running;                       ///< is running
     bool _visible;                       ///< is this node visible
@@ -2002,14 +2050,30 @@ protected:
     bool _childFollowCameraMask;
     // camera mask, it is visible only when _cameraMask & current camera' camera flag is true
     unsigned short _cameraMask;
+    // union of the camera masks of this node and its descendants
+    mutable unsigned short _subtreeCameraMask;
+    mutable bool _subtreeCameraMaskDirty;
 
-#if AX_ENABLE_SCRIPT_BINDING
-    int _scriptHandler;        ///< script handler for onEnter() & onExit(), used in Javascript binding and Lua binding.
-    int _updateScriptHandler;  ///< script handler for update() callback per frame, which is invoked from lua &
-                               ///< javascript.
-#endif
+    Director* _director;                 // cached director pointer to improve rendering performance
+    Vector<Node*> _children;             ///< array of children nodes
+    NodeIndexerMap_t* _childrenIndexer;  ///< The children indexer for fast find child
+    Node* _parent;                       ///< weak reference to parent node
+    int _tag;                            ///< a tag. Can be any number you assigned just to identify this node
+
+    float _globalZOrder;  ///< Global order used to sort the node
+
+    static std::uint32_t s_globalOrderOfArrival;
+    static std::uint32_t s_hierarchyVersion;
+
+    uint64_t _hashOfName;  ///< hash value of the name, used for speed in getChildByName
+
+    std::uint32_t _hierarchyVersion;  ///< changes with the hierarchy below this node, see getHierarchyVersion
 
-    ComponentContainer* _componentContainer;  ///< Dictionary of components
+    Scheduler* _scheduler;  ///< scheduler used to schedule timers and updates
+
+    ActionManager* _actionManager;  ///< a pointer to ActionManager singleton, which is used to handle all the actions
+
+    EventDispatcher* _eventDispatcher;  ///< event dispatcher used to dispatch all kinds of events
 
     // opacity controls
     Color3B _displayedColor;
@@ -2017,13 +2081,15 @@ protected:
     Color3B _realColor;
     uint8_t _realOpacity;
 
-    std::function<void()> _onEnterCallback;
-    std::function<void()> _onExitCallback;
-    std::function<void()> _onEnterTransitionDidFinishCallback;
-    std::function<void()> _onExitTransitionDidStartCallback;
-
     backend::ProgramState* _programState = nullptr;
 
+    // only converting to node space uses it, so it's kept apart from the members visit() touches
+    mutable Mat4 _inverse;  ///< inverse transform
+
+    ColdData* _coldData;  ///< rarely used state, see getColdData()
+
+    static const std::function<void()> s_emptyCallback;
+
 // Physics:remaining backwardly compatible
 #if defined(AX_ENABLE_PHYSICS)
     PhysicsBody* _physicsBody;
@@ -0,0 +1,389 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/NodeQuery.h"
+#include "2d/Node.h"
+#include "xxhash.h"
+
+NS_AX_BEGIN
+
+static constexpr size_t MAX_CACHED_QUERIES = 128;
+
+static bool isAncestor(const Node* ancestor, const Node* node)
+{
+    for (auto parent = node->getParent(); parent; parent = parent->getParent())
+    {
+        if (parent == ancestor)
+            return true;
+    }
+    return false;
+}
+
+static bool matchGlobClass(std::string_view pattern, size_t& pos, char ch, bool& matched)
+{
+    // pattern[pos] is '['
+    auto i      = pos + 1;
+    bool negate = i < pattern.size() && (pattern[i] == '!' || pattern[i] == '^');
+    if (negate)
+        ++i;
+
+    matched    = false;
+    bool first = true;
+    while (i < pattern.size() && (pattern[i] != ']' || first))
+    {
+        first = false;
+        if (i + 2 < pattern.size() && pattern[i + 1] == '-' && pattern[i + 2] != ']')
+        {
+            matched |= pattern[i] <= ch && ch <= pattern[i + 2];
+            i += 3;
+        }
+        else
+            matched |= pattern[i++] == ch;
+    }
+
+    // unterminated, '[' is a literal
+    if (i >= pattern.size())
+        return false;
+
+    matched = matched != negate;
+    pos     = i + 1;
+    return true;
+}
+
+static bool matchGlob(std::string_view pattern, std::string_view name)
+{
+    size_t p = 0, n = 0;
+    size_t starP = std::string_view::npos, starN = 0;
+    while (n < name.size())
+    {
+        if (p < pattern.size())
+        {
+            auto c = pattern[p];
+            if (c == '*')
+            {
+                starP = p++;
+                starN = n;
+                continue;
+            }
+
+            bool matched = false;
+            auto next    = p;
+            if (c == '[' && matchGlobClass(pattern, next, name[n], matched))
+            {
+                if (matched)
+                {
+                    p = next;
+                    ++n;
+                    continue;
+                }
+            }
+            else if (c == '?' || c == name[n])
+            {
+                ++p;
+                ++n;
+                continue;
+            }
+        }
+
+        // backtrack to the last '*'
+        if (starP == std::string_view::npos)
+            return false;
+        p = starP + 1;
+        n = ++starN;
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+//
+// NodeNameIndex
+//
+NodeNameIndex::NodeNameIndex(const Node* root) : _root(root)
+{
+    AXASSERT(root, "Invalid root");
+}
+
+const std::vector<Node*>* NodeNameIndex::find(uint64_t nameHash) const
+{
+    if (!_built || _version != _root->getHierarchyVersion())
+    {
+        // keep the vectors, a rebuild usually finds the same names
+        for (auto it = _nodes.begin(); it != _nodes.end(); ++it)
+            it.value().clear();
+        build(_root);
+        _version = _root->getHierarchyVersion();
+        _built   = true;
+    }
+
+    auto it = _nodes.find(nameHash);
+    return it != _nodes.end() ? &it->second : nullptr;
+}
+
+void NodeNameIndex::build(const Node* node) const
+{
+    // same order as the DESCENDANT axis: the children, then their subtrees
+    auto& children = node->getChildren();
+    for (auto&& child : children)
+    {
+        if (child->getNameHash())
+            _nodes.try_emplace(child->getNameHash()).first.value().emplace_back(child);
+    }
+    for (auto&& child : children)
+        build(child);
+}
+
+//
+// NodeQuery
+//
+NodeQuery::NodeQuery(std::string_view path, Syntax syntax) : _path(path)
+{
+    bool descendant = false;
+    if (path.size() > 2 && path[0] == '/' && path[1] == '/')
+    {
+        descendant = true;
+        path.remove_prefix(2);
+    }
+
+    if (path.size() > 3 && path.substr(path.size() - 3) == "/.."sv)
+    {
+        _fromParent = true;
+        _cacheable  = false;
+        path.remove_suffix(3);
+    }
+
+    bool hasDescendant = false;
+    size_t start       = 0;
+    while (start <= path.size())
+    {
+        auto end = path.find('/', start);
+        if (end == std::string_view::npos)
+            end = path.size();
+        auto segment = path.substr(start, end - start);
+        start        = end + 1;
+
+        // "a//b"
+        if (segment.empty())
+        {
+            descendant = true;
+            continue;
+        }
+
+        auto& step = _steps.emplace_back();
+        if (segment == ".."sv)
+        {
+            step.axis  = Axis::PARENT;
+            _cacheable = false;
+            // siblings lead to the same parent
+            _mayRepeat |= _steps.size() > 1;
+        }
+        else
+        {
+            step.axis = descendant ? Axis::DESCENDANT : Axis::CHILD;
+            compileStep(step, segment, syntax);
+            // nested matches of a DESCENDANT step lead to the same descendants
+            _mayRepeat |= descendant && hasDescendant;
+            hasDescendant |= descendant;
+        }
+        descendant = false;
+    }
+}
+
+void NodeQuery::compileStep(Step& step, std::string_view segment, Syntax syntax)
+{
+    auto isLiteral = [syntax](std::string_view s) {
+        return s.find_first_of(syntax == Syntax::GLOB ? "*?["sv : ".^$|()[]{}*+?\\"sv) == std::string_view::npos;
+    };
+    auto any = syntax == Syntax::GLOB ? "*"sv : ".*"sv;
+
+    if (segment == any)
+        step.match = Match::ANY;
+    else if (isLiteral(segment))
+    {
+        step.match = Match::EXACT;
+        step.hash  = XXH3_64bits(segment.data(), segment.length());
+    }
+    else if (segment.size() > any.size() && segment.substr(segment.size() - any.size()) == any &&
+             isLiteral(segment.substr(0, segment.size() - any.size())))
+    {
+        step.match = Match::PREFIX;
+        segment.remove_suffix(any.size());
+    }
+    else if (segment.size() > any.size() && segment.substr(0, any.size()) == any &&
+             isLiteral(segment.substr(any.size())))
+    {
+        step.match = Match::SUFFIX;
+        segment.remove_prefix(any.size());
+    }
+    else if (syntax == Syntax::GLOB)
+        step.match = Match::GLOB;
+    else
+    {
+        step.match = Match::REGEX;
+        step.regex = std::regex(segment.begin(), segment.end());
+    }
+
+    step.pattern = segment;
+}
+
+bool NodeQuery::Step::matches(const Node* node) const
+{
+    auto name = node->getName();
+    switch (match)
+    {
+    case Match::ANY:
+        return true;
+    case Match::EXACT:
+        return node->getNameHash() == hash && name == pattern;
+    case Match::PREFIX:
+        return name.size() >= pattern.size() && name.substr(0, pattern.size()) == pattern;
+    case Match::SUFFIX:
+        return name.size() >= pattern.size() && name.substr(name.size() - pattern.size()) == pattern;
+    case Match::GLOB:
+        return matchGlob(pattern, name);
+    case Match::REGEX:
+        return std::regex_match(name.begin(), name.end(), regex);
+    }
+    return false;
+}
+
+std::shared_ptr<const NodeQuery> NodeQuery::get(std::string_view path)
+{
+    static hlookup::string_map<std::shared_ptr<const NodeQuery>> s_queries;
+
+    auto it = s_queries.find(path);
+    if (it != s_queries.end())
+        return it->second;
+
+    if (s_queries.size() >= MAX_CACHED_QUERIES)
+        s_queries.clear();
+
+    auto query = std::make_shared<const NodeQuery>(path);
+    s_queries.emplace(path, query);
+    return query;
+}
+
+bool NodeQuery::evaluate(const Node* root, const std::function<bool(Node*)>& callback,
+                         const NodeNameIndex* index) const
+{
+    AXASSERT(root, "Invalid root");
+
+    if (_fromParent)
+    {
+        root = root->getParent();
+        if (!root)
+            return false;
+    }
+
+    if (_steps.empty())
+        return false;
+
+    tsl::robin_set<Node*> visited;
+    Context context{callback, index, _mayRepeat ? &visited : nullptr};
+    return evaluateStep(root, 0, context);
+}
+
+const std::vector<Node*>& NodeQuery::select(const Node* root, const NodeNameIndex* index) const
+{
+    if (_cacheable && root == _cachedRoot && root->getHierarchyVersion() == _cachedVersion)
+        return _cachedNodes;
+
+    _cachedNodes.clear();
+    evaluate(
+        root,
+        [this](Node* node) {
+            _cachedNodes.emplace_back(node);
+            return false;
+        },
+        index);
+
+    _cachedRoot    = _cacheable ? root : nullptr;
+    _cachedVersion = root->getHierarchyVersion();
+    return _cachedNodes;
+}
+
+bool NodeQuery::evaluateStep(const Node* node, size_t stepIndex, Context& context) const
+{
+    auto& step = _steps[stepIndex];
+    switch (step.axis)
+    {
+    case Axis::PARENT:
+        return node->getParent() && evaluateNext(const_cast<Node*>(node->getParent()), stepIndex, context);
+    case Axis::CHILD:
+        for (auto&& child : node->getChildren())
+        {
+            if (step.matches(child) && evaluateNext(child, stepIndex, context))
+                return true;
+        }
+        return false;
+    case Axis::DESCENDANT:
+        if (step.match == Match::EXACT && context.index &&
+            (context.index->getRoot() == node || isAncestor(context.index->getRoot(), node)))
+        {
+            if (auto nodes = context.index->find(step.hash))
+            {
+                for (auto&& candidate : *nodes)
+                {
+                    if (candidate->getName() == step.pattern && isAncestor(node, candidate) &&
+                        evaluateNext(candidate, stepIndex, context))
+                        return true;
+                }
+            }
+            return false;
+        }
+        return evaluateDescendants(node, stepIndex, context);
+    }
+    return false;
+}
+
+bool NodeQuery::evaluateDescendants(const Node* node, size_t stepIndex, Context& context) const
+{
+    // the order enumerateChildren always had: the matching children, then the subtrees of the children
+    auto& step     = _steps[stepIndex];
+    auto& children = node->getChildren();
+    for (auto&& child : children)
+    {
+        if (step.matches(child) && evaluateNext(child, stepIndex, context))
+            return true;
+    }
+    for (auto&& child : children)
+    {
+        if (evaluateDescendants(child, stepIndex, context))
+            return true;
+    }
+    return false;
+}
+
+bool NodeQuery::evaluateNext(Node* node, size_t stepIndex, Context& context) const
+{
+    if (stepIndex + 1 < _steps.size())
+        return evaluateStep(node, stepIndex + 1, context);
+
+    if (context.visited && !context.visited->insert(node).second)
+        return false;
+    return context.callback(node);
+}
+
+NS_AX_END
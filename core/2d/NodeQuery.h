@@ -0,0 +1,172 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef _AX_NODE_QUERY_H_
+#define _AX_NODE_QUERY_H_
+
+#include <functional>
+#include <memory>
+#include <regex>
+#include <vector>
+#include "base/hlookup.h"
+#include "platform/PlatformMacros.h"
+
+NS_AX_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/**
+ * @brief An index of the names of all the descendants of a node.
+ *
+ * A query looking up a name anywhere below the root (`//Name`) uses it instead of walking the subtree. The index is
+ * rebuilt lazily when a node is added, removed, renamed or reordered below the root.
+ * The index doesn't retain the root, it must not outlive it.
+ */
+class AX_DLL NodeNameIndex
+{
+public:
+    explicit NodeNameIndex(const Node* root);
+
+    const Node* getRoot() const { return _root; }
+
+    /** Nodes below the root with the name hash, in the order enumerateChildren reports them. */
+    const std::vector<Node*>* find(uint64_t nameHash) const;
+
+private:
+    void build(const Node* node) const;
+
+    const Node* _root;
+    mutable uint32_t _version = 0;
+    mutable bool _built       = false;
+    mutable tsl::robin_map<uint64_t, std::vector<Node*>> _nodes;
+};
+
+/**
+ * @brief A compiled node path pattern, see `Node::enumerateChildren`.
+ *
+ * The path is split into segments by '/':
+ * - `//` before a segment matches it at any depth, instead of the direct children only.
+ * - `..` selects the parent. A trailing `/..` keeps its enumerateChildren meaning: the whole path is searched from
+ *   the parent.
+ * - Other segments are name patterns, ECMAScript regular expressions or globs (`*`, `?`, `[a-z]`, `[!a]`) depending
+ *   on the syntax. Literal names, "any", prefix and suffix patterns (`Button.*`, `Button*`) are matched without a
+ *   regex.
+ *
+ * Compiling is the expensive part, so keep the query around or use `NodeQuery::get`. The query can be used from the
+ * main thread only.
+ */
+class AX_DLL NodeQuery
+{
+public:
+    enum class Syntax
+    {
+        REGEX,
+        GLOB,
+    };
+
+    explicit NodeQuery(std::string_view path, Syntax syntax = Syntax::REGEX);
+
+    /** A compiled regex syntax query from a small cache of the recently used paths. */
+    static std::shared_ptr<const NodeQuery> get(std::string_view path);
+
+    /**
+     * Invoke the callback for the nodes matching the path from the root, until it returns true.
+     * @param index An index of the root or one of its ancestors, to look up `//Name` segments.
+     * @return true if the callback stopped the enumeration.
+     */
+    bool evaluate(const Node* root, const std::function<bool(Node*)>& callback,
+                  const NodeNameIndex* index = nullptr) const;
+
+    /**
+     * The nodes matching the path from the root. The result is kept until a node is added, removed, renamed or
+     * reordered below the root, queries with `..` are evaluated each time.
+     */
+    const std::vector<Node*>& select(const Node* root, const NodeNameIndex* index = nullptr) const;
+
+    const std::string& getPath() const { return _path; }
+
+private:
+    enum class Axis
+    {
+        CHILD,
+        DESCENDANT,
+        PARENT,
+    };
+
+    enum class Match
+    {
+        ANY,
+        EXACT,
+        PREFIX,
+        SUFFIX,
+        GLOB,
+        REGEX,
+    };
+
+    struct Step
+    {
+        Axis axis   = Axis::CHILD;
+        Match match = Match::ANY;
+        std::string pattern;
+        uint64_t hash = 0;
+        std::regex regex;
+
+        bool matches(const Node* node) const;
+    };
+
+    struct Context
+    {
+        const std::function<bool(Node*)>& callback;
+        const NodeNameIndex* index;
+        tsl::robin_set<Node*>* visited;
+    };
+
+    static void compileStep(Step& step, std::string_view segment, Syntax syntax);
+
+    bool evaluateStep(const Node* node, size_t stepIndex, Context& context) const;
+    bool evaluateDescendants(const Node* node, size_t stepIndex, Context& context) const;
+    bool evaluateNext(Node* node, size_t stepIndex, Context& context) const;
+
+    std::string _path;
+    std::vector<Step> _steps;
+    bool _fromParent = false;  // legacy trailing '/..'
+    bool _cacheable  = true;
+    bool _mayRepeat  = false;  // whether a node may be reached twice
+
+    mutable const Node* _cachedRoot = nullptr;
+    mutable uint32_t _cachedVersion = 0;
+    mutable std::vector<Node*> _cachedNodes;
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
+
+#endif  // _AX_NODE_QUERY_H_
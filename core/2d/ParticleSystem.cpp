@@ -1556,9 +1556,9 @@ void ParticleSystem::update(float dt)
 
     AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
 
-    if (_componentContainer && !_componentContainer->isEmpty())
+    if (_coldData && _coldData->componentContainer && !_coldData->componentContainer->isEmpty())
     {
-        _componentContainer->visit(dt);
+        _coldData->componentContainer->visit(dt);
     }
 
     if (_fixedFPS != 0)
@@ -301,7 +301,10 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint3
         auto node = _children.at(i);
 
         if (node && node->getLocalZOrder() < 0)
-            node->visit(renderer, _modelViewTransform, flags);
+        {
+            if (shouldVisitChild(node, flags))
+                node->visit(renderer, _modelViewTransform, flags);
+        }
         else
             break;
     }
@@ -311,7 +314,10 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint3
         auto node = _protectedChildren.at(j);
 
         if (node && node->getLocalZOrder() < 0)
-            node->visit(renderer, _modelViewTransform, flags);
+        {
+            if (shouldVisitChild(node, flags))
+                node->visit(renderer, _modelViewTransform, flags);
+        }
         else
             break;
     }
@@ -326,10 +332,16 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint3
     // draw children and protectedChildren zOrder >= 0
     //
     for (auto it = _protectedChildren.cbegin() + j, itCend = _protectedChildren.cend(); it != itCend; ++it)
-        (*it)->visit(renderer, _modelViewTransform, flags);
+    {
+        if (shouldVisitChild(*it, flags))
+            (*it)->visit(renderer, _modelViewTransform, flags);
+    }
 
     for (auto it = _children.cbegin() + i, itCend = _children.cend(); it != itCend; ++it)
-        (*it)->visit(renderer, _modelViewTransform, flags);
+    {
+        if (shouldVisitChild(*it, flags))
+            (*it)->visit(renderer, _modelViewTransform, flags);
+    }
 
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -444,6 +456,14 @@ void ProtectedNode::setCameraMask(unsigned short mask, bool applyChildren)
     }
 }
 
+unsigned short ProtectedNode::computeSubtreeCameraMask() const
+{
+    unsigned short mask = Node::computeSubtreeCameraMask();
+    for (auto&& child : _protectedChildren)
+        mask |= child->getSubtreeCameraMask();
+    return mask;
+}
+
 void ProtectedNode::setGlobalZOrder(float globalZOrder)
 {
     Node::setGlobalZOrder(globalZOrder);
@@ -207,6 +207,8 @@ protected:
     /// helper that reorder a child
     void insertProtectedChild(Node* child, int z);
 
+    virtual unsigned short computeSubtreeCameraMask() const override;
+
     Vector<Node*> _protectedChildren;  ///< array of children nodes
     bool _reorderProtectedChildDirty;
 
@@ -463,45 +463,46 @@ bool RenderTexture::saveToFile(std::string_view fileName,
 
 void RenderTexture::onSaveToFile(std::string filename, bool isRGBA, bool forceNonPMA)
 {
-    auto callbackFunc = [this, _filename = std::move(filename), isRGBA, forceNonPMA](RefPtr<Image> image) {
-        if (image)
+    auto callbackFunc = [self = RefPtr(this), _filename = std::move(filename), isRGBA,
+                         forceNonPMA](RefPtr<Image> image) {
+        if (!image)
         {
-            if (forceNonPMA && image->hasPremultipliedAlpha())
+            if (self->_saveFileCallback)
             {
-                _director->getJobSystem()->enqueue([self = RefPtr(this), image, _filename, isRGBA, forceNonPMA]() {
-                    image->reversePremultipliedAlpha();
-
-                    Director::getInstance()->getScheduler()->runOnAxmolThread([self, image, _filename, isRGBA] {
-                        image->saveToFile(_filename, !isRGBA);
-                        if (self->_saveFileCallback)
-                        {
-                            self->_saveFileCallback(self, _filename);
-                        }
-                    });
-                });
+                self->_saveFileCallback(self, _filename);
             }
-            else
-            {
-                image->saveToFile(_filename, !isRGBA);
-                if (_saveFileCallback)
+            return;
+        }
+
+        // un-premultiply and encode on a worker thread, only the callback runs on the axmol thread
+        Director::getInstance()->getJobSystem()->enqueue([self, image, _filename, isRGBA, forceNonPMA]() {
+            if (forceNonPMA && image->hasPremultipliedAlpha())
+                image->reversePremultipliedAlpha();
+            image->saveToFile(_filename, !isRGBA);
+
+            Director::getInstance()->getScheduler()->runOnAxmolThread([self, _filename] {
+                if (self->_saveFileCallback)
                 {
-                    _saveFileCallback(this, _filename);
+                    self->_saveFileCallback(self, _filename);
                 }
-            }
-        }
-        else
-        {
-            if (_saveFileCallback)
-            {
-                _saveFileCallback(this, _filename);
-            }          
-        }
+            });
+        });
     };
-    newImage(callbackFunc);
+    readImage(std::move(callbackFunc), true);
 }
 
 /* get buffer as Image */
-void RenderTexture::newImage(std::function<void(RefPtr<Image>)> imageCallback, bool flipImage)
+void RenderTexture::newImage(std::function<void(RefPtr<Image>)> imageCallback, bool /*flipImage*/)
+{
+    readImage(std::move(imageCallback), false);
+}
+
+void RenderTexture::newImageAsync(std::function<void(RefPtr<Image>)> imageCallback)
+{
+    readImage(std::move(imageCallback), true);
+}
+
+void RenderTexture::readImage(std::function<void(RefPtr<Image>)> imageCallback, bool async)
 {
     AXASSERT(_pixelFormat == backend::PixelFormat::RGBA8, "only RGBA8888 can be saved as image");
 
@@ -510,16 +511,10 @@ void RenderTexture::newImage(std::function<void(RefPtr<Image>)> imageCallback, b
         return;
     }
 
-    const Vec2& s = _texture2D->getContentSizeInPixels();
-
-    // to get the image size to save
-    //        if the saving image domain exceeds the buffer texture domain,
-    //        it should be cut
-    int savedBufferWidth       = (int)s.width;
-    int savedBufferHeight      = (int)s.height;
     bool hasPremultipliedAlpha = _texture2D->hasPremultipliedAlpha();
 
-    _director->getRenderer()->readPixels(_renderTarget, [=](const backend::PixelBufferDescriptor& pbd) {
+    auto callback = [imageCallback = std::move(imageCallback),
+                     hasPremultipliedAlpha](const backend::PixelBufferDescriptor& pbd) {
         if (pbd)
         {
             auto image = utils::makeInstance<Image>(&Image::initWithRawData, pbd._data.getBytes(), pbd._data.getSize(),
@@ -528,7 +523,13 @@ void RenderTexture::newImage(std::function<void(RefPtr<Image>)> imageCallback, b
         }
         else
             imageCallback(nullptr);
-    });
+    };
+
+    auto renderer = _director->getRenderer();
+    if (async)
+        renderer->readPixelsAsync(_renderTarget, std::move(callback));
+    else
+        renderer->readPixels(_renderTarget, std::move(callback));
 }
 
 void RenderTexture::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
@@ -642,7 +643,7 @@ void RenderTexture::begin()
 
     auto beginCommand = renderer->nextCallbackCommand();
     beginCommand->init(_globalZOrder);
-    beginCommand->func = AX_CALLBACK_0(RenderTexture::onBegin, this);
+    beginCommand->setCallback(renderer->getFrameArena(), [this] { onBegin(); });
     renderer->addCommand(beginCommand);
 }
 
@@ -652,7 +653,7 @@ void RenderTexture::end()
 
     auto endCommand = renderer->nextCallbackCommand();
     endCommand->init(_globalZOrder);
-    endCommand->func = AX_CALLBACK_0(RenderTexture::onEnd, this);
+    endCommand->setCallback(renderer->getFrameArena(), [this] { onEnd(); });
 
     renderer->addCommand(endCommand);
     renderer->popGroup();
@@ -675,10 +676,10 @@ void RenderTexture::clearColorAttachment()
     auto renderer                     = _director->getRenderer();
     auto beforeClearAttachmentCommand = renderer->nextCallbackCommand();
     beforeClearAttachmentCommand->init(0);
-    beforeClearAttachmentCommand->func = [this, renderer]() -> void {
+    beforeClearAttachmentCommand->setCallback(renderer->getFrameArena(), [this, renderer]() -> void {
         _oldRenderTarget = renderer->getRenderTarget();
         renderer->setRenderTarget(_renderTarget);
-    };
+    });
     renderer->addCommand(beforeClearAttachmentCommand);
 
     Color4F color(0.f, 0.f, 0.f, 0.f);
@@ -687,7 +688,8 @@ void RenderTexture::clearColorAttachment()
     // auto renderer                    = _director->getRenderer();
     auto afterClearAttachmentCommand = renderer->nextCallbackCommand();
     afterClearAttachmentCommand->init(0);
-    afterClearAttachmentCommand->func = [this, renderer]() -> void { renderer->setRenderTarget(_oldRenderTarget); };
+    afterClearAttachmentCommand->setCallback(renderer->getFrameArena(),
+                                             [this, renderer]() -> void { renderer->setRenderTarget(_oldRenderTarget); });
     renderer->addCommand(afterClearAttachmentCommand);
 }
 
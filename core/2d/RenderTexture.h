@@ -168,6 +168,12 @@ public:
      */
     void newImage(std::function<void(RefPtr<Image>)> imageCallback, bool flipImage = true);
 
+    /* Like newImage, but the pixels are read back without stalling the GPU,
+     * so the callback is invoked a few frames later.
+     * @js NA
+     */
+    void newImageAsync(std::function<void(RefPtr<Image>)> imageCallback);
+
     /** Saves the texture into a file using JPEG format. The file will be saved in the Documents folder.
      * Returns true if the operation is successful.
      *
@@ -383,6 +389,7 @@ protected:
     void clearColorAttachment();
 
     void onSaveToFile(std::string fileName, bool isRGBA = true, bool forceNonPMA = false);
+    void readImage(std::function<void(RefPtr<Image>)> imageCallback, bool async);
 
     bool _keepMatrix = false;
     Rect _rtTextureRect;
@@ -307,6 +307,16 @@ void Scene::removeAllChildren()
 }
 
 #if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+void Scene::setPhysics3DWorld(Physics3DWorld* world)
+{
+    if (_physics3DWorld != world)
+    {
+        AX_SAFE_RETAIN(world);
+        AX_SAFE_RELEASE(_physics3DWorld);
+        _physics3DWorld = world;
+    }
+}
+
 void Scene::setPhysics3DDebugCamera(Camera* camera)
 {
     AX_SAFE_RETAIN(camera);
@@ -173,6 +173,11 @@ public:
      */
     Physics3DWorld* getPhysics3DWorld() { return _physics3DWorld; }
 
+    /** Set the 3d physics world of the scene, e.g. a multithreaded one, should be called before
+     * any physics object added.
+     */
+    void setPhysics3DWorld(Physics3DWorld* world);
+
     /**
      * Set Physics3D debug draw camera.
      */
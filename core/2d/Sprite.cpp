@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "2d/AnimationCache.h"
 #include "2d/SpriteFrame.h"
 #include "2d/SpriteFrameCache.h"
+#include "2d/DynamicAtlas.h"
 #include "renderer/TextureCache.h"
 #include "renderer/Texture2D.h"
 #include "renderer/Renderer.h"
@@ -199,6 +200,17 @@ bool Sprite::initWithFile(std::string_view filename, PixelFormat format)
 
     _fileName = filename;
 
+    // the pages of the dynamic atlas are RGBA8
+    if (format == PixelFormat::RGBA8)
+    {
+        auto dynamicAtlas = DynamicAtlas::getInstance();
+        if (dynamicAtlas->isEnabled())
+        {
+            if (auto frame = dynamicAtlas->addImage(filename))
+                return initWithSpriteFrame(frame);
+        }
+    }
+
     Texture2D* texture = _director->getTextureCache()->addImage(filename, format);
     if (texture)
     {
@@ -221,6 +233,16 @@ bool Sprite::initWithFile(std::string_view filename, const Rect& rect)
 
     _fileName = filename;
 
+    if (Texture2D::getDefaultAlphaPixelFormat() == PixelFormat::RGBA8)
+    {
+        auto dynamicAtlas = DynamicAtlas::getInstance();
+        if (dynamicAtlas->isEnabled())
+        {
+            if (auto frame = dynamicAtlas->addImage(filename))
+                return initWithTexture(frame->getTexture(), Rect(rect.origin + frame->getRect().origin, rect.size));
+        }
+    }
+
     Texture2D* texture = _director->getTextureCache()->addImage(filename);
     if (texture)
         return initWithTexture(texture, rect);
@@ -1090,6 +1112,9 @@ void Sprite::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
         _trianglesCommand.init(_globalZOrder, _texture, _blendFunc, _polyInfo.triangles, transform, flags);
         renderer->addCommand(&_trianglesCommand);
 
+        if (_texture->isStreamed())
+            requestStreamedTextureDetail(transform);
+
 #if AX_SPRITE_DEBUG_DRAW
         _debugDrawNode->clear();
         auto count   = _polyInfo.triangles.indexCount / 3;
@@ -1725,4 +1750,25 @@ void Sprite::setMVPMatrixUniform()
         programState->setUniform(_mvpMatrixLocation, projectionMat.m, sizeof(projectionMat.m));
 }
 
+void Sprite::requestStreamedTextureDetail(const Mat4& transform)
+{
+    auto glView = _director->getGLView();
+    if (!glView)
+        return;
+
+    // the screen pixels covered along each axis of the sprite, and the texels of level 0 drawn across them
+    float pixelsWide = _contentSize.width * Vec3(transform.m[0], transform.m[1], transform.m[2]).length() *
+                       glView->getScaleX();
+    float pixelsHigh = _contentSize.height * Vec3(transform.m[4], transform.m[5], transform.m[6]).length() *
+                       glView->getScaleY();
+    if (pixelsWide <= 0 || pixelsHigh <= 0)
+        return;
+
+    auto texels = AX_SIZE_POINTS_TO_PIXELS(_rect.size);
+    if (_rectRotated)
+        std::swap(texels.width, texels.height);
+
+    _texture->requestStreamedDetail((std::min)(texels.width / pixelsWide, texels.height / pixelsHigh));
+}
+
 NS_AX_END
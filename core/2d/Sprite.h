@@ -99,6 +99,8 @@ struct transformValues_;
  */
 class AX_DLL Sprite : public Node, public TextureProtocol
 {
+    friend class DynamicAtlas;
+
 public:
     enum class RenderMode
     {
@@ -671,6 +673,7 @@ protected:
     void updateStretchFactor();
     void populateTriangle(int quadIndex, const V3F_C4B_T2F_Quad& quad);
     void setMVPMatrixUniform();
+    void requestStreamedTextureDetail(const Mat4& transform);
     //
     // Data used when the sprite is rendered using a SpriteSheet
     //
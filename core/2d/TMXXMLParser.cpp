@@ -65,6 +65,145 @@ void TMXLayerInfo::setProperties(ValueMap var)
     _properties = var;
 }
 
+namespace
+{
+#pragma pack(push, 1)
+struct TMXBinaryTilesHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t flags;
+    uint32_t width;
+    uint32_t height;
+    uint32_t payloadSize;
+};
+#pragma pack(pop)
+
+constexpr char TMX_BINARY_TILES_MAGIC[4] = {'A', 'X', 'T', 'L'};
+constexpr uint16_t TMX_BINARY_TILES_VERSION  = 1;
+constexpr uint16_t TMX_BINARY_TILES_COMPRESSED = 1;
+
+// the format is little endian, swaps the header fields and gids in place on big endian hosts
+void swapBinaryTilesHeader(TMXBinaryTilesHeader& header)
+{
+    if (!AX_HOST_IS_BIG_ENDIAN)
+        return;
+    header.version     = AX_SWAP16(header.version);
+    header.flags       = AX_SWAP16(header.flags);
+    header.width       = AX_SWAP32(header.width);
+    header.height      = AX_SWAP32(header.height);
+    header.payloadSize = AX_SWAP32(header.payloadSize);
+}
+
+void swapBinaryTiles(uint32_t* tiles, size_t count)
+{
+    if (!AX_HOST_IS_BIG_ENDIAN)
+        return;
+    for (size_t i = 0; i < count; ++i)
+        tiles[i] = AX_SWAP32(tiles[i]);
+}
+}  // namespace
+
+bool TMXLayerInfo::loadTilesFromBinary(const void* data, size_t size)
+{
+    TMXBinaryTilesHeader header;
+    if (size < sizeof(header))
+    {
+        AXLOGW("TiledMap: binary tiles too small");
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    swapBinaryTilesHeader(header);
+    if (memcmp(header.magic, TMX_BINARY_TILES_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TMX_BINARY_TILES_VERSION || header.payloadSize > size - sizeof(header))
+    {
+        AXLOGW("TiledMap: invalid binary tiles header");
+        return false;
+    }
+
+    // the layer element declares the size too, a stale sidecar of another size must not be used for it
+    if (_layerSize.width > 0 && _layerSize.height > 0 &&
+        (header.width != static_cast<uint32_t>(_layerSize.width) ||
+         header.height != static_cast<uint32_t>(_layerSize.height)))
+    {
+        AXLOGW("TiledMap: binary tiles size {}x{} mismatch the layer size {}x{}", header.width, header.height,
+               _layerSize.width, _layerSize.height);
+        return false;
+    }
+
+    auto tilesAmount = static_cast<size_t>(header.width) * header.height;
+    auto payload     = static_cast<const uint8_t*>(data) + sizeof(header);
+    uint32_t* tiles  = nullptr;
+    if (header.flags & TMX_BINARY_TILES_COMPRESSED)
+    {
+        auto buffer =
+            ZipUtils::decompressGZ(payload, header.payloadSize, static_cast<int>(tilesAmount * sizeof(uint32_t)));
+        if (buffer.size() != tilesAmount * sizeof(uint32_t))
+        {
+            AXLOGW("TiledMap: inflate binary tiles error");
+            return false;
+        }
+        tiles = reinterpret_cast<uint32_t*>(buffer.release_pointer());
+    }
+    else
+    {
+        if (header.payloadSize != tilesAmount * sizeof(uint32_t))
+        {
+            AXLOGW("TiledMap: invalid binary tiles size");
+            return false;
+        }
+        axstd::pod_vector<uint32_t> buffer(tilesAmount);
+        memcpy(buffer.data(), payload, header.payloadSize);
+        tiles = buffer.release_pointer();
+    }
+    swapBinaryTiles(tiles, tilesAmount);
+
+    if (_ownTiles && _tiles)
+        free(_tiles);
+    _tiles     = tiles;
+    _ownTiles  = true;
+    _layerSize = Vec2(static_cast<float>(header.width), static_cast<float>(header.height));
+    return true;
+}
+
+bool TMXLayerInfo::saveTilesToBinaryFile(std::string_view filePath, bool compressed) const
+{
+    if (!_tiles)
+        return false;
+
+    TMXBinaryTilesHeader header;
+    memcpy(header.magic, TMX_BINARY_TILES_MAGIC, sizeof(header.magic));
+    header.version = TMX_BINARY_TILES_VERSION;
+    header.flags   = compressed ? TMX_BINARY_TILES_COMPRESSED : 0;
+    header.width   = static_cast<uint32_t>(_layerSize.width);
+    header.height  = static_cast<uint32_t>(_layerSize.height);
+
+    auto tilesAmount     = static_cast<size_t>(header.width) * header.height;
+    auto tilesSize       = tilesAmount * sizeof(uint32_t);
+    const uint32_t* gids = _tiles;
+    axstd::pod_vector<uint32_t> swapped;
+    if (AX_HOST_IS_BIG_ENDIAN)
+    {
+        swapped.assign(_tiles, _tiles + tilesAmount);
+        swapBinaryTiles(swapped.data(), tilesAmount);
+        gids = swapped.data();
+    }
+
+    yasio::byte_buffer payload;
+    if (compressed)
+        payload = ZipUtils::compressGZ(gids, tilesSize);
+    else
+        payload.assign(reinterpret_cast<const uint8_t*>(gids), reinterpret_cast<const uint8_t*>(gids) + tilesSize);
+    header.payloadSize = static_cast<uint32_t>(payload.size());
+    swapBinaryTilesHeader(header);
+
+    Data data;
+    data.resize(sizeof(header) + payload.size());
+    memcpy(data.getBytes(), &header, sizeof(header));
+    memcpy(data.getBytes() + sizeof(header), payload.data(), payload.size());
+    return FileUtils::getInstance()->writeDataToFile(data, filePath);
+}
+
 // implementation TMXTilesetInfo
 TMXTilesetInfo::TMXTilesetInfo() : _firstGid(0), _tileSize(Vec2::ZERO), _spacing(0), _margin(0), _imageSize(Vec2::ZERO)
 {}
@@ -475,6 +614,30 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
             tmxMapInfo->setLayerAttribs(layerAttribs | TMXLayerAttribCSV);
             tmxMapInfo->setStoringCharacters(true);
         }
+        else if (encoding == "axbin")
+        {
+            // not combined with the previous attribs, the tiles are complete when the element ends
+            tmxMapInfo->setLayerAttribs(TMXLayerAttribBinary);
+
+            // the tiles are stored in a sidecar file, relative to the tmx file like the tileset images
+            std::string source = attributeDict["source"].asString();
+            auto slashPos      = _TMXFileName.find_last_of('/');
+            if (FileUtils::getInstance()->isAbsolutePath(source))
+            {
+                // absolute path, e.g. generated into the writable path
+            }
+            else if (slashPos != std::string::npos)
+                source.insert(0, _TMXFileName, 0, slashPos + 1);
+            else if (!_resources.empty())
+                source.insert(0, _resources + "/");
+
+            TMXLayerInfo* layer = tmxMapInfo->getLayers().back();
+            auto data           = FileUtils::getInstance()->getDataFromFile(source);
+            if (!layer->loadTilesFromBinary(data.getBytes(), data.getSize()))
+            {
+                AXLOGW("TiledMap: load binary tiles from {} failed", source);
+            }
+        }
     }
     else if (elementName == "object")
     {
@@ -66,6 +66,7 @@ enum
     TMXLayerAttribGzip   = 1 << 2,
     TMXLayerAttribZlib   = 1 << 3,
     TMXLayerAttribCSV    = 1 << 4,
+    TMXLayerAttribBinary = 1 << 5,
 };
 
 enum
@@ -195,6 +196,19 @@ public:
     void setProperties(ValueMap properties);
     ValueMap& getProperties();
 
+    /** Loads the tile gids from the compact binary tile layer format, which is referenced by a TMX layer as
+     * <data encoding="axbin" source="layer.axtl"/> to skip the xml/csv/base64 decoding of huge layers.
+     *
+     * The format is little endian: a 20 bytes header (magic "AXTL", uint16 version, uint16 flags, uint32 width,
+     * uint32 height, uint32 payload size) followed by width * height uint32 gids in row order, gzip compressed
+     * when flags & 1. The size of the layer is taken from the header, and must match the size declared by the
+     * layer element if any.
+     */
+    bool loadTilesFromBinary(const void* data, size_t size);
+
+    /** Saves the tile gids with the binary tile layer format, for converting the layers of huge maps offline. */
+    bool saveTilesToBinaryFile(std::string_view filePath, bool compressed = true) const;
+
     ValueMap _properties;
     std::string _name;
     Vec2 _layerSize;
@@ -409,8 +409,8 @@ void MotionStreak3D::draw(Renderer* renderer, const Mat4& transform, uint32_t fl
 
     _programState->setUniform(_locMVP, mvpMatrix.m, sizeof(mvpMatrix.m));
 
-    beforeCommand->func = AX_CALLBACK_0(MotionStreak3D::onBeforeDraw, this);
-    afterCommand->func  = AX_CALLBACK_0(MotionStreak3D::onAfterDraw, this);
+    beforeCommand->setCallback(renderer->getFrameArena(), [this] { onBeforeDraw(); });
+    afterCommand->setCallback(renderer->getFrameArena(), [this] { onAfterDraw(); });
 
     _customCommand.updateVertexBuffer(_vertexData.data(), sizeof(_vertexData[0]) * _nuPoints * 2);
 
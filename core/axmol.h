@@ -55,6 +55,7 @@ THE SOFTWARE.
 #include "base/Scheduler.h"
 #include "base/UserDefault.h"
 #include "base/Value.h"
+#include "base/ValueBinary.h"
 #include "base/Vector.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
@@ -63,6 +64,7 @@ THE SOFTWARE.
 #include "base/Types.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
+#include "base/FrameRecorder.h"
 
 // EventDispatcher
 #include "base/EventAcceleration.h"
@@ -119,12 +121,14 @@ THE SOFTWARE.
 #include "2d/FontFNT.h"
 #include "2d/FontFreeType.h"
 #include "2d/Label.h"
+#include "2d/LabelLayoutCache.h"
 #include "2d/LabelAtlas.h"
 #include "2d/Layer.h"
 #include "2d/Menu.h"
 #include "2d/MenuItem.h"
 #include "2d/MotionStreak.h"
 #include "2d/Node.h"
+#include "2d/NodeQuery.h"
 #include "2d/NodeGrid.h"
 #include "2d/ParticleBatchNode.h"
 #include "2d/ParticleExamples.h"
@@ -150,6 +154,7 @@ THE SOFTWARE.
 // renderer
 #include "renderer/CallbackCommand.h"
 #include "renderer/CustomCommand.h"
+#include "renderer/FrameArena.h"
 #include "renderer/GroupCommand.h"
 #include "renderer/Material.h"
 #include "renderer/Pass.h"
@@ -158,10 +163,13 @@ THE SOFTWARE.
 #include "renderer/RenderCommandPool.h"
 #include "renderer/RenderState.h"
 #include "renderer/Renderer.h"
+#include "renderer/StreamBuffer.h"
 #include "renderer/Technique.h"
 #include "renderer/Texture2D.h"
 #include "renderer/TextureCube.h"
 #include "renderer/TextureCache.h"
+#include "renderer/TextureStreamer.h"
+#include "renderer/AtlasPacker.h"
 #include "renderer/TrianglesCommand.h"
 #include "renderer/Shaders.h"
 
@@ -241,6 +249,7 @@ THE SOFTWARE.
 #include "2d/SpriteBatchNode.h"
 #include "2d/SpriteFrame.h"
 #include "2d/SpriteFrameCache.h"
+#include "2d/DynamicAtlas.h"
 
 // text_input_node
 #include "2d/TextFieldTTF.h"
@@ -34,11 +34,13 @@ THE SOFTWARE.
 #include <string>
 
 #include "2d/SpriteFrameCache.h"
+#include "2d/DynamicAtlas.h"
 #include "platform/FileUtils.h"
 
 #include "2d/ActionManager.h"
 #include "2d/FontFNT.h"
 #include "2d/FontAtlasCache.h"
+#include "2d/LabelLayoutCache.h"
 #include "2d/AnimationCache.h"
 #include "2d/Transition.h"
 #include "2d/FontFreeType.h"
@@ -672,10 +674,12 @@ void Director::purgeCachedData()
 {
     FontFNT::purgeCachedData();
     FontAtlasCache::purgeCachedData();
+    LabelLayoutCache::purgeCachedData();
 
     if (s_SharedDirector->getGLView())
     {
         SpriteFrameCache::getInstance()->removeUnusedSpriteFrames();
+        DynamicAtlas::getInstance()->removeUnusedPages();
         _textureCache->removeUnusedTextures();
 
         // Note: some tests such as ActionsTest are leaking refcounted textures
@@ -1045,16 +1049,19 @@ void Director::reset()
     AX_SAFE_RELEASE_NULL(_FPSLabel);
     AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
     AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+    AX_SAFE_RELEASE_NULL(_statsExtraLabel);
 
     // purge bitmap cache
     FontFNT::purgeCachedData();
     FontAtlasCache::purgeCachedData();
+    LabelLayoutCache::purgeCachedData();
 
     FontFreeType::shutdownFreeType();
 
     // purge all managed caches
     AnimationCache::destroyInstance();
     SpriteFrameCache::destroyInstance();
+    DynamicAtlas::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
     backend::ProgramStateRegistry::destroyInstance();
@@ -1075,6 +1082,7 @@ void Director::cleanupDirector()
     AX_SAFE_RELEASE(_FPSLabel);
     AX_SAFE_RELEASE(_drawnVerticesLabel);
     AX_SAFE_RELEASE(_drawnBatchesLabel);
+    AX_SAFE_RELEASE(_statsExtraLabel);
 
     AX_SAFE_RELEASE(_runningScene);
     AX_SAFE_RELEASE(_notificationNode);
@@ -1271,6 +1279,8 @@ void Director::showStats()
         _drawnVerticesLabel->visit(_renderer, identity, 0);
         _drawnBatchesLabel->visit(_renderer, identity, 0);
         _FPSLabel->visit(_renderer, identity, 0);
+        if (_statsExtraLabel && !_statsExtraText.empty())
+            _statsExtraLabel->visit(_renderer, identity, 0);
     }
 }
 
@@ -1306,6 +1316,7 @@ void Director::createStatsLabel()
         AX_SAFE_RELEASE_NULL(_FPSLabel);
         AX_SAFE_RELEASE_NULL(_drawnBatchesLabel);
         AX_SAFE_RELEASE_NULL(_drawnVerticesLabel);
+        AX_SAFE_RELEASE_NULL(_statsExtraLabel);
         _textureCache->removeTextureForKey("/cc_fps_images");
         FileUtils::getInstance()->purgeCachedEntries();
     }
@@ -1352,6 +1363,11 @@ void Director::createStatsLabel()
     _drawnVerticesLabel->setIgnoreContentScaleFactor(true);
     _drawnVerticesLabel->setScale(scaleFactor);
 
+    _statsExtraLabel = LabelAtlas::create(_statsExtraText, texture, 12, 32, '.');
+    _statsExtraLabel->retain();
+    _statsExtraLabel->setIgnoreContentScaleFactor(true);
+    _statsExtraLabel->setScale(scaleFactor);
+
     setStatsAnchor();
 }
 
@@ -1437,11 +1453,26 @@ void Director::setStatsAnchor(AnchorPreset anchor)
         _drawnVerticesLabel->setPosition(Vec2(0, height_spacing * 2.0f) + _fpsPosition + safeOrigin);
         _drawnBatchesLabel->setPosition(Vec2(0, height_spacing * 1.0f) + _fpsPosition + safeOrigin);
         _FPSLabel->setPosition(Vec2(0, height_spacing * 0.0f) + _fpsPosition + safeOrigin);
+
+        // the extra line goes below the stats at the top of the screen, above them otherwise
+        const bool atTop = anchor == AnchorPreset::TOP_LEFT || anchor == AnchorPreset::TOP_CENTER ||
+                           anchor == AnchorPreset::TOP_RIGHT;
+        _statsExtraLabel->setAnchorPoint(_FPSLabel->getAnchorPoint());
+        _statsExtraLabel->setPosition(Vec2(0, height_spacing * (atTop ? -1.0f : 3.0f)) + _fpsPosition + safeOrigin);
     }
 }
 
 #endif  // #if !AX_STRIP_FPS
 
+void Director::setStatsExtraText(std::string_view text)
+{
+    if (_statsExtraText == text)
+        return;
+    _statsExtraText = text;
+    if (_statsExtraLabel)
+        _statsExtraLabel->setString(_statsExtraText);
+}
+
 void Director::setContentScaleFactor(float scaleFactor)
 {
     if (scaleFactor != _contentScaleFactor)
@@ -164,6 +164,10 @@ public:
     /** Sets the stats corner displayed on screen if display stats is enabled. */
     void setStatsAnchor(AnchorPreset anchor = (AnchorPreset)0);
 
+    /** Sets an extra line displayed with the stats, eg: the script GC stats, an empty text hides it. */
+    void setStatsExtraText(std::string_view text);
+    std::string_view getStatsExtraText() const { return _statsExtraText; }
+
     /** Sets the FPS value. */
 
     /**
@@ -618,6 +622,8 @@ protected:
     LabelAtlas* _FPSLabel           = nullptr;
     LabelAtlas* _drawnBatchesLabel  = nullptr;
     LabelAtlas* _drawnVerticesLabel = nullptr;
+    LabelAtlas* _statsExtraLabel    = nullptr;
+    std::string _statsExtraText;
 
     /** Whether or not the Director is paused */
     bool _paused = false;
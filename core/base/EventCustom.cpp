@@ -25,9 +25,37 @@
 
 #include "base/EventCustom.h"
 #include "base/Event.h"
+#include "base/hlookup.h"
 
 NS_AX_BEGIN
 
 EventCustom::EventCustom(std::string_view eventName) : Event(Type::CUSTOM), _userData(nullptr), _eventName(eventName) {}
 
+static hlookup::string_map<uint32_t>& getEventIds()
+{
+    static hlookup::string_map<uint32_t> s_eventIds;
+    return s_eventIds;
+}
+
+uint32_t EventCustom::internEventName(std::string_view eventName)
+{
+    auto& eventIds = getEventIds();
+
+    auto iter = eventIds.find(eventName);
+    if (iter != eventIds.end())
+        return iter->second;
+
+    auto eventId = static_cast<uint32_t>(eventIds.size() + 1);
+    eventIds.emplace(eventName, eventId);
+    return eventId;
+}
+
+uint32_t EventCustom::findEventId(std::string_view eventName)
+{
+    auto& eventIds = getEventIds();
+
+    auto iter = eventIds.find(eventName);
+    return iter != eventIds.end() ? iter->second : 0;
+}
+
 NS_AX_END
@@ -27,6 +27,7 @@
 #define __cocos2d_libs__CCCustomEvent__
 
 #include <string>
+#include <stdint.h>
 #include "base/Event.h"
 
 /**
@@ -67,9 +68,40 @@ public:
      */
     std::string_view getEventName() const { return _eventName; }
 
+    /** Gets the interned id of the event name.
+     * Events with the same name share the same id. Names are interned when a listener is registered for them,
+     * the id is 0 for the names nobody ever listened to.
+     *
+     * @return The interned id of the event name, or 0.
+     */
+    uint32_t getEventId() const
+    {
+        if (_eventId == 0)
+            _eventId = findEventId(_eventName);
+        return _eventId;
+    }
+
+    /** Interns a custom event name, ids are dense, start from 1 and stay valid for the lifetime of the process.
+     * EventDispatcher interns the names custom listeners are registered for, so the table only grows with them.
+     * @note Must be called on the axmol thread.
+     *
+     * @param eventName The name of the custom event.
+     * @return The interned id of the event name.
+     */
+    static uint32_t internEventName(std::string_view eventName);
+
+    /** Finds the interned id of a custom event name without interning it.
+     * @note Must be called on the axmol thread.
+     *
+     * @param eventName The name of the custom event.
+     * @return The interned id of the event name, 0 if the name wasn't interned.
+     */
+    static uint32_t findEventId(std::string_view eventName);
+
 protected:
     void* _userData;  ///< User data
     std::string _eventName;
+    mutable uint32_t _eventId = 0;  ///< Interned id of _eventName, 0 until it's found interned
 };
 
 NS_AX_END
@@ -508,6 +508,7 @@ void EventDispatcher::addEventListener(EventListener* listener)
     else
     {
         _toAddedListeners.emplace_back(listener);
+        ++_pendingChanges;
     }
 #if AX_ENABLE_GC_FOR_NATIVE_OBJECTS
     auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
@@ -529,6 +530,11 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
 
         listeners = new EventListenerVector();
         _listenerMap.emplace(listenerID, listeners);
+        ++_listenerMapVersion;
+
+        // Only the names listened to get an id, the events nobody listens to take the string keyed path
+        if (listener->getType() == EventListener::Type::CUSTOM)
+            EventCustom::internEventName(listenerID);
     }
     else
     {
@@ -679,6 +685,7 @@ void EventDispatcher::removeEventListener(EventListener* listener)
             {
                 AX_SAFE_RETAIN(l);
                 l->setRegistered(false);
+                ++_pendingChanges;
                 if (l->getAssociatedNode() != nullptr)
                 {
                     dissociateNodeAndEventListener(l->getAssociatedNode(), l);
@@ -739,6 +746,7 @@ void EventDispatcher::removeEventListener(EventListener* listener)
             _priorityDirtyFlagMap.erase(listener->getListenerID());
             auto list = iter->second;
             iter      = _listenerMap.erase(iter);
+            ++_listenerMapVersion;
             AX_SAFE_DELETE(list);
         }
         else
@@ -975,6 +983,12 @@ void EventDispatcher::dispatchEvent(Event* event, bool forced)
         return;
     }
 
+    if (event->getType() == Event::Type::CUSTOM && static_cast<EventCustom*>(event)->getEventId() != 0)
+    {
+        dispatchCustomEventById(static_cast<EventCustom*>(event));
+        return;
+    }
+
     auto listenerID = __getListenerID(event);
 
     sortEventListeners(listenerID);
@@ -1008,6 +1022,67 @@ void EventDispatcher::dispatchCustomEvent(std::string_view eventName, void* opti
     dispatchEvent(&ev, forced);
 }
 
+void EventDispatcher::dispatchCustomEventById(EventCustom* event)
+{
+    auto eventId = event->getEventId();
+    if (eventId >= _customListenerSlots.size())
+        _customListenerSlots.resize(eventId + 1);
+
+    // Listeners queued or unregistered from here on, e.g. by the callbacks, need updateListeners
+    auto pendingChanges = _pendingChanges;
+
+    auto& slot = _customListenerSlots[eventId];
+    if (slot.mapVersion != _listenerMapVersion)
+    {
+        slot.listeners  = getListeners(event->getEventName());
+        slot.mapVersion = _listenerMapVersion;
+    }
+
+    if (slot.listeners && slot.dirtyVersion != _dirtyVersion)
+    {
+        // Record the version first, sortEventListeners bumps it when the sorting has to be deferred
+        slot.dirtyVersion = _dirtyVersion;
+        sortEventListeners(event->getEventName());
+    }
+
+    // The slot may be reallocated by a nested dispatch, don't hold on to it
+    auto listeners = slot.listeners;
+    if (listeners)
+    {
+        auto fixedPriorityListeners = listeners->getFixedPriorityListeners();
+        if (listeners->getSceneGraphPriorityListeners())
+        {
+            auto onEvent = [event](EventListener* listener) -> bool {
+                event->setCurrentTarget(listener->getAssociatedNode());
+                listener->_onEvent(event);
+                return event->isStopped();
+            };
+
+            dispatchEventToListeners(listeners, onEvent);
+        }
+        else if (fixedPriorityListeners)
+        {
+            // Without scene graph listeners the sorted fixed priority listeners are walked in one go,
+            // fixed priority listeners have no associated node
+            event->setCurrentTarget(nullptr);
+            auto size = fixedPriorityListeners->size();
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto l = (*fixedPriorityListeners)[i];
+                if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+                {
+                    l->_onEvent(event);
+                    if (event->isStopped())
+                        break;
+                }
+            }
+        }
+    }
+
+    if (pendingChanges != _pendingChanges)
+        updateListeners(event);
+}
+
 bool EventDispatcher::hasEventListener(std::string_view listenerID) const
 {
     return getListeners(listenerID) != nullptr;
@@ -1288,20 +1363,6 @@ void EventDispatcher::updateListeners(Event* event)
 
     AXASSERT(_inDispatch == 1, "_inDispatch should be 1 here.");
 
-    for (auto iter = _listenerMap.begin(); iter != _listenerMap.end();)
-    {
-        if (iter->second->empty())
-        {
-            _priorityDirtyFlagMap.erase(iter->first);
-            delete iter->second;
-            iter = _listenerMap.erase(iter);
-        }
-        else
-        {
-            ++iter;
-        }
-    }
-
     if (!_toAddedListeners.empty())
     {
         for (auto&& listener : _toAddedListeners)
@@ -1315,6 +1376,22 @@ void EventDispatcher::updateListeners(Event* event)
     {
         cleanToRemovedListeners();
     }
+
+    // Sweep after the pending lists were flushed, so vectors emptied by cleanToRemovedListeners go away as well
+    for (auto iter = _listenerMap.begin(); iter != _listenerMap.end();)
+    {
+        if (iter->second->empty())
+        {
+            _priorityDirtyFlagMap.erase(iter->first);
+            delete iter->second;
+            iter = _listenerMap.erase(iter);
+            ++_listenerMapVersion;
+        }
+        else
+        {
+            ++iter;
+        }
+    }
 }
 
 void EventDispatcher::updateDirtyFlagForSceneGraph()
@@ -1367,6 +1444,7 @@ void EventDispatcher::sortEventListeners(std::string_view listenerID)
             else
             {
                 dirtyIter->second = DirtyFlag::SCENE_GRAPH_PRIORITY;
+                ++_dirtyVersion;
             }
         }
     }
@@ -1470,6 +1548,7 @@ void EventDispatcher::removeEventListenersForListenerID(std::string_view listene
             {
                 auto l = *iter;
                 l->setRegistered(false);
+                ++_pendingChanges;
                 if (l->getAssociatedNode() != nullptr)
                 {
                     dissociateNodeAndEventListener(l->getAssociatedNode(), l);
@@ -1501,6 +1580,7 @@ void EventDispatcher::removeEventListenersForListenerID(std::string_view listene
             listeners->clear();
             delete listeners;
             _listenerMap.erase(listenerItemIter);
+            ++_listenerMapVersion;
         }
     }
 
@@ -1578,6 +1658,7 @@ void EventDispatcher::removeAllEventListeners()
     if (!_inDispatch && cleanMap)
     {
         _listenerMap.clear();
+        ++_listenerMapVersion;
     }
 }
 
@@ -1609,6 +1690,8 @@ void EventDispatcher::setDirtyForNode(Node* node)
 
 void EventDispatcher::setDirty(std::string_view listenerID, DirtyFlag flag)
 {
+    ++_dirtyVersion;
+
     auto iter = _priorityDirtyFlagMap.find(listenerID);
     if (iter == _priorityDirtyFlagMap.end())
     {
@@ -278,6 +278,9 @@ protected:
      */
     void updateListeners(Event* event);
 
+    /** Custom events are looked up by their interned id and skip the string keyed maps in steady state. */
+    void dispatchCustomEventById(EventCustom* event);
+
     /** Touch event needs to be processed different with other events since it needs support ALL_AT_ONCE and ONE_BY_NONE
      * mode. */
     void dispatchTouchEvent(EventTouch* event);
@@ -356,6 +359,26 @@ protected:
     int _nodePriorityIndex;
 
     std::set<std::string> _internalCustomListenerIDs;
+
+    /** The listeners of a custom event cached by its interned id, revalidated against the version counters */
+    struct CustomListenerSlot
+    {
+        EventListenerVector* listeners = nullptr;
+        uint32_t mapVersion            = 0;
+        uint32_t dirtyVersion          = 0;
+    };
+
+    /** Indexed by EventCustom::getEventId */
+    std::vector<CustomListenerSlot> _customListenerSlots;
+
+    /** Bumped whenever a listener vector is inserted into or erased from _listenerMap */
+    uint32_t _listenerMapVersion = 1;
+
+    /** Bumped whenever a priority dirty flag is set */
+    uint32_t _dirtyVersion = 1;
+
+    /** Bumped whenever listeners are queued for adding or unregistered, tells whether updateListeners has work */
+    uint32_t _pendingChanges = 0;
 };
 
 NS_AX_END
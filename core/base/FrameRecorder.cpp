@@ -0,0 +1,160 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/FrameRecorder.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include "base/JobSystem.h"
+#include "base/Utils.h"
+#include "platform/FileUtils.h"
+#include "renderer/Renderer.h"
+#include "fmt/format.h"
+
+NS_AX_BEGIN
+
+FrameRecorder::FrameRecorder(std::size_t maxFrames, unsigned int frameInterval)
+    : _frames(std::max(maxFrames, std::size_t{1})), _frameInterval(std::max(frameInterval, 1u))
+{}
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+void FrameRecorder::start()
+{
+    if (_listener)
+        return;
+
+    _token        = std::make_shared<FrameRecorder*>(this);
+    _frameCounter = 0;
+
+    auto eventDispatcher = Director::getInstance()->getEventDispatcher();
+    // !!!Metal: needs setFrameBufferOnly before draw, see utils::captureScreen
+#if defined(AX_USE_METAL)
+    _listener = eventDispatcher->addCustomEventListener(Director::EVENT_BEFORE_DRAW,
+                                                        [this](EventCustom* /*event*/) { captureFrame(); });
+#else
+    _listener = eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW,
+                                                        [this](EventCustom* /*event*/) { captureFrame(); });
+#endif
+}
+
+void FrameRecorder::stop()
+{
+    if (!_listener)
+        return;
+
+    Director::getInstance()->getEventDispatcher()->removeEventListener(_listener);
+    _listener = nullptr;
+    _token.reset();
+}
+
+void FrameRecorder::clear()
+{
+    _head  = 0;
+    _count = 0;
+}
+
+const FrameRecorder::Frame& FrameRecorder::getFrame(std::size_t index) const
+{
+    AXASSERT(index < _count, "FrameRecorder: frame index out of range");
+    return _frames[(_head + index) % _frames.size()];
+}
+
+void FrameRecorder::captureFrame()
+{
+    if (_frameCounter++ % _frameInterval != 0)
+        return;
+
+    auto director   = Director::getInstance();
+    auto renderer   = director->getRenderer();
+    auto frameIndex = static_cast<uint64_t>(director->getTotalFrames());
+    renderer->readPixelsAsync(renderer->getDefaultRenderTarget(),
+                              [token = std::weak_ptr<FrameRecorder*>(_token),
+                               frameIndex](const backend::PixelBufferDescriptor& pbd) {
+        if (auto self = token.lock(); self && pbd)
+            (*self)->onFrameRead(pbd, frameIndex);
+    });
+}
+
+void FrameRecorder::onFrameRead(const backend::PixelBufferDescriptor& pbd, uint64_t frameIndex)
+{
+    // overwrite the oldest frame when full, its storage is reused
+    std::size_t slot;
+    if (_count < _frames.size())
+        slot = (_head + _count++) % _frames.size();
+    else
+    {
+        slot  = _head;
+        _head = (_head + 1) % _frames.size();
+    }
+
+    auto& frame = _frames[slot];
+    frame.pixels.assign(pbd._data.getBytes(), pbd._data.getBytes() + pbd._data.getSize());
+    frame.width      = pbd._width;
+    frame.height     = pbd._height;
+    frame.frameIndex = frameIndex;
+}
+
+void FrameRecorder::saveFrames(std::string_view directory,
+                               std::string_view prefix,
+                               Image::Format format,
+                               std::function<void(bool)> callback)
+{
+    AXASSERT(format == Image::Format::JPG || format == Image::Format::PNG,
+             "the frames can only be saved as JPG or PNG format");
+
+    auto frames = std::make_shared<std::vector<Frame>>();
+    frames->reserve(_count);
+    for (std::size_t i = 0; i < _count; ++i)
+        frames->emplace_back(getFrame(i));
+
+    std::string basePath{directory};
+    if (!basePath.empty() && basePath.back() != '/')
+        basePath.push_back('/');
+    basePath.append(prefix);
+    const char* extension = format == Image::Format::PNG ? ".png" : ".jpg";
+
+    auto succeed = std::make_shared<bool>(true);
+    Director::getInstance()->getJobSystem()->enqueue(
+        [frames, basePath = std::move(basePath), extension, succeed]() {
+        for (std::size_t i = 0; i < frames->size(); ++i)
+        {
+            auto& frame = (*frames)[i];
+            auto image  = utils::makeInstance<Image>(&Image::initWithRawData, frame.pixels.data(),
+                                                    static_cast<ssize_t>(frame.pixels.size()), frame.width,
+                                                    frame.height, 8, false);
+            if (!image || !image->saveToFile(fmt::format("{}{:04}{}", basePath, i, extension), false))
+                *succeed = false;
+        }
+    },
+        [succeed, callback = std::move(callback)]() {
+        if (callback)
+            callback(*succeed);
+    });
+}
+
+NS_AX_END
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "platform/Image.h"
+#include "renderer/backend/PixelBufferDescriptor.h"
+
+NS_AX_BEGIN
+
+class EventListenerCustom;
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ * Records the last N rendered frames to memory for replay clips.
+ * Every recorded frame is read back with `Renderer::readPixelsAsync`, so recording never stalls the GPU.
+ * Once the ring is full, the oldest frame storage is overwritten in place and the GL readback storage is reused, so a
+ * steady recording of the same size doesn't reallocate frame buffers (each readback still uses its own pixel pack
+ * buffer on the GPU).
+ */
+class AX_DLL FrameRecorder
+{
+public:
+    /** A recorded frame, RGBA8 pixels with the top row first. */
+    struct Frame
+    {
+        std::vector<uint8_t> pixels;
+        int width           = 0;
+        int height          = 0;
+        uint64_t frameIndex = 0;  ///< Director's total frames when the frame was rendered.
+    };
+
+    /**
+     * @param maxFrames The number of frames kept, older frames are dropped.
+     * @param frameInterval Record every Nth frame.
+     */
+    explicit FrameRecorder(std::size_t maxFrames, unsigned int frameInterval = 1);
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&)            = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    void start();
+    /** Stop recording, the readbacks in flight are dropped. */
+    void stop();
+    bool isRecording() const { return _listener != nullptr; }
+
+    /** Drop the recorded frames. */
+    void clear();
+
+    std::size_t getFrameCount() const { return _count; }
+    std::size_t getMaxFrames() const { return _frames.size(); }
+
+    /** Get a recorded frame, index 0 is the oldest. */
+    const Frame& getFrame(std::size_t index) const;
+
+    /**
+     * Encode the recorded frames to `<directory>/<prefix><index>.png` (or .jpg) on the job system.
+     * The frames are copied, recording may go on meanwhile.
+     * @param callback Invoked on the axmol thread with whether every frame was saved.
+     */
+    void saveFrames(std::string_view directory,
+                    std::string_view prefix,
+                    Image::Format format,
+                    std::function<void(bool)> callback = nullptr);
+
+protected:
+    // Store a read back frame in the ring.
+    void onFrameRead(const backend::PixelBufferDescriptor& pbd, uint64_t frameIndex);
+
+private:
+    void captureFrame();
+
+    std::vector<Frame> _frames;
+    std::size_t _head  = 0;  // slot of the oldest frame
+    std::size_t _count = 0;
+
+    unsigned int _frameInterval = 1;
+    unsigned int _frameCounter  = 0;
+
+    EventListenerCustom* _listener = nullptr;
+    // readbacks resolved after stop or destruction are dropped once the token changed
+    std::shared_ptr<FrameRecorder*> _token;
+};
+
+// end of base group
+/** @} */
+
+NS_AX_END
@@ -34,6 +34,7 @@
 #include <future>
 #include <functional>
 #include <stdexcept>
+#include <atomic>
 
 NS_AX_BEGIN
 
@@ -173,6 +174,7 @@ JobSystem::JobSystem(std::span<std::shared_ptr<JobThreadData>> tdds)
 void JobSystem::init(const std::span<std::shared_ptr<JobThreadData>>& tdds)
 {
     _mainThreadData = new MainThreadData();
+    _threadCount    = static_cast<int>(tdds.size());
     if (!tdds.empty())
         _executor = new JobExecutor(tdds);
 }
@@ -232,6 +234,56 @@ void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
         taskw(_mainThreadData);
 }
 
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+    if (count == 0)
+        return;
+    if (!_executor || count == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    struct ParallelForState
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        size_t count{0};
+        const std::function<void(size_t)>* func{nullptr};
+        std::mutex mtx;
+        std::condition_variable cv;
+
+        void run()
+        {
+            size_t index;
+            while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count)
+            {
+                (*func)(index);
+                if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+                {
+                    std::lock_guard<std::mutex> lck(mtx);
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+
+    // helpers may be scheduled after all indices were consumed, so the state must outlive this call
+    auto state   = std::make_shared<ParallelForState>();
+    state->count = count;
+    state->func  = &func;
+
+    const auto helpers = (std::min)(count - 1, static_cast<size_t>(_threadCount));
+    for (size_t i = 0; i < helpers; ++i)
+        _executor->enqueue_v([state](JobThreadData*) { state->run(); });
+
+    state->run();
+
+    std::unique_lock<std::mutex> lck(state->mtx);
+    state->cv.wait(lck, [&state] { return state->done.load(std::memory_order_acquire) == state->count; });
+}
+
 #pragma endregion
 
 NS_AX_END
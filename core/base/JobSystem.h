@@ -39,6 +39,7 @@ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
 #include <memory>
 #include <string>
 #include <span>
+#include <functional>
 #include "base/Config.h"
 #include "platform/PlatformDefine.h"
 
@@ -101,12 +102,23 @@ public:
     void enqueue(std::function<void()> task, std::function<void()> done);
     void enqueue(std::shared_ptr<JobThreadTask> task);
 
+    /**
+     * Runs func(index) for every index in [0, count) on the worker threads and the calling thread,
+     * returns after all of them finished. The calling thread always participates, so it's safe to
+     * call even if all workers are busy.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
+    /** Gets the number of worker threads, 0 means all jobs run on the calling thread. */
+    int getThreadCount() const { return _threadCount; }
+
  protected:
     void init(const std::span<std::shared_ptr<JobThreadData>>& tdds);
 
 private:
     JobExecutor* _executor{nullptr};
     JobThreadData* _mainThreadData{nullptr};
+    int _threadCount{0};
 };
 
 NS_AX_END
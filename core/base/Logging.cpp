@@ -24,6 +24,15 @@
  ****************************************************************************/
 
 #include "base/Logging.h"
+#include "platform/FileUtils.h"
+#include "platform/FileStream.h"
+
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "yasio/utils.hpp"
 #include "fmt/color.h"
@@ -67,6 +76,367 @@ AX_API void setLogOutput(ILogOutput* output)
     s_logOutput = output;
 }
 
+namespace
+{
+/* A single producer single consumer ring of variable sized records, each logging thread owns one. */
+class LogRing
+{
+public:
+    struct Header
+    {
+        uint32_t size;  // record size including the header, 0 marks the padding before a wrap
+        uint32_t messageSize;
+        LogLevel level;
+        bool hasStyle;
+        uint16_t tagSize;  // including the null terminator
+        uint16_t prefixSize;
+        uint16_t qualifierSize;
+    };
+
+    explicit LogRing(size_t capacity) : _capacity(std::bit_ceil((std::max)(capacity, static_cast<size_t>(4096))))
+    {
+        _buffer.reset(new char[_capacity]);
+    }
+
+    bool push(Header header, const char* tag, std::string_view message)
+    {
+        const size_t tagSize = strlen(tag) + 1;
+        header.tagSize       = static_cast<uint16_t>(tagSize);
+        header.messageSize   = static_cast<uint32_t>(message.size());
+        header.size          = static_cast<uint32_t>(alignSize(sizeof(Header) + tagSize + message.size()));
+
+        auto tail             = _tail.load(std::memory_order_relaxed);
+        const auto head       = _head.load(std::memory_order_acquire);
+        auto offset           = tail & (_capacity - 1);
+        const auto contiguous = _capacity - offset;
+        const auto required   = header.size <= contiguous ? header.size : contiguous + header.size;
+        if (required > _capacity - (tail - head))
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (header.size > contiguous)
+        {
+            if (contiguous >= sizeof(Header))
+            {
+                const uint32_t padding = 0;
+                memcpy(_buffer.get() + offset, &padding, sizeof(padding));
+            }
+            tail += contiguous;
+            offset = 0;
+        }
+
+        auto wptr = _buffer.get() + offset;
+        memcpy(wptr, &header, sizeof(Header));
+        memcpy(wptr + sizeof(Header), tag, tagSize);
+        memcpy(wptr + sizeof(Header) + tagSize, message.data(), message.size());
+        _tail.store(tail + header.size, std::memory_order_release);
+        return true;
+    }
+
+    template <typename _Fn>
+    size_t consume(_Fn&& fn)
+    {
+        auto head       = _head.load(std::memory_order_relaxed);
+        const auto tail = _tail.load(std::memory_order_acquire);
+        size_t count    = 0;
+        while (head != tail)
+        {
+            const auto offset     = head & (_capacity - 1);
+            const auto contiguous = _capacity - offset;
+            Header header;
+            if (contiguous < sizeof(Header))
+                header.size = 0;
+            else
+                memcpy(&header, _buffer.get() + offset, sizeof(Header));
+
+            if (header.size == 0)
+            {
+                head += contiguous;
+            }
+            else
+            {
+                auto rptr = _buffer.get() + offset + sizeof(Header);
+                fn(header, rptr, std::string_view{rptr + header.tagSize, header.messageSize});
+                head += header.size;
+                ++count;
+            }
+            _head.store(head, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+    uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    static size_t alignSize(size_t size) { return (size + 7) & ~static_cast<size_t>(7); }
+
+    const size_t _capacity;
+    std::unique_ptr<char[]> _buffer;
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+    std::atomic<uint64_t> _dropped{0};
+};
+
+class LogFileSink
+{
+public:
+    ~LogFileSink()
+    {
+        _enabled = false;
+        _stream.close();
+    }
+
+    void open(std::string_view fileName, size_t maxFileSize, int maxBackups)
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mutex);
+        _enabled = false;
+        _stream.close();
+        if (fileName.empty())
+            return;
+
+        auto fileUtils = FileUtils::getInstance();
+        _path          = fileUtils->getWritablePath();
+        _path += fileName;
+        _maxFileSize = maxFileSize;
+        _maxBackups  = maxBackups;
+        _size        = 0;
+        if (fileUtils->isFileExist(_path))
+            _size = static_cast<size_t>((std::max)(fileUtils->getFileSize(_path), (int64_t)0));
+        _enabled = _stream.open(_path, FileStream::Mode::APPEND);
+    }
+
+    void write(std::string_view message)
+    {
+        std::lock_guard<std::recursive_mutex> lck(_mutex);
+        if (!_stream.isOpen())
+            return;
+
+        _stream.write(message.data(), static_cast<unsigned int>(message.size()));
+        _size += message.size();
+        if (_maxFileSize && _size >= _maxFileSize)
+            rotate();
+    }
+
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+private:
+    void rotate()
+    {
+        _stream.close();
+
+        // fileName.(n-1) -> fileName.n, ..., fileName -> fileName.1
+        auto fileUtils = FileUtils::getInstance();
+        if (_maxBackups > 0)
+        {
+            auto oldest = fmt::format("{}.{}", _path, _maxBackups);
+            if (fileUtils->isFileExist(oldest))
+                fileUtils->removeFile(oldest);
+            for (int i = _maxBackups - 1; i > 0; --i)
+            {
+                auto backup = fmt::format("{}.{}", _path, i);
+                if (fileUtils->isFileExist(backup))
+                    fileUtils->renameFile(backup, fmt::format("{}.{}", _path, i + 1));
+            }
+            fileUtils->renameFile(_path, fmt::format("{}.1", _path));
+        }
+
+        _size    = 0;
+        _enabled = _stream.open(_path, FileStream::Mode::WRITE);
+    }
+
+    std::recursive_mutex _mutex;
+    FileStream _stream;
+    std::string _path;
+    size_t _maxFileSize = 0;
+    size_t _size        = 0;
+    int _maxBackups     = 0;
+    std::atomic<bool> _enabled{false};
+};
+}  // namespace
+
+static LogFileSink s_logFileSink;
+
+static void deliverLog(LogItem& item, const char* tag)
+{
+    if (!s_logOutput)
+        writeLog(item, tag);
+    else
+        s_logOutput->write(item, tag);
+
+    if (s_logFileSink.isEnabled())
+        s_logFileSink.write(item.message());
+}
+
+class AsyncLogWriter
+{
+public:
+    ~AsyncLogWriter() { stop(); }
+
+    void start(size_t ringCapacity)
+    {
+        _ringCapacity = ringCapacity;
+        if (_running.exchange(true))
+            return;
+        _thread = std::thread(&AsyncLogWriter::run, this);
+    }
+
+    void stop()
+    {
+        if (!_running.exchange(false))
+            return;
+        {
+            std::lock_guard<std::mutex> lck(_mutex);
+            _stopRequested = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+        _stopRequested = false;
+    }
+
+    bool isRunning() const { return _running.load(std::memory_order_acquire); }
+
+    void post(LogItem& item, const char* tag)
+    {
+        static thread_local std::shared_ptr<LogRing> t_ring;
+        if (!t_ring)
+        {
+            t_ring = std::make_shared<LogRing>(_ringCapacity.load(std::memory_order_relaxed));
+            std::lock_guard<std::mutex> lck(_mutex);
+            _rings.emplace_back(t_ring);
+        }
+
+        LogRing::Header header{};
+        header.level         = item.level_;
+        header.hasStyle      = item.has_style_;
+        header.prefixSize    = static_cast<uint16_t>(item.prefix_size_);
+        header.qualifierSize = static_cast<uint16_t>(item.qualifier_size_);
+        if (t_ring->push(header, tag, item.qualified_message_) && item.level_ >= LogLevel::Error)
+            _cv.notify_one();
+    }
+
+    void flush()
+    {
+        if (!isRunning() || std::this_thread::get_id() == _thread.get_id())
+            return;
+
+        // wait for a full pass which started after this call
+        std::unique_lock<std::mutex> lck(_mutex);
+        const auto target = _passes + 2;
+        _cv.notify_one();
+        _flushCv.wait(lck, [this, target] { return _passes >= target || _stopRequested; });
+    }
+
+    LogStats getStats()
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        LogStats stats;
+        stats.written = _written.load(std::memory_order_relaxed);
+        stats.dropped = _droppedOfReleasedRings;
+        for (auto&& ring : _rings)
+            stats.dropped += ring->dropped();
+        return stats;
+    }
+
+private:
+    void run()
+    {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        std::unique_lock<std::mutex> lck(_mutex);
+        for (;;)
+        {
+            // rings only referenced here belong to exited threads, release them once drained
+            std::erase_if(_rings, [this](const std::shared_ptr<LogRing>& ring) {
+                if (ring.use_count() > 1 || !ring->empty())
+                    return false;
+                _droppedOfReleasedRings += ring->dropped();
+                return true;
+            });
+            const bool stopping = _stopRequested;
+            rings               = _rings;
+            auto dropped        = _droppedOfReleasedRings;
+            lck.unlock();
+
+            size_t count = 0;
+            for (auto&& ring : rings)
+            {
+                count += ring->consume([](const LogRing::Header& header, const char* tag, std::string_view message) {
+                    LogItem item{header.level};
+                    item.has_style_      = header.hasStyle;
+                    item.prefix_size_    = header.prefixSize;
+                    item.qualifier_size_ = header.qualifierSize;
+                    item.qualified_message_.assign(message);
+                    deliverLog(item, tag);
+                });
+                dropped += ring->dropped();
+            }
+            rings.clear();
+            _written.fetch_add(count, std::memory_order_relaxed);
+
+            if (dropped != _reportedDropped)
+            {
+                deliverLog(LogItem::vformat(FMT_COMPILE("{}axmol: {} log records dropped, the ring is full\n"),
+                                            preprocessLog(LogItem{LogLevel::Warn}), dropped - _reportedDropped),
+                           "axmol");
+                _reportedDropped = dropped;
+            }
+
+            lck.lock();
+            ++_passes;
+            _flushCv.notify_all();
+            if (stopping)
+                break;
+            if (count == 0 && !_stopRequested)
+                _cv.wait_for(lck, std::chrono::milliseconds(10));
+        }
+    }
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::condition_variable _flushCv;
+    std::vector<std::shared_ptr<LogRing>> _rings;  // guarded by _mutex
+    bool _stopRequested              = false;      // guarded by _mutex
+    uint64_t _passes                 = 0;          // guarded by _mutex
+    uint64_t _droppedOfReleasedRings = 0;          // guarded by _mutex
+    uint64_t _reportedDropped        = 0;          // writer thread only
+    std::atomic<bool> _running{false};
+    std::atomic<size_t> _ringCapacity{64 * 1024};
+    std::atomic<uint64_t> _written{0};
+};
+
+static AsyncLogWriter s_asyncLogWriter;
+
+AX_API void setLogAsync(bool enabled, size_t ringCapacity)
+{
+    if (enabled)
+        s_asyncLogWriter.start(ringCapacity);
+    else
+        s_asyncLogWriter.stop();
+}
+
+AX_API bool isLogAsync()
+{
+    return s_asyncLogWriter.isRunning();
+}
+
+AX_API void flushLog()
+{
+    s_asyncLogWriter.flush();
+}
+
+AX_API LogStats getLogStats()
+{
+    return s_asyncLogWriter.getStats();
+}
+
+AX_API void setLogFile(std::string_view fileName, size_t maxFileSize, int maxBackups)
+{
+    s_logFileSink.open(fileName, maxFileSize, maxBackups);
+}
+
 AX_API LogItem& preprocessLog(LogItem&& item)
 {
     if (s_logFmtFlags != LogFmtFlag::Null)
@@ -161,8 +531,10 @@ AX_API LogItem& preprocessLog(LogItem&& item)
 
 AX_DLL void outputLog(LogItem& item, const char* tag)
 {
-    if (!s_logOutput) writeLog(item, tag);
-    else s_logOutput->write(item, tag);
+    if (s_asyncLogWriter.isRunning())
+        s_asyncLogWriter.post(item, tag);
+    else
+        deliverLog(item, tag);
 }
 
 AX_DLL void writeLog(LogItem& item, const char* tag)
@@ -54,10 +54,13 @@ enum class LogFmtFlag
 };
 AX_ENABLE_BITMASK_OPS(LogFmtFlag);
 
+class AsyncLogWriter;
+
 class LogItem
 {
     friend AX_API LogItem& preprocessLog(LogItem&& logItem);
     friend AX_API void writeLog(LogItem& item, const char* tag);
+    friend class AsyncLogWriter;
 
 public:
     static constexpr auto COLOR_PREFIX_SIZE    = 5;                      // \x1b[00m
@@ -122,6 +125,33 @@ AX_API void setLogFmtFlag(LogFmtFlag flags);
 /* @brief set log output */
 AX_API void setLogOutput(ILogOutput* output);
 
+struct LogStats
+{
+    uint64_t written = 0;  // records written by the async writer thread
+    uint64_t dropped = 0;  // records dropped because the ring buffer of the logging thread was full
+};
+
+/* @brief control asynchronous logging
+ *
+ * When enabled, a log call only copies the formatted record into a lock-free ring buffer owned by the calling
+ * thread, a single writer thread drains the rings and performs the platform output, the file output and the
+ * ILogOutput::write calls. Records are ordered per thread. When a ring is full the record is dropped and counted,
+ * the writer reports the dropped count with a warning. ringCapacity applies to rings created afterwards.
+ * Should be called from the main thread.
+ */
+AX_API void setLogAsync(bool enabled, size_t ringCapacity = 64 * 1024);
+AX_API bool isLogAsync();
+
+/* @brief blocks until all queued records were written, does nothing in synchronous mode */
+AX_API void flushLog();
+
+AX_API LogStats getLogStats();
+
+/* @brief write logs into a file in the writable path as well, rotated to fileName.1 ... fileName.maxBackups
+ * when it exceeds maxFileSize, an empty fileName disables the file output
+ */
+AX_API void setLogFile(std::string_view fileName, size_t maxFileSize = 4 * 1024 * 1024, int maxBackups = 3);
+
 /* @brief internal use */
 AX_API LogItem& preprocessLog(LogItem&& logItem);
 
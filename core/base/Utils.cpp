@@ -112,8 +112,8 @@ void captureScreen(std::function<void(RefPtr<Image>)> imageCallback)
 #endif
         eventDispatcher->removeEventListener(s_captureScreenListener);
         s_captureScreenListener = nullptr;
-        // !!!GL: AFTER_DRAW and BEFORE_END_FRAME
-        renderer->readPixels(renderer->getDefaultRenderTarget(), [=](const backend::PixelBufferDescriptor& pbd) {
+        // !!!GL: AFTER_DRAW and BEFORE_END_FRAME, resolved by a later endFrame without stalling the GPU
+        renderer->readPixelsAsync(renderer->getDefaultRenderTarget(), [=](const backend::PixelBufferDescriptor& pbd) {
             if (pbd)
             {
                 auto image = utils::makeInstance<Image>(&Image::initWithRawData, pbd._data.getBytes(),
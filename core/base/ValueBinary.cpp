@@ -0,0 +1,347 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/ValueBinary.h"
+
+#include <cstring>
+#include <type_traits>
+
+NS_AX_BEGIN
+
+namespace ValueBinary
+{
+
+namespace
+{
+// the low bits of a tag are the type family, the high bits the integer flags
+constexpr uint8_t TAG_UNSIGNED = 0x10;
+constexpr uint8_t TAG_64BIT    = 0x20;
+
+// a decoder gives up on containers nested deeper than this instead of overflowing the stack
+constexpr int MAX_DEPTH = 256;
+
+template <typename T>
+void writePod(std::string& out, T value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::string& out, size_t value)
+{
+    // 7 bits per byte, the high bit tells another byte follows
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void writeString(std::string& out, std::string_view value)
+{
+    writeSize(out, value.size());
+    out.append(value);
+}
+
+template <typename T>
+bool readPod(std::string_view& data, T& value)
+{
+    if (data.size() < sizeof(T))
+        return false;
+    memcpy(&value, data.data(), sizeof(T));
+    data.remove_prefix(sizeof(T));
+    return true;
+}
+
+bool readSize(std::string_view& data, size_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < sizeof(size_t) * 8 && !data.empty(); shift += 7)
+    {
+        const auto byte = static_cast<uint8_t>(data.front());
+        data.remove_prefix(1);
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool readString(std::string_view& data, std::string_view& value)
+{
+    size_t size;
+    if (!readSize(data, size) || size > data.size())
+        return false;
+    value = data.substr(0, size);
+    data.remove_prefix(size);
+    return true;
+}
+
+bool decodeValue(std::string_view& data, Value& value, int depth);
+
+bool decodeVector(std::string_view& data, ValueVector& vector, int depth)
+{
+    size_t count;
+    // every element takes at least its tag byte
+    if (!readSize(data, count) || count > data.size())
+        return false;
+    vector.resize(count);
+    for (auto&& element : vector)
+    {
+        if (!decodeValue(data, element, depth))
+            return false;
+    }
+    return true;
+}
+
+bool decodeMap(std::string_view& data, ValueMap& map, int depth)
+{
+    size_t count;
+    if (!readSize(data, count) || count > data.size())
+        return false;
+    map.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string_view key;
+        Value element;
+        if (!readString(data, key) || !decodeValue(data, element, depth))
+            return false;
+        map.emplace(std::string{key}, std::move(element));
+    }
+    return true;
+}
+
+bool decodeIntKeyMap(std::string_view& data, ValueMapIntKey& map, int depth)
+{
+    size_t count;
+    if (!readSize(data, count) || count > data.size())
+        return false;
+    map.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int32_t key;
+        Value element;
+        if (!readPod(data, key) || !decodeValue(data, element, depth))
+            return false;
+        map.emplace(key, std::move(element));
+    }
+    return true;
+}
+
+template <typename T>
+bool decodeNumber(std::string_view& data, Value& value)
+{
+    T number;
+    if (!readPod(data, number))
+        return false;
+    value = Value(number);
+    return true;
+}
+
+bool decodeValue(std::string_view& data, Value& value, int depth)
+{
+    uint8_t tag;
+    if (++depth > MAX_DEPTH || !readPod(data, tag))
+        return false;
+
+    switch (static_cast<Value::Type>(tag & 0x0f))
+    {
+    case Value::Type::NONE:
+        value = Value::Null;
+        return true;
+    case Value::Type::INTEGER:
+        switch (tag & (TAG_UNSIGNED | TAG_64BIT))
+        {
+        case 0:
+            return decodeNumber<int32_t>(data, value);
+        case TAG_UNSIGNED:
+            return decodeNumber<uint32_t>(data, value);
+        case TAG_64BIT:
+            return decodeNumber<int64_t>(data, value);
+        default:
+            return decodeNumber<uint64_t>(data, value);
+        }
+    case Value::Type::FLOAT:
+        return decodeNumber<float>(data, value);
+    case Value::Type::DOUBLE:
+        return decodeNumber<double>(data, value);
+    case Value::Type::BOOLEAN:
+    {
+        uint8_t boolean;
+        if (!readPod(data, boolean))
+            return false;
+        value = Value(boolean != 0);
+        return true;
+    }
+    case Value::Type::STRING:
+    {
+        std::string_view string;
+        if (!readString(data, string))
+            return false;
+        value = Value(string);
+        return true;
+    }
+    case Value::Type::VECTOR:
+    {
+        ValueVector vector;
+        if (!decodeVector(data, vector, depth))
+            return false;
+        value = Value(std::move(vector));
+        return true;
+    }
+    case Value::Type::MAP:
+    {
+        ValueMap map;
+        if (!decodeMap(data, map, depth))
+            return false;
+        value = Value(std::move(map));
+        return true;
+    }
+    case Value::Type::INT_KEY_MAP:
+    {
+        ValueMapIntKey map;
+        if (!decodeIntKeyMap(data, map, depth))
+            return false;
+        value = Value(std::move(map));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool decodeTagged(std::string_view& data, Value::Type type)
+{
+    uint8_t tag;
+    if (!readPod(data, tag) || tag != static_cast<uint8_t>(type))
+        return false;
+    return true;
+}
+}  // namespace
+
+void encode(const Value& value, std::string& out)
+{
+    const auto type = value.getType();
+    switch (value.getTypeFamily())
+    {
+    case Value::Type::INTEGER:
+    {
+        uint8_t tag = static_cast<uint8_t>(Value::Type::INTEGER);
+        if ((uint32_t)type & (uint32_t)Value::Type::MASK_UNSIGNED)
+            tag |= TAG_UNSIGNED;
+        if ((uint32_t)type & (uint32_t)Value::Type::MASK_64BIT)
+            tag |= TAG_64BIT;
+        writePod(out, tag);
+        switch (type)
+        {
+        case Value::Type::INT_UI32:
+            writePod(out, static_cast<uint32_t>(value.asUint()));
+            break;
+        case Value::Type::INT_I64:
+            writePod(out, static_cast<int64_t>(value.asInt64()));
+            break;
+        case Value::Type::INT_UI64:
+            writePod(out, static_cast<uint64_t>(value.asUint64()));
+            break;
+        default:
+            writePod(out, static_cast<int32_t>(value.asInt()));
+            break;
+        }
+        break;
+    }
+    case Value::Type::FLOAT:
+        writePod(out, static_cast<uint8_t>(Value::Type::FLOAT));
+        writePod(out, value.asFloat());
+        break;
+    case Value::Type::DOUBLE:
+        writePod(out, static_cast<uint8_t>(Value::Type::DOUBLE));
+        writePod(out, value.asDouble());
+        break;
+    case Value::Type::BOOLEAN:
+        writePod(out, static_cast<uint8_t>(Value::Type::BOOLEAN));
+        writePod(out, static_cast<uint8_t>(value.asBool()));
+        break;
+    case Value::Type::STRING:
+        writePod(out, static_cast<uint8_t>(Value::Type::STRING));
+        writeString(out, value.asStringRef());
+        break;
+    case Value::Type::VECTOR:
+        encode(value.asValueVector(), out);
+        break;
+    case Value::Type::MAP:
+        encode(value.asValueMap(), out);
+        break;
+    case Value::Type::INT_KEY_MAP:
+        writePod(out, static_cast<uint8_t>(Value::Type::INT_KEY_MAP));
+        writeSize(out, value.asIntKeyMap().size());
+        for (auto&& [key, element] : value.asIntKeyMap())
+        {
+            writePod(out, static_cast<int32_t>(key));
+            encode(element, out);
+        }
+        break;
+    default:
+        writePod(out, static_cast<uint8_t>(Value::Type::NONE));
+        break;
+    }
+}
+
+void encode(const ValueMap& map, std::string& out)
+{
+    writePod(out, static_cast<uint8_t>(Value::Type::MAP));
+    writeSize(out, map.size());
+    for (auto&& [key, element] : map)
+    {
+        writeString(out, key);
+        encode(element, out);
+    }
+}
+
+void encode(const ValueVector& vector, std::string& out)
+{
+    writePod(out, static_cast<uint8_t>(Value::Type::VECTOR));
+    writeSize(out, vector.size());
+    for (auto&& element : vector)
+        encode(element, out);
+}
+
+bool decode(std::string_view& data, Value& value)
+{
+    return decodeValue(data, value, 0);
+}
+
+bool decode(std::string_view& data, ValueMap& map)
+{
+    return decodeTagged(data, Value::Type::MAP) && decodeMap(data, map, 1);
+}
+
+bool decode(std::string_view& data, ValueVector& vector)
+{
+    return decodeTagged(data, Value::Type::VECTOR) && decodeVector(data, vector, 1);
+}
+
+}  // namespace ValueBinary
+
+NS_AX_END
@@ -0,0 +1,67 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __AX_VALUE_BINARY_H__
+#define __AX_VALUE_BINARY_H__
+
+#include <string>
+#include <string_view>
+#include "base/Value.h"
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+NS_AX_BEGIN
+
+/**
+ * A compact binary encoding of Value, ValueMap and ValueVector.
+ *
+ * Numbers are stored in the byte order of the device, so the encoding is meant for caches on the device which
+ * produced them, e.g. the plist cache of FileUtils, not for files shipped with a game.
+ * The decoder reads from a memory view with bounds checks, it can decode a memory mapped file in place.
+ */
+namespace ValueBinary
+{
+/** Appends the encoding of a value to a buffer. */
+AX_DLL void encode(const Value& value, std::string& out);
+AX_DLL void encode(const ValueMap& map, std::string& out);
+AX_DLL void encode(const ValueVector& vector, std::string& out);
+
+/**
+ * Decodes a value from the start of a memory view.
+ * @param data The view, on success it's advanced past the decoded value.
+ * @return false if the data is truncated or isn't an encoded value, the output is unspecified then.
+ */
+AX_DLL bool decode(std::string_view& data, Value& value);
+AX_DLL bool decode(std::string_view& data, ValueMap& map);
+AX_DLL bool decode(std::string_view& data, ValueVector& vector);
+}  // namespace ValueBinary
+
+/** @} */
+
+NS_AX_END
+
+#endif  // __AX_VALUE_BINARY_H__
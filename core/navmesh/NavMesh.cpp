@@ -30,7 +30,11 @@
 #    include "renderer/Renderer.h"
 #    include "recast/DetourCommon.h"
 #    include "recast/DetourDebugDraw.h"
+#    include "base/Director.h"
 #    include <sstream>
+#    include <atomic>
+#    include <mutex>
+#    include <chrono>
 
 NS_AX_BEGIN
 
@@ -88,12 +92,92 @@ static unsigned char* parseRow(unsigned char* buf, unsigned char* bufEnd, char*
 
 static const int TILECACHESET_MAGIC   = 'T' << 24 | 'S' << 16 | 'E' << 8 | 'T';  //'TSET';
 static const int TILECACHESET_VERSION = 1;
-static const int MAX_AGENTS           = 128;
+static const int MAX_POLYS                  = 256;
+static const int MAX_SMOOTH                 = 2048;
+static const int MAX_SEARCH_NODES           = 2048;
+static const int MAX_LANE_INFLIGHT_REQUESTS = 8;   // the DetourPathQueue capacity
+static const int PATH_QUERY_ITERS_PER_STEP  = 64;  // the iterations between two budget checks
+static const float POLY_PICK_EXT[3]         = {2, 4, 2};
+
+struct NavMesh::PathRequest
+{
+    unsigned int id{0};
+    Vec3 start;
+    Vec3 end;
+    PathCallback callback;
+    std::vector<Vec3> pathPoints;
+    dtPathQueueRef ref{DT_PATHQ_INVALID};
+    dtPolyRef startRef{0};
+    bool assigned{false};
+    bool finished{false};
+    bool succeed{false};
+    std::atomic<bool> cancelled{false};
+};
+
+struct NavMesh::StreamTile
+{
+    int tx{0};
+    int ty{0};
+    int tlayer{0};
+    Vec3 bmin;
+    Vec3 bmax;
+    int64_t offset{0};
+    int dataSize{0};
+    dtCompressedTileRef ref{0};
+    bool loading{false};
+};
 
-NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath)
+struct NavMesh::LoadedTile
+{
+    size_t index{0};
+    unsigned char* data{nullptr};
+    int dataSize{0};
+};
+
+// The tiles read by workers, shared with the read jobs which may outlive the navmesh.
+struct NavMesh::TileLoadQueue
+{
+    ~TileLoadQueue()
+    {
+        for (auto&& loaded : tiles)
+            dtFree(loaded.data);
+    }
+
+    std::mutex mtx;
+    std::vector<LoadedTile> tiles;
+    bool closed{false};
+};
+
+struct NavMesh::PathQueryLane
+{
+    ~PathQueryLane() { dtFreeNavMeshQuery(query); }
+
+    dtPathQueue pathQueue;
+    dtNavMeshQuery* query{nullptr};
+    std::vector<PathRequest*> inflight;
+};
+
+NavMesh* NavMesh::create(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents)
 {
     auto ref = new NavMesh();
-    if (ref->initWithFilePath(navFilePath, geomFilePath))
+    if (ref->initWithFilePath(navFilePath, geomFilePath, maxAgents))
+    {
+        ref->autorelease();
+        return ref;
+    }
+    AX_SAFE_DELETE(ref);
+    return nullptr;
+}
+
+NavMesh* NavMesh::createWithTileStreaming(std::string_view navFilePath,
+                                          std::string_view geomFilePath,
+                                          float loadRadius,
+                                          int maxAgents)
+{
+    auto ref                     = new NavMesh();
+    ref->_isTileStreamingEnabled = true;
+    ref->setStreamingRadius(loadRadius, loadRadius * 1.25f);
+    if (ref->initWithFilePath(navFilePath, geomFilePath, maxAgents))
     {
         ref->autorelease();
         return ref;
@@ -112,10 +196,34 @@ NavMesh::NavMesh()
     , _meshProcess(nullptr)
     , _geomData(nullptr)
     , _isDebugDrawEnabled(false)
+    , _maxAgents(128)
+    , _nextPathRequestId(0)
+    , _pathQueryBudget(0.002f)
+    , _maxPathQueryLanes(4)
+    , _maxAgentMoveRequestsPerFrame(0)
+    , _lastUpdateTime(0.0f)
+    , _isTileStreamingEnabled(false)
+    , _streamAroundAgents(true)
+    , _tileCacheDirty(false)
+    , _streamLoadRadius(0.0f)
+    , _streamUnloadRadius(0.0f)
+    , _stagingNavMesh(nullptr)
 {}
 
 NavMesh::~NavMesh()
 {
+    if (_tileBuildJob.valid())
+        _tileBuildJob.wait();
+    if (_tileLoadQueue)
+    {
+        std::lock_guard<std::mutex> lck(_tileLoadQueue->mtx);
+        _tileLoadQueue->closed = true;
+    }
+    dtFreeNavMesh(_stagingNavMesh);
+
+    _pathQueryLanes.clear();
+    _pathRequests.clear();
+
     dtFreeTileCache(_tileCache);
     dtFreeCrowd(_crowed);
     dtFreeNavMesh(_navMesh);
@@ -136,10 +244,17 @@ NavMesh::~NavMesh()
         AX_SAFE_RELEASE(iter);
     }
     _obstacleList.clear();
+
+    for (auto&& change : _pendingObstacleChanges)
+    {
+        AX_SAFE_RELEASE(change.first);
+    }
+    _pendingObstacleChanges.clear();
 }
 
-bool NavMesh::initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath)
+bool NavMesh::initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents)
 {
+    _maxAgents    = maxAgents > 0 ? maxAgents : 128;
     _navFilePath  = navFilePath;
     _geomFilePath = geomFilePath;
     if (!read())
@@ -159,6 +274,9 @@ bool NavMesh::read()
 
 bool NavMesh::loadNavMeshFile()
 {
+    if (_isTileStreamingEnabled)
+        return loadNavMeshTileIndex();
+
     auto data = FileUtils::getInstance()->getDataFromFile(_navFilePath);
     if (data.isNull())
         return false;
@@ -176,12 +294,101 @@ bool NavMesh::loadNavMeshFile()
         return false;
     }
 
+    if (!initNavMeshObjects(header.meshParams, header.cacheParams))
+        return false;
+
+    // Read tiles.
+    for (int i = 0; i < header.numTiles; ++i)
+    {
+        TileCacheTileHeader tileHeader = *((TileCacheTileHeader*)(data.getBytes() + offset));
+        offset += sizeof(TileCacheTileHeader);
+        if (!tileHeader.tileRef || !tileHeader.dataSize)
+            break;
+
+        unsigned char* tileData = (unsigned char*)dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM);
+        if (!tileData)
+            break;
+        memcpy(tileData, (data.getBytes() + offset), tileHeader.dataSize);
+        offset += tileHeader.dataSize;
+
+        dtCompressedTileRef tile = 0;
+        _tileCache->addTile(tileData, tileHeader.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile);
+
+        if (tile)
+            _tileCache->buildNavMeshTile(tile, _navMesh);
+    }
+
+    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
+    return true;
+}
+
+bool NavMesh::loadNavMeshTileIndex()
+{
+    auto stream = FileUtils::getInstance()->openFileStream(_navFilePath, IFileStream::Mode::READ);
+    if (!stream)
+        return false;
+
+    // Read header, only the tile headers are indexed, the tile data is streamed in on demand.
+    TileCacheSetHeader header;
+    if (stream->read(&header, sizeof(header)) != sizeof(header))
+        return false;
+    if (header.magic != TILECACHESET_MAGIC)
+    {
+        return false;
+    }
+    if (header.version != TILECACHESET_VERSION)
+    {
+        return false;
+    }
+
+    if (!initNavMeshObjects(header.meshParams, header.cacheParams))
+        return false;
+
+    _stagingNavMesh = dtAllocNavMesh();
+    if (!_stagingNavMesh || dtStatusFailed(_stagingNavMesh->init(&header.meshParams)))
+        return false;
+    _tileLoadQueue = std::make_shared<TileLoadQueue>();
+
+    int64_t offset = sizeof(TileCacheSetHeader);
+    for (int i = 0; i < header.numTiles; ++i)
+    {
+        TileCacheTileHeader tileHeader;
+        if (stream->seek(offset, SEEK_SET) != offset ||
+            stream->read(&tileHeader, sizeof(tileHeader)) != sizeof(tileHeader))
+            break;
+        offset += sizeof(TileCacheTileHeader);
+        if (!tileHeader.tileRef || tileHeader.dataSize < static_cast<int32_t>(sizeof(dtTileCacheLayerHeader)))
+            break;
+
+        // The compressed tile starts with an uncompressed layer header.
+        dtTileCacheLayerHeader layerHeader;
+        if (stream->read(&layerHeader, sizeof(layerHeader)) != sizeof(layerHeader))
+            break;
+
+        StreamTile tile;
+        tile.tx       = layerHeader.tx;
+        tile.ty       = layerHeader.ty;
+        tile.tlayer   = layerHeader.tlayer;
+        tile.bmin     = Vec3(layerHeader.bmin[0], layerHeader.bmin[1], layerHeader.bmin[2]);
+        tile.bmax     = Vec3(layerHeader.bmax[0], layerHeader.bmax[1], layerHeader.bmax[2]);
+        tile.offset   = offset;
+        tile.dataSize = tileHeader.dataSize;
+        _streamTiles.emplace_back(tile);
+
+        offset += tileHeader.dataSize;
+    }
+
+    return !_streamTiles.empty();
+}
+
+bool NavMesh::initNavMeshObjects(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams)
+{
     _navMesh = dtAllocNavMesh();
     if (!_navMesh)
     {
         return false;
     }
-    dtStatus status = _navMesh->init(&header.meshParams);
+    dtStatus status = _navMesh->init(&meshParams);
     if (dtStatusFailed(status))
     {
         return false;
@@ -196,45 +403,23 @@ bool NavMesh::loadNavMeshFile()
     _allocator   = new LinearAllocator(32000);
     _compressor  = new FastLZCompressor();
     _meshProcess = new MeshProcess(_geomData);
-    status       = _tileCache->init(&header.cacheParams, _allocator, _compressor, _meshProcess);
+    status       = _tileCache->init(&cacheParams, _allocator, _compressor, _meshProcess);
 
     if (dtStatusFailed(status))
     {
         return false;
     }
 
-    // Read tiles.
-    for (int i = 0; i < header.numTiles; ++i)
-    {
-        TileCacheTileHeader tileHeader = *((TileCacheTileHeader*)(data.getBytes() + offset));
-        offset += sizeof(TileCacheTileHeader);
-        if (!tileHeader.tileRef || !tileHeader.dataSize)
-            break;
-
-        unsigned char* tileData = (unsigned char*)dtAlloc(tileHeader.dataSize, DT_ALLOC_PERM);
-        if (!tileData)
-            break;
-        memcpy(tileData, (data.getBytes() + offset), tileHeader.dataSize);
-        offset += tileHeader.dataSize;
-
-        dtCompressedTileRef tile = 0;
-        _tileCache->addTile(tileData, tileHeader.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile);
-
-        if (tile)
-            _tileCache->buildNavMeshTile(tile, _navMesh);
-    }
-
     // create crowed
     _crowed = dtAllocCrowd();
-    _crowed->init(MAX_AGENTS, header.cacheParams.walkableRadius, _navMesh);
+    _crowed->init(_maxAgents, cacheParams.walkableRadius, _navMesh);
 
     // create NavMeshQuery
     _navMeshQuery = dtAllocNavMeshQuery();
-    _navMeshQuery->init(_navMesh, 2048);
+    _navMeshQuery->init(_navMesh, MAX_SEARCH_NODES);
 
-    _agentList.assign(MAX_AGENTS, nullptr);
-    _obstacleList.assign(header.cacheParams.maxObstacles, nullptr);
-    // duDebugDrawNavMesh(&_debugDraw, *_navMesh, DU_DRAWNAVMESH_OFFMESHCONS);
+    _agentList.assign(_maxAgents, nullptr);
+    _obstacleList.assign(cacheParams.maxObstacles, nullptr);
     return true;
 }
 
@@ -319,6 +504,10 @@ void ax::NavMesh::drawOffMeshConnections()
 
 void ax::NavMesh::drawObstacles()
 {
+    // The tile cache is owned by worker while building
+    if (isTileBuilding())
+        return;
+
     // Draw obstacles
     for (auto&& iter : _obstacleList)
     {
@@ -415,9 +604,16 @@ void NavMesh::removeNavMeshObstacle(NavMeshObstacle* obstacle)
     auto iter = std::find(_obstacleList.begin(), _obstacleList.end(), obstacle);
     if (iter != _obstacleList.end())
     {
+        _obstacleList[iter - _obstacleList.begin()] = nullptr;
+        // the tile cache is owned by the worker while building, the change keeps the reference until it's applied
+        if (isTileBuilding())
+        {
+            _pendingObstacleChanges.emplace_back(obstacle, false);
+            return;
+        }
         obstacle->removeFrom(_tileCache);
+        _tileCacheDirty = true;
         obstacle->release();
-        _obstacleList[iter - _obstacleList.begin()] = nullptr;
     }
 }
 
@@ -426,12 +622,34 @@ void NavMesh::addNavMeshObstacle(NavMeshObstacle* obstacle)
     auto iter = std::find(_obstacleList.begin(), _obstacleList.end(), nullptr);
     if (iter != _obstacleList.end())
     {
-        obstacle->addTo(_tileCache);
         obstacle->retain();
         _obstacleList[iter - _obstacleList.begin()] = obstacle;
+        if (isTileBuilding())
+        {
+            obstacle->retain();
+            _pendingObstacleChanges.emplace_back(obstacle, true);
+            return;
+        }
+        obstacle->addTo(_tileCache);
+        _tileCacheDirty = true;
     }
 }
 
+void NavMesh::applyPendingObstacleChanges()
+{
+    // replayed in order, so an obstacle added and removed while building is added before it's removed
+    for (auto&& change : _pendingObstacleChanges)
+    {
+        if (change.second)
+            change.first->addTo(_tileCache);
+        else
+            change.first->removeFrom(_tileCache);
+        change.first->release();
+    }
+    _tileCacheDirty = _tileCacheDirty || !_pendingObstacleChanges.empty();
+    _pendingObstacleChanges.clear();
+}
+
 void NavMesh::removeNavMeshAgent(NavMeshAgent* agent)
 {
     auto iter = std::find(_agentList.begin(), _agentList.end(), agent);
@@ -478,53 +696,500 @@ void NavMesh::debugDraw(Renderer* renderer)
 
 void NavMesh::update(float dt)
 {
+    auto startTime = std::chrono::steady_clock::now();
+
+    int moveRequestBudget = _maxAgentMoveRequestsPerFrame > 0 ? _maxAgentMoveRequestsPerFrame : _maxAgents;
     for (auto&& iter : _agentList)
     {
-        if (iter)
-            iter->preUpdate(dt);
+        if (iter && iter->preUpdate(dt, moveRequestBudget > 0))
+            --moveRequestBudget;
     }
 
-    for (auto&& iter : _obstacleList)
+    // obstacles can't touch the tile cache while a worker is building tiles, they sync in next frames
+    const bool syncObstacles = !isTileBuilding();
+    if (syncObstacles)
     {
-        if (iter)
-            iter->preUpdate(dt);
+        for (auto&& iter : _obstacleList)
+        {
+            if (iter)
+            {
+                auto obstacleID = iter->_obstacleID;
+                iter->preUpdate(dt);
+                if (obstacleID != iter->_obstacleID)
+                    _tileCacheDirty = true;
+            }
+        }
     }
 
     if (_crowed)
         _crowed->update(dt, nullptr);
 
-    if (_tileCache)
+    if (_isTileStreamingEnabled)
+        updateTileStreaming();
+    else if (_tileCache)
         _tileCache->update(dt, _navMesh);
 
+    updatePathRequests();
+
     for (auto&& iter : _agentList)
     {
         if (iter)
             iter->postUpdate(dt);
     }
 
-    for (auto&& iter : _obstacleList)
+    if (syncObstacles && !isTileBuilding())
     {
-        if (iter)
-            iter->postUpdate(dt);
+        for (auto&& iter : _obstacleList)
+        {
+            if (iter)
+                iter->postUpdate(dt);
+        }
     }
+
+    _lastUpdateTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned int NavMesh::findPathAsync(const Vec3& start, const Vec3& end, const PathCallback& callback)
+{
+    if (!_navMesh)
+        return 0;
+
+    if (++_nextPathRequestId == 0)
+        ++_nextPathRequestId;
+
+    auto request      = std::make_shared<PathRequest>();
+    request->id       = _nextPathRequestId;
+    request->start    = start;
+    request->end      = end;
+    request->callback = callback;
+    _pathRequests.emplace_back(std::move(request));
+    return _nextPathRequestId;
+}
+
+void NavMesh::cancelPathRequest(unsigned int requestId)
+{
+    for (auto&& request : _pathRequests)
+    {
+        if (request->id == requestId)
+        {
+            request->cancelled = true;
+            break;
+        }
+    }
+}
+
+int NavMesh::getPendingPathRequestCount() const
+{
+    // cancelled requests stay queued until a lane drops them
+    return static_cast<int>(std::count_if(_pathRequests.begin(), _pathRequests.end(),
+                                          [](const std::shared_ptr<PathRequest>& request) { return !request->cancelled; }));
+}
+
+void NavMesh::setMaxPathQueryLanes(int lanes)
+{
+    _maxPathQueryLanes = (std::max)(lanes, 1);
+}
+
+void NavMesh::updatePathRequests()
+{
+    if (_pathRequests.empty())
+        return;
+
+    // lanes can be resized only when no search in flight
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    auto numLanes  = static_cast<size_t>((std::min)(_maxPathQueryLanes, jobSystem->getThreadCount() + 1));
+    if (_pathQueryLanes.size() != numLanes &&
+        std::all_of(_pathQueryLanes.begin(), _pathQueryLanes.end(),
+                    [](const std::unique_ptr<PathQueryLane>& lane) { return lane->inflight.empty(); }))
+    {
+        _pathQueryLanes.clear();
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            auto lane   = std::make_unique<PathQueryLane>();
+            lane->query = dtAllocNavMeshQuery();
+            if (!lane->query || dtStatusFailed(lane->query->init(_navMesh, MAX_SEARCH_NODES)) ||
+                !lane->pathQueue.init(MAX_POLYS, MAX_SEARCH_NODES, _navMesh))
+                break;
+            _pathQueryLanes.emplace_back(std::move(lane));
+        }
+        if (_pathQueryLanes.empty())
+            return;
+    }
+
+    std::vector<PathRequest*> unassigned;
+    for (auto&& request : _pathRequests)
+    {
+        if (!request->assigned)
+            unassigned.emplace_back(request.get());
+    }
+
+    std::atomic<size_t> cursor{0};
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<float>(_pathQueryBudget));
+    const dtQueryFilter* filter = &_pathQueryFilter;
+
+    jobSystem->parallelFor(_pathQueryLanes.size(), [&, this](size_t laneIndex) {
+        auto lane = _pathQueryLanes[laneIndex].get();
+        dtPolyRef polys[MAX_POLYS];
+        for (;;)
+        {
+            while (lane->inflight.size() < MAX_LANE_INFLIGHT_REQUESTS)
+            {
+                auto index = cursor.fetch_add(1, std::memory_order_relaxed);
+                if (index >= unassigned.size())
+                    break;
+
+                auto request      = unassigned[index];
+                request->assigned = true;
+                if (request->cancelled)
+                {
+                    request->finished = true;
+                    continue;
+                }
+
+                dtPolyRef endRef = 0;
+                lane->query->findNearestPoly(&request->start.x, POLY_PICK_EXT, filter, &request->startRef, nullptr);
+                lane->query->findNearestPoly(&request->end.x, POLY_PICK_EXT, filter, &endRef, nullptr);
+                if (request->startRef && endRef)
+                    request->ref =
+                        lane->pathQueue.request(request->startRef, endRef, &request->start.x, &request->end.x, filter);
+
+                if (request->ref == DT_PATHQ_INVALID)
+                    request->finished = true;
+                else
+                    lane->inflight.emplace_back(request);
+            }
+
+            if (lane->inflight.empty())
+                break;
+
+            lane->pathQueue.update(PATH_QUERY_ITERS_PER_STEP);
+
+            auto iter = lane->inflight.begin();
+            while (iter != lane->inflight.end())
+            {
+                auto request  = *iter;
+                auto status   = lane->pathQueue.getRequestStatus(request->ref);
+                if (dtStatusInProgress(status) && !request->cancelled)
+                {
+                    ++iter;
+                    continue;
+                }
+
+                int npolys = 0;
+                lane->pathQueue.getPathResult(request->ref, polys, &npolys, MAX_POLYS);
+                if (dtStatusSucceed(status) && npolys > 0 && !request->cancelled)
+                {
+                    buildSmoothPath(_navMesh, lane->query, filter, request->start, request->end, request->startRef,
+                                    polys, npolys, request->pathPoints);
+                    request->succeed = !request->pathPoints.empty();
+                }
+                request->finished = true;
+                iter              = lane->inflight.erase(iter);
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+        }
+    });
+
+    // deliver results on main thread in request order
+    std::vector<std::shared_ptr<PathRequest>> finished;
+    auto iter = _pathRequests.begin();
+    while (iter != _pathRequests.end())
+    {
+        if ((*iter)->finished)
+        {
+            finished.emplace_back(std::move(*iter));
+            iter = _pathRequests.erase(iter);
+        }
+        else
+            ++iter;
+    }
+
+    for (auto&& request : finished)
+    {
+        if (!request->cancelled && request->callback)
+            request->callback(request->id, request->succeed, request->pathPoints);
+    }
+}
+
+void NavMesh::setStreamingRadius(float loadRadius, float unloadRadius)
+{
+    _streamLoadRadius   = loadRadius;
+    _streamUnloadRadius = (std::max)(loadRadius, unloadRadius);
+}
+
+void NavMesh::addStreamingAnchor(Node* anchor)
+{
+    if (anchor && !_streamAnchors.contains(anchor))
+        _streamAnchors.pushBack(anchor);
+}
+
+void NavMesh::removeStreamingAnchor(Node* anchor)
+{
+    _streamAnchors.eraseObject(anchor);
+}
+
+int NavMesh::getLoadedTileCount() const
+{
+    if (!_isTileStreamingEnabled)
+    {
+        if (!_navMesh)
+            return 0;
+
+        // getMaxTiles is the capacity, only the tiles with a header hold data
+        const dtNavMesh* navMesh = _navMesh;
+        int count                = 0;
+        for (int i = 0; i < navMesh->getMaxTiles(); ++i)
+        {
+            auto tile = navMesh->getTile(i);
+            if (tile && tile->header)
+                ++count;
+        }
+        return count;
+    }
+
+    return static_cast<int>(
+        std::count_if(_streamTiles.begin(), _streamTiles.end(), [](const StreamTile& tile) { return tile.ref != 0; }));
+}
+
+int NavMesh::getTotalTileCount() const
+{
+    return static_cast<int>(_streamTiles.size());
+}
+
+static float distanceToTileSq(const Vec3& pos, const Vec3& bmin, const Vec3& bmax)
+{
+    // the tiles are streamed by the distance on xz plane
+    float dx = (std::max)((std::max)(bmin.x - pos.x, 0.0f), pos.x - bmax.x);
+    float dz = (std::max)((std::max)(bmin.z - pos.z, 0.0f), pos.z - bmax.z);
+    return dx * dx + dz * dz;
+}
+
+void NavMesh::updateTileStreaming()
+{
+    if (isTileBuilding())
+    {
+        if (_tileBuildJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        commitBuiltTiles();
+    }
+
+    std::vector<Vec3> anchors;
+    for (auto&& anchor : _streamAnchors)
+    {
+        Mat4 mat = anchor->getNodeToWorldTransform();
+        anchors.emplace_back(mat.m[12], mat.m[13], mat.m[14]);
+    }
+    if (_streamAroundAgents)
+    {
+        for (auto&& iter : _agentList)
+        {
+            if (iter && iter->_agentID != -1)
+            {
+                auto agent = _crowed->getAgent(iter->_agentID);
+                anchors.emplace_back(agent->npos[0], agent->npos[1], agent->npos[2]);
+            }
+        }
+    }
+
+    auto minDistanceSq = [&anchors](const StreamTile& tile) {
+        float minDist = FLT_MAX;
+        for (auto&& pos : anchors)
+            minDist = (std::min)(minDist, distanceToTileSq(pos, tile.bmin, tile.bmax));
+        return minDist;
+    };
+
+    const float loadRadiusSq   = _streamLoadRadius * _streamLoadRadius;
+    const float unloadRadiusSq = _streamUnloadRadius * _streamUnloadRadius;
+
+    // unload far tiles, request near ones
+    auto jobSystem = Director::getInstance()->getJobSystem();
+    for (size_t i = 0; i < _streamTiles.size(); ++i)
+    {
+        auto& tile = _streamTiles[i];
+        float dist = minDistanceSq(tile);
+        if (tile.ref && dist > unloadRadiusSq)
+        {
+            _tileCache->removeTile(tile.ref, nullptr, nullptr);
+            _navMesh->removeTile(_navMesh->getTileRefAt(tile.tx, tile.ty, tile.tlayer), nullptr, nullptr);
+            tile.ref = 0;
+        }
+        else if (!tile.ref && !tile.loading && dist <= loadRadiusSq)
+        {
+            tile.loading = true;
+            jobSystem->enqueue([queue = _tileLoadQueue, path = _navFilePath, index = i, offset = tile.offset,
+                                dataSize = tile.dataSize]() {
+                LoadedTile loaded;
+                loaded.index = index;
+                auto stream  = FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+                if (stream && stream->seek(offset, SEEK_SET) == offset)
+                {
+                    loaded.data = (unsigned char*)dtAlloc(dataSize, DT_ALLOC_PERM);
+                    if (loaded.data && stream->read(loaded.data, dataSize) == dataSize)
+                        loaded.dataSize = dataSize;
+                }
+
+                if (!loaded.dataSize)
+                {
+                    dtFree(loaded.data);
+                    loaded.data = nullptr;
+                }
+
+                std::lock_guard<std::mutex> lck(queue->mtx);
+                if (queue->closed)
+                    dtFree(loaded.data);
+                else
+                    queue->tiles.emplace_back(loaded);
+            });
+        }
+    }
+
+    std::vector<LoadedTile> loadedTiles;
+    {
+        std::lock_guard<std::mutex> lck(_tileLoadQueue->mtx);
+        loadedTiles.swap(_tileLoadQueue->tiles);
+    }
+
+    for (auto&& loaded : loadedTiles)
+    {
+        auto& tile   = _streamTiles[loaded.index];
+        tile.loading = false;
+        if (!loaded.data)
+            continue;
+
+        // the anchors may moved away while reading
+        if (minDistanceSq(tile) > unloadRadiusSq ||
+            dtStatusFailed(_tileCache->addTile(loaded.data, loaded.dataSize, DT_COMPRESSEDTILE_FREE_DATA, &tile.ref)))
+        {
+            dtFree(loaded.data);
+            tile.ref = 0;
+            continue;
+        }
+        _tilesToBuild.emplace_back(tile.ref);
+
+        // the obstacles added before the tile was loaded need to touch it
+        for (auto&& obstacle : _obstacleList)
+        {
+            if (!obstacle)
+                continue;
+            auto ob = _tileCache->getObstacleByRef(obstacle->_obstacleID);
+            if (!ob)
+                continue;
+            float bmin[3], bmax[3];
+            _tileCache->getObstacleBounds(ob, bmin, bmax);
+            if (bmin[0] <= tile.bmax.x && bmax[0] >= tile.bmin.x && bmin[2] <= tile.bmax.z && bmax[2] >= tile.bmin.z)
+            {
+                obstacle->removeFrom(_tileCache);
+                obstacle->addTo(_tileCache);
+                _tileCacheDirty = true;
+            }
+        }
+    }
+
+    if (!_tilesToBuild.empty() || _tileCacheDirty)
+        launchTileBuild();
+}
+
+void NavMesh::launchTileBuild()
+{
+    // snapshot obstacle states to find the tiles touched by the processed obstacles later
+    const int obstacleCount = _tileCache->getObstacleCount();
+    _obstacleSnapshot.resize(obstacleCount);
+    for (int i = 0; i < obstacleCount; ++i)
+    {
+        auto ob              = _tileCache->getObstacle(i);
+        _obstacleSnapshot[i] = (static_cast<unsigned int>(ob->salt) << 8) | ob->state;
+    }
+
+    _buildingTiles.swap(_tilesToBuild);
+    _tilesToBuild.clear();
+    _tileCacheDirty = false;
+
+    auto promise  = std::make_shared<std::promise<void>>();
+    _tileBuildJob = promise->get_future();
+    Director::getInstance()->getJobSystem()->enqueue([this, promise]() {
+        // the main thread doesn't touch the tile cache and staging navmesh until the job finished
+        for (auto ref : _buildingTiles)
+            _tileCache->buildNavMeshTile(ref, _stagingNavMesh);
+
+        static const int MAX_OBSTACLE_UPDATES = 256;
+        bool upToDate                         = false;
+        for (int i = 0; !upToDate && i < MAX_OBSTACLE_UPDATES; ++i)
+            _tileCache->update(0, _stagingNavMesh, &upToDate);
+
+        promise->set_value();
+    });
+}
+
+void NavMesh::commitBuiltTiles()
+{
+    _tileBuildJob.get();
+
+    std::vector<dtCompressedTileRef> rebuiltTiles;
+    rebuiltTiles.swap(_buildingTiles);
+    for (int i = 0; i < _tileCache->getObstacleCount(); ++i)
+    {
+        auto ob = _tileCache->getObstacle(i);
+        if (_obstacleSnapshot[i] != ((static_cast<unsigned int>(ob->salt) << 8) | ob->state))
+            rebuiltTiles.insert(rebuiltTiles.end(), ob->touched, ob->touched + ob->ntouched);
+    }
+    std::sort(rebuiltTiles.begin(), rebuiltTiles.end());
+    rebuiltTiles.erase(std::unique(rebuiltTiles.begin(), rebuiltTiles.end()), rebuiltTiles.end());
+
+    // move the built tiles from staging navmesh, the empty tiles are removed
+    for (auto ref : rebuiltTiles)
+    {
+        auto tile = _tileCache->getTileByRef(ref);
+        if (!tile || !tile->header)
+            continue;
+
+        auto header = tile->header;
+        _navMesh->removeTile(_navMesh->getTileRefAt(header->tx, header->ty, header->tlayer), nullptr, nullptr);
+
+        auto stagingRef = _stagingNavMesh->getTileRefAt(header->tx, header->ty, header->tlayer);
+        if (!stagingRef)
+            continue;
+
+        auto builtTile = _stagingNavMesh->getTileByRef(stagingRef);
+        auto navData   = (unsigned char*)dtAlloc(builtTile->dataSize, DT_ALLOC_PERM);
+        if (navData)
+        {
+            memcpy(navData, builtTile->data, builtTile->dataSize);
+            if (dtStatusFailed(_navMesh->addTile(navData, builtTile->dataSize, DT_TILE_FREE_DATA, 0, nullptr)))
+                dtFree(navData);
+        }
+        _stagingNavMesh->removeTile(stagingRef, nullptr, nullptr);
+    }
+
+    applyPendingObstacleChanges();
 }
 
 void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints)
 {
-    static const int MAX_POLYS  = 256;
-    static const int MAX_SMOOTH = 2048;
-    float ext[3];
-    ext[0] = 2;
-    ext[1] = 4;
-    ext[2] = 2;
     dtQueryFilter filter;
     dtPolyRef startRef, endRef;
     dtPolyRef polys[MAX_POLYS];
     int npolys = 0;
-    _navMeshQuery->findNearestPoly(&start.x, ext, &filter, &startRef, 0);
-    _navMeshQuery->findNearestPoly(&end.x, ext, &filter, &endRef, 0);
+    _navMeshQuery->findNearestPoly(&start.x, POLY_PICK_EXT, &filter, &startRef, 0);
+    _navMeshQuery->findNearestPoly(&end.x, POLY_PICK_EXT, &filter, &endRef, 0);
     _navMeshQuery->findPath(startRef, endRef, &start.x, &end.x, &filter, polys, &npolys, MAX_POLYS);
 
+    buildSmoothPath(_navMesh, _navMeshQuery, &filter, start, end, startRef, polys, npolys, pathPoints);
+}
+
+void NavMesh::buildSmoothPath(dtNavMesh* navMesh,
+                              dtNavMeshQuery* query,
+                              const dtQueryFilter* filter,
+                              const Vec3& start,
+                              const Vec3& end,
+                              dtPolyRef startRef,
+                              dtPolyRef* polys,
+                              int npolys,
+                              std::vector<Vec3>& pathPoints)
+{
     if (npolys)
     {
         //// Iterate over the path to find smooth path on the detail mesh surface.
@@ -533,8 +1198,8 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
         // int npolys = npolys;
 
         float iterPos[3], targetPos[3];
-        _navMeshQuery->closestPointOnPoly(startRef, &start.x, iterPos, 0);
-        _navMeshQuery->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
+        query->closestPointOnPoly(startRef, &start.x, iterPos, 0);
+        query->closestPointOnPoly(polys[npolys - 1], &end.x, targetPos, 0);
 
         static const float STEP_SIZE = 0.5f;
         static const float SLOP      = 0.01f;
@@ -555,7 +1220,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             unsigned char steerPosFlag;
             dtPolyRef steerPosRef;
 
-            if (!getSteerTarget(_navMeshQuery, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
+            if (!getSteerTarget(query, iterPos, targetPos, SLOP, polys, npolys, steerPos, steerPosFlag,
                                 steerPosRef))
                 break;
 
@@ -578,13 +1243,13 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
             float result[3];
             dtPolyRef visited[16];
             int nvisited = 0;
-            _navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &filter, result, visited, &nvisited, 16);
+            query->moveAlongSurface(polys[0], iterPos, moveTgt, filter, result, visited, &nvisited, 16);
 
             npolys = fixupCorridor(polys, npolys, MAX_POLYS, visited, nvisited);
-            npolys = fixupShortcuts(polys, npolys, _navMeshQuery);
+            npolys = fixupShortcuts(polys, npolys, query);
 
             float h = 0;
-            _navMeshQuery->getPolyHeight(polys[0], result, &h);
+            query->getPolyHeight(polys[0], result, &h);
             result[1] = h;
             dtVcopy(iterPos, result);
 
@@ -621,7 +1286,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                 npolys -= npos;
 
                 // Handle the connection.
-                dtStatus status = _navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
+                dtStatus status = navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, startPos, endPos);
                 if (dtStatusSucceed(status))
                 {
                     if (nsmoothPath < MAX_SMOOTH)
@@ -642,7 +1307,7 @@ void ax::NavMesh::findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>
                     // Move position at the other side of the off-mesh link.
                     dtVcopy(iterPos, endPos);
                     float eh = 0.0f;
-                    _navMeshQuery->getPolyHeight(polys[0], iterPos, &eh);
+                    query->getPolyHeight(polys[0], iterPos, &eh);
                     iterPos[1] = eh;
                 }
             }
@@ -31,13 +31,18 @@
 #if defined(AX_ENABLE_NAVMESH)
 
 #    include "base/Object.h"
+#    include "base/Vector.h"
 #    include "math/Vec3.h"
 #    include "recast/DetourNavMesh.h"
 #    include "recast/DetourNavMeshQuery.h"
 #    include "recast/DetourCrowd.h"
 #    include "recast/DetourTileCache.h"
+#    include "recast/DetourPathQueue.h"
 #    include <string>
 #    include <vector>
+#    include <memory>
+#    include <functional>
+#    include <future>
 
 #    include "navmesh/NavMeshAgent.h"
 #    include "navmesh/NavMeshDebugDraw.h"
@@ -51,6 +56,7 @@ NS_AX_BEGIN
  * @{
  */
 class Renderer;
+class Node;
 /** @brief NavMesh: The NavMesh information container, include mesh, tileCache, and so on. */
 class AX_DLL NavMesh : public Object
 {
@@ -61,7 +67,32 @@ public:
     @param navFilePath The NavMesh File path.
     @param geomFilePath The geometry File Path,include offmesh information,etc.
     */
-    static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath);
+    static NavMesh* create(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents = 128);
+
+    /**
+    The callback of async path request, invoked on the main thread.
+
+    @param requestId The id returned by findPathAsync.
+    @param succeed Whether a path was found.
+    @param pathPoints the key points of path.
+    */
+    typedef std::function<void(unsigned int requestId, bool succeed, const std::vector<Vec3>& pathPoints)>
+        PathCallback;
+
+    /**
+    Create navmesh with tile streaming, only the compressed tiles around the streaming anchors are
+    read from the tile cache file and resident in memory, the navmesh tiles and the tiles touched by
+    obstacles are rebuilt on JobSystem worker.
+
+    @param navFilePath The NavMesh File path, same format as create.
+    @param geomFilePath The geometry File Path,include offmesh information,etc.
+    @param loadRadius The tiles within the radius of any anchor are loaded.
+    @param maxAgents The max count of agents.
+    */
+    static NavMesh* createWithTileStreaming(std::string_view navFilePath,
+                                            std::string_view geomFilePath,
+                                            float loadRadius,
+                                            int maxAgents = 128);
 
     /** update navmesh. */
     void update(float dt);
@@ -81,7 +112,7 @@ public:
     /** remove a agent from navmesh. */
     void removeNavMeshAgent(NavMeshAgent* agent);
 
-    /** add a obstacle to navmesh. */
+    /** add a obstacle to navmesh, while tiles are building the change is applied once the build is committed. */
     void addNavMeshObstacle(NavMeshObstacle* obstacle);
 
     /** remove a obstacle from navmesh. */
@@ -96,18 +127,101 @@ public:
     */
     void findPath(const Vec3& start, const Vec3& end, std::vector<Vec3>& pathPoints);
 
+    /**
+    find a path on navmesh asynchronously, the search is sliced with DetourPathQueue and runs on
+    JobSystem workers during update, the callback is invoked on the main thread in request order.
+
+    @param start The start search position in world coordinate system.
+    @param end The end search position in world coordinate system.
+    @param callback The callback invoked when the search finished.
+    @return The request id, 0 if the request can't be queued.
+    */
+    unsigned int findPathAsync(const Vec3& start, const Vec3& end, const PathCallback& callback);
+
+    /** cancel a pending async path request, the callback won't be invoked. */
+    void cancelPathRequest(unsigned int requestId);
+
+    /** get the count of async path requests that not finished yet. */
+    int getPendingPathRequestCount() const;
+
+    /** set the time budget of async path searching per frame in seconds, default is 0.002. */
+    void setPathQueryBudget(float seconds) { _pathQueryBudget = seconds; }
+    float getPathQueryBudget() const { return _pathQueryBudget; }
+
+    /** set the max count of path search lanes running in parallel, default is 4, 1 means no worker used. */
+    void setMaxPathQueryLanes(int lanes);
+    int getMaxPathQueryLanes() const { return _maxPathQueryLanes; }
+
+    /**
+    set the max count of agent move requests submitted to crowd per frame, the others are deferred to
+    next frames, so lots of agents replanning at once don't spike one frame. 0 means unlimited.
+    */
+    void setMaxAgentMoveRequestsPerFrame(int count) { _maxAgentMoveRequestsPerFrame = count; }
+    int getMaxAgentMoveRequestsPerFrame() const { return _maxAgentMoveRequestsPerFrame; }
+
+    /** Check whether tile streaming enabled. */
+    bool isTileStreamingEnabled() const { return _isTileStreamingEnabled; }
+
+    /**
+    set the streaming radius, the tiles within loadRadius of any anchor are loaded, and the tiles
+    beyond unloadRadius of all anchors are unloaded.
+    */
+    void setStreamingRadius(float loadRadius, float unloadRadius);
+
+    /** add a node(e.g. camera or player) whose world position drives tile streaming. */
+    void addStreamingAnchor(Node* anchor);
+
+    /** remove a streaming anchor. */
+    void removeStreamingAnchor(Node* anchor);
+
+    /** set whether the agents positions drive tile streaming too, default is true. */
+    void setStreamAroundAgents(bool enabled) { _streamAroundAgents = enabled; }
+    bool isStreamAroundAgents() const { return _streamAroundAgents; }
+
+    /** get the count of tiles resident in memory. */
+    int getLoadedTileCount() const;
+
+    /** get the count of tiles in tile cache file. */
+    int getTotalTileCount() const;
+
+    /** get the time cost of last update in seconds, for profiling. */
+    float getLastUpdateTime() const { return _lastUpdateTime; }
+
     NavMesh();
     virtual ~NavMesh();
 
 protected:
-    bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath);
+    struct PathRequest;
+    struct PathQueryLane;
+    struct StreamTile;
+    struct LoadedTile;
+    struct TileLoadQueue;
+
+    bool initWithFilePath(std::string_view navFilePath, std::string_view geomFilePath, int maxAgents = 128);
     bool read();
     bool loadNavMeshFile();
+    bool loadNavMeshTileIndex();
+    bool initNavMeshObjects(const dtNavMeshParams& meshParams, const dtTileCacheParams& cacheParams);
+    void updateTileStreaming();
+    void launchTileBuild();
+    void commitBuiltTiles();
+    void applyPendingObstacleChanges();
+    bool isTileBuilding() const { return _tileBuildJob.valid(); }
     bool loadGeomFile();
     void dtDraw();
     void drawAgents();
     void drawObstacles();
     void drawOffMeshConnections();
+    void updatePathRequests();
+    static void buildSmoothPath(dtNavMesh* navMesh,
+                                dtNavMeshQuery* query,
+                                const dtQueryFilter* filter,
+                                const Vec3& start,
+                                const Vec3& end,
+                                dtPolyRef startRef,
+                                dtPolyRef* polys,
+                                int npolys,
+                                std::vector<Vec3>& pathPoints);
 
 protected:
     dtNavMesh* _navMesh;
@@ -125,6 +239,32 @@ protected:
     std::string _navFilePath;
     std::string _geomFilePath;
     bool _isDebugDrawEnabled;
+
+    int _maxAgents;
+    dtQueryFilter _pathQueryFilter;
+    std::vector<std::shared_ptr<PathRequest>> _pathRequests;
+    std::vector<std::unique_ptr<PathQueryLane>> _pathQueryLanes;
+    unsigned int _nextPathRequestId;
+    float _pathQueryBudget;
+    int _maxPathQueryLanes;
+    int _maxAgentMoveRequestsPerFrame;
+    float _lastUpdateTime;
+
+    bool _isTileStreamingEnabled;
+    bool _streamAroundAgents;
+    bool _tileCacheDirty;
+    float _streamLoadRadius;
+    float _streamUnloadRadius;
+    Vector<Node*> _streamAnchors;
+    std::vector<StreamTile> _streamTiles;
+    std::shared_ptr<TileLoadQueue> _tileLoadQueue;
+    dtNavMesh* _stagingNavMesh;
+    std::future<void> _tileBuildJob;
+    std::vector<dtCompressedTileRef> _tilesToBuild;
+    std::vector<dtCompressedTileRef> _buildingTiles;
+    std::vector<unsigned int> _obstacleSnapshot;
+    /// Obstacles added (true) or removed (false) while tiles were building, each holds a reference.
+    std::vector<std::pair<NavMeshObstacle*, bool>> _pendingObstacleChanges;
 };
 
 /** @} */
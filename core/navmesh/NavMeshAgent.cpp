@@ -316,7 +316,7 @@ void NavMeshAgent::pause()
     _needUpdateAgent = true;
 }
 
-void NavMeshAgent::preUpdate(float delta)
+bool NavMeshAgent::preUpdate(float delta, bool allowMoveRequest)
 {
     if (_state != DT_CROWDAGENT_STATE_INVALID)
         _totalTimeAfterMove += delta;
@@ -326,10 +326,10 @@ void NavMeshAgent::preUpdate(float delta)
     if ((_syncFlag & NODE_TO_AGENT) != 0)
         syncToAgent();
 
-    if (_needMove && _crowd && _navMeshQuery)
+    if (_needMove && allowMoveRequest && _crowd && _navMeshQuery)
     {
         if (_state == DT_CROWDAGENT_STATE_OFFMESH)
-            return;
+            return false;
         _state              = DT_CROWDAGENT_STATE_WALKING;
         _totalTimeAfterMove = 0.0f;
         dtPolyRef pRef      = 0;
@@ -338,7 +338,9 @@ void NavMeshAgent::preUpdate(float delta)
                                        nearestPos);
         _crowd->requestMoveTarget(_agentID, pRef, nearestPos);
         _needMove = false;
+        return true;
     }
+    return false;
 }
 
 void NavMeshAgent::postUpdate(float /*delta*/)
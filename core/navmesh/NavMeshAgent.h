@@ -207,7 +207,7 @@ private:
     void addTo(dtCrowd* crowed);
     void removeFrom(dtCrowd* crowed);
     void setNavMeshQuery(dtNavMeshQuery* query);
-    void preUpdate(float delta);
+    bool preUpdate(float delta, bool allowMoveRequest = true);
     void postUpdate(float delta);
     static void convertTodtAgentParam(const NavMeshAgentParam& inParam, dtCrowdAgentParams& outParam);
 
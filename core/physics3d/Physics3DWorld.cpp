@@ -26,22 +26,101 @@
 
 #include "physics3d/Physics3D.h"
 #include "renderer/Renderer.h"
+#include "base/Director.h"
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 
+#        include <chrono>
+#        if BT_THREADSAFE
+#            include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#            include "bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#            include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+
+// defined in btThreads.cpp, tell bullet that workers are running to detect nested parallel loops
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+#        endif
+
 NS_AX_BEGIN
 
+#        if BT_THREADSAFE
+/**
+ * The bullet task scheduler adapter, dispatches bullet parallel loops to the JobSystem workers,
+ * the calling thread participates the loops too.
+ */
+class Physics3DTaskScheduler : public btITaskScheduler
+{
+public:
+    static Physics3DTaskScheduler* getInstance()
+    {
+        static Physics3DTaskScheduler s_instance;
+        return &s_instance;
+    }
+
+    Physics3DTaskScheduler() : btITaskScheduler("axmol") {}
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return getJobSystem()->getThreadCount() + 1; }
+    // the thread count is determined by JobSystem
+    void setNumThreads(int /*numThreads*/) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        const int grain = (std::max)(grainSize, 1);
+        const int count = iEnd - iBegin;
+        if (count <= 0)
+            return;
+
+        btPushThreadsAreRunning();
+        getJobSystem()->parallelFor((count + grain - 1) / grain, [&](size_t chunk) {
+            const int first = iBegin + static_cast<int>(chunk) * grain;
+            body.forLoop(first, (std::min)(first + grain, iEnd));
+        });
+        btPopThreadsAreRunning();
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        const int grain = (std::max)(grainSize, 1);
+        const int count = iEnd - iBegin;
+        if (count <= 0)
+            return btScalar(0);
+
+        std::vector<btScalar> sums((count + grain - 1) / grain);
+        btPushThreadsAreRunning();
+        getJobSystem()->parallelFor(sums.size(), [&](size_t chunk) {
+            const int first = iBegin + static_cast<int>(chunk) * grain;
+            sums[chunk]     = body.sumLoop(first, (std::min)(first + grain, iEnd));
+        });
+        btPopThreadsAreRunning();
+
+        btScalar sum = btScalar(0);
+        for (auto value : sums)
+            sum += value;
+        return sum;
+    }
+
+private:
+    // the scheduler outlives the Director, which recreates its JobSystem, so it's looked up on every use
+    static JobSystem* getJobSystem() { return Director::getInstance()->getJobSystem(); }
+};
+#        endif
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _isMultiThreaded(false)
+    , _maxSubSteps(3)
+    , _lastSimulateTime(0.0f)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
     , _broadphase(nullptr)
     , _solver(nullptr)
+    , _solverPool(nullptr)
     , _ghostCallback(nullptr)
     , _debugDrawer(nullptr)
 {}
@@ -54,8 +133,12 @@ Physics3DWorld::~Physics3DWorld()
     AX_SAFE_DELETE(_dispatcher);
     AX_SAFE_DELETE(_broadphase);
     AX_SAFE_DELETE(_ghostCallback);
-    AX_SAFE_DELETE(_solver);
     AX_SAFE_DELETE(_btPhyiscsWorld);
+    AX_SAFE_DELETE(_solver);
+#        if BT_THREADSAFE
+    // btConstraintSolverPoolMt is only complete when bullet is thread safe, it's never created otherwise
+    AX_SAFE_DELETE(_solverPool);
+#        endif
     AX_SAFE_DELETE(_debugDrawer);
     for (auto&& it : _physicsComponents)
         it->setPhysics3DObject(nullptr);
@@ -82,25 +165,56 @@ Vec3 Physics3DWorld::getGravity() const
 
 bool Physics3DWorld::init(Physics3DWorldDes* info)
 {
+    _maxSubSteps = info->maxSubSteps;
+
     /// collision configuration contains default setup for memory, collision setup
     _collisionConfiguration = new btDefaultCollisionConfiguration();
     //_collisionConfiguration->setConvexConvexMultipointIterations();
 
-    /// use the default collision dispatcher. For parallel processing you can use a different dispatcher (see
-    /// Extras/BulletMultiThreaded)
-    _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
-
     _broadphase = new btDbvtBroadphase();
 
-    /// the default constraint solver. For parallel processing you can use a different solver (see
-    /// Extras/BulletMultiThreaded)
-    btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
-    _solver                                  = sol;
-
     btGhostPairCallback* ghostCallback = new btGhostPairCallback();
     _ghostCallback                     = ghostCallback;
 
-    _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    if (info->isMultiThreaded)
+    {
+#        if BT_THREADSAFE
+        auto scheduler = Physics3DTaskScheduler::getInstance();
+        if (scheduler->getNumThreads() > 1 && scheduler->getNumThreads() <= BT_MAX_THREAD_COUNT)
+        {
+            // the task scheduler must be set before creating any Mt objects
+            if (btGetTaskScheduler() != scheduler)
+                btSetTaskScheduler(scheduler);
+
+            _dispatcher = new btCollisionDispatcherMt(_collisionConfiguration, 40);
+
+            const int poolSize = info->solverPoolSize > 0 ? info->solverPoolSize : scheduler->getNumThreads();
+            _solverPool        = new btConstraintSolverPoolMt(poolSize);
+            _solver            = new btSequentialImpulseConstraintSolverMt();
+
+            _btPhyiscsWorld =
+                new btDiscreteDynamicsWorldMt(_dispatcher, _broadphase, _solverPool, _solver, _collisionConfiguration);
+            _isMultiThreaded = true;
+        }
+        else
+            AXLOGW("Physics3DWorld: JobSystem has no suitable workers, fallback to single threaded world");
+#        else
+        AXLOGW("Physics3DWorld: bullet isn't built with BT_THREADSAFE, enable AX_ENABLE_3D_PHYSICS_MT to use multithreaded world");
+#        endif
+    }
+
+    if (!_btPhyiscsWorld)
+    {
+        /// use the default collision dispatcher.
+        _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+
+        /// the default constraint solver.
+        btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
+        _solver                                  = sol;
+
+        _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    }
+
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(info->gravity));
     if (info->isDebugDrawEnabled)
     {
@@ -265,7 +379,10 @@ void Physics3DWorld::stepSimulate(float dt)
         {
             it->preSimulate();
         }
-        _btPhyiscsWorld->stepSimulation(dt, 3);
+        auto startTime = std::chrono::steady_clock::now();
+        _btPhyiscsWorld->stepSimulation(dt, _maxSubSteps);
+        _lastSimulateTime =
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
         // sync dynamic node after simulation
         for (auto&& it : _physicsComponents)
         {
@@ -40,6 +40,7 @@ class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 struct btDbvtBroadphase;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btGhostPairCallback;
 class btRigidBody;
 class btCollisionObject;
@@ -64,10 +65,16 @@ struct AX_DLL Physics3DWorldDes
 {
     bool isDebugDrawEnabled;  // using physics debug draw?, false by default
     ax::Vec3 gravity;    // gravity, (0, -9.8, 0)
+    bool isMultiThreaded;  // using bullet multithreaded world driven by JobSystem?, requires AX_ENABLE_3D_PHYSICS_MT, false by default
+    int solverPoolSize;    // the solver count of multithreaded world, 0 means JobSystem thread count + 1
+    int maxSubSteps;       // max sub steps per simulation, 3 by default
     Physics3DWorldDes()
     {
         isDebugDrawEnabled = false;
         gravity            = ax::Vec3(0.f, -9.8f, 0.f);
+        isMultiThreaded    = false;
+        solverPoolSize     = 0;
+        maxSubSteps        = 3;
     }
 };
 
@@ -130,6 +137,12 @@ public:
     /** Internal method, the updater of debug drawing, need called each frame. */
     void debugDraw(ax::Renderer* renderer);
 
+    /** Check whether the world is simulated by bullet multithreaded world. */
+    bool isMultiThreaded() const { return _isMultiThreaded; }
+
+    /** Get the time cost of last simulation in seconds, for profiling. */
+    float getLastSimulateTime() const { return _lastSimulateTime; }
+
     /** Get the list of Physics3DObjects. */
     const std::vector<Physics3DObject*>& getPhysicsObjects() const { return _objects; }
 
@@ -167,6 +180,9 @@ protected:
     bool _needCollisionChecking;
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
+    bool _isMultiThreaded;
+    int _maxSubSteps;
+    float _lastSimulateTime;
 
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     btDynamicsWorld* _btPhyiscsWorld;
@@ -174,6 +190,7 @@ protected:
     btCollisionDispatcher* _dispatcher;
     btDbvtBroadphase* _broadphase;
     btSequentialImpulseConstraintSolver* _solver;
+    btConstraintSolverPoolMt* _solverPool;
     btGhostPairCallback* _ghostCallback;
     Physics3DDebugDrawer* _debugDrawer;
 #        endif  // AX_ENABLE_BULLET_INTEGRATION
@@ -36,6 +36,9 @@ THE SOFTWARE.
 #include "base/Director.h"
 #include "platform/SAXParser.h"
 #include "platform/FileStream.h"
+#include "base/ValueBinary.h"
+#include "mio/mio.hpp"
+#include "xxhash/xxhash.h"
 
 #ifdef MINIZIP_FROM_SYSTEM
 #    include <minizip/unzip.h>
@@ -136,6 +139,18 @@ public:
         return _rootDict;
     }
 
+    ValueMap dictionaryWithIntrusiveData(char* filedata, size_t filesize)
+    {
+        _resultType = SAX_RESULT_DICT;
+        SAXParser parser;
+
+        AXASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
+        parser.setDelegator(this);
+
+        parser.parseIntrusive(filedata, filesize);
+        return _rootDict;
+    }
+
     ValueVector arrayWithContentsOfFile(std::string_view fileName)
     {
         _resultType = SAX_RESULT_ARRAY;
@@ -341,11 +356,111 @@ public:
     }
 };
 
+// The cache of getValueMapFromFile, one file per source file: a header which identifies the content of
+// the source file, followed by the ValueBinary encoding of the parsed ValueMap.
+static constexpr uint32_t VALUE_MAP_CACHE_MAGIC   = 0x4d565841;  // "AXVM"
+static constexpr uint32_t VALUE_MAP_CACHE_VERSION = 1;
+
+struct ValueMapCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+    uint64_t payloadSize;
+};
+
+static std::string getValueMapCachePath(const FileUtils* fileUtils, std::string_view fullPath)
+{
+    return fmt::format("{}valuemap-cache/{:016x}.bin", fileUtils->getNativeWritableAbsolutePath(),
+                       XXH3_64bits(fullPath.data(), fullPath.size()));
+}
+
+static bool loadValueMapCache(std::string_view cachePath, const ValueMapCacheHeader& expected, ValueMap& dict)
+{
+    FileStream stream;
+    if (!stream.open(cachePath, IFileStream::Mode::READ))
+        return false;
+
+    const auto fileSize = stream.size();
+    if (fileSize < static_cast<int64_t>(sizeof(ValueMapCacheHeader)))
+        return false;
+
+    std::error_code error;
+    mio::mmap_source mapping;
+    mapping.map(stream.nativeHandle(), 0, mio::map_entire_file, error);
+    if (error)
+        return false;
+
+    ValueMapCacheHeader header;
+    memcpy(&header, mapping.data(), sizeof(header));
+    if (header.magic != expected.magic || header.version != expected.version ||
+        header.sourceSize != expected.sourceSize || header.sourceHash != expected.sourceHash ||
+        header.payloadSize != mapping.size() - sizeof(header))
+        return false;
+
+    std::string_view payload{mapping.data() + sizeof(header), mapping.size() - sizeof(header)};
+    return ValueBinary::decode(payload, dict) && payload.empty();
+}
+
+static void saveValueMapCache(const FileUtils* fileUtils,
+                              std::string_view cachePath,
+                              ValueMapCacheHeader header,
+                              const ValueMap& dict)
+{
+    std::string buffer(sizeof(header), '\0');
+    ValueBinary::encode(dict, buffer);
+    header.payloadSize = buffer.size() - sizeof(header);
+    memcpy(buffer.data(), &header, sizeof(header));
+
+    auto dirPath = cachePath.substr(0, cachePath.find_last_of('/') + 1);
+    if (!fileUtils->isDirectoryExist(dirPath) && !fileUtils->createDirectory(dirPath))
+        return;
+
+    // Truncating the cache in place would break a concurrent load which has it mapped, write a new file and rename it
+    // over the old one instead. A failed or racing write leaves a payload size or content which doesn't match, the
+    // next load discards it.
+    std::string tmpPath{cachePath};
+    tmpPath += ".tmp"sv;
+    if (!FileUtils::writeBinaryToFile(buffer.data(), buffer.size(), tmpPath) ||
+        !fileUtils->renameFile(tmpPath, cachePath))
+        fileUtils->removeFile(tmpPath);
+}
+
 ValueMap FileUtils::getValueMapFromFile(std::string_view filename) const
 {
     const std::string fullPath = fullPathForFilename(filename);
+    if (!_valueMapCacheEnabled)
+    {
+        DictMaker tMaker;
+        return tMaker.dictionaryWithContentsOfFile(fullPath);
+    }
+
+    Data data = getDataFromFile(fullPath);
+    if (data.isNull())
+        return ValueMap();
+
+    // The cache is validated by the content of the file, so it stays correct when a hot update replaces it.
+    ValueMapCacheHeader header{VALUE_MAP_CACHE_MAGIC, VALUE_MAP_CACHE_VERSION, static_cast<uint64_t>(data.getSize()),
+                               XXH3_64bits(data.getBytes(), data.getSize()), 0};
+    const auto cachePath = getValueMapCachePath(this, fullPath);
+
+    ValueMap dict;
+    if (loadValueMapCache(cachePath, header, dict))
+        return dict;
+
     DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath);
+    dict = tMaker.dictionaryWithIntrusiveData(reinterpret_cast<char*>(data.getBytes()), data.getSize());
+    if (!dict.empty())
+        saveValueMapCache(this, cachePath, header, dict);
+    return dict;
+}
+
+void FileUtils::getValueMapFromFile(std::string_view filename, std::function<void(ValueMap)> callback) const
+{
+    performOperationOffthread(
+        [path = std::string{filename}]() { return FileUtils::getInstance()->getValueMapFromFile(path); },
+        std::move(callback));
 }
 
 ValueMap FileUtils::getValueMapFromData(const char* filedata, int filesize) const
@@ -409,6 +409,26 @@ public:
      */
     virtual ValueMap getValueMapFromFile(std::string_view filename) const;
 
+    /**
+     *  Converts the contents of a file to a ValueMap, done async off the main cocos thread.
+     *
+     *  @param filename The filename of the file to gets content.
+     *  @param callback The function that will be called with the ValueMap of the file contents. This function
+     *  will be executed on the main cocos thread.
+     */
+    virtual void getValueMapFromFile(std::string_view filename, std::function<void(ValueMap)> callback) const;
+
+    /**
+     *  Sets whether getValueMapFromFile caches the parsed files in the writable path.
+     *
+     *  The cache holds a binary encoding of the ValueMap, it's used as long as the content of the file
+     *  doesn't change and saves the xml parsing on later loads. It's enabled by default.
+     */
+    void setValueMapCacheEnabled(bool enabled) { _valueMapCacheEnabled = enabled; }
+
+    /** Checks whether getValueMapFromFile caches the parsed files in the writable path. */
+    bool isValueMapCacheEnabled() const { return _valueMapCacheEnabled; }
+
     /** Converts the contents of a file to a ValueMap.
      *  This method is used internally.
      */
@@ -869,6 +889,11 @@ protected:
      */
     std::string _writablePath;
 
+    /**
+     * Whether getValueMapFromFile caches the parsed files in the writable path.
+     */
+    bool _valueMapCacheEnabled = true;
+
 #if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32 || AX_TARGET_PLATFORM == AX_PLATFORM_LINUX
     /*
      * The dir of executable file, only present targets: win32, linux
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "renderer/backend/PixelFormatUtils.h"
 
 #include <string>
+#include <atomic>
+#include <thread>
 #include <ctype.h>
 
 #include "base/axstd.h"
@@ -126,6 +128,14 @@ struct dirent* readdir$INODE64(DIR* dir)
 #include "base/Configuration.h"
 #include "base/Utils.h"
 #include "base/ZipUtils.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "xxhash.h"
+#include "base/filesystem.h"
+
+#if defined(_WIN32)
+#    include "ntcvt/ntcvt.hpp"
+#endif
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID)
 #    include "platform/android/FileUtils-android.h"
 #    include "platform/GL.h"
@@ -558,10 +568,189 @@ bool Image::isCompressedImageHavePMA(uint32_t target)
     return target & COMPRESSED_IMAGE_PMA_FLAGS;
 }
 
+bool Image::DECODED_CACHE_ENABLED = false;
+size_t Image::DECODED_CACHE_LIMIT = 64 * 1024 * 1024;
+
+namespace
+{
+// rows of ETC blocks decoded by one job, smaller images are decoded on the calling thread
+constexpr uint32_t ETC_STRIP_BLOCK_ROWS = 16;
+}  // namespace
+
+int Image::decodeETC2(int format, const uint8_t* input, uint8_t* output, uint32_t width, uint32_t height)
+{
+    const size_t blockBytes    = format == ETC2_RGBA_NO_MIPMAPS ? 16 : 8;
+    const size_t inputRowPitch = ((width + 3) / 4) * blockBytes;
+    const uint32_t blockRows   = (height + 3) / 4;
+    const uint32_t strips      = (blockRows + ETC_STRIP_BLOCK_ROWS - 1) / ETC_STRIP_BLOCK_ROWS;
+
+    auto jobSystem = strips > 1 ? Director::getInstance()->getJobSystem() : nullptr;
+    if (!jobSystem)
+        return etc2_decode_image(format, input, output, width, height);
+
+    // every strip is a band of whole block rows, so they decode independently
+    std::atomic<int> result{0};
+    jobSystem->parallelFor(strips, [&](size_t strip) {
+        const auto firstBlockRow = static_cast<uint32_t>(strip) * ETC_STRIP_BLOCK_ROWS;
+        const auto y             = firstBlockRow * 4;
+        const auto stripHeight   = (std::min)(height - y, ETC_STRIP_BLOCK_ROWS * 4);
+        if (etc2_decode_image(format, input + firstBlockRow * inputRowPitch, output + size_t(y) * width * 4, width,
+                              stripHeight) != 0)
+            result = -1;
+    });
+    return result;
+}
+
+namespace
+{
+struct DecodedCacheHeader
+{
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t reserved;
+    uint64_t sourceHash;
+};
+constexpr uint32_t DECODED_CACHE_MAGIC = 0x31544441;  // "ADT1"
+
+#if defined(_WIN32)
+inline stdfs::path toFspath(std::string_view pathSV)
+{
+    return stdfs::path{ntcvt::from_chars(pathSV)};
+}
+#else
+inline stdfs::path toFspath(std::string_view pathSV)
+{
+    return stdfs::path{pathSV};
+}
+#endif
+
+std::string getDecodedCacheDir()
+{
+    return fmt::format("{}decoded-textures/", FileUtils::getInstance()->getWritablePath());
+}
+
+std::string getDecodedCachePath(uint64_t sourceHash)
+{
+    return fmt::format("{}{:016x}.rgba", getDecodedCacheDir(), sourceHash);
+}
+
+// removes the least recently used textures until the cache fits in limit
+void trimDecodedCache(std::string_view dir, uint64_t limit)
+{
+    struct CacheFile
+    {
+        stdfs::path path;
+        stdfs::file_time_type lastUsed;
+        uint64_t size;
+    };
+    std::vector<CacheFile> files;
+    uint64_t total = 0;
+
+    // other loading threads may write or trim at the same time, so errors only skip the file
+    std::error_code ec;
+    for (const auto& entry : stdfs::directory_iterator(toFspath(dir), ec))
+    {
+        if (!entry.is_regular_file(ec) || entry.path().extension() != ".rgba")
+            continue;
+        auto lastUsed = entry.last_write_time(ec);
+        auto size     = entry.file_size(ec);
+        if (ec)
+            continue;
+        files.emplace_back(CacheFile{entry.path(), lastUsed, size});
+        total += size;
+    }
+    if (total <= limit)
+        return;
+
+    std::sort(files.begin(), files.end(),
+              [](const CacheFile& lhs, const CacheFile& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+    for (auto& file : files)
+    {
+        if (total <= limit)
+            break;
+        if (stdfs::remove(file.path, ec))
+            total -= file.size;
+    }
+}
+}  // namespace
+
+void Image::purgeDecodedCache()
+{
+    FileUtils::getInstance()->removeDirectory(getDecodedCacheDir());
+}
+
+bool Image::decodeToRGBA8(const uint8_t* pixels, size_t size, const std::function<int(uint8_t*)>& decoder)
+{
+    _dataLen = _width * _height * 4;
+    _data    = static_cast<uint8_t*>(malloc(_dataLen));
+
+    uint64_t sourceHash = 0;
+    std::string cachePath;
+    if (DECODED_CACHE_ENABLED)
+    {
+        // the dimensions are part of the key since some formats have no per-pixel header
+        sourceHash = XXH64(pixels, size, (static_cast<uint64_t>(_width) << 32) | static_cast<uint32_t>(_height));
+        cachePath  = getDecodedCachePath(sourceHash);
+
+        bool hit = false;
+        if (auto stream = FileUtils::getInstance()->openFileStream(cachePath, IFileStream::Mode::READ))
+        {
+            DecodedCacheHeader header{};
+            hit = stream->read(&header, sizeof(header)) == sizeof(header) && header.magic == DECODED_CACHE_MAGIC &&
+                  header.sourceHash == sourceHash && header.width == static_cast<uint32_t>(_width) &&
+                  header.height == static_cast<uint32_t>(_height) &&
+                  stream->read(_data, static_cast<unsigned int>(_dataLen)) == _dataLen;
+        }
+        if (hit)
+        {
+            // the modification time orders the textures for trimDecodedCache
+            std::error_code ec;
+            stdfs::last_write_time(toFspath(cachePath), stdfs::file_time_type::clock::now(), ec);
+
+            _pixelFormat = backend::PixelFormat::RGBA8;
+            return true;
+        }
+    }
+
+    if (UTILS_UNLIKELY(decoder(_data) != 0))
+    {
+        // software decode fail, release pixels data
+        AX_SAFE_FREE(_data);
+        _dataLen = 0;
+        return false;
+    }
+    _pixelFormat = backend::PixelFormat::RGBA8;
+
+    if (!cachePath.empty())
+    {
+        // written off the loading thread, a temporary file keeps concurrent writers from exposing partial files
+        DecodedCacheHeader header{DECODED_CACHE_MAGIC, static_cast<uint32_t>(_width), static_cast<uint32_t>(_height),
+                                  0, sourceHash};
+        std::vector<uint8_t> content(sizeof(header) + _dataLen);
+        memcpy(content.data(), &header, sizeof(header));
+        memcpy(content.data() + sizeof(header), _data, _dataLen);
+        Director::getInstance()->getJobSystem()->enqueue(
+            [content = std::move(content), cachePath = std::move(cachePath), limit = DECODED_CACHE_LIMIT]() {
+            auto fileUtils = FileUtils::getInstance();
+            auto dir       = cachePath.substr(0, cachePath.find_last_of('/') + 1);
+            if (!fileUtils->isDirectoryExist(dir))
+                fileUtils->createDirectory(dir);
+
+            auto tempPath = fmt::format("{}.{}", cachePath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            if (FileUtils::writeBinaryToFile(content.data(), content.size(), tempPath) &&
+                fileUtils->renameFile(tempPath, cachePath))
+                trimDecodedCache(dir, limit);
+        });
+    }
+    return true;
+}
+
 Image::Image()
     : _data(nullptr)
     , _dataLen(0)
     , _offset(0)
+    , _fileBacked(false)
     , _width(0)
     , _height(0)
     , _unpack(false)
@@ -712,6 +901,8 @@ bool Image::initWithImageData(uint8_t* data, ssize_t dataLen, bool ownData)
         if (_data != unpackedData && ownData)
             free(unpackedData);
         // else, the hardware texture decoder used, the compressed data was stored directly
+
+        _fileBacked = ret && _data == data && _offset > 0;
     } while (0);
 
     return ret;
@@ -1845,20 +2036,12 @@ bool Image::initWithETCData(uint8_t* data, ssize_t dataLen, bool ownData)
     {
         AXLOGW("Hardware ETC1 decoder not present. Using software decoder");
 
-        _dataLen = _width * _height * 4;
-        _data    = static_cast<uint8_t*>(malloc(_dataLen));
-        if (etc2_decode_image(ETC2_RGB_NO_MIPMAPS, static_cast<const uint8_t*>(data) + pixelOffset,
-                              static_cast<etc2_byte*>(_data), _width, _height) == 0)
-        {  // if it is not gles or device do not support ETC1, decode texture by software
-           // directly decode ETC1_RGB to RGBA8888
-            _pixelFormat = backend::PixelFormat::RGBA8;
-            return true;
-        }
-
-        // software decode fail, release pixels data
-        AX_SAFE_FREE(_data);
-        _dataLen = 0;
-        return false;
+        // if it is not gles or device do not support ETC1, decode texture by software
+        // directly decode ETC1_RGB to RGBA8888
+        auto pixels = static_cast<const uint8_t*>(data) + pixelOffset;
+        return decodeToRGBA8(pixels, dataLen - pixelOffset, [this, pixels](uint8_t* out) {
+            return decodeETC2(ETC2_RGB_NO_MIPMAPS, pixels, out, _width, _height);
+        });
     }
 }
 
@@ -1912,17 +2095,11 @@ bool Image::initWithETC2Data(uint8_t* data, ssize_t dataLen, bool ownData)
 
             // if device do not support ETC2, decode texture by software
             // etc2_decode_image always decode to RGBA8888
-            _dataLen = _width * _height * 4;
-            _data    = static_cast<uint8_t*>(malloc(_dataLen));
-            if (UTILS_UNLIKELY(etc2_decode_image(format, static_cast<const uint8_t*>(data) + pixelOffset,
-                                                 static_cast<etc2_byte*>(_data), _width, _height) != 0))
-            {
-                // software decode fail, release pixels data
-                AX_SAFE_FREE(_data);
-                _dataLen = 0;
+            auto pixels = static_cast<const uint8_t*>(data) + pixelOffset;
+            if (!decodeToRGBA8(pixels, dataLen - pixelOffset, [this, pixels, format](uint8_t* out) {
+                    return decodeETC2(format, pixels, out, _width, _height);
+                }))
                 break;
-            }
-            _pixelFormat = backend::PixelFormat::RGBA8;
         }
 
         _hasPremultipliedAlpha = isCompressedImageHavePMA(CompressedImagePMAFlag::ETC2);
@@ -1997,18 +2174,13 @@ bool Image::initWithASTCData(uint8_t* data, ssize_t dataLen, bool ownData)
         {
             AXLOGW("Hardware ASTC decoder not present. Using software decoder");
 
-            _dataLen = _width * _height * 4;
-            _data    = static_cast<uint8_t*>(malloc(_dataLen));
-            if (UTILS_UNLIKELY(astc_decompress_image(static_cast<const uint8_t*>(data) + ASTC_HEAD_SIZE,
-                                                     static_cast<uint32_t>(dataLen) - ASTC_HEAD_SIZE, _data, _width,
-                                                     _height, block_x, block_y) != 0))
-            {
-                AX_SAFE_FREE(_data);
-                _dataLen = 0;
+            // astc_decompress_image decodes the blocks on its own worker threads
+            auto pixels    = static_cast<const uint8_t*>(data) + ASTC_HEAD_SIZE;
+            auto pixelsLen = static_cast<uint32_t>(dataLen) - ASTC_HEAD_SIZE;
+            if (!decodeToRGBA8(pixels, pixelsLen, [this, pixels, pixelsLen, block_x, block_y](uint8_t* out) {
+                    return astc_decompress_image(pixels, pixelsLen, out, _width, _height, block_x, block_y);
+                }))
                 break;
-            }
-
-            _pixelFormat = backend::PixelFormat::RGBA8;
         }
 
         _hasPremultipliedAlpha = isCompressedImageHavePMA(CompressedImagePMAFlag::ASTC);
@@ -2305,6 +2477,17 @@ void Image::forwardPixels(uint8_t* data, ssize_t dataLen, int offset, bool ownDa
     }
 }
 
+ssize_t Image::getMipmapFileOffset(int level) const
+{
+    if (!_fileBacked || _filePath.empty() || level < 0 || level >= _numberOfMipmaps)
+        return -1;
+
+    auto& mipmap = _mipmaps[level];
+    if (mipmap.address < _data || mipmap.address + mipmap.len > _data + _dataLen)
+        return -1;
+    return mipmap.address - _data;
+}
+
 #if (AX_TARGET_PLATFORM != AX_PLATFORM_IOS)
 bool Image::saveToFile(std::string_view filename, bool isToRGB)
 {
@@ -32,6 +32,8 @@ THE SOFTWARE.
 #include "renderer/Texture2D.h"
 #include "base/Data.h"
 
+#include <functional>
+
 #if AX_TARGET_PLATFORM == AX_PLATFORM_WINRT
 #    define AX_USE_WIC 1
 #else
@@ -67,6 +69,7 @@ class AX_DLL Image : public Object
 {
 public:
     friend class TextureCache;
+    friend class DynamicAtlas;
     /**
      * @js ctor
      */
@@ -139,6 +142,29 @@ public:
     static void setCompressedImagesHavePMA(uint32_t targets, bool havePMA);
     static bool isCompressedImageHavePMA(uint32_t target);
 
+    /**
+     * Enables or disables the cache of software decoded ETC/ETC2/ASTC textures.
+     * When the GPU doesn't support the compressed format, the decoded RGBA8 pixels are stored under
+     * `<writable path>/decoded-textures/` keyed by the hash of the compressed data, so the decode
+     * cost is paid only once per device.
+     *
+     *  @param enabled (default: false)
+     */
+    static void setDecodedCacheEnabled(bool enabled) { DECODED_CACHE_ENABLED = enabled; }
+    static bool isDecodedCacheEnabled() { return DECODED_CACHE_ENABLED; }
+
+    /**
+     * Sets the size in bytes the decoded cache may take on disk, the least recently used
+     * textures are removed once a new one makes the cache exceed it.
+     *
+     *  @param limit (default: 64MB)
+     */
+    static void setDecodedCacheLimit(size_t limit) { DECODED_CACHE_LIMIT = limit; }
+    static size_t getDecodedCacheLimit() { return DECODED_CACHE_LIMIT; }
+
+    /** Removes every texture stored by the decoded cache. */
+    static void purgeDecodedCache();
+
     /**
     @brief Load the image from the specified path.
     @param path   the absolute file path.
@@ -178,6 +204,13 @@ public:
     bool hasPremultipliedAlpha() { return _hasPremultipliedAlpha; }
     std::string getFilePath() const { return _filePath; }
 
+    /**
+     @brief Gets where a mipmap is stored in the image file, to read it again without loading the whole file.
+     @return The offset in the file, or -1 if the mipmap isn't stored as is in the file, e.g. it was decoded by
+     software or the file is compressed.
+     */
+    ssize_t getMipmapFileOffset(int level) const;
+
     int getBitPerPixel();
     bool hasAlpha();
     bool isCompressed();
@@ -211,6 +244,10 @@ protected:
     bool initWithETCData(uint8_t* data, ssize_t dataLen, bool ownData);
     bool initWithETC2Data(uint8_t* data, ssize_t dataLen, bool ownData);
     bool initWithASTCData(uint8_t* data, ssize_t dataLen, bool ownData);
+    // Software decode compressed pixels to RGBA8 with decoder, reusing the decoded cache when enabled.
+    bool decodeToRGBA8(const uint8_t* pixels, size_t size, const std::function<int(uint8_t*)>& decoder);
+    // Software decode ETC2 to RGBA8, split in strips of block rows over the job system for tall images.
+    static int decodeETC2(int format, const uint8_t* input, uint8_t* output, uint32_t width, uint32_t height);
     bool initWithS3TCData(uint8_t* data, ssize_t dataLen, bool ownData);
     bool initWithATITCData(uint8_t* data, ssize_t dataLen, bool ownData);
 
@@ -231,10 +268,13 @@ protected:
      */
     static bool PNG_PREMULTIPLIED_ALPHA_ENABLED;
     static uint32_t COMPRESSED_IMAGE_PMA_FLAGS;
+    static bool DECODED_CACHE_ENABLED;
+    static size_t DECODED_CACHE_LIMIT;
 
     uint8_t* _data;
     ssize_t _dataLen;
     ssize_t _offset;  // useful for hardware decoder present to hold data without copy
+    bool _fileBacked;  // whether _data holds the image file as is
     int _width;
     int _height;
     bool _unpack;
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/AtlasPacker.h"
+
+#include <algorithm>
+
+NS_AX_BEGIN
+
+AtlasPacker::AtlasPacker(int width, int height)
+{
+    reset(width, height);
+}
+
+void AtlasPacker::reset(int width, int height)
+{
+    _width    = width;
+    _height   = height;
+    _usedArea = 0;
+    _skyline.clear();
+    if (width > 0)
+        _skyline.push_back(Segment{0, 0, width});
+}
+
+int AtlasPacker::fitAt(size_t index, int width, int height) const
+{
+    if (_skyline[index].x + width > _width)
+        return -1;
+
+    // the rectangle rests on the highest segment below it
+    int y         = 0;
+    int remaining = width;
+    for (; remaining > 0; ++index)
+    {
+        auto& segment = _skyline[index];
+        y             = (std::max)(y, segment.y);
+        if (y + height > _height)
+            return -1;
+        remaining -= segment.width;
+    }
+    return y;
+}
+
+bool AtlasPacker::insert(int width, int height, int& x, int& y)
+{
+    if (width <= 0 || height <= 0)
+        return false;
+
+    // lowest top first, then the narrowest segment to keep wide gaps for wide rectangles
+    size_t best    = _skyline.size();
+    int bestTop    = INT32_MAX;
+    int bestWidth  = INT32_MAX;
+    int bestBottom = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i)
+    {
+        int bottom = fitAt(i, width, height);
+        if (bottom < 0)
+            continue;
+
+        int top = bottom + height;
+        if (top < bestTop || (top == bestTop && _skyline[i].width < bestWidth))
+        {
+            best       = i;
+            bestTop    = top;
+            bestWidth  = _skyline[i].width;
+            bestBottom = bottom;
+        }
+    }
+    if (best == _skyline.size())
+        return false;
+
+    x = _skyline[best].x;
+    y = bestBottom;
+
+    // the rectangle's top becomes a new segment, the segments it covers shrink or go away
+    _skyline.insert(_skyline.begin() + best, Segment{x, bestTop, width});
+    for (size_t i = best + 1; i < _skyline.size();)
+    {
+        auto& previous = _skyline[i - 1];
+        auto& segment  = _skyline[i];
+        int overlap    = previous.x + previous.width - segment.x;
+        if (overlap <= 0)
+            break;
+
+        if (overlap < segment.width)
+        {
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        _skyline.erase(_skyline.begin() + i);
+    }
+
+    // merge neighbours of the same height
+    for (size_t i = 0; i + 1 < _skyline.size();)
+    {
+        if (_skyline[i].y == _skyline[i + 1].y)
+        {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+
+    _usedArea += static_cast<int64_t>(width) * height;
+    return true;
+}
+
+float AtlasPacker::getOccupancy() const
+{
+    return _width > 0 && _height > 0 ? static_cast<float>(static_cast<double>(_usedArea) / _width / _height) : 0.0f;
+}
+
+NS_AX_END
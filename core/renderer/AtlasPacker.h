@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+/**
+ * Packs rectangles into a fixed size page with the skyline bottom-left heuristic.
+ *
+ * The packer keeps the top edge of the packed area as a list of horizontal segments and places each rectangle where
+ * its top ends lowest. Rectangles are never rotated and space is never reclaimed, reset the packer to reuse a page.
+ * It does no locking, an instance must only be used by one thread at a time.
+ */
+class AX_DLL AtlasPacker
+{
+public:
+    AtlasPacker(int width = 0, int height = 0);
+
+    /** Empties the page and changes its size. */
+    void reset(int width, int height);
+
+    /**
+     * Finds room for a rectangle and marks it used.
+     * @param x Receives the left edge of the placed rectangle.
+     * @param y Receives the bottom edge of the placed rectangle.
+     * @return false if the rectangle doesn't fit, x and y are unchanged then.
+     */
+    bool insert(int width, int height, int& x, int& y);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+
+    /** The used area divided by the page area. */
+    float getOccupancy() const;
+
+private:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    /** The bottom of a rectangle placed at the start of segment index, -1 if it doesn't fit there. */
+    int fitAt(size_t index, int width, int height) const;
+
+    std::vector<Segment> _skyline;
+    int _width;
+    int _height;
+    int64_t _usedArea;
+};
+
+// end of renderer group
+/// @}
+
+NS_AX_END
@@ -51,11 +51,15 @@ void CallbackCommand::reset()
     _skipBatching = false;
     _is3D = false;
     _depth = 0.0f;
+    _closure = nullptr;
+    _invoke = nullptr;
 }
 
 void CallbackCommand::execute()
 {
-    if (func)
+    if (_invoke)
+        _invoke(_closure);
+    else if (func)
         func();
 }
 
@@ -26,6 +26,7 @@
 
 #include "renderer/backend/PixelBufferDescriptor.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/FrameArena.h"
 #include "base/RefPtr.h"
 
 /**
@@ -67,8 +68,26 @@ public:
      Execute the render command and call callback functions.
      */
     void execute();
+
+    /**
+     * Set a callback whose closure lives in the frame arena instead of the heap, it is preferred over `func`.
+     * The closure is destroyed when the arena is reset, so the command must be queued in the same frame.
+     * @see Renderer::getFrameArena
+     */
+    template <typename _Fty>
+    void setCallback(FrameArena& arena, _Fty&& callback)
+    {
+        using Closure = std::decay_t<_Fty>;
+        _closure      = arena.construct<Closure>(std::forward<_Fty>(callback));
+        _invoke       = [](void* closure) { (*static_cast<Closure*>(closure))(); };
+    }
+
     /**Callback function.*/
     std::function<void()> func;
+
+protected:
+    void* _closure         = nullptr;
+    void (*_invoke)(void*) = nullptr;
 };
 
 NS_AX_END
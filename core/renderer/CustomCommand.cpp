@@ -26,6 +26,7 @@
 #include "renderer/TextureAtlas.h"
 #include "renderer/backend/Buffer.h"
 #include "renderer/backend/DriverBase.h"
+#include "renderer/backend/ProgramState.h"
 #include "base/Utils.h"
 #include <stddef.h>
 
@@ -134,6 +135,28 @@ void CustomCommand::init(float globalZOrder, const BlendFunc& blendFunc)
     blendDescriptor.destinationRGBBlendFactor = blendDescriptor.destinationAlphaBlendFactor = blendFunc.dst;
 }
 
+void CustomCommand::setBatchTriangles(const TrianglesCommand::Triangles& triangles, backend::TextureBackend* texture)
+{
+    AXASSERT(_primitiveType == PrimitiveType::TRIANGLE, "Only triangle lists can be batched");
+    AXASSERT(triangles.indexCount % 3 == 0, "The index count must be multiple times of 3");
+
+    _batchTriangles = triangles;
+
+    auto programState = _pipelineDescriptor.programState;
+    programState->updateBatchId();
+
+    auto& blendDescriptor = _pipelineDescriptor.blendDescriptor;
+    auto blendFunc        = blendDescriptor.blendEnabled ? BlendFunc{blendDescriptor.sourceRGBBlendFactor,
+                                                                     blendDescriptor.destinationRGBBlendFactor}
+                                                         : BlendFunc::DISABLE;
+    _materialID = TrianglesCommand::computeMaterialID(texture, programState->getBatchId(), blendFunc);
+}
+
+void CustomCommand::resetBatchTriangles()
+{
+    _batchTriangles = TrianglesCommand::Triangles{};
+}
+
 void CustomCommand::createVertexBuffer(std::size_t vertexSize, std::size_t capacity, BufferUsage usage)
 {
     AX_SAFE_RELEASE(_vertexBuffer);
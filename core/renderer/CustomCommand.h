@@ -25,6 +25,7 @@
 #pragma once
 
 #include "renderer/RenderCommand.h"
+#include "renderer/TrianglesCommand.h"
 
 /**
  * @addtogroup renderer
@@ -36,7 +37,8 @@ NS_AX_BEGIN
 namespace backend
 {
 class Buffer;
-}
+class TextureBackend;
+}  // namespace backend
 
 /**
 Custom command is used to draw all things except triangle commands. You can use
@@ -231,6 +233,27 @@ TODO: should remove it.
 
     const CallBackFunc& getAfterCallback() { return _afterCallback; }
 
+    /**
+    Submit the command through the renderer's shared triangle batch instead of its own buffers.
+    The vertices are transformed by the model view matrix passed to `init` on the CPU, so the program state
+    must not apply it again. Consecutive commands and TrianglesCommands with the same material ID
+    (texture, program, uniforms, blend function) are drawn with a single draw call.
+    The data must stay valid until the frame is rendered.
+    @param triangles the vertex and index data, the vertices are in local space.
+    @param texture the texture sampled by the program state, may be nullptr.
+    */
+    void setBatchTriangles(const TrianglesCommand::Triangles& triangles, backend::TextureBackend* texture);
+    /**
+    Go back to drawing with the command's own vertex/index buffers.
+    */
+    void resetBatchTriangles();
+
+    /** Whether the command is submitted through the shared triangle batch. */
+    bool isBatchable() const { return _batchTriangles.verts != nullptr && !_beforeCallback && !_afterCallback; }
+    const TrianglesCommand::Triangles& getBatchTriangles() const { return _batchTriangles; }
+    /** Get the material id of a batchable command. */
+    uint32_t getMaterialID() const { return _materialID; }
+
 protected:
     std::size_t computeIndexSize() const;
 
@@ -257,6 +280,9 @@ protected:
     std::size_t _vertexCapacity = 0;
     std::size_t _indexCapacity  = 0;
 
+    TrianglesCommand::Triangles _batchTriangles;
+    uint32_t _materialID = 0;
+
     CallBackFunc _beforeCallback = nullptr;
     CallBackFunc _afterCallback  = nullptr;
 };
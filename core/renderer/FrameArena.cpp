@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/FrameArena.h"
+#include "base/Macros.h"
+
+NS_AX_BEGIN
+
+FrameArena::FrameArena(std::size_t blockSize) : _blockSize(blockSize) {}
+
+FrameArena::~FrameArena()
+{
+    for (auto destructor = _destructors; destructor; destructor = destructor->next)
+        destructor->destroy(destructor->object);
+    freeBlocks();
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    AXASSERT(alignment && !(alignment & (alignment - 1)), "FrameArena: alignment must be a power of two");
+
+    for (;;)
+    {
+        if (_blockIndex < _blocks.size())
+        {
+            auto& block    = _blocks[_blockIndex];
+            auto address   = reinterpret_cast<uintptr_t>(block.data) + _offset;
+            auto aligned   = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            auto newOffset = aligned - reinterpret_cast<uintptr_t>(block.data) + size;
+            if (newOffset <= block.size)
+            {
+                _stats.allocatedBytes += newOffset - _offset;
+                ++_stats.allocations;
+                _offset = newOffset;
+                return reinterpret_cast<void*>(aligned);
+            }
+
+            // doesn't fit, the next block is tried
+            ++_blockIndex;
+            _offset = 0;
+            continue;
+        }
+
+        auto blockSize = (std::max)(_blockSize, size + alignment);
+        _blocks.emplace_back(Block{static_cast<uint8_t*>(malloc(blockSize)), blockSize});
+        ++_stats.heapAllocations;
+    }
+}
+
+void FrameArena::addDestructor(void* object, void (*destroy)(void*))
+{
+    auto destructor = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+    *destructor     = Destructor{destroy, object, _destructors};
+    _destructors    = destructor;
+}
+
+void FrameArena::reset()
+{
+    for (auto destructor = _destructors; destructor; destructor = destructor->next)
+        destructor->destroy(destructor->object);
+    _destructors = nullptr;
+
+    // merge the blocks the frame needed, so the next frame fits into one
+    if (_blocks.size() > 1)
+    {
+        std::size_t total = 0;
+        for (auto&& block : _blocks)
+            total += block.size;
+        freeBlocks();
+        _blockSize = total;
+        _blocks.emplace_back(Block{static_cast<uint8_t*>(malloc(total)), total});
+        ++_stats.heapAllocations;
+    }
+
+    _blockIndex = 0;
+    _offset     = 0;
+}
+
+void FrameArena::endFrame()
+{
+    _frameStats = _stats;
+    _stats      = Stats{};
+}
+
+std::size_t FrameArena::getCapacity() const
+{
+    std::size_t total = 0;
+    for (auto&& block : _blocks)
+        total += block.size;
+    return total;
+}
+
+void FrameArena::freeBlocks()
+{
+    for (auto&& block : _blocks)
+        free(block.data);
+    _blocks.clear();
+}
+
+NS_AX_END
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+NS_AX_BEGIN
+
+/**
+ * A bump allocator for memory that only lives until the frame was rendered, like render command closures or
+ * per-frame vertex scratch. The renderer resets it after the render queues were executed.
+ *
+ * When a frame needs more than the current block, another block is allocated and the blocks are merged into one at
+ * the next reset, so a steady frame doesn't touch the heap.
+ */
+class AX_DLL FrameArena
+{
+public:
+    /** Counters of a frame. */
+    struct Stats
+    {
+        unsigned int allocations     = 0;  ///< Allocations served by the arena, each one a heap allocation saved.
+        std::size_t allocatedBytes   = 0;  ///< Bytes handed out, padding included.
+        unsigned int heapAllocations = 0;  ///< Blocks the arena itself allocated to grow.
+    };
+
+    explicit FrameArena(std::size_t blockSize = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Allocate memory valid until the next reset.
+     * @param alignment Must be a power of two.
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    /** Allocate an uninitialized array of trivial objects, valid until the next reset. */
+    template <typename _Ty>
+    _Ty* allocateArray(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<_Ty>, "FrameArena: arrays must be trivially destructible");
+        return static_cast<_Ty*>(allocate(sizeof(_Ty) * count, alignof(_Ty)));
+    }
+
+    /** Construct an object destroyed by the next reset. */
+    template <typename _Ty, typename... _Args>
+    _Ty* construct(_Args&&... args)
+    {
+        auto object = new (allocate(sizeof(_Ty), alignof(_Ty))) _Ty(std::forward<_Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<_Ty>)
+            addDestructor(object, [](void* p) { static_cast<_Ty*>(p)->~_Ty(); });
+        return object;
+    }
+
+    /** Destroy the constructed objects and release all the memory for reuse. */
+    void reset();
+
+    /** Mark the end of the frame for the counters. */
+    void endFrame();
+
+    /** Bytes the arena holds. */
+    std::size_t getCapacity() const;
+
+    /** Counters of the last finished frame. */
+    const Stats& getFrameStats() const { return _frameStats; }
+
+private:
+    struct Block
+    {
+        uint8_t* data;
+        std::size_t size;
+    };
+
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    void addDestructor(void* object, void (*destroy)(void*));
+    void freeBlocks();
+
+    std::vector<Block> _blocks;
+    std::size_t _blockSize  = 0;
+    std::size_t _blockIndex = 0;  // block allocations are served from
+    std::size_t _offset     = 0;  // first free byte of the current block
+
+    // most recently constructed first, so objects are destroyed in reverse order
+    Destructor* _destructors = nullptr;
+
+    Stats _stats;
+    Stats _frameStats;
+};
+
+NS_AX_END
+
+/**
+ end of support group
+ @}
+ */
@@ -36,6 +36,7 @@
 #include "renderer/Technique.h"
 #include "renderer/Pass.h"
 #include "renderer/Texture2D.h"
+#include "renderer/StreamBuffer.h"
 
 #include "base/Configuration.h"
 #include "base/Director.h"
@@ -156,6 +157,13 @@ void RenderQueue::realloc(size_t reserveSize)
 //
 static const int DEFAULT_RENDER_QUEUE = 0;
 
+template <typename _Ty>
+static void fillBatchIndices(_Ty* dst, const unsigned short* indices, size_t count, unsigned int firstVertex)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<_Ty>(firstVertex + indices[i]);
+}
+
 //
 // constructors, destructor, init
 //
@@ -170,6 +178,8 @@ Renderer::Renderer()
 
     // for the batched TriangleCommand
     _triBatchesToDraw = (TriBatchToDraw*)malloc(sizeof(_triBatchesToDraw[0]) * _triBatchesToDrawCapacity);
+    _verts.resize(_batchVertexCapacity);
+    _indices.resize(_batchIndexCapacity * sizeof(uint16_t));
 }
 
 Renderer::~Renderer()
@@ -187,6 +197,8 @@ Renderer::~Renderer()
     _groupCommandManager->release();
 
     free(_triBatchesToDraw);
+    AX_SAFE_DELETE(_vertexStream);
+    AX_SAFE_DELETE(_indexStream);
 
     AX_SAFE_RELEASE(_depthStencilState);
     AX_SAFE_RELEASE(_commandBuffer);
@@ -197,10 +209,9 @@ Renderer::~Renderer()
 
 void Renderer::init()
 {
-    // Should invoke _triangleCommandBufferManager.init() first.
-    _triangleCommandBufferManager.init();
-    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
-    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
+    // the rings start with room for two full batches, they grow when a frame needs more
+    _vertexStream = new StreamBuffer(backend::BufferType::VERTEX, VBO_SIZE * sizeof(V3F_C4B_T2F) * 2);
+    _indexStream  = new StreamBuffer(backend::BufferType::INDEX, INDEX_VBO_SIZE * sizeof(uint16_t) * 2);
 
     auto driver    = backend::DriverBase::getInstance();
     _commandBuffer = driver->newCommandBuffer();
@@ -296,34 +307,7 @@ void Renderer::processRenderCommand(RenderCommand* command)
         flush3D();
 
         auto cmd = static_cast<TrianglesCommand*>(command);
-
-        // flush own queue when buffer is full
-        if (_queuedTotalVertexCount + cmd->getVertexCount() > VBO_SIZE ||
-            _queuedTotalIndexCount + cmd->getIndexCount() > INDEX_VBO_SIZE)
-        {
-            AXASSERT(cmd->getVertexCount() >= 0 && cmd->getVertexCount() < VBO_SIZE,
-                     "VBO for vertex is not big enough, please break the data down or use customized render command");
-            AXASSERT(cmd->getIndexCount() >= 0 && cmd->getIndexCount() < INDEX_VBO_SIZE,
-                     "VBO for index is not big enough, please break the data down or use customized render command");
-            drawBatchedTriangles();
-
-            _queuedTotalIndexCount = _queuedTotalVertexCount = 0;
-#ifdef AX_USE_METAL
-            _queuedIndexCount = _queuedVertexCount = 0;
-            _triangleCommandBufferManager.prepareNextBuffer();
-            _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
-            _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
-#endif
-        }
-
-        // queue it
-        _queuedTriangleCommands.emplace_back(cmd);
-#ifdef AX_USE_METAL
-        _queuedIndexCount += cmd->getIndexCount();
-        _queuedVertexCount += cmd->getVertexCount();
-#endif
-        _queuedTotalVertexCount += cmd->getVertexCount();
-        _queuedTotalIndexCount += cmd->getIndexCount();
+        queueTriangles(cmd, cmd->getTriangles(), cmd->getMaterialID());
     }
     break;
     case RenderCommand::Type::MESH_COMMAND:
@@ -335,9 +319,20 @@ void Renderer::processRenderCommand(RenderCommand* command)
         _groupCommandPool.emplace_back(static_cast<GroupCommand*>(command));
         break;
     case RenderCommand::Type::CUSTOM_COMMAND:
-        flush();
-        drawCustomCommand(command);
-        break;
+    {
+        auto cmd = static_cast<CustomCommand*>(command);
+        if (cmd->isBatchable())
+        {
+            flush3D();
+            queueTriangles(cmd, cmd->getBatchTriangles(), cmd->getMaterialID());
+        }
+        else
+        {
+            flush();
+            drawCustomCommand(command);
+        }
+    }
+    break;
     case RenderCommand::Type::CALLBACK_COMMAND:
         flush();
         static_cast<CallbackCommand*>(command)->execute();
@@ -428,13 +423,41 @@ void Renderer::endFrame()
 {
     _commandBuffer->endFrame();
 
-#ifdef AX_USE_METAL
-    _triangleCommandBufferManager.putbackAllBuffers();
-    _vertexBuffer = _triangleCommandBufferManager.getVertexBuffer();
-    _indexBuffer  = _triangleCommandBufferManager.getIndexBuffer();
-#endif
-    _queuedTotalIndexCount  = 0;
-    _queuedTotalVertexCount = 0;
+    _vertexStream->endFrame();
+    _indexStream->endFrame();
+    _frameArena.endFrame();
+
+    _queuedIndexCount  = 0;
+    _queuedVertexCount = 0;
+}
+
+std::size_t Renderer::getUploadedBytes() const
+{
+    return _vertexStream->getFrameStats().uploadedBytes + _indexStream->getFrameStats().uploadedBytes;
+}
+
+void Renderer::setBatchIndexFormat(backend::IndexFormat format)
+{
+    AXASSERT(!_isRendering, "Cannot change the index format while rendering");
+    if (_batchIndexFormat == format)
+        return;
+
+    drawBatchedTriangles();
+
+    _batchIndexFormat = format;
+    if (format == backend::IndexFormat::U_INT)
+    {
+        _batchVertexCapacity = VBO_SIZE_U32;
+        _batchIndexCapacity  = INDEX_VBO_SIZE_U32;
+        _indices.resize(_batchIndexCapacity * sizeof(uint32_t));
+    }
+    else
+    {
+        _batchVertexCapacity = VBO_SIZE;
+        _batchIndexCapacity  = INDEX_VBO_SIZE;
+        _indices.resize(_batchIndexCapacity * sizeof(uint16_t));
+    }
+    _verts.resize(_batchVertexCapacity);
 }
 
 void Renderer::clean()
@@ -452,6 +475,9 @@ void Renderer::clean()
 
     // Clear batch commands
     _queuedTriangleCommands.clear();
+
+    // the queued commands are gone, so is the memory their closures used
+    _frameArena.reset();
 }
 
 void Renderer::setDepthTest(bool value)
@@ -587,25 +613,46 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
     _viewport.height = h;
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
+void Renderer::queueTriangles(RenderCommand* cmd, const TrianglesCommand::Triangles& triangles, uint32_t materialID)
+{
+    // flush own queue when the batch is full
+    if (_queuedVertexCount + triangles.vertCount > _batchVertexCapacity ||
+        _queuedIndexCount + triangles.indexCount > _batchIndexCapacity)
+    {
+        AXASSERT(triangles.vertCount < _batchVertexCapacity,
+                 "VBO for vertex is not big enough, please break the data down or use customized render command");
+        AXASSERT(triangles.indexCount < _batchIndexCapacity,
+                 "VBO for index is not big enough, please break the data down or use customized render command");
+        drawBatchedTriangles();
+    }
+
+    // queue it
+    _queuedTriangleCommands.emplace_back(QueuedTriangles{cmd, &triangles, materialID});
+    _queuedIndexCount += triangles.indexCount;
+    _queuedVertexCount += triangles.vertCount;
+}
+
+void Renderer::fillVerticesAndIndices(const QueuedTriangles& queued)
 {
-    size_t vertexCount = cmd->getVertexCount();
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * vertexCount);
+    size_t vertexCount = queued.triangles->vertCount;
+    memcpy(&_verts[_filledVertex], queued.triangles->verts, sizeof(V3F_C4B_T2F) * vertexCount);
 
     // fill vertex, and convert them to world coordinates
-    const Mat4& modelView = cmd->getModelView();
+    const Mat4& modelView = queued.cmd->getMV();
     for (size_t i = 0; i < vertexCount; ++i)
     {
         modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
     }
 
     // fill index
-    const unsigned short* indices = cmd->getIndices();
-    size_t indexCount             = cmd->getIndexCount();
-    for (size_t i = 0; i < indexCount; ++i)
-    {
-        _indices[_filledIndex + i] = vertexBufferOffset + _filledVertex + indices[i];
-    }
+    const unsigned short* indices = queued.triangles->indices;
+    size_t indexCount             = queued.triangles->indexCount;
+    if (_batchIndexFormat == backend::IndexFormat::U_INT)
+        fillBatchIndices(reinterpret_cast<uint32_t*>(_indices.data()) + _filledIndex, indices, indexCount,
+                         _filledVertex);
+    else
+        fillBatchIndices(reinterpret_cast<uint16_t*>(_indices.data()) + _filledIndex, indices, indexCount,
+                         _filledVertex);
 
     _filledVertex += vertexCount;
     _filledIndex += indexCount;
@@ -616,16 +663,8 @@ void Renderer::drawBatchedTriangles()
     if (_queuedTriangleCommands.empty())
         return;
 
-        /************** 1: Setup up vertices/indices *************/
-#ifdef AX_USE_METAL
-    unsigned int vertexBufferFillOffset = _queuedTotalVertexCount - _queuedVertexCount;
-    unsigned int indexBufferFillOffset  = _queuedTotalIndexCount - _queuedIndexCount;
-#else
-    unsigned int vertexBufferFillOffset = 0;
-    unsigned int indexBufferFillOffset  = 0;
-#endif
-
-    _triBatchesToDraw[0].offset        = indexBufferFillOffset;
+    /************** 1: Setup up vertices/indices *************/
+    _triBatchesToDraw[0].offset        = 0;
     _triBatchesToDraw[0].indicesToDraw = 0;
     _triBatchesToDraw[0].cmd           = nullptr;
 
@@ -636,19 +675,18 @@ void Renderer::drawBatchedTriangles()
     _filledVertex = 0;
     _filledIndex  = 0;
 
-    for (const auto& cmd : _queuedTriangleCommands)
+    for (const auto& queued : _queuedTriangleCommands)
     {
-        auto currentMaterialID = cmd->getMaterialID();
+        auto cmd               = queued.cmd;
+        auto currentMaterialID = queued.materialID;
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        fillVerticesAndIndices(queued);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
         {
-            AX_ASSERT((firstCommand || _triBatchesToDraw[batchesTotal].cmd->getMaterialID() == cmd->getMaterialID()) &&
-                      "argh... error in logic");
-            _triBatchesToDraw[batchesTotal].indicesToDraw += cmd->getIndexCount();
+            _triBatchesToDraw[batchesTotal].indicesToDraw += queued.triangles->indexCount;
             _triBatchesToDraw[batchesTotal].cmd = cmd;
         }
         else
@@ -662,7 +700,7 @@ void Renderer::drawBatchedTriangles()
             }
 
             _triBatchesToDraw[batchesTotal].cmd           = cmd;
-            _triBatchesToDraw[batchesTotal].indicesToDraw = (int)cmd->getIndexCount();
+            _triBatchesToDraw[batchesTotal].indicesToDraw = queued.triangles->indexCount;
 
             // is this a single batch ? Prevent creating a batch group then
             if (!batchable)
@@ -681,20 +719,16 @@ void Renderer::drawBatchedTriangles()
         firstCommand   = false;
     }
     batchesTotal++;
-#ifdef AX_USE_METAL
-    _vertexBuffer->updateSubData(_verts, vertexBufferFillOffset * sizeof(_verts[0]), _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateSubData(_indices, indexBufferFillOffset * sizeof(_indices[0]),
-                                _filledIndex * sizeof(_indices[0]));
-#else
-    _vertexBuffer->updateData(_verts, _filledVertex * sizeof(_verts[0]));
-    _indexBuffer->updateData(_indices, _filledIndex * sizeof(_indices[0]));
-#endif
+
+    const auto indexSize = _batchIndexFormat == backend::IndexFormat::U_INT ? sizeof(uint32_t) : sizeof(uint16_t);
+    auto vertices        = _vertexStream->upload(_verts.data(), _filledVertex * sizeof(_verts[0]));
+    auto indices         = _indexStream->upload(_indices.data(), _filledIndex * indexSize);
 
     /************** 2: Draw *************/
     beginRenderPass();
 
-    _commandBuffer->setVertexBuffer(_vertexBuffer);
-    _commandBuffer->setIndexBuffer(_indexBuffer);
+    _commandBuffer->setVertexBuffer(vertices.buffer, vertices.offset);
+    _commandBuffer->setIndexBuffer(indices.buffer);
 
     for (int i = 0; i < batchesTotal; ++i)
     {
@@ -702,8 +736,8 @@ void Renderer::drawBatchedTriangles()
         _commandBuffer->updatePipelineState(_currentRT, drawInfo.cmd->getPipelineDescriptor());
         auto& pipelineDescriptor = drawInfo.cmd->getPipelineDescriptor();
         _commandBuffer->setProgramState(pipelineDescriptor.programState);
-        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, backend::IndexFormat::U_SHORT,
-                                     drawInfo.indicesToDraw, drawInfo.offset * sizeof(_indices[0]));
+        _commandBuffer->drawElements(backend::PrimitiveType::TRIANGLE, _batchIndexFormat, drawInfo.indicesToDraw,
+                                     indices.offset + drawInfo.offset * indexSize);
 
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
@@ -714,10 +748,8 @@ void Renderer::drawBatchedTriangles()
     /************** 3: Cleanup *************/
     _queuedTriangleCommands.clear();
 
-#ifdef AX_USE_METAL
     _queuedIndexCount  = 0;
     _queuedVertexCount = 0;
-#endif
 }
 
 void Renderer::drawCustomCommand(RenderCommand* command)
@@ -836,6 +868,16 @@ void Renderer::readPixels(backend::RenderTarget* rt,
     _commandBuffer->readPixels(rt, std::move(callback));
 }
 
+void Renderer::readPixelsAsync(backend::RenderTarget* rt,
+                               std::function<void(const backend::PixelBufferDescriptor&)> callback)
+{
+    assert(!!rt);
+    if (rt == _defaultRT)
+        backend::DriverBase::getInstance()->setFrameBufferOnly(false);
+
+    _commandBuffer->readPixelsAsync(rt, std::move(callback));
+}
+
 void Renderer::beginRenderPass()
 {
     _commandBuffer->beginRenderPass(_currentRT, _renderPassDesc);
@@ -871,7 +913,7 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
 
     CallbackCommand* command = nextCallbackCommand();
     command->init(globalOrder);
-    command->func = [this, flags, color, depth, stencil]() -> void {
+    command->setCallback(_frameArena, [this, flags, color, depth, stencil]() -> void {
 
         backend::RenderPassDescriptor descriptor;
 
@@ -892,7 +934,7 @@ void Renderer::clear(ClearFlag flags, const Color4F& color, float depth, unsigne
                                        _scissorState.rect.width, _scissorState.rect.height);
         _commandBuffer->beginRenderPass(_currentRT, descriptor);
         _commandBuffer->endRenderPass();
-    };
+    });
     addCommand(command);
 }
 
@@ -953,73 +995,6 @@ void Renderer::setScissorRect(float x, float y, float width, float height)
     _scissorState.rect.height = height;
 }
 
-// TriangleCommandBufferManager
-Renderer::TriangleCommandBufferManager::~TriangleCommandBufferManager()
-{
-    for (auto&& vertexBuffer : _vertexBufferPool)
-        vertexBuffer->release();
-
-    for (auto&& indexBuffer : _indexBufferPool)
-        indexBuffer->release();
-}
-
-void Renderer::TriangleCommandBufferManager::init()
-{
-    createBuffer();
-}
-
-void Renderer::TriangleCommandBufferManager::putbackAllBuffers()
-{
-    _currentBufferIndex = 0;
-}
-
-void Renderer::TriangleCommandBufferManager::prepareNextBuffer()
-{
-    if (_currentBufferIndex < (int)_vertexBufferPool.size() - 1)
-    {
-        ++_currentBufferIndex;
-        return;
-    }
-
-    createBuffer();
-    ++_currentBufferIndex;
-}
-
-backend::Buffer* Renderer::TriangleCommandBufferManager::getVertexBuffer() const
-{
-    return _vertexBufferPool[_currentBufferIndex];
-}
-
-backend::Buffer* Renderer::TriangleCommandBufferManager::getIndexBuffer() const
-{
-    return _indexBufferPool[_currentBufferIndex];
-}
-
-void Renderer::TriangleCommandBufferManager::createBuffer()
-{
-    auto driver = backend::DriverBase::getInstance();
-
-    // Not initializing the buffer before passing it to updateData for Android/OpenGL ES.
-    // This change does fix the Android/OpenGL ES performance problem
-    // If for some reason we get reports of performance issues on OpenGL implementations,
-    // then we can just add pre-processor checks for OpenGL and have the updateData() allocate the full size after buffer creation.
-    auto vertexBuffer = driver->newBuffer(Renderer::VBO_SIZE * sizeof(_verts[0]), backend::BufferType::VERTEX,
-                                          backend::BufferUsage::DYNAMIC);
-    if (!vertexBuffer)
-        return;
-
-    auto indexBuffer = driver->newBuffer(Renderer::INDEX_VBO_SIZE * sizeof(_indices[0]), backend::BufferType::INDEX,
-                                         backend::BufferUsage::DYNAMIC);
-    if (!indexBuffer)
-    {
-        vertexBuffer->release();
-        return;
-    }
-
-    _vertexBufferPool.emplace_back(vertexBuffer);
-    _indexBufferPool.emplace_back(indexBuffer);
-}
-
 void Renderer::pushStateBlock()
 {
     StateBlock block;
@@ -33,6 +33,8 @@
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/TrianglesCommand.h"
+#include "renderer/FrameArena.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
 
@@ -62,6 +64,7 @@ class TrianglesCommand;
 class MeshCommand;
 class GroupCommand;
 class CallbackCommand;
+class StreamBuffer;
 struct PipelineDescriptor;
 class Texture2D;
 
@@ -132,10 +135,14 @@ Whenever possible prefer to use `TrianglesCommand` objects since the renderer wi
 class AX_DLL Renderer
 {
 public:
-    /**The max number of vertices in a vertex buffer object.*/
+    /**The max number of vertices of a triangles batch with 16-bit indices.*/
     static const int VBO_SIZE = 65536;
-    /**The max number of indices in a index buffer.*/
+    /**The max number of indices of a triangles batch with 16-bit indices.*/
     static const int INDEX_VBO_SIZE = VBO_SIZE * 6 / 4;
+    /**The max number of vertices of a triangles batch with 32-bit indices, see `setBatchIndexFormat`.*/
+    static const int VBO_SIZE_U32 = VBO_SIZE * 4;
+    /**The max number of indices of a triangles batch with 32-bit indices.*/
+    static const int INDEX_VBO_SIZE_U32 = VBO_SIZE_U32 * 6 / 4;
     /**The rendercommands which can be batched will be saved into a list, this is the reserved size of this list.*/
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
@@ -185,6 +192,33 @@ public:
     /* clear draw stats */
     void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
 
+    /** Bytes of batched vertices and indices uploaded to the GPU during the last frame. */
+    std::size_t getUploadedBytes() const;
+
+    /**
+     * Set the index format of batched triangles. With backend::IndexFormat::U_INT a batch holds up to VBO_SIZE_U32
+     * vertices instead of VBO_SIZE, which saves draw calls for big batches at the cost of twice the index data.
+     * @note GLES 2.0 needs GL_OES_element_index_uint for 32-bit indices.
+     */
+    void setBatchIndexFormat(backend::IndexFormat format);
+    backend::IndexFormat getBatchIndexFormat() const { return _batchIndexFormat; }
+
+    /**
+     * The rings batched triangles are streamed through, custom commands may upload their per frame geometry to them
+     * as well. Uploaded data must be drawn in the same frame.
+     */
+    StreamBuffer* getVertexStreamBuffer() const { return _vertexStream; }
+    StreamBuffer* getIndexStreamBuffer() const { return _indexStream; }
+
+    /**
+     * Memory for frame scoped data, like callback command closures or vertex scratch. It is reset by `clean`, after
+     * the queued commands were executed, see `CallbackCommand::setCallback`.
+     */
+    FrameArena& getFrameArena() { return _frameArena; }
+
+    /** Allocation counters of the frame arena during the last frame. */
+    const FrameArena::Stats& getFrameArenaStats() const { return _frameArena.getFrameStats(); }
+
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
      @flags Flags to indicate which attachment to be replaced.
@@ -414,6 +448,10 @@ public:
     /** read pixels from RenderTarget or screen framebuffer */
     void readPixels(backend::RenderTarget* rt, std::function<void(const backend::PixelBufferDescriptor&)> callback);
 
+    /** read pixels without stalling the GPU, the callback is invoked a few frames later by endFrame */
+    void readPixelsAsync(backend::RenderTarget* rt,
+                         std::function<void(const backend::PixelBufferDescriptor&)> callback);
+
     void beginRenderPass();  /// Begin a render pass.
     void endRenderPass();
 
@@ -423,45 +461,6 @@ protected:
     friend class Director;
     friend class GroupCommand;
 
-    /**
-     * Create and reuse vertex and index buffer for triangleCommand.
-     * When queued vertex or index count exceed the limited value, a new vertex or index buffer will be created.
-     */
-    class TriangleCommandBufferManager
-    {
-    public:
-        ~TriangleCommandBufferManager();
-
-        /**
-         * Create a new vertex buffer and a index buffer and push it to cache.
-         * @note Should invoke firstly.
-         */
-        void init();
-
-        /**
-         * Reset avalable buffer index to zero.
-         * That means when get vertex buffer or index buffer, the earliest created buffer object in the cache will be
-         * returned.
-         */
-        void putbackAllBuffers();
-
-        /**
-         * Buffer will be created If next buffer unavailable in the cache, otherwise set the buffer index in order to
-         * get the next available buffer.
-         */
-        void prepareNextBuffer();
-
-        backend::Buffer* getVertexBuffer() const;  ///< Get the vertex buffer.
-        backend::Buffer* getIndexBuffer() const;   ///< Get the index buffer.
-
-    private:
-        void createBuffer();
-
-        int _currentBufferIndex = 0;
-        std::vector<backend::Buffer*> _vertexBufferPool;
-        std::vector<backend::Buffer*> _indexBufferPool;
-    };
-
     inline GroupCommandManager* getGroupCommandManager() const { return _groupCommandManager; }
     void drawBatchedTriangles();
     void drawCustomCommand(RenderCommand* command);
@@ -484,7 +483,16 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    // Triangles waiting to be drawn in the shared batch, from TrianglesCommand or batchable CustomCommand
+    struct QueuedTriangles
+    {
+        RenderCommand* cmd                           = nullptr;
+        const TrianglesCommand::Triangles* triangles = nullptr;
+        uint32_t materialID                          = 0;
+    };
+
+    void queueTriangles(RenderCommand* cmd, const TrianglesCommand::Triangles& triangles, uint32_t materialID);
+    void fillVerticesAndIndices(const QueuedTriangles& queued);
 
     void pushStateBlock();
 
@@ -500,19 +508,24 @@ protected:
 
     std::vector<RenderQueue> _renderGroups;
 
-    std::vector<TrianglesCommand*> _queuedTriangleCommands;
+    std::vector<QueuedTriangles> _queuedTriangleCommands;
 
     // the pool for callback commands
     std::vector<CallbackCommand*> _callbackCommandsPool;
 
     std::vector<GroupCommand*> _groupCommandPool;
 
-    // for TrianglesCommand
-    V3F_C4B_T2F _verts[VBO_SIZE];
-    unsigned short _indices[INDEX_VBO_SIZE];
-    backend::Buffer* _vertexBuffer = nullptr;
-    backend::Buffer* _indexBuffer  = nullptr;
-    TriangleCommandBufferManager _triangleCommandBufferManager;
+    FrameArena _frameArena;
+
+    // for TrianglesCommand, batches are filled on the CPU and streamed to the GPU rings
+    std::vector<V3F_C4B_T2F> _verts;
+    std::vector<uint8_t> _indices;
+    StreamBuffer* _vertexStream = nullptr;
+    StreamBuffer* _indexStream  = nullptr;
+
+    backend::IndexFormat _batchIndexFormat = backend::IndexFormat::U_SHORT;
+    unsigned int _batchVertexCapacity      = VBO_SIZE;
+    unsigned int _batchIndexCapacity       = INDEX_VBO_SIZE;
 
     backend::CommandBuffer* _commandBuffer = nullptr;
     backend::RenderPassDescriptor _renderPassDesc;
@@ -523,7 +536,7 @@ protected:
     // Internal structure that has the information for the batches
     struct TriBatchToDraw
     {
-        TrianglesCommand* cmd      = nullptr;  // needed for the Material
+        RenderCommand* cmd         = nullptr;  // needed for the Material
         unsigned int indicesToDraw = 0;
         unsigned int offset        = 0;
     };
@@ -532,12 +545,10 @@ protected:
     // the TriBatches
     TriBatchToDraw* _triBatchesToDraw = nullptr;
 
-    unsigned int _queuedTotalVertexCount = 0;
-    unsigned int _queuedTotalIndexCount  = 0;
-    unsigned int _queuedVertexCount      = 0;
-    unsigned int _queuedIndexCount       = 0;
-    unsigned int _filledIndex            = 0;
-    unsigned int _filledVertex           = 0;
+    unsigned int _queuedVertexCount = 0;
+    unsigned int _queuedIndexCount  = 0;
+    unsigned int _filledIndex       = 0;
+    unsigned int _filledVertex      = 0;
 
     // stats
     size_t _drawnBatches  = 0;
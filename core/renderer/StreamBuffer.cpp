@@ -0,0 +1,190 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/StreamBuffer.h"
+
+#include <limits>
+
+#include "base/Macros.h"
+#include "renderer/backend/Buffer.h"
+#include "renderer/backend/DriverBase.h"
+#include "renderer/backend/Macros.h"
+
+NS_AX_BEGIN
+
+// alignment of the ring size, so the alignment of a position is the alignment of its ring offset
+static constexpr std::size_t RING_ALIGNMENT = 256;
+
+StreamBuffer::StreamBuffer(backend::BufferType type, std::size_t capacity, backend::DriverBase* driver)
+    : _driver(driver ? driver : backend::DriverBase::getInstance()), _type(type)
+{
+    _capacity = (std::max(capacity, RING_ALIGNMENT) + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+    _buffer   = _driver->newBuffer(_capacity, _type, backend::BufferUsage::STREAM);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    deleteFences();
+    AX_SAFE_RELEASE(_buffer);
+}
+
+StreamBuffer::Slice StreamBuffer::upload(const void* data, std::size_t size, std::size_t alignment)
+{
+    AXASSERT(alignment && alignment <= RING_ALIGNMENT && (alignment & (alignment - 1)) == 0, "Invalid alignment");
+
+    if (!_buffer || !size)
+        return Slice{};
+
+    auto offset = reserve(size, alignment);
+    if (!_buffer)
+        return Slice{};
+
+    if (auto mapped = _buffer->mapRange(offset, size))
+    {
+        memcpy(mapped, data, size);
+        _buffer->unmapRange();
+    }
+    else
+        _buffer->updateSubData(data, offset, size);
+
+    _stats.uploadedBytes += size;
+    ++_stats.uploads;
+
+    return Slice{_buffer, offset};
+}
+
+void StreamBuffer::endFrame()
+{
+    if (_head != _frameBegin)
+    {
+        _frames.emplace_back(FrameMark{_driver->newFence(), _head});
+        _frameBegin = _head;
+    }
+
+    // release the frames the GPU already finished without blocking
+    while (!_frames.empty() && _frames.front().fence && _driver->waitFence(_frames.front().fence, 0))
+    {
+        _driver->deleteFence(_frames.front().fence);
+        _tail = _frames.front().end;
+        _frames.pop_front();
+    }
+
+    // without fences the GPU progress is unknown, the backends keep at most MAX_INFLIGHT_BUFFER frames in flight
+    while (_frames.size() > MAX_INFLIGHT_BUFFER && !_frames.front().fence)
+    {
+        _tail = _frames.front().end;
+        _frames.pop_front();
+    }
+
+    _frameStats = _stats;
+    _stats      = Stats{};
+}
+
+std::size_t StreamBuffer::reserve(std::size_t size, std::size_t alignment)
+{
+    for (;;)
+    {
+        uint64_t position = (_head + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+        auto offset       = static_cast<std::size_t>(position % _capacity);
+        if (offset + size > _capacity)
+        {
+            // not enough room before the end of the ring, continue at its start
+            position += _capacity - offset;
+            offset = 0;
+        }
+
+        if (position + size - _tail <= _capacity)
+        {
+            _head = position + size;
+            return offset;
+        }
+
+        if (!retireOldestFrame())
+        {
+            grow(static_cast<std::size_t>(_head - _frameBegin) + size + alignment);
+            if (!_buffer)
+                return 0;
+        }
+    }
+}
+
+bool StreamBuffer::retireOldestFrame()
+{
+    if (_frames.empty())
+        return false;
+
+    auto& frame = _frames.front();
+    if (frame.fence)
+    {
+        if (!_driver->waitFence(frame.fence, 0))
+        {
+            ++_stats.stalls;
+            _driver->waitFence(frame.fence, std::numeric_limits<uint64_t>::max());
+        }
+        _driver->deleteFence(frame.fence);
+        _tail = frame.end;
+        _frames.pop_front();
+    }
+    else if (_buffer->orphan())
+    {
+        // the new data store is unused, draws already submitted keep reading the old one
+        ++_stats.orphans;
+        deleteFences();
+        _tail = _head;
+    }
+    else
+    {
+        // no fences and no orphaning, the backend keeps a copy of the buffer per frame in flight
+        _tail = frame.end;
+        _frames.pop_front();
+    }
+    return true;
+}
+
+void StreamBuffer::grow(std::size_t minCapacity)
+{
+    // leave room for the frames in flight
+    auto capacity = _capacity;
+    while (capacity < minCapacity * 2)
+        capacity *= 2;
+
+    AXLOGD("StreamBuffer: grow ring from {} to {} bytes", _capacity, capacity);
+
+    // the old buffer stays alive as long as submitted draws use it
+    deleteFences();
+    AX_SAFE_RELEASE(_buffer);
+    _buffer   = _driver->newBuffer(capacity, _type, backend::BufferUsage::STREAM);
+    _capacity = capacity;
+    _head = _tail = _frameBegin = 0;
+    ++_stats.grows;
+}
+
+void StreamBuffer::deleteFences()
+{
+    for (auto& frame : _frames)
+        _driver->deleteFence(frame.fence);
+    _frames.clear();
+}
+
+NS_AX_END
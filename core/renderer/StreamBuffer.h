@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <deque>
+
+#include "platform/PlatformMacros.h"
+#include "renderer/backend/Types.h"
+
+/**
+ * @addtogroup renderer
+ * @{
+ */
+
+NS_AX_BEGIN
+
+namespace backend
+{
+class Buffer;
+class DriverBase;
+}
+
+/**
+ * A ring of GPU memory for geometry that is rebuilt every frame, like batched triangles.
+ *
+ * Uploads are appended to the ring and must be drawn in the frame they were uploaded in. Space of earlier frames is
+ * reused once the driver fence inserted at their end passed. Without fences the data store is orphaned when the ring
+ * wraps around, and the frames older than the ones the backends keep in flight are released. When a single frame needs
+ * more than the ring holds the ring grows.
+ */
+class AX_DLL StreamBuffer
+{
+public:
+    /** Counters of a frame. */
+    struct Stats
+    {
+        std::size_t uploadedBytes = 0;  ///< Bytes copied to the GPU.
+        unsigned int uploads      = 0;  ///< Number of uploads.
+        unsigned int stalls       = 0;  ///< Waits on a fence the GPU hadn't passed yet.
+        unsigned int orphans      = 0;  ///< Times the data store was orphaned.
+        unsigned int grows        = 0;  ///< Times the ring was reallocated with a bigger capacity.
+    };
+
+    /** A range of the ring, `buffer` is nullptr if the upload failed. */
+    struct Slice
+    {
+        backend::Buffer* buffer = nullptr;
+        std::size_t offset      = 0;
+    };
+
+    /**
+     * @param type The buffer type, BufferType::VERTEX or BufferType::INDEX.
+     * @param capacity The initial ring size in bytes.
+     * @param driver The driver the buffers and fences are created with, the shared driver if nullptr.
+     */
+    StreamBuffer(backend::BufferType type, std::size_t capacity, backend::DriverBase* driver = nullptr);
+    ~StreamBuffer();
+
+    /**
+     * Copy data into the ring.
+     * @param alignment The byte alignment of the returned offset, must be a power of two not bigger than 256.
+     * @return The buffer to bind and the byte offset of the data in it, only valid until the next upload since the
+     * ring may grow.
+     */
+    Slice upload(const void* data, std::size_t size, std::size_t alignment = 4);
+
+    /** Mark the end of the frame, should be invoked after the frame's draw calls were submitted. */
+    void endFrame();
+
+    std::size_t getCapacity() const { return _capacity; }
+
+    /** The number of finished frames whose ring space isn't reusable yet. */
+    std::size_t getPendingFrameCount() const { return _frames.size(); }
+
+    /** Counters of the last finished frame. */
+    const Stats& getFrameStats() const { return _frameStats; }
+
+private:
+    struct FrameMark
+    {
+        uintptr_t fence;
+        uint64_t end;
+    };
+
+    std::size_t reserve(std::size_t size, std::size_t alignment);
+    bool retireOldestFrame();
+    void grow(std::size_t minCapacity);
+    void deleteFences();
+
+    backend::DriverBase* _driver;
+    backend::BufferType _type;
+    backend::Buffer* _buffer = nullptr;
+    std::size_t _capacity    = 0;
+
+    // positions count every byte ever reserved, the ring offset is position % capacity
+    uint64_t _head       = 0;  // next free byte
+    uint64_t _tail       = 0;  // first byte the GPU may still read
+    uint64_t _frameBegin = 0;  // first byte of the current frame
+    std::deque<FrameMark> _frames;
+
+    Stats _stats;
+    Stats _frameStats;
+};
+
+NS_AX_END
+
+/**
+ end of support group
+ @}
+ */
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "renderer/Shaders.h"
 #include "renderer/backend/PixelFormatUtils.h"
 #include "renderer/Renderer.h"
+#include "renderer/TextureStreamer.h"
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 #    include "renderer/TextureCache.h"
@@ -85,6 +86,9 @@ Texture2D::~Texture2D()
 
     AX_SAFE_DELETE(_ninePatchInfo);
 
+    if (_streamedInfo)
+        _streamedInfo->streamer->removeTexture(this);
+
     AX_SAFE_RELEASE(_texture);
     AX_SAFE_RELEASE(_programState);
 }
@@ -257,7 +261,7 @@ bool Texture2D::updateWithImage(Image* image, backend::PixelFormat format, int i
 
         // pixel format of data is not converted, renderFormat can be different from pixelFormat
         // it will be done later
-        updateWithMipmaps(image->getMipmaps(), image->getNumberOfMipmaps(), image->getPixelFormat(), renderFormat, imageHeight, imageWidth, image->hasPremultipliedAlpha(), index);
+        updateWithMipmaps(image->getMipmaps(), image->getNumberOfMipmaps(), image->getPixelFormat(), renderFormat, imageWidth, imageHeight, image->hasPremultipliedAlpha(), index);
     }
     else if (image->isCompressed())
     {  // !Only hardware support texture will be compression PixelFormat, otherwise, will convert to RGBA8 duraing image
@@ -379,7 +383,9 @@ bool Texture2D::updateWithMipmaps(MipmapInfo* mipmaps,
         textureDescriptor.textureFormat = pixelFormat;
         AXASSERT(textureDescriptor.textureFormat != backend::PixelFormat::NONE, "PixelFormat should not be NONE");
 
-        if (_texture->getTextureFormat() != textureDescriptor.textureFormat)
+        if (_texture->getTextureFormat() != textureDescriptor.textureFormat ||
+            (i == 0 && (_texture->getWidth() != static_cast<std::size_t>(pixelsWide) ||
+                        _texture->getHeight() != static_cast<std::size_t>(pixelsHigh))))
             _texture->updateTextureDescriptor(textureDescriptor, index);
 
         if (compressed)
@@ -433,6 +439,35 @@ bool Texture2D::updateWithMipmaps(MipmapInfo* mipmaps,
     return true;
 }
 
+bool Texture2D::initWithMipmapsFromLevel(MipmapInfo* mipmaps,
+                                         int mipmapsNum,
+                                         int baseLevel,
+                                         backend::PixelFormat pixelFormat,
+                                         int pixelsWide,
+                                         int pixelsHigh,
+                                         bool preMultipliedAlpha)
+{
+    if (!updateWithMipmaps(mipmaps, mipmapsNum, pixelFormat, pixelFormat, (std::max)(pixelsWide >> baseLevel, 1),
+                           (std::max)(pixelsHigh >> baseLevel, 1), preMultipliedAlpha))
+        return false;
+
+    // texture coordinates are normalized, so the smaller texture maps the same as the full one
+    _contentSize = Vec2((float)pixelsWide, (float)pixelsHigh);
+    _pixelsWide  = pixelsWide;
+    _pixelsHigh  = pixelsHigh;
+    return true;
+}
+
+void Texture2D::requestStreamedDetail(float texelsPerPixel)
+{
+    if (!_streamedInfo)
+        return;
+
+    int level = texelsPerPixel > 1.0f ? static_cast<int>(std::log2(texelsPerPixel)) : 0;
+    if (level < _streamedInfo->requestedLevel)
+        _streamedInfo->requestedLevel = level;
+}
+
 bool Texture2D::updateWithSubData(void* data, int offsetX, int offsetY, int width, int height, int index)
 {
     if (_texture && width > 0 && height > 0)
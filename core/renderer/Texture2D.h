@@ -41,6 +41,7 @@ NS_AX_BEGIN
 class Image;
 class NinePatchInfo;
 class SpriteFrame;
+struct StreamedTextureInfo;
 typedef struct _MipmapInfo MipmapInfo;
 
 namespace ui
@@ -373,6 +374,15 @@ public:
 
     std::string getPath() const { return _filePath; }
 
+    /** Whether the mipmaps of the texture are streamed by the TextureStreamer. */
+    bool isStreamed() const { return _streamedInfo != nullptr; }
+
+    /**
+     * Records how detailed a streamed texture is drawn this frame, the TextureStreamer loads the matching mipmap.
+     * @param texelsPerPixel The number of texels of level 0 drawn per screen pixel.
+     */
+    void requestStreamedDetail(float texelsPerPixel);
+
 private:
     /**
      * A struct for storing 9-patch image capInsets.
@@ -419,6 +429,18 @@ private:
 
     void initProgram();
 
+    /**
+     * Uploads the mipmaps of a pixelsWide x pixelsHigh texture from baseLevel on, the texture keeps the size of
+     * level 0 and renders at the resolution of baseLevel.
+     */
+    bool initWithMipmapsFromLevel(MipmapInfo* mipmaps,
+                                  int mipmapsNum,
+                                  int baseLevel,
+                                  backend::PixelFormat pixelFormat,
+                                  int pixelsWide,
+                                  int pixelsHigh,
+                                  bool preMultipliedAlpha);
+
 protected:
     /** pixel format of the texture */
     backend::PixelFormat _pixelFormat;
@@ -448,10 +470,13 @@ protected:
     friend class SpriteFrameCache;
     friend class TextureCache;
     friend class ui::Scale9Sprite;
+    friend class TextureStreamer;
 
     bool _valid;
     std::string _filePath;
 
+    StreamedTextureInfo* _streamedInfo = nullptr;
+
     backend::ProgramState* _programState = nullptr;
     backend::UniformLocation _mvpMatrixLocation;
     backend::UniformLocation _textureLocation;
@@ -72,6 +72,7 @@ TextureCache::~TextureCache()
         texture.second->release();
 
     AX_SAFE_DELETE(_loadingThread);
+    AX_SAFE_DELETE(_streamer);
 }
 
 std::string TextureCache::getDescription() const
@@ -340,7 +341,8 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
                 // generate texture in render thread
                 texture = new Texture2D();
 
-                texture->initWithImage(image, asyncStruct->pixelFormat);
+                if (!_streamer || !_streamer->initTexture(texture, image))
+                    texture->initWithImage(image, asyncStruct->pixelFormat);
                 // parse 9-patch info
                 this->parseNinePatchImage(image, texture, asyncStruct->filename);
 #if AX_ENABLE_CACHE_TEXTURE_DATA
@@ -464,7 +466,7 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 
             texture = new Texture2D();
 
-            if (texture->initWithImage(image, format))
+            if ((_streamer && _streamer->initTexture(texture, image)) || texture->initWithImage(image, format))
             {
 #if AX_ENABLE_CACHE_TEXTURE_DATA
                 // cache the texture file name
@@ -751,6 +753,18 @@ void TextureCache::waitForQuit()
         _loadingThread->join();
 }
 
+void TextureCache::setStreamingBudget(size_t budget)
+{
+    if (!_streamer)
+        _streamer = new TextureStreamer();
+    _streamer->setBudget(budget);
+}
+
+size_t TextureCache::getStreamingBudget() const
+{
+    return _streamer ? _streamer->getBudget() : 0;
+}
+
 std::string TextureCache::getCachedTextureInfo() const
 {
     std::string buffer;
@@ -781,6 +795,10 @@ std::string TextureCache::getCachedTextureInfo() const
              (long)count, (long)totalBytes / 1024, totalBytes / (1024.0f * 1024.0f));
     buffer += buftmp;
 
+    if (_streamer)
+        buffer += fmt::format("TextureCache streamed mipmaps: {} KB resident, {} KB budget\n",
+                              _streamer->getResidentSize() / 1024, _streamer->getBudget() / 1024);
+
     return buffer;
 }
 
@@ -982,6 +1000,12 @@ void VolatileTextureMgr::reloadTexture(Texture2D* texture, std::string_view file
     if (!texture)
         return;
 
+    if (texture->isStreamed())
+    {
+        Director::getInstance()->getTextureCache()->getStreamer()->reloadTexture(texture);
+        return;
+    }
+
     Image image;
 
     if (image.initWithImageFile(filename))
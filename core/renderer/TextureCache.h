@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "base/Object.h"
 #include "renderer/Texture2D.h"
 #include "platform/Image.h"
+#include "renderer/TextureStreamer.h"
 
 #if AX_ENABLE_CACHE_TEXTURE_DATA
 #    include <list>
@@ -223,6 +224,16 @@ public:
      */
     void renameTextureWithKey(std::string_view srcName, std::string_view dstName);
 
+    /** Sets the memory budget of texture streaming in bytes, 0 disables streaming, which is the default.
+     * The large mipmapped compressed textures loaded from files while a budget is set are created from their small
+     * mipmaps, their large ones are streamed when the textures are drawn large enough, see TextureStreamer.
+     */
+    void setStreamingBudget(size_t budget);
+    size_t getStreamingBudget() const;
+
+    /** Gets the texture streamer, nullptr if no streaming budget was ever set. */
+    TextureStreamer* getStreamer() const { return _streamer; }
+
 private:
     void addImageAsyncCallBack(float dt);
     void loadImage();
@@ -249,6 +260,8 @@ protected:
 
     hlookup::string_map<Texture2D*> _textures;
 
+    TextureStreamer* _streamer = nullptr;
+
     static std::string s_etc1AlphaFileSuffix;
 };
 
@@ -0,0 +1,310 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/TextureStreamer.h"
+
+#include <algorithm>
+
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/Scheduler.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/Texture2D.h"
+
+NS_AX_BEGIN
+
+// the loads in flight, each one holds the levels it reads in memory until they're uploaded
+static constexpr int MAX_LOADING_COUNT = 2;
+
+TextureStreamer::TextureStreamer()
+{
+    Director::getInstance()->getScheduler()->schedule([this](float) { update(); }, this, 0, false, "TextureStreamer");
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    Director::getInstance()->getScheduler()->unschedule("TextureStreamer", this);
+
+    // the textures may outlive the streamer, they keep their resident levels
+    for (auto texture : _textures)
+    {
+        delete texture->_streamedInfo;
+        texture->_streamedInfo = nullptr;
+    }
+}
+
+size_t TextureStreamer::getLevelsSize(const StreamedTextureInfo& info, int fromLevel)
+{
+    size_t size = 0;
+    for (int level = fromLevel; level < static_cast<int>(info.levels.size()); ++level)
+        size += info.levels[level].size;
+    return size;
+}
+
+size_t TextureStreamer::getResidentSize() const
+{
+    size_t size = 0;
+    for (auto texture : _textures)
+        size += getLevelsSize(*texture->_streamedInfo, texture->_streamedInfo->residentLevel);
+    return size;
+}
+
+bool TextureStreamer::initTexture(Texture2D* texture, Image* image)
+{
+    if (_budget == 0 || texture->_streamedInfo || !image->isCompressed())
+        return false;
+
+    const int mipmapsNum = image->getNumberOfMipmaps();
+    const int width      = image->getWidth();
+    const int height     = image->getHeight();
+
+    int tailLevel = 0;
+    while (tailLevel < mipmapsNum - 1 && (std::max)(width >> tailLevel, height >> tailLevel) > TAIL_SIZE)
+        ++tailLevel;
+    if (tailLevel == 0)
+        return false;
+
+    std::vector<StreamedTextureInfo::Level> levels;
+    levels.reserve(mipmapsNum);
+    for (int level = 0; level < mipmapsNum; ++level)
+    {
+        auto fileOffset = image->getMipmapFileOffset(level);
+        if (fileOffset < 0)
+            return false;
+        levels.push_back({static_cast<int64_t>(fileOffset), static_cast<uint32_t>(image->getMipmaps()[level].len)});
+    }
+
+    auto info                = new StreamedTextureInfo();
+    info->streamer           = this;
+    info->filePath           = image->getFilePath();
+    info->pixelFormat        = image->getPixelFormat();
+    info->pixelsWide         = width;
+    info->pixelsHigh         = height;
+    info->premultipliedAlpha = image->hasPremultipliedAlpha();
+    info->levels             = std::move(levels);
+    info->tailLevel          = tailLevel;
+    info->residentLevel      = tailLevel;
+    info->requestedLevel     = INT32_MAX;
+    info->loadingLevel       = -1;
+    info->lastDrawnFrame     = _frame;
+
+    info->tail.reserve(getLevelsSize(*info, tailLevel));
+    for (int level = tailLevel; level < mipmapsNum; ++level)
+    {
+        auto& mipmap = image->getMipmaps()[level];
+        info->tail.insert(info->tail.end(), mipmap.address, mipmap.address + mipmap.len);
+    }
+
+    texture->_streamedInfo = info;
+    texture->_filePath     = info->filePath;
+    _textures.push_back(texture);
+
+    uploadLevels(texture, tailLevel, nullptr);
+    return true;
+}
+
+void TextureStreamer::reloadTexture(Texture2D* texture)
+{
+    if (texture->_streamedInfo)
+        uploadLevels(texture, texture->_streamedInfo->tailLevel, nullptr);
+}
+
+void TextureStreamer::removeTexture(Texture2D* texture)
+{
+    auto it = std::find(_textures.begin(), _textures.end(), texture);
+    if (it == _textures.end())
+        return;
+
+    _textures.erase(it);
+    delete texture->_streamedInfo;
+    texture->_streamedInfo = nullptr;
+}
+
+void TextureStreamer::update()
+{
+    ++_frame;
+
+    _infos.clear();
+    for (auto texture : _textures)
+        _infos.push_back(texture->_streamedInfo);
+    planUpdate(_infos, _budget, _frame, MAX_LOADING_COUNT - _loadingCount, _plan);
+
+    for (auto index : _plan.drops)
+        dropLevels(_textures[index]);
+    for (auto&& [index, level] : _plan.loads)
+        loadLevels(_textures[index], level);
+
+    for (auto texture : _textures)
+        texture->_streamedInfo->requestedLevel = INT32_MAX;
+}
+
+void TextureStreamer::planUpdate(const std::vector<StreamedTextureInfo*>& infos,
+                                 size_t budget,
+                                 uint32_t frame,
+                                 int loadSlots,
+                                 UpdatePlan& plan)
+{
+    plan.drops.clear();
+    plan.loads.clear();
+
+    size_t committedSize = 0;
+    for (auto info : infos)
+    {
+        if (info->requestedLevel != INT32_MAX)
+            info->lastDrawnFrame = frame;
+        committedSize += getLevelsSize(*info, info->loadingLevel >= 0 ? info->loadingLevel : info->residentLevel);
+    }
+
+    auto& candidates = plan.candidates;
+    candidates.clear();
+    for (size_t i = 0; i < infos.size(); ++i)
+        candidates.push_back(i);
+
+    // over the budget, the textures drawn least recently drop their streamed levels
+    if (committedSize > budget)
+    {
+        std::stable_sort(candidates.begin(), candidates.end(), [&infos](size_t a, size_t b) {
+            return infos[a]->lastDrawnFrame < infos[b]->lastDrawnFrame;
+        });
+        for (auto index : candidates)
+        {
+            if (committedSize <= budget)
+                break;
+
+            auto info = infos[index];
+            if (info->residentLevel == info->tailLevel || info->loadingLevel >= 0)
+                continue;
+
+            committedSize -= getLevelsSize(*info, info->residentLevel) - info->tail.size();
+            plan.drops.push_back(index);
+        }
+    }
+
+    // load the levels the textures were drawn at, the most blurred ones first, as far as the budget allows
+    auto isSharpEnough = [&infos, &plan](size_t index) {
+        auto info = infos[index];
+        return info->loadingLevel >= 0 || info->requestedLevel >= info->residentLevel ||
+               std::find(plan.drops.begin(), plan.drops.end(), index) != plan.drops.end();
+    };
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), isSharpEnough), candidates.end());
+    std::stable_sort(candidates.begin(), candidates.end(), [&infos](size_t a, size_t b) {
+        return infos[a]->residentLevel - infos[a]->requestedLevel > infos[b]->residentLevel - infos[b]->requestedLevel;
+    });
+    for (auto index : candidates)
+    {
+        if (static_cast<int>(plan.loads.size()) >= loadSlots)
+            break;
+
+        auto info         = infos[index];
+        auto residentSize = getLevelsSize(*info, info->residentLevel);
+        for (int level = info->requestedLevel; level < info->residentLevel; ++level)
+        {
+            auto size = getLevelsSize(*info, level);
+            if (committedSize + size - residentSize <= budget)
+            {
+                committedSize += size - residentSize;
+                plan.loads.emplace_back(index, level);
+                break;
+            }
+        }
+    }
+}
+
+void TextureStreamer::dropLevels(Texture2D* texture)
+{
+    uploadLevels(texture, texture->_streamedInfo->tailLevel, nullptr);
+}
+
+void TextureStreamer::loadLevels(Texture2D* texture, int level)
+{
+    auto info          = texture->_streamedInfo;
+    info->loadingLevel = level;
+    ++_loadingCount;
+
+    // the texture is retained until the levels are uploaded, a destroyed streamer clears _streamedInfo
+    texture->retain();
+
+    auto data   = std::make_shared<std::vector<uint8_t>>();
+    auto levels = std::vector<StreamedTextureInfo::Level>(info->levels.begin() + level,
+                                                          info->levels.begin() + info->tailLevel);
+    auto read   = [data, path = info->filePath, levels = std::move(levels)]() {
+        auto stream = FileUtils::getInstance()->openFileStream(path, IFileStream::Mode::READ);
+        if (!stream)
+            return;
+
+        size_t size = 0;
+        for (auto& streamedLevel : levels)
+            size += streamedLevel.size;
+        data->resize(size);
+
+        auto out = data->data();
+        for (auto& streamedLevel : levels)
+        {
+            if (stream->seek(streamedLevel.fileOffset, SEEK_SET) != streamedLevel.fileOffset ||
+                stream->read(out, streamedLevel.size) != static_cast<int>(streamedLevel.size))
+            {
+                data->clear();
+                return;
+            }
+            out += streamedLevel.size;
+        }
+    };
+    auto upload = [texture, level, data]() {
+        if (auto info = texture->_streamedInfo)
+        {
+            --info->streamer->_loadingCount;
+            info->loadingLevel = -1;
+            if (!data->empty())
+                info->streamer->uploadLevels(texture, level, data->data());
+            else
+                AXLOGW("TextureStreamer: failed to read the mipmaps of {}", info->filePath);
+        }
+        texture->release();
+    };
+    Director::getInstance()->getJobSystem()->enqueue(std::move(read), std::move(upload));
+}
+
+void TextureStreamer::uploadLevels(Texture2D* texture, int level, const uint8_t* data)
+{
+    auto info = texture->_streamedInfo;
+
+    // an image has at most 16 mipmaps, see Image::MIPMAP_MAX
+    MipmapInfo mipmaps[16];
+    const int mipmapsNum = static_cast<int>(info->levels.size()) - level;
+    const uint8_t* tail  = info->tail.data();
+    for (int i = 0; i < mipmapsNum; ++i)
+    {
+        auto& source       = level + i < info->tailLevel ? data : tail;
+        mipmaps[i].address = const_cast<uint8_t*>(source);
+        mipmaps[i].len     = static_cast<int>(info->levels[level + i].size);
+        source += mipmaps[i].len;
+    }
+
+    if (texture->initWithMipmapsFromLevel(mipmaps, mipmapsNum, level, info->pixelFormat, info->pixelsWide,
+                                          info->pixelsHigh, info->premultipliedAlpha))
+        info->residentLevel = level;
+}
+
+NS_AX_END
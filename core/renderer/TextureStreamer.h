@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+#include "renderer/backend/Enums.h"
+
+NS_AX_BEGIN
+
+class Image;
+class Texture2D;
+class TextureStreamer;
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+
+/** The streaming state of a texture, see TextureStreamer. */
+struct StreamedTextureInfo
+{
+    struct Level
+    {
+        int64_t fileOffset;
+        uint32_t size;
+    };
+
+    TextureStreamer* streamer;
+    std::string filePath;
+    backend::PixelFormat pixelFormat;
+    int pixelsWide;
+    int pixelsHigh;
+    bool premultipliedAlpha;
+
+    std::vector<Level> levels;
+    /// The levels from tailLevel on, they're always resident and kept in memory for re-uploading the chain.
+    std::vector<uint8_t> tail;
+    int tailLevel;
+
+    /// The most detailed level on the GPU.
+    int residentLevel;
+    /// The most detailed level drawn since the last update, INT32_MAX if the texture wasn't drawn.
+    int requestedLevel;
+    /// The level being loaded, -1 if none.
+    int loadingLevel;
+    uint32_t lastDrawnFrame;
+};
+
+/**
+ * Streams the mipmaps of large mipmapped compressed textures.
+ *
+ * A streamed texture is created from the small mipmaps of its image only, the others are read from the image file
+ * on worker threads once the texture is drawn large enough to need them. The resident mipmaps of all streamed
+ * textures are kept under a memory budget, the textures which weren't drawn for the longest time drop their large
+ * mipmaps first when it's exceeded.
+ *
+ * The streamer is owned by the TextureCache, see TextureCache::setStreamingBudget.
+ */
+class AX_DLL TextureStreamer
+{
+public:
+    /** The textures whose level 0 isn't larger than this are never streamed. */
+    static constexpr int TAIL_SIZE = 256;
+
+    TextureStreamer();
+    ~TextureStreamer();
+
+    /** Sets the memory budget of the resident mipmaps of all streamed textures, in bytes. */
+    void setBudget(size_t budget) { _budget = budget; }
+    size_t getBudget() const { return _budget; }
+
+    /** Gets the memory of the resident mipmaps of all streamed textures, in bytes. */
+    size_t getResidentSize() const;
+
+    /**
+     * Initializes a texture from the small mipmaps of an image and streams the others.
+     * @return false if the image can't be streamed, e.g. it isn't a mipmapped compressed image or it was loaded
+     * from a compressed file, the texture is left untouched then.
+     */
+    bool initTexture(Texture2D* texture, Image* image);
+
+    /** Re-uploads the resident mipmaps of a texture, e.g. after the renderer was recreated. */
+    void reloadTexture(Texture2D* texture);
+
+    /** Stops streaming a texture, called when it's destroyed. */
+    void removeTexture(Texture2D* texture);
+
+    /** Loads the mipmaps the textures were drawn at and drops them to keep the budget, called every frame. */
+    void update();
+
+    /** The levels update drops and loads in a frame, indices in the textures passed to planUpdate. */
+    struct UpdatePlan
+    {
+        std::vector<size_t> drops;                  ///< the textures to drop to their tail level, in order
+        std::vector<std::pair<size_t, int>> loads;  ///< the textures to load and the level to load, in order
+        std::vector<size_t> candidates;
+    };
+
+    /**
+     * Chooses the levels to drop and load in a frame without touching the textures.
+     * Over the budget, the textures drawn least recently are dropped first. Then the textures drawn more detailed
+     * than their resident level are loaded, the most blurred first, as far as the budget and the load slots allow.
+     * The textures dropped in a frame aren't loaded in the same frame.
+     *
+     * @param infos The streaming state of the textures, lastDrawnFrame is set to frame for the drawn ones.
+     * @param loadSlots The number of loads which can be started.
+     */
+    static void planUpdate(const std::vector<StreamedTextureInfo*>& infos,
+                           size_t budget,
+                           uint32_t frame,
+                           int loadSlots,
+                           UpdatePlan& plan);
+
+private:
+    static size_t getLevelsSize(const StreamedTextureInfo& info, int fromLevel);
+
+    void dropLevels(Texture2D* texture);
+    void loadLevels(Texture2D* texture, int level);
+    void uploadLevels(Texture2D* texture, int level, const uint8_t* data);
+
+    std::vector<Texture2D*> _textures;
+    std::vector<StreamedTextureInfo*> _infos;
+    UpdatePlan _plan;
+    size_t _budget    = 0;
+    uint32_t _frame   = 0;
+    int _loadingCount = 0;
+};
+
+// end of _2d group
+/// @}
+
+NS_AX_END
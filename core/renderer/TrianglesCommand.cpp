@@ -84,6 +84,13 @@ void TrianglesCommand::updateMaterialID()
 TrianglesCommand::~TrianglesCommand() {}
 
 void TrianglesCommand::generateMaterialID()
+{
+    _materialID = computeMaterialID(_texture, _batchId, _blendType);
+}
+
+uint32_t TrianglesCommand::computeMaterialID(backend::TextureBackend* texture,
+                                             uint64_t batchId,
+                                             const BlendFunc& blendType)
 {
     struct
     {
@@ -98,11 +105,11 @@ void TrianglesCommand::generateMaterialID()
     // are set to random values by different compilers.
     memset(&hashMe, 0, sizeof(hashMe));
 
-    hashMe.texture = _texture;
-    hashMe.src     = _blendType.src;
-    hashMe.dst     = _blendType.dst;
-    hashMe.batchId = _batchId;
-    _materialID    = XXH32((const void*)&hashMe, sizeof(hashMe), 0);
+    hashMe.texture = texture;
+    hashMe.src     = blendType.src;
+    hashMe.dst     = blendType.dst;
+    hashMe.batchId = batchId;
+    return XXH32((const void*)&hashMe, sizeof(hashMe), 0);
 }
 
 NS_AX_END
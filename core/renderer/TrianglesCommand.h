@@ -106,6 +106,12 @@ public:
     /** update material ID */
     void updateMaterialID();
 
+    /**
+     * Compute the material ID shared by every command that can be drawn in the same batch,
+     * @see CustomCommand::setBatchTriangles.
+     */
+    static uint32_t computeMaterialID(backend::TextureBackend* texture, uint64_t batchId, const BlendFunc& blendType);
+
 protected:
     /**Generate the material ID by textureID, glProgramState, and blend function.*/
     void generateMaterialID();
@@ -73,6 +73,26 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) = 0;
 
+    /**
+     * @brief Map a buffer sub-region for writing without synchronizing with the GPU.
+     * The caller must make sure the GPU no longer reads the region, see `DriverBase::newFence`.
+     * @param offset Specifies the byte offset of the region.
+     * @param size Specifies the size in bytes of the region.
+     * @return A pointer to the region or nullptr if the buffer can't be mapped, use `updateSubData` instead then.
+     */
+    virtual void* mapRange(std::size_t /*offset*/, std::size_t /*size*/) { return nullptr; }
+
+    /**
+     * Finish writing to the region returned by `mapRange`.
+     */
+    virtual void unmapRange() {}
+
+    /**
+     * @brief Replace the data store with a new one of the same size, pending draws keep reading the old store.
+     * @return false if the buffer can't be orphaned.
+     */
+    virtual bool orphan() { return false; }
+
     /**
      * Get buffer size in bytes.
      * @return The buffer size in bytes.
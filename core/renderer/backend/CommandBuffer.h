@@ -130,8 +130,9 @@ public:
     /**
      * Set a global buffer for all vertex shaders at the given bind point index 0.
      * @param buffer The vertex buffer to be setted in the buffer argument table.
+     * @param offset Byte offset of the first vertex within the buffer.
      */
-    virtual void setVertexBuffer(Buffer* buffer) = 0;
+    virtual void setVertexBuffer(Buffer* buffer, std::size_t offset = 0) = 0;
 
     /**
      * Set unifroms and textures
@@ -220,6 +221,16 @@ public:
      */
     virtual void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) = 0;
 
+    /**
+     * Get a screen snapshot without stalling the pipeline, the callback is invoked by a later `endFrame`
+     * once the GPU finished the copy. Backends without fences fall back to `readPixels`.
+     * @param callback A callback to deal with screen snapshot image.
+     */
+    virtual void readPixelsAsync(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+    {
+        readPixels(rt, std::move(callback));
+    }
+
     /**
      * Update both front and back stencil reference value.
      * @param value Specifies stencil reference value.
@@ -98,11 +98,30 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      * @return A Buffer object.
      */
     virtual Buffer* newBuffer(size_t size, BufferType type, BufferUsage usage) = 0;
 
+    /**
+     * Insert a fence after the commands submitted so far.
+     * @return A fence handle, 0 if the driver doesn't support fences.
+     */
+    virtual uintptr_t newFence() { return 0; }
+
+    /**
+     * Wait until the GPU passed a fence.
+     * @param fence The fence returned by `newFence`.
+     * @param timeoutNs Nanoseconds to wait at most, 0 only polls the fence.
+     * @return true if the GPU passed the fence, false if the timeout expired.
+     */
+    virtual bool waitFence(uintptr_t /*fence*/, uint64_t /*timeoutNs*/) { return true; }
+
+    /**
+     * Delete a fence returned by `newFence`.
+     */
+    virtual void deleteFence(uintptr_t /*fence*/) {}
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -37,7 +37,8 @@ NS_AX_BACKEND_BEGIN
 enum class BufferUsage : uint32_t
 {
     STATIC,
-    DYNAMIC
+    DYNAMIC,
+    STREAM
 };
 
 enum class BufferType : uint32_t
@@ -137,7 +137,7 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      * @return A Buffer object.
      */
     Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
@@ -201,6 +201,15 @@ void TextureMTL::updateSamplerDescriptor(const SamplerDescriptor& sampler)
 
 void TextureMTL::updateTextureDescriptor(const ax::backend::TextureDescriptor& descriptor, int index)
 {
+    // a metal texture can't change its size or format, recreate it, e.g. for a streamed texture changing its
+    // resident mipmaps
+    if (index < AX_META_TEXTURES && _textureInfo._mtlTextures[index] &&
+        (descriptor.width != _width || descriptor.height != _height || descriptor.textureFormat != _textureFormat))
+    {
+        [_textureInfo._mtlTextures[index] release];
+        _textureInfo._mtlTextures[index] = nil;
+    }
+
     TextureBackend::updateTextureDescriptor(descriptor, index);
 
     _textureInfo._descriptor = descriptor;
@@ -42,6 +42,8 @@ GLenum toGLUsage(const BufferUsage& usage)
         return GL_STATIC_DRAW;
     case BufferUsage::DYNAMIC:
         return GL_DYNAMIC_DRAW;
+    case BufferUsage::STREAM:
+        return GL_STREAM_DRAW;
     default:
         return GL_DYNAMIC_DRAW;
     }
@@ -52,6 +54,9 @@ BufferGL::BufferGL(std::size_t size, BufferType type, BufferUsage usage) : Buffe
 {
     glGenBuffers(1, &_buffer);
 
+    if (BufferUsage::STREAM == usage)
+        allocateStreamStorage();
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     _backToForegroundListener =
         EventListenerCustom::create(EVENT_RENDERER_RECREATED, [this](EventCustom*) { this->reloadBuffer(); });
@@ -81,6 +86,13 @@ void BufferGL::reloadBuffer()
 {
     glGenBuffers(1, &_buffer);
 
+    if (BufferUsage::STREAM == _usage)
+    {
+        _persistentData = nullptr;
+        allocateStreamStorage();
+        return;
+    }
+
     if (!_needDefaultStoredData)
         return;
 
@@ -102,10 +114,82 @@ void BufferGL::fillBuffer(const void* data, std::size_t offset, std::size_t size
 }
 #endif
 
+void BufferGL::allocateStreamStorage()
+{
+    auto target = __gl->bindBuffer(_type, _buffer);
+#if AX_GL_HAVE_BUFFER_SYNC && defined(GLAD_GL_H_)
+    if (GLAD_GL_ARB_buffer_storage || GLAD_GL_EXT_buffer_storage)
+    {
+        // immutable store mapped once for the buffer lifetime, writes don't need map/unmap calls anymore
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        if (GLAD_GL_ARB_buffer_storage)
+            glBufferStorage(target, _size, nullptr, flags);
+        else
+            glBufferStorageEXT(target, _size, nullptr, flags);
+        _persistentData = glMapBufferRange(target, 0, _size, flags);
+        CHECK_GL_ERROR_DEBUG();
+        if (_persistentData)
+        {
+            _bufferAllocated = _size;
+            return;
+        }
+
+        // the store can't be reallocated, start over with a new buffer object
+        __gl->deleteBuffer(_type, _buffer);
+        glGenBuffers(1, &_buffer);
+        target = __gl->bindBuffer(_type, _buffer);
+    }
+#endif
+    glBufferData(target, _size, nullptr, GL_STREAM_DRAW);
+    CHECK_GL_ERROR_DEBUG();
+    _bufferAllocated = _size;
+}
+
+void* BufferGL::mapRange(std::size_t offset, std::size_t size)
+{
+    AXASSERT(offset + size <= _bufferAllocated, "buffer size overflow");
+
+    if (_persistentData)
+        return static_cast<uint8_t*>(_persistentData) + offset;
+
+#if AX_GL_HAVE_BUFFER_SYNC
+    if (_buffer && BufferUsage::STATIC != _usage)
+    {
+        return glMapBufferRange(__gl->bindBuffer(_type, _buffer), offset, size,
+                                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+#endif
+    return nullptr;
+}
+
+void BufferGL::unmapRange()
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    if (!_persistentData && _buffer)
+        glUnmapBuffer(__gl->bindBuffer(_type, _buffer));
+#endif
+}
+
+bool BufferGL::orphan()
+{
+    if (_persistentData || !_buffer || !_bufferAllocated)
+        return false;
+
+    glBufferData(__gl->bindBuffer(_type, _buffer), _bufferAllocated, nullptr, toGLUsage(_usage));
+    return true;
+}
+
 void BufferGL::updateData(const void* data, std::size_t size)
 {
     assert(size && size <= _size);
 
+    if (_persistentData)
+    {
+        if (data)
+            memcpy(_persistentData, data, size);
+        return;
+    }
+
     if (_buffer)
     {
         glBufferData(__gl->bindBuffer(_type, _buffer), size, data, toGLUsage(_usage));
@@ -125,6 +209,12 @@ void BufferGL::updateSubData(const void* data, std::size_t offset, std::size_t s
     AXASSERT(_bufferAllocated != 0, "updateData should be invoke before updateSubData");
     AXASSERT(offset + size <= _bufferAllocated, "buffer size overflow");
 
+    if (_persistentData)
+    {
+        memcpy(static_cast<uint8_t*>(_persistentData) + offset, data, size);
+        return;
+    }
+
     if (_buffer)
     {
         CHECK_GL_ERROR_DEBUG();
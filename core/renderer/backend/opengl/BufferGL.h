@@ -47,7 +47,7 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      */
     BufferGL(std::size_t size, BufferType type, BufferUsage usage);
     ~BufferGL();
@@ -78,6 +78,18 @@ public:
      */
     virtual void usingDefaultStoredData(bool needDefaultStoredData) override;
 
+    /**
+     * Map a region of a dynamic or stream buffer, stream buffers stay mapped persistently where
+     * GL_ARB_buffer_storage or GL_EXT_buffer_storage is available.
+     */
+    void* mapRange(std::size_t offset, std::size_t size) override;
+    void unmapRange() override;
+
+    /**
+     * Orphan the data store with glBufferData, not possible for persistently mapped buffers.
+     */
+    bool orphan() override;
+
     /**
      * Get buffer object.
      * @return Buffer object.
@@ -85,6 +97,8 @@ public:
     inline GLuint getHandler() const { return _buffer; }
 
 private:
+    void allocateStreamStorage();
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void reloadBuffer();
     void fillBuffer(const void* data, std::size_t offset, std::size_t size);
@@ -95,6 +109,7 @@ private:
     GLuint _buffer               = 0;
     std::size_t _bufferAllocated = 0;
     char* _data                  = nullptr;
+    void* _persistentData        = nullptr;
     bool _needDefaultStoredData  = true;
 };
 // end of _opengl group
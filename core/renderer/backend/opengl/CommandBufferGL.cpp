@@ -42,6 +42,11 @@ NS_AX_BACKEND_BEGIN
 
 namespace
 {
+// frames a readback may stay in flight before endFrame waits for it
+constexpr uint32_t MAX_READBACK_LATENCY = 3;
+// pixel pack buffers kept for reuse, enough for a readback every frame
+constexpr size_t MAX_FREE_READBACK_BUFFERS = MAX_READBACK_LATENCY + 1;
+
 void applyTexture(TextureBackend* texture, int slot, int index)
 {
     switch (texture->getTextureType())
@@ -64,6 +69,16 @@ CommandBufferGL::CommandBufferGL() {}
 CommandBufferGL::~CommandBufferGL()
 {
     cleanResources();
+
+#if AX_GL_HAVE_BUFFER_SYNC
+    for (auto&& readback : _pendingReadbacks)
+    {
+        glDeleteBuffers(1, &readback.pbo);
+        DriverBase::getInstance()->deleteFence(readback.fence);
+    }
+    for (auto&& buffer : _freeReadbackBuffers)
+        glDeleteBuffers(1, &buffer.pbo);
+#endif
 }
 
 bool CommandBufferGL::beginFrame()
@@ -202,9 +217,10 @@ void CommandBufferGL::setInstanceBuffer(Buffer* buffer)
     _instanceTransformBuffer = static_cast<BufferGL*>(buffer);
 }
 
-void CommandBufferGL::setVertexBuffer(Buffer* buffer)
+void CommandBufferGL::setVertexBuffer(Buffer* buffer, std::size_t offset)
 {
     assert(buffer != nullptr);
+    _vertexBufferOffset = offset;
     if (buffer == nullptr || _vertexBuffer == buffer)
         return;
 
@@ -294,9 +310,14 @@ void CommandBufferGL::endRenderPass()
     AX_SAFE_RELEASE_NULL(_indexBuffer);
     AX_SAFE_RELEASE_NULL(_vertexBuffer);
     AX_SAFE_RELEASE_NULL(_instanceTransformBuffer);
+    _vertexBufferOffset = 0;
 }
 
-void CommandBufferGL::endFrame() {}
+void CommandBufferGL::endFrame()
+{
+    if (!_pendingReadbacks.empty())
+        resolveReadbacks();
+}
 
 void CommandBufferGL::prepareDrawing() const
 {
@@ -343,7 +364,7 @@ void CommandBufferGL::bindVertexBuffer(uint32_t& usedBits) const
         __gl->enableVertexAttribArray(attribute.index);
         glVertexAttribPointer(attribute.index, UtilsGL::getGLAttributeSize(attribute.format),
                               UtilsGL::toGLAttributeType(attribute.format), attribute.needToBeNormallized,
-                              vertexLayout->getStride(), (GLvoid*)attribute.offset);
+                              vertexLayout->getStride(), (GLvoid*)(_vertexBufferOffset + attribute.offset));
         // non-instance attrib not use divisor, so clear to 0
         __gl->clearVertexAttribDivisor(attribute.index);
         usedBits |= (1 << attribute.index);
@@ -434,24 +455,169 @@ void CommandBufferGL::setScissorRect(bool isEnabled, float x, float y, float wid
         __gl->disableScissor();
 }
 
-void CommandBufferGL::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+bool CommandBufferGL::getReadRect(RenderTarget* rt, int& x, int& y, uint32_t& width, uint32_t& height) const
 {
-    PixelBufferDescriptor pbd;
     if (rt->isDefaultRenderTarget())
     {  // read pixels from screen
-        readPixels(rt, _viewPort.x, _viewPort.y, _viewPort.width, _viewPort.height, _viewPort.width * 4, pbd);
+        x      = _viewPort.x;
+        y      = _viewPort.y;
+        width  = _viewPort.width;
+        height = _viewPort.height;
+        return true;
+    }
+
+    // we only readPixels from the COLOR0 attachment.
+    auto colorAttachment = rt->_color[0].texture;
+    if (!colorAttachment)
+        return false;
+
+    x      = 0;
+    y      = 0;
+    width  = colorAttachment->getWidth();
+    height = colorAttachment->getHeight();
+    return true;
+}
+
+void CommandBufferGL::readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+    PixelBufferDescriptor pbd;
+    int x = 0, y = 0;
+    uint32_t width = 0, height = 0;
+    if (getReadRect(rt, x, y, width, height))
+        readPixels(rt, x, y, width, height, width * 4, pbd);
+    callback(pbd);
+}
+
+void CommandBufferGL::readPixelsAsync(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback)
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    int x = 0, y = 0;
+    uint32_t width = 0, height = 0;
+    if (!getReadRect(rt, x, y, width, height))
+    {
+        callback(PixelBufferDescriptor{});
+        return;
+    }
+
+    auto rtGL = static_cast<RenderTargetGL*>(rt);
+    rtGL->bindFrameBuffer();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    PendingReadback readback;
+    readback.width  = width;
+    readback.height = height;
+    readback.pbo    = acquireReadbackBuffer(width * height * 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, 0);
+
+    if (!rtGL->isDefaultRenderTarget())
+        rtGL->unbindFrameBuffer();
+
+    readback.fence = DriverBase::getInstance()->newFence();
+    if (!readback.fence)
+    {  // no fence, the copy will be waited on when it's resolved
+        readback.frames = MAX_READBACK_LATENCY;
+    }
+    readback.callback = std::move(callback);
+    _pendingReadbacks.emplace_back(std::move(readback));
+#else
+    readPixels(rt, std::move(callback));
+#endif
+}
+
+void CommandBufferGL::resolveReadbacks()
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    auto driver = DriverBase::getInstance();
+
+    // the callbacks may queue new readbacks, resolve the current ones only
+    auto pendings = std::move(_pendingReadbacks);
+    _pendingReadbacks.clear();
+    for (auto&& readback : pendings)
+    {
+        const bool expired = ++readback.frames >= MAX_READBACK_LATENCY;
+        if (readback.fence && !driver->waitFence(readback.fence, expired ? UINT64_MAX : 0))
+        {
+            _pendingReadbacks.emplace_back(std::move(readback));
+            continue;
+        }
+
+        PixelBufferDescriptor pbd;
+        auto bytesPerRow = readback.width * 4;
+        auto bufferSize  = bytesPerRow * readback.height;
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, readback.pbo);
+        auto buffer = (uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT);
+        if (buffer)
+            pbd._data = std::move(_readbackData);
+        copyFlippedRows(buffer, readback.width, readback.height, bytesPerRow, pbd);
+        if (buffer)
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, 0);
+        releaseReadbackBuffer(readback.pbo, bufferSize);
+        driver->deleteFence(readback.fence);
+
+        readback.callback(pbd);
+
+        // the callback copies what it keeps, a steady readback of the same size doesn't reallocate
+        _readbackData = std::move(pbd._data);
+    }
+#endif
+}
+
+#if AX_GL_HAVE_BUFFER_SYNC
+GLuint CommandBufferGL::acquireReadbackBuffer(uint32_t size)
+{
+    GLuint pbo = 0;
+    auto it    = std::find_if(_freeReadbackBuffers.begin(), _freeReadbackBuffers.end(),
+                              [size](const ReadbackBuffer& buffer) { return buffer.size == size; });
+    if (it != _freeReadbackBuffers.end())
+    {
+        // the storage is overwritten by glReadPixels, no need to respecify it
+        pbo = it->pbo;
+        _freeReadbackBuffers.erase(it);
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, pbo);
     }
     else
     {
-        // we only readPixels from the COLOR0 attachment.
-        auto colorAttachment = rt->_color[0].texture;
-        if (colorAttachment)
+        glGenBuffers(1, &pbo);
+        __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    return pbo;
+}
+
+void CommandBufferGL::releaseReadbackBuffer(GLuint pbo, uint32_t size)
+{
+    // the most recently used buffers are kept, readbacks of a size no longer read age out
+    if (_freeReadbackBuffers.size() >= MAX_FREE_READBACK_BUFFERS)
+    {
+        glDeleteBuffers(1, &_freeReadbackBuffers.front().pbo);
+        _freeReadbackBuffers.erase(_freeReadbackBuffers.begin());
+    }
+    _freeReadbackBuffers.emplace_back(ReadbackBuffer{pbo, size});
+}
+#endif
+
+void CommandBufferGL::copyFlippedRows(const uint8_t* buffer,
+                                      uint32_t width,
+                                      uint32_t height,
+                                      uint32_t bytesPerRow,
+                                      PixelBufferDescriptor& pbd)
+{
+    uint8_t* wptr = nullptr;
+    if (buffer && (wptr = pbd._data.resize(bytesPerRow * height)))
+    {
+        auto rptr = buffer + (height - 1) * bytesPerRow;
+        for (int row = 0; row < height; ++row)
         {
-            readPixels(rt, 0, 0, colorAttachment->getWidth(), colorAttachment->getHeight(),
-                       colorAttachment->getWidth() * 4, pbd);
+            memcpy(wptr, rptr, bytesPerRow);
+            wptr += bytesPerRow;
+            rptr -= bytesPerRow;
         }
+        pbd._width  = width;
+        pbd._height = height;
     }
-    callback(pbd);
 }
 
 void CommandBufferGL::readPixels(RenderTarget* rt,
@@ -481,19 +647,7 @@ void CommandBufferGL::readPixels(RenderTarget* rt,
     memset(buffer, 0, bufferSize);
     glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
 #endif
-    uint8_t* wptr = nullptr;
-    if (buffer && (wptr = pbd._data.resize(bufferSize)))
-    {
-        auto rptr = buffer + (height - 1) * bytesPerRow;
-        for (int row = 0; row < height; ++row)
-        {
-            memcpy(wptr, rptr, bytesPerRow);
-            wptr += bytesPerRow;
-            rptr -= bytesPerRow;
-        }
-        pbd._width  = width;
-        pbd._height = height;
-    }
+    copyFlippedRows(buffer, width, height, bytesPerRow, pbd);
 #if AX_GLES_PROFILE != 200
     glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
     __gl->bindBuffer(BufferType::PIXEL_PACK_BUFFER, 0);
@@ -117,7 +117,7 @@ public:
      * Set a global buffer for all vertex shaders at the given bind point index 0.
      * @param buffer The vertex buffer to be setted in the buffer argument table.
      */
-    void setVertexBuffer(Buffer* buffer) override;
+    void setVertexBuffer(Buffer* buffer, std::size_t offset = 0) override;
 
     /**
      * Set unifroms and textures
@@ -204,7 +204,32 @@ public:
      */
     void readPixels(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
 
+    /**
+     * Read pixels into a pixel pack buffer and resolve them in a later endFrame once the fence signaled.
+     * @param callback A callback to deal with screen snapshot image.
+     */
+    void readPixelsAsync(RenderTarget* rt, std::function<void(const PixelBufferDescriptor&)> callback) override;
+
 protected:
+    // A readback in flight, the pixels are copied out of the pixel pack buffer once the fence signaled.
+    struct PendingReadback
+    {
+        GLuint pbo      = 0;
+        uintptr_t fence = 0;
+        uint32_t width  = 0;
+        uint32_t height = 0;
+        uint32_t frames = 0;
+        std::function<void(const PixelBufferDescriptor&)> callback;
+    };
+    // A pixel pack buffer whose readback was resolved, kept for the next readback of the same size.
+    struct ReadbackBuffer
+    {
+        GLuint pbo    = 0;
+        uint32_t size = 0;
+    };
+
+    // The readback rectangle of a render target: the viewport for screen, COLOR0 attachment otherwise.
+    bool getReadRect(RenderTarget* rt, int& x, int& y, uint32_t& width, uint32_t& height) const;
     void readPixels(RenderTarget* rt,
                     int x,
                     int y,
@@ -212,6 +237,16 @@ protected:
                     uint32_t height,
                     uint32_t bytesPerRow,
                     PixelBufferDescriptor& pbd);
+    static void copyFlippedRows(const uint8_t* buffer,
+                                uint32_t width,
+                                uint32_t height,
+                                uint32_t bytesPerRow,
+                                PixelBufferDescriptor& pbd);
+    // Resolve the readbacks whose fence signaled, waits for the ones in flight for too many frames.
+    void resolveReadbacks();
+    // Bind a pixel pack buffer of size bytes, reusing a pooled one when possible.
+    GLuint acquireReadbackBuffer(uint32_t size);
+    void releaseReadbackBuffer(GLuint pbo, uint32_t size);
 
 protected:
 
@@ -222,6 +257,7 @@ protected:
     void cleanResources();
 
     BufferGL* _vertexBuffer                   = nullptr;
+    std::size_t _vertexBufferOffset           = 0;
     ProgramState* _programState               = nullptr;
     BufferGL* _indexBuffer                    = nullptr;
     BufferGL* _instanceTransformBuffer        = nullptr;
@@ -231,6 +267,11 @@ protected:
     Viewport _viewPort;
     GLboolean _alphaTestEnabled               = false;
 
+    std::vector<PendingReadback> _pendingReadbacks;
+    std::vector<ReadbackBuffer> _freeReadbackBuffers;
+    // The storage of the resolved readbacks, reused by the next ones
+    Data _readbackData;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _backToForegroundListener = nullptr;
 #endif
@@ -201,6 +201,36 @@ Buffer* DriverGL::newBuffer(std::size_t size, BufferType type, BufferUsage usage
     return new BufferGL(size, type, usage);
 }
 
+uintptr_t DriverGL::newFence()
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    return reinterpret_cast<uintptr_t>(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+#else
+    return 0;
+#endif
+}
+
+bool DriverGL::waitFence(uintptr_t fence, uint64_t timeoutNs)
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    if (fence)
+    {
+        auto result = glClientWaitSync(reinterpret_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+        // a failed wait can't be recovered by waiting again, e.g. the fence was lost with the context
+        return result != GL_TIMEOUT_EXPIRED;
+    }
+#endif
+    return true;
+}
+
+void DriverGL::deleteFence(uintptr_t fence)
+{
+#if AX_GL_HAVE_BUFFER_SYNC
+    if (fence)
+        glDeleteSync(reinterpret_cast<GLsync>(fence));
+#endif
+}
+
 TextureBackend* DriverGL::newTexture(const TextureDescriptor& descriptor)
 {
     switch (descriptor.textureType)
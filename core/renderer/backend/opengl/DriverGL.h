@@ -58,11 +58,15 @@ public:
      * @param type Specifies the target buffer object. The symbolic constant must be BufferType::VERTEX or
      * BufferType::INDEX.
      * @param usage Specifies the expected usage pattern of the data store. The symbolic constant must be
-     * BufferUsage::STATIC, BufferUsage::DYNAMIC.
+     * BufferUsage::STATIC, BufferUsage::DYNAMIC or BufferUsage::STREAM.
      * @return A Buffer object.
      */
     Buffer* newBuffer(std::size_t size, BufferType type, BufferUsage usage) override;
 
+    uintptr_t newFence() override;
+    bool waitFence(uintptr_t fence, uint64_t timeoutNs) override;
+    void deleteFence(uintptr_t fence) override;
+
     /**
      * New a TextureBackend object, not auto released.
      * @param descriptor Specifies texture description.
@@ -26,6 +26,13 @@
 
 #include "base/Macros.h"
 
+// Fences and unsynchronized buffer mapping need GL 3.2 or GLES 3.0, WebGL can neither map buffers nor block on fences
+#if AX_GLES_PROFILE != 200 && AX_TARGET_PLATFORM != AX_PLATFORM_WASM
+#    define AX_GL_HAVE_BUFFER_SYNC 1
+#else
+#    define AX_GL_HAVE_BUFFER_SYNC 0
+#endif
+
 #if !defined(_AX_DEBUG) || _AX_DEBUG == 0
 #    define CHECK_GL_ERROR_DEBUG()
 #else
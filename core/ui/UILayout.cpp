@@ -262,7 +262,7 @@ void Layout::stencilClippingVisit(Renderer* renderer, const Mat4& parentTransfor
 
     auto afterDrawStencilCmd = renderer->nextCallbackCommand();
     afterDrawStencilCmd->init(_globalZOrder);
-    afterDrawStencilCmd->func = AX_CALLBACK_0(StencilStateManager::onAfterDrawStencil, _stencilStateManager);
+    afterDrawStencilCmd->setCallback(renderer->getFrameArena(), [this] { _stencilStateManager->onAfterDrawStencil(); });
     renderer->addCommand(afterDrawStencilCmd);
 
     int i = 0;  // used by _children
@@ -310,7 +310,7 @@ void Layout::stencilClippingVisit(Renderer* renderer, const Mat4& parentTransfor
 
     auto afterVisitCmdStencil = renderer->nextCallbackCommand();
     afterVisitCmdStencil->init(_globalZOrder);
-    afterVisitCmdStencil->func = AX_CALLBACK_0(StencilStateManager::onAfterVisit, _stencilStateManager);
+    afterVisitCmdStencil->setCallback(renderer->getFrameArena(), [this] { _stencilStateManager->onAfterVisit(); });
     renderer->addCommand(afterVisitCmdStencil);
 
     renderer->popGroup();
@@ -376,14 +376,14 @@ void Layout::scissorClippingVisit(Renderer* renderer, const Mat4& parentTransfor
 
     auto beforeVisitCmdScissor = renderer->nextCallbackCommand();
     beforeVisitCmdScissor->init(_globalZOrder);
-    beforeVisitCmdScissor->func = AX_CALLBACK_0(Layout::onBeforeVisitScissor, this);
+    beforeVisitCmdScissor->setCallback(renderer->getFrameArena(), [this] { onBeforeVisitScissor(); });
     renderer->addCommand(beforeVisitCmdScissor);
 
     ProtectedNode::visit(renderer, parentTransform, parentFlags);
 
     auto afterVisitCmdScissor = renderer->nextCallbackCommand();
     afterVisitCmdScissor->init(_globalZOrder);
-    afterVisitCmdScissor->func = AX_CALLBACK_0(Layout::onAfterVisitScissor, this);
+    afterVisitCmdScissor->setCallback(renderer->getFrameArena(), [this] { onAfterVisitScissor(); });
     renderer->addCommand(afterVisitCmdScissor);
 
     renderer->popGroup();
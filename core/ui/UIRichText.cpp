@@ -380,6 +380,10 @@ private:
 
     RichText* _richText;
 
+    int _depth       = 0;
+    bool _rootClosed = false;
+    bool _balanced   = true; /*!< false if the root element is closed before the end of the text */
+
     struct TagBehavior
     {
         bool isFontElement;
@@ -418,6 +422,9 @@ public:
 
     std::string getName() const;
 
+    /** @brief whether every element was closed in the text and the root element closed at its end */
+    bool isBalanced() const { return _balanced && _depth == 0; }
+
     void startElement(void* ctx, const char* name, const char** atts) override;
 
     void endElement(void* ctx, const char* name) override;
@@ -890,6 +897,9 @@ std::string MyXMLVisitor::getName() const
 
 void MyXMLVisitor::startElement(void* /*ctx*/, const char* elementName, const char** atts)
 {
+    if (_depth++ == 0 && _rootClosed)
+        _balanced = false;
+
     auto it = _tagTables.find(elementName);
     if (it != _tagTables.end())
     {
@@ -1096,6 +1106,12 @@ void MyXMLVisitor::startElement(void* /*ctx*/, const char* elementName, const ch
 
 void MyXMLVisitor::endElement(void* /*ctx*/, const char* elementName)
 {
+    if (--_depth <= 0)
+    {
+        _balanced   = _balanced && _depth == 0 && !_rootClosed;
+        _rootClosed = true;
+    }
+
     auto it = _tagTables.find(elementName);
     if (it != _tagTables.end())
     {
@@ -1118,6 +1134,9 @@ void MyXMLVisitor::endElement(void* /*ctx*/, const char* elementName)
 
 void MyXMLVisitor::textHandler(void* /*ctx*/, const char* str, size_t len)
 {
+    if (_depth == 0)
+        _balanced = false;
+
     std::string text(str, len);
     auto color         = getColor();
     auto face          = getFace();
@@ -1241,7 +1260,12 @@ const std::string RichText::KEY_ANCHOR_TEXT_SHADOW_BLUR_RADIUS("KEY_ANCHOR_TEXT_
 const std::string RichText::KEY_ANCHOR_TEXT_GLOW_COLOR("KEY_ANCHOR_TEXT_GLOW_COLOR");
 const std::string RichText::KEY_ID("KEY_ID");
 
-RichText::RichText() : _formatTextDirty(true), _leftSpaceWidth(0.0f)
+RichText::RichText()
+    : _formatTextDirty(true)
+    , _dirtyElementIndex(std::string::npos)
+    , _layoutWidth(0.0f)
+    , _leftSpaceWidth(0.0f)
+    , _textBalanced(false)
 {
     _defaults[KEY_VERTICAL_SPACE]           = 0.0f;
     _defaults[KEY_WRAP_MODE]                = static_cast<int>(WrapMode::WRAP_PER_WORD);
@@ -1309,26 +1333,106 @@ bool RichText::initWithXML(std::string_view origxml, const ValueMap& defaults, c
 
 bool RichText::setString(std::string_view text)
 {
-    if (_text != text)
+    if (_text == text)
+        return true;
+
+    // text appended to a string which ends with a closed tag can't continue any element of it,
+    // e.g. a chat log, only the appended part is parsed
+    const auto length = _text.length();
+    if (_textBalanced && length != 0 && _text.back() == '>' && text.length() > length &&
+        text.substr(0, length) == _text)
     {
-        _formatTextDirty = true;
+        _xmlText.clear();
+        fmt::format_to(std::back_inserter(_xmlText), FMT_COMPILE(R"(<font face="{}" size="{}" color="{}">)"),
+                       this->getFontFace(), this->getFontSize(), this->getFontColor());
+        if (_xmlText == _xmlHeader)
+            return appendString(text.substr(length));
+    }
 
-        _richElements.clear();
-        _text = text;
+    // parse the whole string, the elements before the first one which differs keep their layout
+    Vector<RichElement*> oldElements = std::move(_richElements);
+    const auto dirtyElementIndex     = _dirtyElementIndex;
+    _richElements.clear();
+    _text          = text;
+    _textBalanced  = true;
+    const bool ret = parseString(_text);
 
-        // solves to issues:
-        //  - creates defaults values
-        //  - makes sure that the xml well formed and starts with an element
-        _xmlText.clear();
-        fmt::format_to(std::back_inserter(_xmlText), FMT_COMPILE(R"(<font face="{}" size="{}" color="{}">{}</font>)"),
-                       this->getFontFace(), this->getFontSize(), this->getFontColor(), _text);
+    size_t sameCount      = 0;
+    const size_t oldCount = oldElements.size();
+    const size_t newCount = _richElements.size();
+    while (sameCount < oldCount && sameCount < newCount &&
+           isSameElement(oldElements.at(sameCount), _richElements.at(sameCount)))
+        ++sameCount;
+    _dirtyElementIndex = (sameCount == oldCount && sameCount == newCount) ? dirtyElementIndex
+                                                                          : std::min(dirtyElementIndex, sameCount);
+    return ret;
+}
+
+bool RichText::appendString(std::string_view text)
+{
+    if (text.empty())
+        return true;
+    _text.append(text);
+    return parseString(text);
+}
+
+bool RichText::parseString(std::string_view text)
+{
+    // solves to issues:
+    //  - creates defaults values
+    //  - makes sure that the xml well formed and starts with an element
+    _xmlText.clear();
+    fmt::format_to(std::back_inserter(_xmlText), FMT_COMPILE(R"(<font face="{}" size="{}" color="{}">)"),
+                   this->getFontFace(), this->getFontSize(), this->getFontColor());
+    _xmlHeader = _xmlText;
+    _xmlText.append(text);
+    _xmlText.append("</font>"sv);
+
+    MyXMLVisitor visitor(this);
+    SAXParser parser;
+    parser.setDelegator(&visitor);
+    const bool ret = parser.parseIntrusive(&_xmlText.front(), _xmlText.length(), SAXParser::ParseOption::HTML);
+    _textBalanced  = _textBalanced && ret && visitor.isBalanced();
+    return ret;
+}
 
-        MyXMLVisitor visitor(this);
-        SAXParser parser;
-        parser.setDelegator(&visitor);
-        return parser.parseIntrusive(&_xmlText.front(), _xmlText.length(), SAXParser::ParseOption::HTML);
+bool RichText::isSameElement(const RichElement* lhs, const RichElement* rhs)
+{
+    if (lhs == rhs)
+        return true;
+    if (lhs->_type != rhs->_type || lhs->_tag != rhs->_tag || lhs->_color != rhs->_color ||
+        lhs->_opacity != rhs->_opacity)
+        return false;
+
+    switch (lhs->_type)
+    {
+    case RichElement::Type::TEXT:
+    {
+        auto a = static_cast<const RichElementText*>(lhs);
+        auto b = static_cast<const RichElementText*>(rhs);
+        return a->_text == b->_text && a->_fontName == b->_fontName && a->_fontSize == b->_fontSize &&
+               a->_flags == b->_flags && a->_url == b->_url && a->_outlineColor == b->_outlineColor &&
+               a->_outlineSize == b->_outlineSize && a->_shadowColor == b->_shadowColor &&
+               a->_shadowOffset == b->_shadowOffset && a->_shadowBlurRadius == b->_shadowBlurRadius &&
+               a->_glowColor == b->_glowColor && a->_id == b->_id;
+    }
+    case RichElement::Type::IMAGE:
+    {
+        auto a = static_cast<const RichElementImage*>(lhs);
+        auto b = static_cast<const RichElementImage*>(rhs);
+        return a->_filePath == b->_filePath && a->_textureType == b->_textureType && a->_width == b->_width &&
+               a->_height == b->_height && a->_scaleX == b->_scaleX && a->_scaleY == b->_scaleY &&
+               a->_url == b->_url && a->_id == b->_id;
+    }
+    case RichElement::Type::CUSTOM:
+        return static_cast<const RichElementCustomNode*>(lhs)->_customNode ==
+               static_cast<const RichElementCustomNode*>(rhs)->_customNode;
+    case RichElement::Type::NEWLINE:
+        return static_cast<const RichElementNewLine*>(lhs)->_quantity ==
+               static_cast<const RichElementNewLine*>(rhs)->_quantity;
+    default:
+        return false;
     }
-    return true;
 }
 
 void RichText::initRenderer() {}
@@ -1336,25 +1440,34 @@ void RichText::initRenderer() {}
 void RichText::insertElement(RichElement* element, int index)
 {
     _richElements.insert(index, element);
-    _formatTextDirty = true;
+    markElementsDirty(index);
 }
 
 void RichText::pushBackElement(RichElement* element)
 {
     _richElements.pushBack(element);
-    _formatTextDirty = true;
+    markElementsDirty(_richElements.size() - 1);
 }
 
 void RichText::removeElement(int index)
 {
     _richElements.erase(index);
-    _formatTextDirty = true;
+    markElementsDirty(index);
 }
 
 void RichText::removeElement(RichElement* element)
 {
-    _richElements.eraseObject(element);
-    _formatTextDirty = true;
+    auto index = _richElements.getIndex(element);
+    if (index != -1)
+    {
+        _richElements.erase(index);
+        markElementsDirty(index);
+    }
+}
+
+void RichText::markElementsDirty(size_t index)
+{
+    _dirtyElementIndex = std::min(_dirtyElementIndex, index);
 }
 
 RichText::WrapMode RichText::getWrapMode() const
@@ -1766,167 +1879,304 @@ void RichText::setOpenUrlHandler(const OpenUrlHandler& handleOpenUrl)
 void RichText::formatText(bool force)
 {
     _formatTextDirty |= force;
+
+    // the rows of left aligned text can be reused, the others have their trailing whitespace stripped
+    const auto alignment    = static_cast<HorizontalAlignment>(_defaults.at(KEY_HORIZONTAL_ALIGNMENT).asInt());
+    const bool widthChanged = !_ignoreSize && _layoutWidth != _customSize.width;
+    if (alignment != HorizontalAlignment::LEFT && (widthChanged || _dirtyElementIndex != std::string::npos))
+        _formatTextDirty = true;
+
     if (_formatTextDirty)
     {
         this->removeAllProtectedChildren();
         _elementRenders.clear();
         _lineHeights.clear();
-        if (_ignoreSize)
+        _lineWrapped.clear();
+        _elementLayouts.clear();
+        _dirtyElementIndex = 0;
+    }
+    else if (widthChanged)
+    {
+        rewrapLines(std::min(_dirtyElementIndex, _elementLayouts.size()));
+    }
+    else if (_dirtyElementIndex == std::string::npos)
+    {
+        return;
+    }
+
+    if (_dirtyElementIndex != std::string::npos)
+    {
+        const auto first = std::min(_dirtyElementIndex, _elementLayouts.size());
+        restoreLayout(first);
+        for (size_t i = first, size = _richElements.size(); i < size; ++i)
+            layoutElement(i);
+    }
+    formatRenderers();
+    _formatTextDirty   = false;
+    _dirtyElementIndex = std::string::npos;
+    _layoutWidth       = _customSize.width;
+}
+
+void RichText::layoutElement(size_t index)
+{
+    _elementLayouts.push_back(
+        {_elementRenders.size() - 1, static_cast<size_t>(_elementRenders.back().size()), _leftSpaceWidth,
+         _lineHeights.back()});
+
+    RichElement* element = _richElements.at(index);
+    if (_ignoreSize)
+    {
+        Node* elementRenderer = nullptr;
+        switch (element->_type)
         {
-            addNewLine();
-            for (ssize_t i = 0, size = _richElements.size(); i < size; ++i)
+        case RichElement::Type::TEXT:
+        {
+            RichElementText* elmtText = static_cast<RichElementText*>(element);
+            Label* label;
+            if (FileUtils::getInstance()->isFileExist(elmtText->_fontName))
             {
-                RichElement* element  = _richElements.at(i);
-                Node* elementRenderer = nullptr;
-                switch (element->_type)
-                {
-                case RichElement::Type::TEXT:
-                {
-                    RichElementText* elmtText = static_cast<RichElementText*>(element);
-                    Label* label;
-                    if (FileUtils::getInstance()->isFileExist(elmtText->_fontName))
-                    {
-                        label = Label::createWithTTF(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    else
-                    {
-                        label = Label::createWithSystemFont(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
-                    }
-                    if (elmtText->_flags & RichElementText::ITALICS_FLAG)
-                        label->enableItalics();
-                    if (elmtText->_flags & RichElementText::BOLD_FLAG)
-                        label->enableBold();
-                    if (elmtText->_flags & RichElementText::UNDERLINE_FLAG)
-                        label->enableUnderline();
-                    if (elmtText->_flags & RichElementText::STRIKETHROUGH_FLAG)
-                        label->enableStrikethrough();
-                    if (elmtText->_flags & RichElementText::URL_FLAG)
-                        label->addComponent(UrlTouchListenerComponent::create(
-                            label, elmtText->_url, [this](std::string_view url) { openUrl(url); }));
-                    if (elmtText->_flags & RichElementText::OUTLINE_FLAG)
-                    {
-                        label->enableOutline(Color4B(elmtText->_outlineColor), elmtText->_outlineSize);
-                    }
-                    if (elmtText->_flags & RichElementText::SHADOW_FLAG)
-                    {
-                        label->enableShadow(Color4B(elmtText->_shadowColor), elmtText->_shadowOffset,
-                                            elmtText->_shadowBlurRadius);
-                    }
-                    if (elmtText->_flags & RichElementText::GLOW_FLAG)
-                    {
-                        label->enableGlow(Color4B(elmtText->_glowColor));
-                    }
-                    label->setTextColor(Color4B(elmtText->_color));
+                label = Label::createWithTTF(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
+            }
+            else
+            {
+                label = Label::createWithSystemFont(elmtText->_text, elmtText->_fontName, elmtText->_fontSize);
+            }
+            if (elmtText->_flags & RichElementText::ITALICS_FLAG)
+                label->enableItalics();
+            if (elmtText->_flags & RichElementText::BOLD_FLAG)
+                label->enableBold();
+            if (elmtText->_flags & RichElementText::UNDERLINE_FLAG)
+                label->enableUnderline();
+            if (elmtText->_flags & RichElementText::STRIKETHROUGH_FLAG)
+                label->enableStrikethrough();
+            if (elmtText->_flags & RichElementText::URL_FLAG)
+                label->addComponent(UrlTouchListenerComponent::create(
+                    label, elmtText->_url, [this](std::string_view url) { openUrl(url); }));
+            if (elmtText->_flags & RichElementText::OUTLINE_FLAG)
+            {
+                label->enableOutline(Color4B(elmtText->_outlineColor), elmtText->_outlineSize);
+            }
+            if (elmtText->_flags & RichElementText::SHADOW_FLAG)
+            {
+                label->enableShadow(Color4B(elmtText->_shadowColor), elmtText->_shadowOffset,
+                                    elmtText->_shadowBlurRadius);
+            }
+            if (elmtText->_flags & RichElementText::GLOW_FLAG)
+            {
+                label->enableGlow(Color4B(elmtText->_glowColor));
+            }
+            label->setTextColor(Color4B(elmtText->_color));
 
-                    label->setName(elmtText->_id);
+            label->setName(elmtText->_id);
 
-                    elementRenderer = label;
-                    break;
-                }
-                case RichElement::Type::IMAGE:
-                {
-                    RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
-                    if (elmtImage->_textureType == Widget::TextureResType::LOCAL)
-                        elementRenderer = Sprite::create(elmtImage->_filePath);
-                    else
-                        elementRenderer = Sprite::createWithSpriteFrameName(elmtImage->_filePath);
+            elementRenderer = label;
+            break;
+        }
+        case RichElement::Type::IMAGE:
+        {
+            RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
+            if (elmtImage->_textureType == Widget::TextureResType::LOCAL)
+                elementRenderer = Sprite::create(elmtImage->_filePath);
+            else
+                elementRenderer = Sprite::createWithSpriteFrameName(elmtImage->_filePath);
 
-                    if (elementRenderer && (elmtImage->_height != -1 || elmtImage->_width != -1))
-                    {
-                        auto currentSize = elementRenderer->getContentSize();
-                        if (elmtImage->_width != -1)
-                            elementRenderer->setScaleX((elmtImage->_width / currentSize.width) * elmtImage->_scaleX);
-                        else
-                            elementRenderer->setScaleX(elmtImage->_scaleX);
-
-                        if (elmtImage->_height != -1)
-                            elementRenderer->setScaleY((elmtImage->_height / currentSize.height) * elmtImage->_scaleY);
-                        else
-                            elementRenderer->setScaleY(elmtImage->_scaleY);
-
-                        elementRenderer->setContentSize(Vec2(currentSize.width * elementRenderer->getScaleX(),
-                                                             currentSize.height * elementRenderer->getScaleY()));
-                        elementRenderer->addComponent(
-                            UrlTouchListenerComponent::create(elementRenderer, elmtImage->_url,
-                                                      std::bind(&RichText::openUrl, this, std::placeholders::_1)));
-                        elementRenderer->setColor(element->_color);
-                        elementRenderer->setName(elmtImage->_id);
-                    }
-                    break;
-                }
-                case RichElement::Type::CUSTOM:
-                {
-                    RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
-                    elementRenderer                   = elmtCustom->_customNode;
-                    elementRenderer->setColor(element->_color);
-                    break;
-                }
-                case RichElement::Type::NEWLINE:
-                {
-                    auto* newLineMulti = static_cast<RichElementNewLine*>(element);
+            if (elementRenderer && (elmtImage->_height != -1 || elmtImage->_width != -1))
+            {
+                auto currentSize = elementRenderer->getContentSize();
+                if (elmtImage->_width != -1)
+                    elementRenderer->setScaleX((elmtImage->_width / currentSize.width) * elmtImage->_scaleX);
+                else
+                    elementRenderer->setScaleX(elmtImage->_scaleX);
+
+                if (elmtImage->_height != -1)
+                    elementRenderer->setScaleY((elmtImage->_height / currentSize.height) * elmtImage->_scaleY);
+                else
+                    elementRenderer->setScaleY(elmtImage->_scaleY);
+
+                elementRenderer->setContentSize(Vec2(currentSize.width * elementRenderer->getScaleX(),
+                                                     currentSize.height * elementRenderer->getScaleY()));
+                elementRenderer->addComponent(
+                    UrlTouchListenerComponent::create(elementRenderer, elmtImage->_url,
+                                              std::bind(&RichText::openUrl, this, std::placeholders::_1)));
+                elementRenderer->setColor(element->_color);
+                elementRenderer->setName(elmtImage->_id);
+            }
+            break;
+        }
+        case RichElement::Type::CUSTOM:
+        {
+            RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
+            elementRenderer                   = elmtCustom->_customNode;
+            elementRenderer->setColor(element->_color);
+            break;
+        }
+        case RichElement::Type::NEWLINE:
+        {
+            auto* newLineMulti = static_cast<RichElementNewLine*>(element);
 
-                    addNewLine(newLineMulti->_quantity);
-                    break;
-                }
-                default:
-                    break;
-                }
+            addNewLine(newLineMulti->_quantity);
+            break;
+        }
+        default:
+            break;
+        }
 
-                if (elementRenderer)
-                {
-                    elementRenderer->setOpacity(element->_opacity);
-                    pushToContainer(elementRenderer);
-                }
-            }
+        if (elementRenderer)
+        {
+            elementRenderer->setOpacity(element->_opacity);
+            pushToContainer(elementRenderer);
         }
-        else
+    }
+    else
+    {
+        switch (element->_type)
         {
-            addNewLine();
-            for (ssize_t i = 0, size = _richElements.size(); i < size; ++i)
-            {
-                RichElement* element = _richElements.at(i);
-                switch (element->_type)
-                {
-                case RichElement::Type::TEXT:
-                {
-                    RichElementText* elmtText = static_cast<RichElementText*>(element);
-                    handleTextRenderer(elmtText->_text, elmtText->_fontName, elmtText->_fontSize, elmtText->_color,
-                                       elmtText->_opacity, elmtText->_flags, elmtText->_url, elmtText->_outlineColor,
-                                       elmtText->_outlineSize, elmtText->_shadowColor, elmtText->_shadowOffset,
-                                       elmtText->_shadowBlurRadius, elmtText->_glowColor, elmtText->_id);
-                    break;
-                }
-                case RichElement::Type::IMAGE:
-                {
-                    RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
-                    handleImageRenderer(elmtImage->_filePath, elmtImage->_textureType, elmtImage->_color,
-                                        elmtImage->_opacity, elmtImage->_width, elmtImage->_height, elmtImage->_url,
-                                        elmtImage->_scaleX, elmtImage->_scaleY, elmtImage->_id);
-                    break;
-                }
-                case RichElement::Type::CUSTOM:
-                {
-                    RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
-                    handleCustomRenderer(elmtCustom->_customNode, elmtCustom->_id);
-                    break;
-                }
-                case RichElement::Type::NEWLINE:
-                {
-                    auto* newLineMulti = static_cast<RichElementNewLine*>(element);
+        case RichElement::Type::TEXT:
+        {
+            RichElementText* elmtText = static_cast<RichElementText*>(element);
+            handleTextRenderer(elmtText->_text, elmtText->_fontName, elmtText->_fontSize, elmtText->_color,
+                               elmtText->_opacity, elmtText->_flags, elmtText->_url, elmtText->_outlineColor,
+                               elmtText->_outlineSize, elmtText->_shadowColor, elmtText->_shadowOffset,
+                               elmtText->_shadowBlurRadius, elmtText->_glowColor, elmtText->_id);
+            break;
+        }
+        case RichElement::Type::IMAGE:
+        {
+            RichElementImage* elmtImage = static_cast<RichElementImage*>(element);
+            handleImageRenderer(elmtImage->_filePath, elmtImage->_textureType, elmtImage->_color,
+                                elmtImage->_opacity, elmtImage->_width, elmtImage->_height, elmtImage->_url,
+                                elmtImage->_scaleX, elmtImage->_scaleY, elmtImage->_id);
+            break;
+        }
+        case RichElement::Type::CUSTOM:
+        {
+            RichElementCustomNode* elmtCustom = static_cast<RichElementCustomNode*>(element);
+            handleCustomRenderer(elmtCustom->_customNode, elmtCustom->_id);
+            break;
+        }
+        case RichElement::Type::NEWLINE:
+        {
+            auto* newLineMulti = static_cast<RichElementNewLine*>(element);
 
-                    addNewLine(newLineMulti->_quantity);
-                    break;
-                }
-                default:
-                    break;
-                }
-            }
+            addNewLine(newLineMulti->_quantity);
+            break;
+        }
+        default:
+            break;
         }
-        formatRenderers();
-        _formatTextDirty = false;
     }
 }
 
+void RichText::restoreLayout(size_t index)
+{
+    if (index < _elementLayouts.size())
+    {
+        const auto layout = _elementLayouts[index];
+        for (size_t row = layout.row, size = _elementRenders.size(); row < size; ++row)
+        {
+            auto& renderers = _elementRenders[row];
+            for (ssize_t i = row == layout.row ? layout.column : 0; i < renderers.size(); ++i)
+                this->removeProtectedChild(renderers.at(i));
+        }
+        _elementRenders.resize(layout.row + 1);
+        _lineHeights.resize(layout.row + 1);
+        _lineWrapped.resize(layout.row + 1);
+        _elementLayouts.resize(index);
+
+        auto& renderers = _elementRenders.back();
+        renderers.erase(renderers.begin() + layout.column, renderers.end());
+        _lineHeights.back() = layout.lineHeight;
+        _leftSpaceWidth     = layout.leftSpaceWidth;
+    }
+
+    if (_elementRenders.empty())
+        addNewLine();
+}
+
+void RichText::rewrapLines(size_t elementCount)
+{
+    auto oldLayouts     = std::move(_elementLayouts);
+    auto oldRows        = std::move(_elementRenders);
+    auto oldLineHeights = std::move(_lineHeights);
+    auto oldLineWrapped = std::move(_lineWrapped);
+    _elementLayouts.clear();
+    _elementRenders.clear();
+    _lineHeights.clear();
+    _lineWrapped.clear();
+    addNewLine();
+
+    auto isLineStart = [&](size_t index) {
+        return oldLayouts[index].column == 0 && !oldLineWrapped[oldLayouts[index].row];
+    };
+    auto getRowWidth = [](const Vector<Node*>& row) {
+        float width = 0.0f;
+        for (auto&& renderer : row)
+            width += renderer->getContentSize().width;
+        return width;
+    };
+
+    // the elements between two hard line breaks wrap independently of the others, their rows are reused if none
+    // of them was wrapped and all of them still fit
+    const float widthDelta = _customSize.width - _layoutWidth;
+    size_t rowEnd          = 0;
+    for (size_t first = 0, last = 0; first < elementCount; first = last)
+    {
+        last = first + 1;
+        while (last < oldLayouts.size() && !isLineStart(last))
+            ++last;
+        const bool lineEnds   = last < oldLayouts.size();
+        const size_t firstRow = oldLayouts[first].row;
+        rowEnd                = lineEnds ? oldLayouts[last].row : oldRows.size();
+
+        bool reusable = last <= elementCount;
+        for (size_t row = firstRow; reusable && row < rowEnd; ++row)
+            reusable = !oldLineWrapped[row] && getRowWidth(oldRows[row]) <= _customSize.width;
+
+        if (!reusable)
+        {
+            for (size_t row = firstRow; row < rowEnd; ++row)
+                for (auto&& renderer : oldRows[row])
+                    this->removeProtectedChild(renderer);
+            for (size_t i = first, end = std::min(last, elementCount); i < end; ++i)
+                layoutElement(i);
+            continue;
+        }
+
+        const size_t newRow = _elementRenders.size() - 1;
+        for (size_t i = first; i < last; ++i)
+        {
+            auto layout = oldLayouts[i];
+            layout.row  = layout.row - firstRow + newRow;
+            layout.leftSpaceWidth += widthDelta;
+            _elementLayouts.push_back(layout);
+        }
+        for (size_t row = firstRow; row < rowEnd; ++row)
+        {
+            if (row != firstRow)
+                addNewLine();
+            _elementRenders.back() = std::move(oldRows[row]);
+            _lineHeights.back()    = oldLineHeights[row];
+        }
+        if (lineEnds)
+        {
+            // the row the next line starts in
+            if (rowEnd != firstRow)
+                addNewLine();
+            _lineHeights.back() = oldLayouts[last].lineHeight;
+            _leftSpaceWidth     = oldLayouts[last].leftSpaceWidth + widthDelta;
+        }
+        else
+        {
+            _leftSpaceWidth = _customSize.width - getRowWidth(_elementRenders.back());
+        }
+    }
+
+    // the renderers of the elements which are laid out again
+    for (size_t row = rowEnd; row < oldRows.size(); ++row)
+        for (auto&& renderer : oldRows[row])
+            this->removeProtectedChild(renderer);
+}
+
 namespace
 {
 inline bool isUTF8CharWrappable(const StringUtils::StringUTF8::CharUTF8& ch)
@@ -2118,7 +2368,7 @@ void RichText::handleTextRenderer(std::string_view text,
         {
             if (splitParts > 0)
             {
-                addNewLine();
+                addWrappedLine();
                 _lineHeights.back() = fontSize;
             }
             ++splitParts;
@@ -2264,7 +2514,7 @@ void RichText::handleCustomRenderer(ax::Node* renderer, std::string_view id)
     _leftSpaceWidth -= imgSize.width;
     if (_leftSpaceWidth < 0.0f)
     {
-        addNewLine();
+        addWrappedLine();
         pushToContainer(renderer);
         _leftSpaceWidth -= imgSize.width;
     }
@@ -2281,10 +2531,17 @@ void RichText::addNewLine(int quantity)
         _leftSpaceWidth = _customSize.width;
         _elementRenders.emplace_back();
         _lineHeights.emplace_back();
+        _lineWrapped.emplace_back(false);
     }
     while (--quantity > 0);
 }
 
+void RichText::addWrappedLine()
+{
+    addNewLine();
+    _lineWrapped.back() = true;
+}
+
 void RichText::formatRenderers()
 {
     float verticalSpace = _defaults[KEY_VERTICAL_SPACE].asFloat();
@@ -2322,7 +2579,8 @@ void RichText::formatRenderers()
                     iter->setPosition(nextPosX, nextPosY);
                 }
 
-                this->addProtectedChild(iter, 1);
+                if (iter->getParent() != this)
+                    this->addProtectedChild(iter, 1);
                 newContentSizeWidth += iSize.width;
                 nextPosX += iSize.width;
                 maxY = std::max(maxY, iSize.height);
@@ -2388,7 +2646,8 @@ void RichText::formatRenderers()
                     iter->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
                     iter->setPosition(nextPosX, nextPosY);
                 }
-                this->addProtectedChild(iter, 1);
+                if (iter->getParent() != this)
+                    this->addProtectedChild(iter, 1);
                 nextPosX += iter->getContentSize().width;
             }
 
@@ -2396,9 +2655,6 @@ void RichText::formatRenderers()
         }
     }
 
-    _elementRenders.clear();
-    _lineHeights.clear();
-
     if (_ignoreSize)
     {
         Vec2 s = getVirtualRendererSize();
@@ -612,9 +612,35 @@ public:
                      const ValueMap& defaults            = ValueMap(),
                      const OpenUrlHandler& handleOpenUrl = nullptr);
 
+    /**
+     * @brief Set the rich text string.
+     * When the new string starts with the current one only the appended part is parsed, otherwise the elements
+     * which didn't change keep their layout and only the ones from the first difference on are laid out again.
+     */
     bool setString(std::string_view text);
 
+    /**
+     * @brief Append rich text to the current string, only the appended part is parsed and laid out.
+     * The text is parsed on its own: a tag must be closed in the text it's opened in, and the first text of it
+     * is a new element even if it continues the style of the text before.
+     *
+     * @param text The rich text to append.
+     * @return false if the text isn't well formed.
+     */
+    bool appendString(std::string_view text);
+
+    std::string_view getString() const { return _text; }
+
 protected:
+    /** @brief the layout state before an element, the layout can be resumed from it */
+    struct ElementLayout
+    {
+        size_t row;           /*!< the row the element starts in */
+        size_t column;        /*!< the number of renderers in that row before the element */
+        float leftSpaceWidth; /*!< the width left in that row */
+        float lineHeight;     /*!< the line height of that row */
+    };
+
     void adaptRenderers() override;
 
     void initRenderer() override;
@@ -646,6 +672,13 @@ protected:
     void handleCustomRenderer(Node* renderer, std::string_view id = ""sv);
     void formatRenderers();
     void addNewLine(int quantity = 1);
+    void addWrappedLine();
+    void layoutElement(size_t index);
+    void restoreLayout(size_t index);
+    void rewrapLines(size_t elementCount);
+    void markElementsDirty(size_t index);
+    bool parseString(std::string_view text);
+    static bool isSameElement(const RichElement* lhs, const RichElement* rhs);
     void doHorizontalAlignment(const Vector<Node*>& row, float rowWidth);
     float stripTrailingWhitespace(const Vector<Node*>& row);
 
@@ -653,6 +686,10 @@ protected:
     Vector<RichElement*> _richElements;
     std::vector<Vector<Node*>> _elementRenders;
     std::vector<float> _lineHeights;
+    std::vector<bool> _lineWrapped; /*!< whether a row continues the row before it */
+    std::vector<ElementLayout> _elementLayouts;
+    size_t _dirtyElementIndex; /*!< the first element to lay out again, npos if none */
+    float _layoutWidth;        /*!< the width the rows are wrapped to */
     float _leftSpaceWidth;
 
     ValueMap _defaults;            /*!< default values */
@@ -660,6 +697,8 @@ protected:
 
     std::string _text;
     std::string _xmlText;
+    std::string _xmlHeader; /*!< the default font tag the text was parsed with */
+    bool _textBalanced;     /*!< whether every tag of the text is closed, so text can be appended to it */
 };
 
 }  // namespace ui
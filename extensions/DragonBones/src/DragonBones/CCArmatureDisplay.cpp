@@ -18,6 +18,15 @@ CCArmatureDisplay* CCArmatureDisplay::create()
     return displayContainer;
 }
 
+CCArmatureDisplay::~CCArmatureDisplay()
+{
+    for (auto batchCommand : _batchCommands)
+    {
+        AX_SAFE_RELEASE(batchCommand->command.getPipelineDescriptor().programState);
+        delete batchCommand;
+    }
+}
+
 void CCArmatureDisplay::dbInit(Armature* armature)
 {
     _armature = armature;
@@ -114,6 +123,157 @@ ax::Rect CCArmatureDisplay::getBoundingBox() const
     return ax::RectApplyTransform(rect, getNodeToParentTransform());
 }
 
+void CCArmatureDisplay::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags)
+{
+    if (!_batchEnabled)
+    {
+        ax::Node::visit(renderer, parentTransform, parentFlags);
+        return;
+    }
+
+    if (!_visible)
+    {
+        return;
+    }
+
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+
+    // Like Node::visit, the children (child armatures, user nodes) may read the modelview matrix of the director.
+    _director->pushMatrix(ax::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    _director->loadMatrix(ax::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+
+    // The slot displays are merged by draw(), so they are not visited one by one.
+    if (isVisitableByVisitingCamera())
+    {
+        draw(renderer, _modelViewTransform, flags);
+    }
+
+    _director->popMatrix(ax::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void CCArmatureDisplay::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags)
+{
+    if (!_batchEnabled || _children.empty())
+    {
+        return;
+    }
+
+    sortAllChildren();
+    _buildBatch();
+
+    const auto& projectionMat = _director->getMatrix(ax::MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+
+    // The buffers are complete at this point, so the triangles pointers stay valid until the renderer draws them.
+    size_t commandIndex = 0;
+    for (const auto& run : _batchRuns)
+    {
+        if (run.childDisplay != nullptr)
+        {
+            run.childDisplay->visit(renderer, transform, flags);
+            continue;
+        }
+
+        auto batchCommand = _getBatchCommand(commandIndex++, run.programState);
+        auto programState = batchCommand->command.getPipelineDescriptor().programState;
+        programState->setUniform(batchCommand->mvpLocation, projectionMat.m, sizeof(projectionMat.m));
+        programState->setTexture(batchCommand->textureLocation, 0, run.texture->getBackendTexture());
+
+        ax::TrianglesCommand::Triangles triangles(_batchVertices.data() + run.vertStart,
+                                                  _batchIndices.data() + run.indexStart, run.vertCount,
+                                                  run.indexCount);
+        batchCommand->command.init(_globalZOrder, run.texture, run.blendFunc, triangles, transform, flags);
+        renderer->addCommand(&batchCommand->command);
+    }
+}
+
+void CCArmatureDisplay::_buildBatch()
+{
+    _batchVertices.clear();
+    _batchIndices.clear();
+    _batchRuns.clear();
+
+    BatchRun* currentRun = nullptr;
+    for (const auto child : _children)
+    {
+        if (!child->isVisible())
+        {
+            continue;
+        }
+
+        const auto sprite = dynamic_cast<DBCCSprite*>(child);
+        if (sprite == nullptr)
+        {
+            // Child armature or user node, keep it in draw order.
+            _batchRuns.emplace_back().childDisplay = child;
+            currentRun = nullptr;
+            continue;
+        }
+
+        const auto texture          = sprite->getTexture();
+        const auto& spriteTriangles = sprite->getPolygonInfo().triangles;
+        if (texture == nullptr || texture->getBackendTexture() == nullptr || spriteTriangles.vertCount == 0 ||
+            sprite->getDisplayedOpacity() == 0)
+        {
+            continue;
+        }
+
+        const auto programState = sprite->getProgramState();
+        const auto& blendFunc   = sprite->getBlendFunc();
+        if (currentRun == nullptr || currentRun->texture != texture ||
+            currentRun->programState->getBatchId() != programState->getBatchId() ||
+            currentRun->blendFunc != blendFunc ||
+            currentRun->vertCount + spriteTriangles.vertCount >= ax::Renderer::VBO_SIZE ||
+            currentRun->indexCount + spriteTriangles.indexCount > ax::Renderer::INDEX_VBO_SIZE)
+        {
+            currentRun               = &_batchRuns.emplace_back();
+            currentRun->texture      = texture;
+            currentRun->programState = programState;
+            currentRun->blendFunc    = blendFunc;
+            currentRun->vertStart    = static_cast<unsigned int>(_batchVertices.size());
+            currentRun->indexStart   = static_cast<unsigned int>(_batchIndices.size());
+        }
+
+        // Vertices are transformed into the armature space, indices are relative to the run.
+        const auto& slotTransform = sprite->getNodeToParentTransform();
+        const auto vertexOffset   = static_cast<unsigned short>(currentRun->vertCount);
+        for (unsigned int i = 0; i < spriteTriangles.vertCount; ++i)
+        {
+            auto& vertex = _batchVertices.emplace_back(spriteTriangles.verts[i]);
+            slotTransform.transformPoint(&vertex.vertices);
+        }
+
+        for (unsigned int i = 0; i < spriteTriangles.indexCount; ++i)
+        {
+            _batchIndices.push_back(spriteTriangles.indices[i] + vertexOffset);
+        }
+
+        currentRun->vertCount += spriteTriangles.vertCount;
+        currentRun->indexCount += spriteTriangles.indexCount;
+    }
+}
+
+CCArmatureDisplay::BatchCommand* CCArmatureDisplay::_getBatchCommand(size_t index,
+                                                                     ax::backend::ProgramState* programState)
+{
+    if (index >= _batchCommands.size())
+    {
+        _batchCommands.push_back(new BatchCommand());
+    }
+
+    // Every command owns a clone of the program state, since the texture uniform differs between runs.
+    auto batchCommand  = _batchCommands[index];
+    auto& currentState = batchCommand->command.getPipelineDescriptor().programState;
+    if (currentState == nullptr || currentState->getBatchId() != programState->getBatchId())
+    {
+        AX_SAFE_RELEASE(currentState);
+        currentState                  = programState->clone();
+        batchCommand->mvpLocation     = currentState->getUniformLocation(ax::backend::Uniform::MVP_MATRIX);
+        batchCommand->textureLocation = currentState->getUniformLocation(ax::backend::Uniform::TEXTURE);
+    }
+
+    return batchCommand;
+}
+
 DBCCSprite* DBCCSprite::create()
 {
     DBCCSprite* sprite = new DBCCSprite();
@@ -44,16 +44,42 @@ public:
     bool debugDraw;
 
 protected:
+    struct BatchRun
+    {
+        ax::Node* childDisplay = nullptr;  // child armature, visited in place
+        ax::Texture2D* texture = nullptr;
+        ax::backend::ProgramState* programState = nullptr;
+        ax::BlendFunc blendFunc;
+        unsigned int vertStart  = 0;
+        unsigned int vertCount  = 0;
+        unsigned int indexStart = 0;
+        unsigned int indexCount = 0;
+    };
+
+    struct BatchCommand
+    {
+        ax::TrianglesCommand command;
+        ax::backend::UniformLocation mvpLocation;
+        ax::backend::UniformLocation textureLocation;
+    };
+
     bool _debugDraw;
+    bool _batchEnabled;
     Armature* _armature;
     ax::EventDispatcher* _dispatcher;
 
+    std::vector<ax::V3F_C4B_T2F> _batchVertices;
+    std::vector<unsigned short> _batchIndices;
+    std::vector<BatchRun> _batchRuns;
+    std::vector<BatchCommand*> _batchCommands;
+
 public:
     CCArmatureDisplay()
         : debugDraw(false)
         ,
 
         _debugDraw(false)
+        , _batchEnabled(false)
         , _armature(nullptr)
         , _dispatcher(nullptr)
     {
@@ -61,7 +87,7 @@ public:
         setEventDispatcher(_dispatcher);
         // _dispatcher->setEnabled(true);
     }
-    virtual ~CCArmatureDisplay() {}
+    virtual ~CCArmatureDisplay();
 
 public:
     /**
@@ -109,6 +135,23 @@ public:
      * @inheritDoc
      */
     virtual ax::Rect getBoundingBox() const override;
+
+    /**
+     * Enables the batched display mode, disabled by default.
+     * In batched mode the slot displays are not visited one by one, their vertices are transformed into the
+     * armature space into one contiguous vertex/index buffer and submitted as one TrianglesCommand per run of
+     * slots sharing the same texture, blend func and program, like spine::SkeletonRenderer does.
+     * Child armatures are still visited in draw order. Per-slot culling is not performed in batched mode.
+     */
+    void setBatchEnabled(bool enabled) { _batchEnabled = enabled; }
+    bool isBatchEnabled() const { return _batchEnabled; }
+
+    virtual void visit(ax::Renderer* renderer, const ax::Mat4& parentTransform, uint32_t parentFlags) override;
+    virtual void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+protected:
+    void _buildBatch();
+    BatchCommand* _getBatchCommand(size_t index, ax::backend::ProgramState* programState);
 };
 /**
  * @internal
@@ -1191,7 +1191,7 @@ void PUParticleSystem3D::copyAttributesTo(PUParticleSystem3D* system)
         iter.second.removeAllDatas();
     }
 
-    system->setName(_name);
+    system->setName(getName());
     system->_state = _state;
     if (_render)
         system->setRender(static_cast<PURender*>(_render)->clone());
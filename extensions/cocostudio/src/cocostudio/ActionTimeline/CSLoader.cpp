@@ -35,6 +35,7 @@
 #include "2d/ParticleSystemQuad.h"
 #include "2d/FastTMXTiledMap.h"
 #include "platform/FileUtils.h"
+#include "renderer/TextureCache.h"
 
 #include "ActionTimelineCache.h"
 #include "ActionTimeline.h"
@@ -95,6 +96,7 @@
 #include "cocostudio/WidgetCallBackHandlerProtocol.h"
 
 #include <fstream>
+#include <set>
 
 using namespace ax::ui;
 using namespace cocostudio;
@@ -202,7 +204,14 @@ void CSLoader::destroyInstance()
 }
 
 CSLoader::CSLoader()
-    : _recordJsonPath(true), _jsonPath(""), _monoCocos2dxVersion(""), _rootNode(nullptr), _csBuildID("10.0.3000.0")
+    : _recordJsonPath(true)
+    , _jsonPath("")
+    , _monoCocos2dxVersion("")
+    , _rootNode(nullptr)
+    , _csBuildID("10.0.3000.0")
+    , _prototypeCacheEnabled(false)
+    , _currentPrototype(nullptr)
+    , _addedPrototypes(nullptr)
 {
     CREATE_CLASS_NODE_READER_INFO(NodeReader);
     CREATE_CLASS_NODE_READER_INFO(SingleNodeReader);
@@ -247,6 +256,11 @@ CSLoader::CSLoader()
     CREATE_CLASS_NODE_READER_INFO(TextFieldExReader);
 }
 
+CSLoader::~CSLoader()
+{
+    purgePrototypes();
+}
+
 void CSLoader::purge() {}
 
 void CSLoader::init()
@@ -357,6 +371,12 @@ ActionTimeline* CSLoader::createTimeline(std::string_view filename)
 
     if (suffix == "csb")
     {
+        auto loader = CSLoader::getInstance();
+        if (loader->_prototypeCacheEnabled)
+        {
+            auto prototype = loader->getPrototype(filename);
+            return prototype ? loader->timelineWithPrototype(prototype) : nullptr;
+        }
         return cache->createActionWithFlatBuffersFile(filename);
     }
     else if (suffix == "json" || suffix == "ExportJson")
@@ -1008,6 +1028,18 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName)
 
 Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeLoadCallback& callback)
 {
+    if (_prototypeCacheEnabled)
+    {
+        auto prototype = getPrototype(fileName);
+        if (prototype == nullptr)
+        {
+            AXLOGD("CSLoader::nodeWithFlatBuffersFile - failed read file: {}", fileName);
+            AX_ASSERT(false);
+            return nullptr;
+        }
+        return nodeWithPrototype(prototype, callback);
+    }
+
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(fileName);
 
     AX_ASSERT(FileUtils::getInstance()->isFileExist(fullPath));
@@ -1023,7 +1055,18 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
 
     auto csparsebinary = GetCSParseBinary(buf.getBytes());
 
-    auto csBuildId = csparsebinary->version();
+    if (!checkBuildId(csparsebinary->version()))
+        return nullptr;
+
+    loadSpriteFrames(csparsebinary->textures());
+
+    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
+
+    return node;
+}
+
+bool CSLoader::checkBuildId(const flatbuffers::String* csBuildId)
+{
     if (csBuildId)
     {
         int readerVersion = 0, writterVersion = 0;
@@ -1070,12 +1113,15 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
                 fmt::format("error: The csloader version not match, require version is:{}, but {} provided!",
                                     csBuildId->c_str(), _csBuildID);
             throw std::logic_error(exceptionMsg.c_str());
-            return nullptr;
+            return false;
         }
     }
+    return true;
+}
 
+void CSLoader::loadSpriteFrames(const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>* textures)
+{
     // decode plist
-    auto textures   = csparsebinary->textures();
     int textureSize = textures->size();
     for (int i = 0; i < textureSize; ++i)
     {
@@ -1085,12 +1131,290 @@ Node* CSLoader::nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeL
             SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plist);
         }
     }
+}
 
-    Node* node = nodeWithFlatBuffers(csparsebinary->nodeTree(), callback);
+void CSLoader::setPrototypeCacheEnabled(bool enabled)
+{
+    _prototypeCacheEnabled = enabled;
+    if (!enabled)
+        purgePrototypes();
+}
+
+CSLoader::Prototype* CSLoader::getPrototype(std::string_view filename)
+{
+    std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filename);
+    if (fullPath.empty())
+        return nullptr;
+
+    auto it = _prototypes.find(fullPath);
+    if (it != _prototypes.end())
+        return it->second.get();
+
+    Data buf = FileUtils::getInstance()->getDataFromFile(fullPath);
+    if (buf.isNull())
+        return nullptr;
+
+    return addPrototype(std::move(fullPath), std::move(buf));
+}
+
+CSLoader::Prototype* CSLoader::addPrototype(std::string fullPath, Data data)
+{
+    auto csparsebinary = GetCSParseBinary(data.getBytes());
+    if (!checkBuildId(csparsebinary->version()))
+        return nullptr;
+
+    auto prototype      = std::make_unique<Prototype>();
+    prototype->fullPath = fullPath;
+    prototype->nodeTree = csparsebinary->nodeTree();
+    prototype->data     = std::move(data);  // the FlatBuffers pointers stay valid, the buffer is moved not copied
+    auto inserted = _prototypes.emplace(std::move(fullPath), std::move(prototype));
+    if (inserted.second && _addedPrototypes)
+        _addedPrototypes->emplace_back(inserted.first->first);
+    return inserted.first->second.get();
+}
+
+struct CSLoader::AsyncNodeRequest
+{
+    std::string filename;
+    std::function<void(ax::Node*)> callback;
+    std::function<void(float)> progress;
+
+    std::vector<std::pair<std::string, Data>> files;  // full path & verified data, the requested file first
+    std::vector<std::string> textures;                // sprite sheet textures
+    size_t loadedTextures = 0;
+};
+
+static void collectProjectNodeFiles(const flatbuffers::NodeTree* nodetree, std::vector<std::string>& files)
+{
+    if (nodetree == nullptr)
+        return;
+
+    if (nodetree->classname()->string_view() == "ProjectNode")
+    {
+        auto projectNodeOptions = (ProjectNodeOptions*)nodetree->options()->data();
+        if (projectNodeOptions->fileName() && projectNodeOptions->fileName()->size() > 0)
+            files.emplace_back(projectNodeOptions->fileName()->c_str());
+    }
+
+    auto children = nodetree->children();
+    for (int i = 0, size = children->size(); i < size; ++i)
+        collectProjectNodeFiles(children->Get(i), files);
+}
+
+static std::string getSpriteSheetTexturePath(std::string_view plist)
+{
+    // Mirrors PlistSpriteSheetLoader, the texture is either named in the metadata or next to the plist.
+    auto fileUtils  = FileUtils::getInstance();
+    auto dict       = fileUtils->getValueMapFromFile(fileUtils->fullPathForFilename(plist));
+    auto metadataIt = dict.find("metadata");
+    if (metadataIt != dict.end() && metadataIt->second.getType() == Value::Type::MAP)
+    {
+        auto& metadataDict = metadataIt->second.asValueMap();
+        auto textureIt     = metadataDict.find("textureFileName");
+        if (textureIt != metadataDict.end() && !textureIt->second.asString().empty())
+            return fileUtils->fullPathFromRelativeFile(textureIt->second.asString(), plist);
+    }
+
+    std::string texturePath{plist};
+    const auto startPos = texturePath.find_last_of('.');
+    if (startPos != std::string::npos)
+        texturePath.erase(startPos);
+    return texturePath.append(".png");
+}
+
+void CSLoader::createNodeAsync(std::string_view filename,
+                               std::function<void(ax::Node*)> callback,
+                               std::function<void(float)> progress)
+{
+    auto request      = std::make_shared<AsyncNodeRequest>();
+    request->filename = filename;
+    request->callback = std::move(callback);
+    request->progress = std::move(progress);
+
+    auto scheduler = Director::getInstance()->getScheduler();
+    Director::getInstance()->getJobSystem()->enqueue([request, scheduler]() {
+        // Prepare phase, only FileUtils & FlatBuffers are used here.
+        auto fileUtils = FileUtils::getInstance();
+        std::vector<std::string> pending{request->filename};
+        std::set<std::string> visitedFiles, visitedPlists;
+        bool failed = false;
+        while (!pending.empty() && !failed)
+        {
+            auto fullPath = fileUtils->fullPathForFilename(pending.back());
+            pending.pop_back();
+            if (fullPath.empty() || !visitedFiles.insert(fullPath).second)
+                continue;
+
+            Data data = fileUtils->getDataFromFile(fullPath);
+            flatbuffers::Verifier verifier(data.getBytes(), data.getSize());
+            if (data.isNull() || !VerifyCSParseBinaryBuffer(verifier))
+            {
+                AXLOGW("CSLoader::createNodeAsync - failed read file: {}", fullPath);
+                // Only the requested file is mandatory, nested project nodes fall back to an empty node.
+                failed = request->files.empty();
+                continue;
+            }
+
+            auto csparsebinary = GetCSParseBinary(data.getBytes());
+            auto textures      = csparsebinary->textures();
+            for (int i = 0, size = textures->size(); i < size; ++i)
+            {
+                std::string plist = textures->Get(i)->str();
+                if (visitedPlists.insert(plist).second)
+                    request->textures.emplace_back(getSpriteSheetTexturePath(plist));
+            }
+            collectProjectNodeFiles(csparsebinary->nodeTree(), pending);
 
+            request->files.emplace_back(std::move(fullPath), std::move(data));
+        }
+
+        if (failed)
+            request->files.clear();
+
+        scheduler->runOnAxmolThread([request]() { CSLoader::getInstance()->loadAsyncTextures(request); });
+    });
+}
+
+void CSLoader::loadAsyncTextures(std::shared_ptr<AsyncNodeRequest> request)
+{
+    if (request->files.empty())
+    {
+        if (request->callback)
+            request->callback(nullptr);
+        return;
+    }
+
+    // Steps: prepared files, decoded textures and the instantiation.
+    auto reportProgress = [request]() {
+        if (request->progress)
+        {
+            auto steps = request->files.size() + request->textures.size() + 1;
+            request->progress(float(request->files.size() + request->loadedTextures) / steps);
+        }
+    };
+    reportProgress();
+
+    if (request->textures.empty())
+    {
+        finishNodeAsync(request);
+        return;
+    }
+
+    for (auto& texture : request->textures)
+    {
+        Director::getInstance()->getTextureCache()->addImageAsync(texture, [request, reportProgress](Texture2D*) {
+            ++request->loadedTextures;
+            reportProgress();
+            if (request->loadedTextures == request->textures.size())
+                CSLoader::getInstance()->finishNodeAsync(request);
+        });
+    }
+}
+
+void CSLoader::finishNodeAsync(std::shared_ptr<AsyncNodeRequest> request)
+{
+    // Instantiate phase, the sprite sheets find their textures in the TextureCache.
+    std::vector<std::string> addedPrototypes;
+    auto previousAddedPrototypes = _addedPrototypes;
+    if (!_prototypeCacheEnabled)
+        _addedPrototypes = &addedPrototypes;
+
+    for (auto& file : request->files)
+    {
+        if (_prototypes.find(file.first) == _prototypes.end())
+            addPrototype(file.first, std::move(file.second));
+    }
+
+    Node* node     = nullptr;
+    auto prototype = _prototypes.find(request->files.front().first);
+    if (prototype != _prototypes.end())
+    {
+        node = nodeWithPrototype(prototype->second.get(), nullptr);
+        reconstructNestNode(node);
+        ActionTimelineCache::getInstance()->loadAnimationWithDataBuffer(prototype->second->data, request->filename);
+    }
+
+    // Without the cache the prototypes added for this instantiation only live for it, including the nested files that
+    // failed the worker verification and were loaded by getPrototype meanwhile. The others may be used by other loads.
+    _addedPrototypes = previousAddedPrototypes;
+    for (auto& fullPath : addedPrototypes)
+    {
+        auto it = _prototypes.find(fullPath);
+        if (it != _prototypes.end())
+        {
+            AX_SAFE_RELEASE(it->second->timeline);
+            _prototypes.erase(it);
+        }
+    }
+
+    if (request->progress)
+        request->progress(1.0f);
+    if (request->callback)
+        request->callback(node);
+}
+
+Node* CSLoader::nodeWithPrototype(Prototype* prototype, const ccNodeLoadCallback& callback)
+{
+    // The sprite frames may have been purged since the prototype was loaded.
+    loadSpriteFrames(GetCSParseBinary(prototype->data.getBytes())->textures());
+
+    auto previousPrototype = _currentPrototype;
+    _currentPrototype      = prototype;
+    Node* node             = nodeWithFlatBuffers(prototype->nodeTree, callback);
+    _currentPrototype      = previousPrototype;
     return node;
 }
 
+ActionTimeline* CSLoader::timelineWithPrototype(Prototype* prototype)
+{
+    if (prototype->timeline == nullptr)
+    {
+        prototype->timeline =
+            ActionTimelineCache::getInstance()->loadAnimationWithDataBuffer(prototype->data, prototype->fullPath);
+        AX_SAFE_RETAIN(prototype->timeline);
+    }
+    return prototype->timeline ? prototype->timeline->clone() : nullptr;
+}
+
+bool CSLoader::preloadPrototype(std::string_view filename)
+{
+    return getPrototype(filename) != nullptr;
+}
+
+void CSLoader::removePrototype(std::string_view filename)
+{
+    auto it = _prototypes.find(FileUtils::getInstance()->fullPathForFilename(filename));
+    if (it != _prototypes.end())
+    {
+        AX_SAFE_RELEASE(it->second->timeline);
+        _prototypes.erase(it);
+    }
+}
+
+void CSLoader::purgePrototypes()
+{
+    for (auto& item : _prototypes)
+        AX_SAFE_RELEASE(item.second->timeline);
+    _prototypes.clear();
+}
+
+size_t CSLoader::getPrototypeMemoryUsage() const
+{
+    using ReaderMap = decltype(Prototype::readers);
+
+    size_t bytes = 0;
+    for (auto& item : _prototypes)
+    {
+        auto prototype = item.second.get();
+        // the key and the path are separate strings, the FlatBuffers data is owned by the prototype
+        bytes += sizeof(Prototype) + item.first.capacity() + prototype->fullPath.capacity() + prototype->data.getSize();
+        // the reader table allocates its bucket array and one node per entry
+        bytes += prototype->readers.bucket_count() * sizeof(void*);
+        bytes += prototype->readers.size() * (sizeof(ReaderMap::value_type) + sizeof(void*));
+    }
+    return bytes;
+}
+
 Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree)
 {
     return nodeWithFlatBuffers(nodetree, nullptr);
@@ -1115,7 +1439,17 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             std::string filePath    = projectNodeOptions->fileName()->c_str();
 
             cocostudio::timeline::ActionTimeline* action = nullptr;
-            if (!filePath.empty() && FileUtils::getInstance()->isFileExist(filePath))
+            // Nested files of a prototype are built from prototypes too, see createNodeAsync.
+            Prototype* prototype = ((_prototypeCacheEnabled || _currentPrototype) && !filePath.empty())
+                                       ? getPrototype(filePath)
+                                       : nullptr;
+            if (prototype)
+            {
+                node   = nodeWithPrototype(prototype, callback);
+                reconstructNestNode(node);
+                action = timelineWithPrototype(prototype);
+            }
+            else if (!filePath.empty() && FileUtils::getInstance()->isFileExist(filePath))
             {
                 Data buf = FileUtils::getInstance()->getDataFromFile(filePath);
                 node     = createNode(buf, callback);
@@ -1155,11 +1489,23 @@ Node* CSLoader::nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const
             std::string readername{getGUIClassName(classname)};
             readername.append("Reader");
 
-            NodeReaderProtocol* reader =
-                dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readername));
+            // The readers of a prototype are resolved once.
+            NodeReaderProtocol* reader = nullptr;
+            if (_currentPrototype)
+            {
+                auto it = _currentPrototype->readers.find(nodetree);
+                if (it != _currentPrototype->readers.end())
+                    reader = it->second;
+            }
             if (reader == nullptr)
-                reader = dynamic_cast<NodeReaderProtocol*>(
-                    ObjectFactory::getInstance()->createObject("CustomRootNodeReader"));
+            {
+                reader = dynamic_cast<NodeReaderProtocol*>(ObjectFactory::getInstance()->createObject(readername));
+                if (reader == nullptr)
+                    reader = dynamic_cast<NodeReaderProtocol*>(
+                        ObjectFactory::getInstance()->createObject("CustomRootNodeReader"));
+                if (reader != nullptr && _currentPrototype)
+                    _currentPrototype->readers.emplace(nodetree, reader);
+            }
             if (reader != nullptr)
             {
                 if (!customClassName.empty())
@@ -30,6 +30,7 @@
 
 #include "base/ObjectFactory.h"
 #include "base/Data.h"
+#include "base/hlookup.h"
 #include "ui/UIWidget.h"
 
 #include "flatbuffers/flatbuffers.h"
@@ -52,6 +53,7 @@ struct ComAudioOptions;
 namespace cocostudio
 {
 class ComAudio;
+class NodeReaderProtocol;
 }
 
 namespace cocostudio
@@ -74,6 +76,7 @@ public:
     static void destroyInstance();
 
     CSLoader();
+    ~CSLoader();
     /** @deprecated Use method destroyInstance() instead */
     AX_DEPRECATED_ATTRIBUTE void purge();
 
@@ -119,7 +122,59 @@ public:
     ax::Node* createNodeWithFlatBuffersForSimulator(std::string_view filename);
     ax::Node* nodeWithFlatBuffersForSimulator(const flatbuffers::NodeTree* nodetree);
 
+    /**
+     * Enables the .csb prototype cache, disabled by default.
+     * When enabled, the first createNode/createTimeline of a .csb file keeps its validated FlatBuffers data, the
+     * resolved node readers and the ActionTimeline as a prototype keyed by full path, later instances are built from
+     * the prototype without file I/O, version checks or reader lookups, and timelines are cloned.
+     * Nested project nodes are built from their own prototypes too.
+     */
+    void setPrototypeCacheEnabled(bool enabled);
+    bool isPrototypeCacheEnabled() const { return _prototypeCacheEnabled; }
+
+    /** Loads the prototype of a .csb file ahead of time, returns false if the file can't be read. */
+    bool preloadPrototype(std::string_view filename);
+    void removePrototype(std::string_view filename);
+    void purgePrototypes();
+
+    /**
+     * Creates a node from a .csb file without blocking the main thread.
+     * The prepare phase runs on a JobSystem worker: reading and verifying the file and the files of its nested project
+     * nodes, and parsing their sprite sheet plists. The sprite sheet textures are then decoded by
+     * TextureCache::addImageAsync. The instantiate phase builds the node on the main thread from the prepared data and
+     * passes it to the callback, nullptr on failure. The timeline of the file is cached too, so a following
+     * createTimeline doesn't read the file again.
+     * The progress callback is called on the main thread with a value in [0, 1].
+     */
+    void createNodeAsync(std::string_view filename,
+                         std::function<void(ax::Node*)> callback,
+                         std::function<void(float)> progress = nullptr);
+
+    size_t getPrototypeCount() const { return _prototypes.size(); }
+    /** Gets the bytes held by the cached FlatBuffers data, paths and reader tables, the timelines are not accounted. */
+    size_t getPrototypeMemoryUsage() const;
+
 protected:
+    struct Prototype
+    {
+        std::string fullPath;
+        Data data;
+        const flatbuffers::NodeTree* nodeTree          = nullptr;
+        cocostudio::timeline::ActionTimeline* timeline = nullptr;  // loaded on first use
+        std::unordered_map<const flatbuffers::NodeTree*, cocostudio::NodeReaderProtocol*> readers;
+    };
+
+    struct AsyncNodeRequest;
+
+    Prototype* getPrototype(std::string_view filename);
+    Prototype* addPrototype(std::string fullPath, Data data);
+    void loadAsyncTextures(std::shared_ptr<AsyncNodeRequest> request);
+    void finishNodeAsync(std::shared_ptr<AsyncNodeRequest> request);
+    ax::Node* nodeWithPrototype(Prototype* prototype, const ccNodeLoadCallback& callback);
+    cocostudio::timeline::ActionTimeline* timelineWithPrototype(Prototype* prototype);
+    bool checkBuildId(const flatbuffers::String* csBuildId);
+    void loadSpriteFrames(const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>* textures);
+
     ax::Node* createNodeWithFlatBuffersFile(std::string_view filename, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffersFile(std::string_view fileName, const ccNodeLoadCallback& callback);
     ax::Node* nodeWithFlatBuffers(const flatbuffers::NodeTree* nodetree, const ccNodeLoadCallback& callback);
@@ -173,6 +228,12 @@ protected:
     ax::Vector<ax::Node*> _callbackHandlers;
 
     std::string _csBuildID;
+
+    bool _prototypeCacheEnabled;
+    hlookup::string_map<std::unique_ptr<Prototype>> _prototypes;
+    Prototype* _currentPrototype;
+    /// The full paths addPrototype inserts are recorded here while set.
+    std::vector<std::string>* _addedPrototypes;
 };
 
 NS_AX_END
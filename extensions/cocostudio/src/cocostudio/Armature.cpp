@@ -118,11 +118,11 @@ bool Armature::init(std::string_view name)
 
         _blendFunc = BlendFunc::ALPHA_PREMULTIPLIED;
 
-        _name = name;
+        setName(name);
 
         ArmatureDataManager* armatureDataManager = ArmatureDataManager::getInstance();
 
-        if (!_name.empty())
+        if (!name.empty())
         {
             AnimationData* animationData = armatureDataManager->getAnimationData(name);
             AXASSERT(animationData, "AnimationData not exist! ");
@@ -160,15 +160,15 @@ bool Armature::init(std::string_view name)
         }
         else
         {
-            _name               = "new_armature";
+            setName("new_armature");
             _armatureData       = ArmatureData::create();
-            _armatureData->name = _name;
+            _armatureData->name = getName();
 
             AnimationData* animationData = AnimationData::create();
-            animationData->name          = _name;
+            animationData->name          = getName();
 
-            armatureDataManager->addArmatureData(_name, _armatureData);
-            armatureDataManager->addAnimationData(_name, animationData);
+            armatureDataManager->addArmatureData(getName(), _armatureData);
+            armatureDataManager->addAnimationData(getName(), animationData);
 
             _animation->setAnimationData(animationData);
         }
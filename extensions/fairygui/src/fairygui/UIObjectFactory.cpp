@@ -125,7 +125,7 @@ void UIObjectFactory::setLoaderExtension(GLoaderCreator creator)
     _loaderCreator = creator;
 }
 
-void UIObjectFactory::resolvePackageItemExtension(PackageItem* pi)
+void UIObjectFactory::resolvePackageItemExtension(PackageItem* pi, const std::string& itemName)
 {
     auto it = _packageItemExtensions.find(UIPackage::URL_PREFIX + pi->owner->getId() + pi->id);
     if (it != _packageItemExtensions.end())
@@ -133,7 +133,7 @@ void UIObjectFactory::resolvePackageItemExtension(PackageItem* pi)
         pi->extensionCreator = it->second;
         return;
     }
-    it = _packageItemExtensions.find(UIPackage::URL_PREFIX + pi->owner->getName() + "/" + pi->name);
+    it = _packageItemExtensions.find(UIPackage::URL_PREFIX + pi->owner->getName() + "/" + itemName);
     if (it != _packageItemExtensions.end())
     {
         pi->extensionCreator = it->second;
@@ -22,7 +22,8 @@ public:
     static void setLoaderExtension(GLoaderCreator creator);
 
 private:
-    static void resolvePackageItemExtension(PackageItem* pi);
+    // itemName is the name before the branch prefix is added
+    static void resolvePackageItemExtension(PackageItem* pi, const std::string& itemName);
 
     static std::unordered_map<std::string, GComponentCreator> _packageItemExtensions;
     static GLoaderCreator _loaderCreator;
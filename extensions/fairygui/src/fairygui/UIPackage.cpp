@@ -95,14 +95,7 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
     if (it != _packageInstById.end())
         return it->second;
 
-    if (_emptyTexture == nullptr)
-    {
-        Image* emptyImage = new Image();
-        emptyImage->initWithRawData(emptyTextureData, 16, 2, 2, 4, false);
-        _emptyTexture = new Texture2D();
-        _emptyTexture->initWithImage(emptyImage);
-        delete emptyImage;
-    }
+    createEmptyTexture();
 
     Data data;
 
@@ -118,18 +111,143 @@ UIPackage* UIPackage::addPackage(const string& assetPath)
 
     UIPackage* pkg = new UIPackage();
     pkg->_assetPath = assetPath;
-    if (!pkg->loadPackage(&buffer))
+    if (!pkg->loadPackage(&buffer, _branch))
     {
         delete pkg;
         return nullptr;
     }
 
+    registerPackage(pkg);
+
+    return pkg;
+}
+
+void UIPackage::addPackageAsync(const string& assetPath, std::function<void(UIPackage*)> callback, std::function<void(float)> progress)
+{
+    auto it = _packageInstById.find(assetPath);
+    if (it != _packageInstById.end())
+    {
+        if (progress)
+            progress(1.0f);
+        if (callback)
+            callback(it->second);
+        return;
+    }
+
+    createEmptyTexture();
+
+    struct PreparedAtlas
+    {
+        PackageItem* item;
+        Image* image;
+        Image* alphaImage;
+    };
+
+    // The branch is a static of the main thread, the worker reads a copy.
+    auto scheduler = Director::getInstance()->getScheduler();
+    Director::getInstance()->getJobSystem()->enqueue([assetPath, branch = _branch, callback = std::move(callback), progress = std::move(progress), scheduler]() {
+        // Prepare phase: file read, parsing and image decoding, nothing here touches the renderer, the package registry
+        // or the package item extensions.
+        UIPackage* pkg = nullptr;
+        std::vector<PreparedAtlas> atlases;
+        std::vector<std::pair<PackageItem*, std::string>> unresolvedExtensions;
+
+        Data data;
+        if (FileUtils::getInstance()->getContents(assetPath + ".fui", &data) == FileUtils::Status::OK)
+        {
+            ssize_t size;
+            char* p = (char*)data.takeBuffer(&size);
+            ByteBuffer buffer(p, 0, (int)size, true);
+
+            pkg = new UIPackage();
+            pkg->_assetPath = assetPath;
+            if (!pkg->loadPackage(&buffer, branch, &unresolvedExtensions))
+            {
+                delete pkg;
+                pkg = nullptr;
+            }
+        }
+
+        if (pkg)
+        {
+            for (auto& item : pkg->_items)
+            {
+                if (item->type == PackageItemType::ATLAS)
+                    atlases.push_back({item, nullptr, nullptr});
+            }
+
+            const float steps = atlases.size() + 2.0f;
+            for (size_t i = 0; i < atlases.size(); i++)
+            {
+                atlases[i].image = decodeAtlasImage(atlases[i].item, &atlases[i].alphaImage);
+                if (progress)
+                    scheduler->runOnAxmolThread([progress, value = (i + 1) / steps]() { progress(value); });
+            }
+        }
+
+        // Instantiate phase: textures and registration on the main thread.
+        scheduler->runOnAxmolThread([assetPath, branch, pkg, atlases = std::move(atlases),
+                                     unresolvedExtensions = std::move(unresolvedExtensions), callback, progress]() {
+            if (pkg == nullptr)
+            {
+                AXLOGE("FairyGUI: cannot load package from '{}'", assetPath);
+                if (callback)
+                    callback(nullptr);
+                return;
+            }
+
+            UIPackage* result = pkg;
+            auto it = _packageInstById.find(assetPath);
+            if (it != _packageInstById.end())
+            {
+                // Added synchronously in the meantime.
+                for (auto& atlas : atlases)
+                {
+                    delete atlas.image;
+                    delete atlas.alphaImage;
+                }
+                delete pkg;
+                result = it->second;
+            }
+            else
+            {
+                // setBranch only updates the registered packages, it may have been called while loading.
+                if (branch != _branch && pkg->_branches.size() > 0)
+                    pkg->_branchIndex = ToolSet::findInStringArray(pkg->_branches, _branch);
+                // setPackageItemExtension writes the extensions on the main thread, they're resolved here
+                for (auto& extension : unresolvedExtensions)
+                    UIObjectFactory::resolvePackageItemExtension(extension.first, extension.second);
+                for (auto& atlas : atlases)
+                    pkg->loadAtlas(atlas.item, atlas.image, atlas.alphaImage);
+                registerPackage(pkg);
+            }
+
+            if (progress)
+                progress(1.0f);
+            if (callback)
+                callback(result);
+        });
+    });
+}
+
+void UIPackage::createEmptyTexture()
+{
+    if (_emptyTexture == nullptr)
+    {
+        Image* emptyImage = new Image();
+        emptyImage->initWithRawData(emptyTextureData, 16, 2, 2, 4, false);
+        _emptyTexture = new Texture2D();
+        _emptyTexture->initWithImage(emptyImage);
+        delete emptyImage;
+    }
+}
+
+void UIPackage::registerPackage(UIPackage* pkg)
+{
     _packageInstById[pkg->getId()] = pkg;
     _packageInstByName[pkg->getName()] = pkg;
-    _packageInstById[assetPath] = pkg;
+    _packageInstById[pkg->_assetPath] = pkg;
     _packageList.push_back(pkg);
-
-    return pkg;
 }
 
 void UIPackage::removePackage(const string& packageIdOrName)
@@ -329,7 +447,9 @@ GObject* UIPackage::createObject(PackageItem* item)
     return g;
 }
 
-bool UIPackage::loadPackage(ByteBuffer* buffer)
+bool UIPackage::loadPackage(ByteBuffer* buffer,
+                            const std::string& branch,
+                            std::vector<std::pair<PackageItem*, std::string>>* unresolvedExtensions)
 {
     if (buffer->readUint() != 0x46475549)
     {
@@ -372,8 +492,8 @@ bool UIPackage::loadPackage(ByteBuffer* buffer)
         if (cnt > 0)
         {
             buffer->readSArray(_branches, cnt);
-            if (_branch.size() > 0)
-                _branchIndex = ToolSet::findInStringArray(_branches, _branch);
+            if (branch.size() > 0)
+                _branchIndex = ToolSet::findInStringArray(_branches, branch);
         }
 
         branchIncluded = cnt > 0;
@@ -449,7 +569,10 @@ bool UIPackage::loadPackage(ByteBuffer* buffer)
                 pi->objectType = ObjectType::COMPONENT;
             pi->rawData = buffer->readBuffer();
 
-            UIObjectFactory::resolvePackageItemExtension(pi);
+            if (unresolvedExtensions)
+                unresolvedExtensions->emplace_back(pi, pi->name);
+            else
+                UIObjectFactory::resolvePackageItemExtension(pi, pi->name);
             break;
         }
 
@@ -602,29 +725,29 @@ void* UIPackage::getItemAsset(PackageItem* item)
 
 void UIPackage::loadAtlas(PackageItem* item)
 {
+    Image* alphaImage = nullptr;
+    Image* image = decodeAtlasImage(item, &alphaImage);
+    loadAtlas(item, image, alphaImage);
+}
+
+//note: called by addPackageAsync on a worker thread, it only decodes the image files.
+Image* UIPackage::decodeAtlasImage(PackageItem* item, Image** alphaImage)
+{
+    *alphaImage = nullptr;
+
     Image* image = new Image();
 #if COCOS2D_VERSION < 0x00031702
     Image::setPNGPremultipliedAlphaEnabled(false);
 #endif
-    if (!image->initWithImageFile(item->file))
-    {
-        item->texture = _emptyTexture;
-        _emptyTexture->retain();
-        delete image;
-#if COCOS2D_VERSION < 0x00031702
-        Image::setPNGPremultipliedAlphaEnabled(true);
-#endif
-        AXLOGW("FairyGUI: texture '{}' not found in {}", item->file, _name);
-        return;
-    }
+    bool decoded = image->initWithImageFile(item->file);
 #if COCOS2D_VERSION < 0x00031702
     Image::setPNGPremultipliedAlphaEnabled(true);
 #endif
-
-    Texture2D* tex = new Texture2D();
-    tex->initWithImage(image);
-    item->texture = tex;
-    delete image;
+    if (!decoded)
+    {
+        delete image;
+        return nullptr;
+    }
 
     string alphaFilePath;
     string ext = FileUtils::getInstance()->getFileExtension(item->file);
@@ -637,23 +760,43 @@ void UIPackage::loadAtlas(PackageItem* item)
     bool hasAlphaTexture = ToolSet::isFileExist(alphaFilePath);
     if (hasAlphaTexture)
     {
-        image = new Image();
-        if (!image->initWithImageFile(alphaFilePath))
-        {
-            delete image;
-            return;
-        }
+        Image* alpha = new Image();
+        if (alpha->initWithImageFile(alphaFilePath))
+            *alphaImage = alpha;
+        else
+            delete alpha;
+    }
+
+    return image;
+}
+
+void UIPackage::loadAtlas(PackageItem* item, Image* image, Image* alphaImage)
+{
+    if (image == nullptr)
+    {
+        item->texture = _emptyTexture;
+        _emptyTexture->retain();
+        AXLOGW("FairyGUI: texture '{}' not found in {}", item->file, _name);
+        return;
+    }
 
+    Texture2D* tex = new Texture2D();
+    tex->initWithImage(image);
+    item->texture = tex;
+    delete image;
+
+    if (alphaImage)
+    {
 #if defined(AX_VERSION)
-        if(image->getFileType() == Image::Format::ETC1)
-            tex->updateWithImage(image, Texture2D::getDefaultAlphaPixelFormat(), 1);
+        if(alphaImage->getFileType() == Image::Format::ETC1)
+            tex->updateWithImage(alphaImage, Texture2D::getDefaultAlphaPixelFormat(), 1);
 #else
         tex = new Texture2D();
-        tex->initWithImage(image);
+        tex->initWithImage(alphaImage);
         item->texture->setAlphaTexture(tex);
         tex->release();
 #endif
-        delete image;
+        delete alphaImage;
     }
 }
 
@@ -20,6 +20,15 @@ public:
     static UIPackage* getById(const std::string& id);
     static UIPackage* getByName(const std::string& name);
     static UIPackage* addPackage(const std::string& descFilePath);
+    /**
+     * Adds a package without blocking the main thread: the .fui file read, the package parsing and the atlas image
+     * decoding run on a JobSystem worker, the textures are created and the package is registered on the main thread,
+     * then the callback is called with the package, or nullptr on failure.
+     * The progress callback is called on the main thread with a value in [0, 1].
+     */
+    static void addPackageAsync(const std::string& descFilePath,
+                                std::function<void(UIPackage*)> callback,
+                                std::function<void(float)> progress = nullptr);
     static void removePackage(const std::string& packageIdOrName);
     static void removeAllPackages();
     static GObject* createObject(const std::string& pkgName, const std::string& resName);
@@ -47,8 +56,16 @@ public:
     static const std::string URL_PREFIX;
 
 private:
-    bool loadPackage(ByteBuffer* buffer);
+    // the component items and names are collected into unresolvedExtensions instead of resolving their extensions,
+    // the extensions may only be read on the main thread
+    bool loadPackage(ByteBuffer* buffer,
+                     const std::string& branch,
+                     std::vector<std::pair<PackageItem*, std::string>>* unresolvedExtensions = nullptr);
     void loadAtlas(PackageItem* item);
+    void loadAtlas(PackageItem* item, ax::Image* image, ax::Image* alphaImage);
+    static ax::Image* decodeAtlasImage(PackageItem* item, ax::Image** alphaImage);
+    static void createEmptyTexture();
+    static void registerPackage(UIPackage* pkg);
     AtlasSprite* getSprite(const std::string& spriteId);
     ax::SpriteFrame* createSpriteTexture(AtlasSprite* sprite);
     void loadImage(PackageItem* item);
@@ -83,6 +83,162 @@ bool luaval_is_usertype(lua_State* L, int lo, const char* type, int def)
     return false;
 }
 
+// value type userdata, see luaval_set_valuetype_userdata
+namespace
+{
+enum ValueType
+{
+    VT_VEC2,  // also used by Size
+    VT_VEC3,
+    VT_RECT,
+    VT_COLOR3B,
+    VT_COLOR4B,
+    VT_COLOR4F,
+    VT_COUNT
+};
+
+struct ValueTypeInfo
+{
+    const char* metatable;
+    const char* name;
+    int count;
+};
+
+const ValueTypeInfo s_valueTypes[VT_COUNT] = {
+    {"_vec2ud", "Vec2", 2},       {"_vec3ud", "Vec3", 3},       {"_rectud", "Rect", 4},
+    {"_color3bud", "Color3B", 3}, {"_color4bud", "Color4B", 4}, {"_color4fud", "Color4F", 4},
+};
+
+bool s_valueTypeUserdata = false;
+
+// maps a field key to the float index, the first character identifies the field like the _vec2mt does
+int valuetype_field(lua_State* L, int type, int keyIndex)
+{
+    if (lua_type(L, keyIndex) == LUA_TNUMBER)
+    {
+        const int n = static_cast<int>(lua_tointeger(L, keyIndex));
+        return n >= 1 && n <= s_valueTypes[type].count ? n - 1 : -1;
+    }
+
+    const char* key = lua_tostring(L, keyIndex);
+    if (!key)
+        return -1;
+    switch (type)
+    {
+    case VT_VEC2:
+        if (*key == 'x' || *key == 'w' || *key == 'u')
+            return 0;
+        return (*key == 'y' || *key == 'h' || *key == 'v') ? 1 : -1;
+    case VT_VEC3:
+        return (*key >= 'x' && *key <= 'z') ? *key - 'x' : -1;
+    case VT_RECT:
+        return *key == 'x' ? 0 : *key == 'y' ? 1 : *key == 'w' ? 2 : *key == 'h' ? 3 : -1;
+    default:
+    {
+        const int n = *key == 'r' ? 0 : *key == 'g' ? 1 : *key == 'b' ? 2 : *key == 'a' ? 3 : -1;
+        return n < s_valueTypes[type].count ? n : -1;  // Color3B has no alpha
+    }
+    }
+}
+
+int valuetype_index(lua_State* L)
+{  // ud k
+    const int n = valuetype_field(L, static_cast<int>(lua_tointeger(L, lua_upvalueindex(1))), 2);
+    if (n >= 0)
+        lua_pushnumber(L, static_cast<const float*>(lua_touserdata(L, 1))[n]);
+    else
+        lua_pushnil(L);
+    return 1;
+}
+
+int valuetype_newindex(lua_State* L)
+{  // ud k v
+    const int type = static_cast<int>(lua_tointeger(L, lua_upvalueindex(1)));
+    const int n    = valuetype_field(L, type, 2);
+    if (n < 0)
+        return luaL_error(L, "invalid field '%s' of %s", lua_tostring(L, 2), s_valueTypes[type].name);
+    static_cast<float*>(lua_touserdata(L, 1))[n] = static_cast<float>(lua_tonumber(L, 3));
+    return 0;
+}
+
+int valuetype_len(lua_State* L)
+{
+    lua_pushinteger(L, s_valueTypes[lua_tointeger(L, lua_upvalueindex(1))].count);
+    return 1;
+}
+
+int valuetype_eq(lua_State* L)
+{
+    const auto size = sizeof(float) * s_valueTypes[lua_tointeger(L, lua_upvalueindex(1))].count;
+    lua_pushboolean(L, memcmp(lua_touserdata(L, 1), lua_touserdata(L, 2), size) == 0);
+    return 1;
+}
+
+int valuetype_tostring(lua_State* L)
+{
+    const auto& info = s_valueTypes[lua_tointeger(L, lua_upvalueindex(1))];
+    auto v           = static_cast<const float*>(lua_touserdata(L, 1));
+    std::string str{info.name};
+    str += '(';
+    for (int i = 0; i < info.count; ++i)
+    {
+        if (i)
+            str += ", ";
+        fmt::format_to(std::back_inserter(str), "{}", v[i]);
+    }
+    str += ')';
+    lua_pushlstring(L, str.data(), str.size());
+    return 1;
+}
+
+void push_valuetype(lua_State* L, int type, const float* values)
+{
+    const auto& info = s_valueTypes[type];
+    auto data        = lua_newuserdata(L, sizeof(float) * info.count); /* L: ud */
+    memcpy(data, values, sizeof(float) * info.count);
+
+    luaL_getmetatable(L, info.metatable); /* L: ud mt */
+    if (!lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        luaL_newmetatable(L, info.metatable);
+        const std::pair<const char*, lua_CFunction> events[] = {{"__index", valuetype_index},
+                                                                {"__newindex", valuetype_newindex},
+                                                                {"__len", valuetype_len},
+                                                                {"__eq", valuetype_eq},
+                                                                {"__tostring", valuetype_tostring}};
+        for (auto&& event : events)
+        {
+            lua_pushinteger(L, type);
+            lua_pushcclosure(L, event.second, 1);
+            lua_setfield(L, -2, event.first);
+        }
+    }
+    lua_setmetatable(L, -2); /* L: ud */
+}
+
+// returns the floats of the value type userdata at lo, or nullptr when it isn't one of the given type
+const float* luaval_to_valuetype(lua_State* L, int lo, int type)
+{
+    if (lua_type(L, lo) != LUA_TUSERDATA || !lua_getmetatable(L, lo)) /* L: mt */
+        return nullptr;
+    luaL_getmetatable(L, s_valueTypes[type].metatable); /* L: mt mt */
+    const bool matched = lua_rawequal(L, -1, -2) != 0;
+    lua_pop(L, 2);
+    return matched ? static_cast<const float*>(lua_touserdata(L, lo)) : nullptr;
+}
+}  // namespace
+
+void luaval_set_valuetype_userdata(bool enabled)
+{
+    s_valueTypeUserdata = enabled;
+}
+
+bool luaval_is_valuetype_userdata()
+{
+    return s_valueTypeUserdata;
+}
+
 bool luaval_to_ushort(lua_State* L, int lo, unsigned short* outValue, const char* funcName)
 {
     if (nullptr == L || nullptr == outValue)
@@ -348,6 +504,12 @@ bool luaval_to_vec2(lua_State* L, int lo, ax::Vec2* outValue, const char* funcNa
     if (nullptr == L || nullptr == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_VEC2))
+    {
+        outValue->set(v[0], v[1]);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -365,6 +527,18 @@ bool luaval_to_vec2(lua_State* L, int lo, ax::Vec2* outValue, const char* funcNa
 
     if (ok)
     {
+        // the array layout of vec2_to_luaval, read it directly instead of through the _vec2mt metamethods
+        lua_rawgeti(L, lo, 1);
+        if (lua_type(L, -1) == LUA_TNUMBER)
+        {
+            outValue->x = (float)lua_tonumber(L, -1);
+            lua_rawgeti(L, lo, 2);
+            outValue->y = (float)lua_tonumber(L, -1);
+            lua_pop(L, 2);
+            return ok;
+        }
+        lua_pop(L, 1);
+
         lua_pushstring(L, "x");
         lua_gettable(L, lo);
         if (lua_isnil(L, -1))
@@ -397,6 +571,12 @@ bool luaval_to_vec3(lua_State* L, int lo, ax::Vec3* outValue, const char* funcNa
     if (nullptr == L || nullptr == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_VEC3))
+    {
+        outValue->set(v[0], v[1], v[2]);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -410,6 +590,20 @@ bool luaval_to_vec3(lua_State* L, int lo, ax::Vec3* outValue, const char* funcNa
 
     if (ok)
     {
+        // the array layout of vec3_to_luaval
+        lua_rawgeti(L, lo, 1);
+        if (lua_type(L, -1) == LUA_TNUMBER)
+        {
+            outValue->x = (float)lua_tonumber(L, -1);
+            lua_rawgeti(L, lo, 2);
+            outValue->y = (float)lua_tonumber(L, -1);
+            lua_rawgeti(L, lo, 3);
+            outValue->z = (float)lua_tonumber(L, -1);
+            lua_pop(L, 3);
+            return ok;
+        }
+        lua_pop(L, 1);
+
         lua_pushstring(L, "x");
         lua_gettable(L, lo);
         outValue->x = lua_isnil(L, -1) ? 0.0f : (float)lua_tonumber(L, -1);
@@ -597,6 +791,12 @@ bool luaval_to_size(lua_State* L, int lo, Size* outValue, const char* funcName)
     if (NULL == L || NULL == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_VEC2))
+    {
+        outValue->setSize(v[0], v[1]);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -629,6 +829,12 @@ bool luaval_to_rect(lua_State* L, int lo, Rect* outValue, const char* funcName)
     if (NULL == L || NULL == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_RECT))
+    {
+        outValue->setRect(v[0], v[1], v[2], v[3]);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -671,6 +877,19 @@ bool luaval_to_color4b(lua_State* L, int lo, Color4B* outValue, const char* func
     if (NULL == L || NULL == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_COLOR4B))
+    {
+        *outValue = Color4B(static_cast<uint8_t>(v[0]), static_cast<uint8_t>(v[1]), static_cast<uint8_t>(v[2]),
+                            static_cast<uint8_t>(v[3]));
+        return true;
+    }
+    if (auto v = luaval_to_valuetype(L, lo, VT_COLOR3B))
+    {
+        // opaque, like a table without the a field
+        *outValue = Color4B(static_cast<uint8_t>(v[0]), static_cast<uint8_t>(v[1]), static_cast<uint8_t>(v[2]), 255);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -713,6 +932,12 @@ bool luaval_to_color4f(lua_State* L, int lo, Color4F* outValue, const char* func
     if (NULL == L || NULL == outValue)
         return false;
 
+    if (auto v = luaval_to_valuetype(L, lo, VT_COLOR4F))
+    {
+        *outValue = Color4F(v[0], v[1], v[2], v[3]);
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -755,6 +980,15 @@ bool luaval_to_color3b(lua_State* L, int lo, Color3B* outValue, const char* func
     if (NULL == L || NULL == outValue)
         return false;
 
+    auto v = luaval_to_valuetype(L, lo, VT_COLOR3B);
+    if (!v)
+        v = luaval_to_valuetype(L, lo, VT_COLOR4B);  // the alpha is ignored, like the a field of a table
+    if (v)
+    {
+        *outValue = Color3B(static_cast<uint8_t>(v[0]), static_cast<uint8_t>(v[1]), static_cast<uint8_t>(v[2]));
+        return true;
+    }
+
     bool ok = true;
 
     tolua_Error tolua_err;
@@ -2139,6 +2373,12 @@ static int vec2_newindex(lua_State* L)
 
 int vec2_to_luaval(lua_State* L, const ax::Vec2& vec2)
 {
+    if (s_valueTypeUserdata)
+    {
+        push_valuetype(L, VT_VEC2, &vec2.x);
+        return 1;
+    }
+
     lua_createtable(L, 2, 0);              /* L: table */
     lua_pushnumber(L, (lua_Number)vec2.x); /* L: table key value*/
     lua_rawseti(L, -2, 1);                 /* table[key] = value, L: table */
@@ -2183,6 +2423,12 @@ static int vec3_newindex(lua_State* L)
 
 int vec3_to_luaval(lua_State* L, const ax::Vec3& vec3)
 {
+    if (s_valueTypeUserdata)
+    {
+        push_valuetype(L, VT_VEC3, &vec3.x);
+        return 1;
+    }
+
     lua_createtable(L, 3, 0);              /* L: table */
     lua_pushnumber(L, (lua_Number)vec3.x); /* L: table key value*/
     lua_rawseti(L, -2, 1);                 /* table[key] = value, L: table */
@@ -2339,6 +2585,8 @@ void size_to_luaval(lua_State* L, const Size& sz)
 {
     if (NULL == L)
         return;
+    if (s_valueTypeUserdata)
+        return push_valuetype(L, VT_VEC2, &sz.width);
     lua_newtable(L);                          /* L: table */
     lua_pushstring(L, "width");               /* L: table key */
     lua_pushnumber(L, (lua_Number)sz.width);  /* L: table key value*/
@@ -2352,6 +2600,11 @@ void rect_to_luaval(lua_State* L, const Rect& rt)
 {
     if (NULL == L)
         return;
+    if (s_valueTypeUserdata)
+    {
+        const float values[] = {rt.origin.x, rt.origin.y, rt.size.width, rt.size.height};
+        return push_valuetype(L, VT_RECT, values);
+    }
     lua_newtable(L);                               /* L: table */
     lua_pushstring(L, "x");                        /* L: table key */
     lua_pushnumber(L, (lua_Number)rt.origin.x);    /* L: table key value*/
@@ -2371,6 +2624,11 @@ void color4b_to_luaval(lua_State* L, const Color4B& color)
 {
     if (NULL == L)
         return;
+    if (s_valueTypeUserdata)
+    {
+        const float values[] = {(float)color.r, (float)color.g, (float)color.b, (float)color.a};
+        return push_valuetype(L, VT_COLOR4B, values);
+    }
     lua_newtable(L);                     /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
@@ -2390,6 +2648,8 @@ void color4f_to_luaval(lua_State* L, const Color4F& color)
 {
     if (NULL == L)
         return;
+    if (s_valueTypeUserdata)
+        return push_valuetype(L, VT_COLOR4F, &color.r);
     lua_newtable(L);                     /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
@@ -2414,6 +2674,11 @@ void color3b_to_luaval(lua_State* L, const Color3B& color)
 {
     if (NULL == L)
         return;
+    if (s_valueTypeUserdata)
+    {
+        const float values[] = {(float)color.r, (float)color.g, (float)color.b};
+        return push_valuetype(L, VT_COLOR3B, values);
+    }
     lua_newtable(L);                     /* L: table */
     lua_pushstring(L, "r");              /* L: table key */
     lua_pushnumber(L, (lua_Number)color.r); /* L: table key value*/
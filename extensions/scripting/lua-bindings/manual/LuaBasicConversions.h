@@ -84,6 +84,21 @@ void luaval_to_native_err(lua_State* L, const char* msg, tolua_Error* err, const
  * return false.
  */
 extern bool luaval_is_usertype(lua_State* L, int lo, const char* type, int def);
+
+/**
+ * Enable or disable the value type userdata, disabled by default.
+ * When enabled, vec2_to_luaval, vec3_to_luaval, size_to_luaval, rect_to_luaval and the color*_to_luaval functions push
+ * a userdata holding the floats instead of a table, which is a single small allocation without string keys. Its fields
+ * are accessed like the table ones (p.x, p.width, p[1], sz.height, rt.width, c.r, ...) and assigning them is allowed,
+ * so a value returned by a getter can be modified and passed back to a setter without any allocation.
+ * The luaval_to_* functions accept both tables and the value type userdata. Scripts checking type(v) == "table"
+ * or iterating the values with pairs() should keep this disabled.
+ * It can be switched from Lua with set_valuetype_userdata(enabled).
+ *
+ * @param enabled whether to push the value type userdata.
+ */
+extern AX_LUA_DLL void luaval_set_valuetype_userdata(bool enabled);
+extern AX_LUA_DLL bool luaval_is_valuetype_userdata();
 // to native
 
 /**
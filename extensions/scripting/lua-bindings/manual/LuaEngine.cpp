@@ -52,6 +52,7 @@ LuaEngine* LuaEngine::getInstance(void)
 
 LuaEngine::~LuaEngine(void)
 {
+    AX_SAFE_DELETE(_gcController);
     AX_SAFE_RELEASE(_stack);
     _defaultEngine = nullptr;
 }
@@ -63,6 +64,13 @@ bool LuaEngine::init(void)
     return true;
 }
 
+LuaGCController* LuaEngine::getGCController()
+{
+    if (!_gcController)
+        _gcController = new LuaGCController(_stack->getLuaState());
+    return _gcController;
+}
+
 void LuaEngine::addSearchPath(const char* path)
 {
     _stack->addSearchPath(path);
@@ -33,6 +33,7 @@ extern "C" {
 
 #include "base/ScriptSupport.h"
 #include "lua-bindings/manual/LuaStack.h"
+#include "lua-bindings/manual/LuaGCController.h"
 #include "lua-bindings/manual/LuaValue.h"
 #include "lua-bindings/manual/base/LuaScriptHandlerMgr.h"
 #include "lua-bindings/manual/Lua-BindingsExport.h"
@@ -86,6 +87,13 @@ public:
      */
     LuaStack* getLuaStack(void) { return _stack; }
 
+    /**
+     * Get the frame budgeted GC controller of the lua_State, it's disabled by default.
+     *
+     * @return LuaGCController object.
+     */
+    LuaGCController* getGCController();
+
     /**
      * Add a path to find lua files in.
      *
@@ -228,7 +236,7 @@ public:
                             const std::function<void(lua_State*, int)>& func);
 
 private:
-    LuaEngine(void) : _stack(nullptr) {}
+    LuaEngine(void) : _stack(nullptr), _gcController(nullptr) {}
     bool init(void);
     int handleNodeEvent(void* data);
     int handleMenuClickedEvent(void* data);
@@ -257,6 +265,7 @@ private:
 private:
     static LuaEngine* _defaultEngine;
     LuaStack* _stack;
+    LuaGCController* _gcController;
 };
 
 NS_AX_END
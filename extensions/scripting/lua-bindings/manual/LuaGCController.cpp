@@ -0,0 +1,251 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "lua-bindings/manual/LuaGCController.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+
+NS_AX_BEGIN
+
+static constexpr int GC_MIN_STEP_KB = 1;
+static constexpr int GC_MAX_STEP_KB = 4096;
+
+LuaGCController::LuaGCController(lua_State* L) : _state(L) {}
+
+LuaGCController::~LuaGCController()
+{
+    setEnabled(false);
+}
+
+void LuaGCController::setEnabled(bool enabled)
+{
+    if (_enabled == enabled)
+        return;
+    _enabled = enabled;
+
+    auto dispatcher = Director::getInstance()->getEventDispatcher();
+    if (enabled)
+    {
+        _prevPause   = lua_gc(_state, LUA_GCSETPAUSE, _pause);
+        _prevStepMul = _stepMul ? lua_gc(_state, LUA_GCSETSTEPMUL, _stepMul) : 0;
+#if defined(LUA_GCINC)
+        // the budgeting assumes the incremental mode, 5.4 may be generational
+        _prevMode = lua_gc(_state, LUA_GCINC, 0, 0, 0);
+#endif
+#if defined(LUA_GCISRUNNING)
+        _prevRunning = lua_gc(_state, LUA_GCISRUNNING, 0) != 0;
+#endif
+        if (!_autoCollect)
+            lua_gc(_state, LUA_GCSTOP, 0);
+
+        // the state of the current cycle is unknown, finish it before pacing the next ones
+        _cycleRunning      = true;
+        _nextCycleHeapSize = 0;
+        _frameBegin        = clock_type::now();
+        _lastHeapSize      = lua_gc(_state, LUA_GCCOUNT, 0);
+        _beforeUpdateListener =
+            dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) { onFrameBegin(); });
+        _afterDrawListener =
+            dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [this](EventCustom*) { onFrameEnd(); });
+        // the listeners are removed with the Director, stop before it happens
+        _resetListener =
+            dispatcher->addCustomEventListener(Director::EVENT_RESET, [this](EventCustom*) { setEnabled(false); });
+    }
+    else
+    {
+        dispatcher->removeEventListener(_beforeUpdateListener);
+        dispatcher->removeEventListener(_afterDrawListener);
+        dispatcher->removeEventListener(_resetListener);
+        _beforeUpdateListener = nullptr;
+        _afterDrawListener    = nullptr;
+        _resetListener        = nullptr;
+        if (_statsDisplay)
+            Director::getInstance()->setStatsExtraText("");
+
+        lua_gc(_state, LUA_GCSETPAUSE, _prevPause);
+        if (_stepMul)
+            lua_gc(_state, LUA_GCSETSTEPMUL, _prevStepMul);
+#if defined(LUA_GCGEN)
+        if (_prevMode == LUA_GCGEN)
+            lua_gc(_state, LUA_GCGEN, 0, 0);
+#endif
+        lua_gc(_state, _prevRunning ? LUA_GCRESTART : LUA_GCSTOP, 0);
+    }
+}
+
+void LuaGCController::setPause(int percent)
+{
+    _pause = percent;
+    if (_enabled)
+        lua_gc(_state, LUA_GCSETPAUSE, percent);
+}
+
+void LuaGCController::setStepMul(int percent)
+{
+    if (_enabled)
+    {
+        if (percent)
+        {
+            const int prev = lua_gc(_state, LUA_GCSETSTEPMUL, percent);
+            if (!_stepMul)
+                _prevStepMul = prev;
+        }
+        else if (_stepMul)
+            lua_gc(_state, LUA_GCSETSTEPMUL, _prevStepMul);
+    }
+    _stepMul = percent;
+}
+
+void LuaGCController::setAutoCollect(bool autoCollect)
+{
+    if (_autoCollect == autoCollect)
+        return;
+    _autoCollect = autoCollect;
+    if (_enabled)
+        lua_gc(_state, autoCollect ? LUA_GCRESTART : LUA_GCSTOP, 0);
+}
+
+void LuaGCController::setStatsDisplay(bool display)
+{
+    if (_statsDisplay == display)
+        return;
+    _statsDisplay = display;
+    _statsTime    = 0.f;
+    if (!display && _enabled)
+        Director::getInstance()->setStatsExtraText("");
+}
+
+float LuaGCController::computeBudget(float timeLeft,
+                                     float allocRate,
+                                     float costPerKB,
+                                     float minBudget,
+                                     float maxBudget)
+{
+    // the collector has to traverse about twice what was allocated to keep up with it
+    return clampf((std::max)(timeLeft, allocRate * 2.f * costPerKB), minBudget, maxBudget);
+}
+
+int LuaGCController::computeStepSize(float budgetLeft, float costPerKB)
+{
+    return static_cast<int>(clampf(budgetLeft / costPerKB, GC_MIN_STEP_KB, GC_MAX_STEP_KB));
+}
+
+bool LuaGCController::step(float budget)
+{
+    bool finished = false;
+    float spent   = 0.f;
+    while (spent < budget)
+    {
+        const int stepSize = computeStepSize(budget - spent, _costPerKB);
+
+        auto start = clock_type::now();
+        finished   = lua_gc(_state, LUA_GCSTEP, stepSize) != 0;
+        auto time  = std::chrono::duration<float, std::milli>(clock_type::now() - start).count();
+
+        _costPerKB      = _costPerKB * 0.8f + (time / stepSize) * 0.2f;
+        _stats.stepSize = stepSize;
+        spent += time;
+
+        // don't start the next cycle in the same frame
+        if (finished)
+        {
+            ++_stats.cycles;
+            onCycleEnd();
+            break;
+        }
+    }
+
+    // LUA_GCSTEP resets the threshold of luajit and lua 5.1, which restarts the automatic collector
+    if (_enabled && !_autoCollect)
+        lua_gc(_state, LUA_GCSTOP, 0);
+
+    _stats.stepTime = spent;
+    return finished;
+}
+
+void LuaGCController::onCycleEnd()
+{
+    _cycleRunning      = false;
+    _nextCycleHeapSize = static_cast<size_t>(lua_gc(_state, LUA_GCCOUNT, 0)) * _pause / 100;
+}
+
+void LuaGCController::fullCollect()
+{
+    lua_gc(_state, LUA_GCCOLLECT, 0);
+    ++_stats.fullCollects;
+    onCycleEnd();
+
+    // same as LUA_GCSTEP, a full collection resets the threshold
+    if (!_autoCollect)
+        lua_gc(_state, LUA_GCSTOP, 0);
+}
+
+void LuaGCController::onFrameBegin()
+{
+    _frameBegin = clock_type::now();
+}
+
+void LuaGCController::onFrameEnd()
+{
+    auto director = Director::getInstance();
+
+    const int heapSize = lua_gc(_state, LUA_GCCOUNT, 0);
+    _stats.allocRate   = _stats.allocRate * 0.9f + (std::max)(heapSize - _lastHeapSize, 0) * 0.1f;
+
+    // with the automatic collector stopped, a cycle starts once the heap has grown by the pause
+    if (!_cycleRunning && (_autoCollect || static_cast<size_t>(heapSize) >= _nextCycleHeapSize))
+        _cycleRunning = true;
+
+    if (_cycleRunning)
+    {
+        // time left until the next frame
+        const float frameTime = director->getAnimationInterval() * 1000.f;
+        const float elapsed   = std::chrono::duration<float, std::milli>(clock_type::now() - _frameBegin).count();
+        step(computeBudget(frameTime - elapsed, _stats.allocRate, _costPerKB, _minBudget, _maxBudget));
+    }
+    else
+        _stats.stepTime = 0.f;
+
+    // the steps didn't keep up with the allocations
+    const size_t heapLimit = _heapLimit ? _heapLimit : _nextCycleHeapSize * 2;
+    if (heapLimit && static_cast<size_t>(lua_gc(_state, LUA_GCCOUNT, 0)) > heapLimit)
+        fullCollect();
+
+    _lastHeapSize      = lua_gc(_state, LUA_GCCOUNT, 0);
+    _stats.heapSize    = static_cast<size_t>(_lastHeapSize);
+    _stats.avgStepTime = _stats.avgStepTime * 0.9f + _stats.stepTime * 0.1f;
+
+    if (_statsDisplay)
+    {
+        _statsTime += director->getDeltaTime();
+        if (_statsTime > AX_DIRECTOR_STATS_INTERVAL)
+        {
+            _statsTime = 0.f;
+            director->setStatsExtraText(fmt::format("Lua GC:{:.2f}ms {}KB", _stats.avgStepTime, _stats.heapSize));
+        }
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,179 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __AX_LUA_GC_CONTROLLER_H_
+#define __AX_LUA_GC_CONTROLLER_H_
+
+#include <chrono>
+
+extern "C" {
+#include "lua.h"
+}
+
+#include "base/Types.h"
+#include "lua-bindings/manual/Lua-BindingsExport.h"
+
+/**
+ * @addtogroup lua
+ * @{
+ */
+
+NS_AX_BEGIN
+
+class EventListenerCustom;
+
+/**
+ * Runs the incremental collector of a lua_State in the idle time of each frame.
+ *
+ * Left alone, the collector runs its steps from within the allocations, so a large step or the end of a cycle can
+ * land anywhere in the frame. When enabled, the controller stops the automatic collector (LUA_GCSTOP) and paces it
+ * itself: a cycle starts once the heap has grown by the pause since the end of the last one, and runs LUA_GCSTEP after
+ * the frame is drawn, for the time left until the next frame, clamped by the min/max budgets. The step size adapts to
+ * the measured cost per KB, and the budget is raised (up to the max budget) when the allocation rate needs more work
+ * per frame to keep the heap bounded. If the heap still goes over the heap limit, a full collection runs.
+ * The pause, step multiplier and collector mode of the lua_State are restored when disabled.
+ * Works with both luajit and plainlua.
+ *
+ * @lua NA
+ */
+class AX_LUA_DLL LuaGCController
+{
+public:
+    struct Stats
+    {
+        float stepTime        = 0.f;  // ms spent in the GC steps of the last frame
+        float avgStepTime     = 0.f;  // smoothed stepTime
+        float allocRate       = 0.f;  // smoothed KB allocated per frame
+        size_t heapSize       = 0;    // KB after the last frame steps
+        int stepSize          = 0;    // KB, the data of the last LUA_GCSTEP
+        uint32_t cycles       = 0;    // collection cycles finished by the controller steps
+        uint32_t fullCollects = 0;    // full collections run because the heap went over the limit
+    };
+
+    explicit LuaGCController(lua_State* L);
+    ~LuaGCController();
+
+    /** Starts or stops stepping the collector after each frame. */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    /** Sets the max ms spent collecting per frame, 2 by default. */
+    void setMaxBudget(float ms) { _maxBudget = ms; }
+    float getMaxBudget() const { return _maxBudget; }
+
+    /** Sets the min ms spent collecting per frame even if the frame is late, 0.25 by default. */
+    void setMinBudget(float ms) { _minBudget = ms; }
+    float getMinBudget() const { return _minBudget; }
+
+    /**
+     * Sets the percent the heap grows after a cycle before the next one starts, 200 by default.
+     * Also applied to the lua_State with LUA_GCSETPAUSE, for the automatic collector.
+     */
+    void setPause(int percent);
+    int getPause() const { return _pause; }
+
+    /** Sets the LUA_GCSETSTEPMUL of the lua_State while enabled, 0 (default) to keep its value. */
+    void setStepMul(int percent);
+    int getStepMul() const { return _stepMul; }
+
+    /**
+     * Whether the automatic collector keeps running its steps from within the allocations, false by default.
+     * When false the collector is stopped and only the controller steps run.
+     */
+    void setAutoCollect(bool autoCollect);
+    bool isAutoCollect() const { return _autoCollect; }
+
+    /**
+     * Sets the heap size in KB above which a full collection runs after the frame steps.
+     * 0 (default) uses twice the heap size at which the next cycle starts.
+     */
+    void setHeapLimit(size_t kb) { _heapLimit = kb; }
+    size_t getHeapLimit() const { return _heapLimit; }
+
+    /** Whether to show the GC time and heap size with the Director stats. */
+    void setStatsDisplay(bool display);
+    bool isStatsDisplay() const { return _statsDisplay; }
+
+    const Stats& getStats() const { return _stats; }
+
+    /**
+     * Runs incremental GC steps for up to budget ms.
+     *
+     * @return true if a collection cycle finished.
+     */
+    bool step(float budget);
+
+    /**
+     * Gets the ms to spend collecting after a frame.
+     *
+     * @param timeLeft ms left until the next frame.
+     * @param allocRate KB allocated per frame.
+     * @param costPerKB ms per KB of LUA_GCSTEP.
+     */
+    static float computeBudget(float timeLeft, float allocRate, float costPerKB, float minBudget, float maxBudget);
+
+    /** Gets the data of the next LUA_GCSTEP for the ms left in the budget. */
+    static int computeStepSize(float budgetLeft, float costPerKB);
+
+private:
+    using clock_type = std::chrono::steady_clock;
+
+    void onFrameBegin();
+    void onFrameEnd();
+    void onCycleEnd();
+    void fullCollect();
+
+    lua_State* _state;
+    bool _enabled             = false;
+    bool _statsDisplay        = false;
+    bool _autoCollect         = false;
+    bool _cycleRunning        = false;
+    float _maxBudget          = 2.f;
+    float _minBudget          = 0.25f;
+    float _costPerKB          = 0.002f;  // ms per KB of LUA_GCSTEP, measured
+    float _statsTime          = 0.f;
+    int _lastHeapSize         = 0;
+    int _pause                = 200;
+    int _stepMul              = 0;
+    size_t _heapLimit         = 0;
+    size_t _nextCycleHeapSize = 0;  // KB, the heap size at which the next cycle starts
+
+    // the lua_State settings to restore when disabled
+    int _prevPause    = 0;
+    int _prevStepMul  = 0;
+    int _prevMode     = 0;
+    bool _prevRunning = true;
+
+    clock_type::time_point _frameBegin;
+    EventListenerCustom* _beforeUpdateListener = nullptr;
+    EventListenerCustom* _afterDrawListener    = nullptr;
+    EventListenerCustom* _resetListener        = nullptr;
+    Stats _stats;
+};
+
+NS_AX_END
+
+// end group
+/// @}
+#endif  // __AX_LUA_GC_CONTROLLER_H_
@@ -8260,6 +8260,12 @@ static int tolua_cocos2d_Vec4_new(lua_State* L)
                                   static_cast<float>(lua_tonumber(L, 3)), static_cast<float>(lua_tonumber(L, 4))});
 }
 
+static int tolua_ax_set_valuetype_userdata(lua_State* L)
+{
+    luaval_set_valuetype_userdata(lua_toboolean(L, 1) != 0);
+    return 0;
+}
+
 int register_all_ax_math_manual(lua_State* tolua_S)
 {
     if (nullptr == tolua_S)
@@ -8280,6 +8286,7 @@ int register_all_ax_math_manual(lua_State* tolua_S)
     tolua_function(tolua_S, "vec2_new", tolua_cocos2d_Vec2_new);
     tolua_function(tolua_S, "vec3_new", tolua_cocos2d_Vec3_new);
     tolua_function(tolua_S, "vec4_new", tolua_cocos2d_Vec4_new);
+    tolua_function(tolua_S, "set_valuetype_userdata", tolua_ax_set_valuetype_userdata);
     tolua_endmodule(tolua_S);
     return 0;
 }
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <spine/Extension.h>
 #include <spine/SkeletonAnimation.h>
+#include <spine/SkeletonBatchUpdater.h>
 #include <spine/spine-axmol.h>
 
 USING_NS_AX;
@@ -49,11 +50,21 @@ namespace spine {
 	} _TrackEntryListeners;
 
 	void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onAnimationStateEvent(entry, type, event);
+		SkeletonAnimation *animation = (SkeletonAnimation *) state->getRendererObject();
+		if (animation->_deferEvents) {
+			animation->_deferredEvents.push_back({entry, type, event, false});
+			return;
+		}
+		animation->onAnimationStateEvent(entry, type, event);
 	}
 
 	void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
-		((SkeletonAnimation *) state->getRendererObject())->onTrackEntryEvent(entry, type, event);
+		SkeletonAnimation *animation = (SkeletonAnimation *) state->getRendererObject();
+		if (animation->_deferEvents) {
+			animation->_deferredEvents.push_back({entry, type, event, true});
+			return;
+		}
+		animation->onTrackEntryEvent(entry, type, event);
 		if (type == EventType_Dispose) {
 			if (entry->getRendererObject()) {
 				delete (spine::_TrackEntryListeners *) entry->getRendererObject();
@@ -125,6 +136,7 @@ namespace spine {
 	}
 
 	SkeletonAnimation::~SkeletonAnimation() {
+		if (_batchUpdatePending) SkeletonBatchUpdater::getInstance()->unschedule(this);
 		if (_ownsAnimationStateData) delete _state->getData();
 		delete _state;
 	}
@@ -135,21 +147,65 @@ namespace spine {
 		super::update(deltaTime);
 
 		deltaTime *= _timeScale;
+		if (_batchUpdateEnabled) {
+			SkeletonBatchUpdater::getInstance()->schedule(this, deltaTime);
+			return;
+		}
 		if (_preUpdateListener) _preUpdateListener(this);
+		updateSkeleton(deltaTime);
+		if (_postUpdateListener) _postUpdateListener(this);
+	}
+
+	void SkeletonAnimation::updateSkeleton(float deltaTime) {
 		_state->update(deltaTime);
 		_state->apply(*_skeleton);
 		_skeleton->updateWorldTransform();
-		if (_postUpdateListener) _postUpdateListener(this);
 	}
 
 	void SkeletonAnimation::draw(axmol::Renderer *renderer, const axmol::Mat4 &transform, uint32_t transformFlags) {
 		if (_firstDraw) {
 			_firstDraw = false;
-			update(0);
+			if (_batchUpdateEnabled) {
+				// This frame's batch update already ran, pose the skeleton right away.
+				if (_preUpdateListener) _preUpdateListener(this);
+				updateSkeleton(0);
+				if (_postUpdateListener) _postUpdateListener(this);
+			} else {
+				update(0);
+			}
 		}
 		super::draw(renderer, transform, transformFlags);
 	}
 
+	void SkeletonAnimation::beginDeferredEvents() {
+		// Track entries are disposed once their deferred events were delivered.
+		_manualTrackEntryDisposal = _state->getManualTrackEntryDisposal();
+		_state->setManualTrackEntryDisposal(true);
+		_deferEvents = true;
+	}
+
+	void SkeletonAnimation::endDeferredEvents() {
+		_deferEvents = false;
+		_state->setManualTrackEntryDisposal(_manualTrackEntryDisposal);
+	}
+
+	void SkeletonAnimation::flushDeferredEvents() {
+		if (_deferredEvents.empty()) return;
+
+		// Listeners may raise new events (eg, setAnimation in a complete listener), those are delivered immediately.
+		std::vector<DeferredEvent> events;
+		events.swap(_deferredEvents);
+		for (const DeferredEvent &deferred : events) {
+			if (deferred.trackEvent) {
+				trackEntryCallback(_state, deferred.type, deferred.entry, deferred.event);
+			} else {
+				animationCallback(_state, deferred.type, deferred.entry, deferred.event);
+				// The state listener is the last one called for a disposed entry.
+				if (deferred.type == EventType_Dispose && !_manualTrackEntryDisposal) _state->disposeTrackEntry(deferred.entry);
+			}
+		}
+	}
+
 	void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
 		AXASSERT(stateData, "stateData cannot be null.");
 
@@ -324,4 +380,12 @@ namespace spine {
 		_updateOnlyIfVisible = status;
 	}
 
+	void SkeletonAnimation::setBatchUpdateEnabled(bool enabled) {
+		_batchUpdateEnabled = enabled;
+	}
+
+	bool SkeletonAnimation::isBatchUpdateEnabled() const {
+		return _batchUpdateEnabled;
+	}
+
 }// namespace spine
@@ -102,16 +102,46 @@ namespace spine {
 		AnimationState *getState() const;
 		void setUpdateOnlyIfVisible(bool status);
 
+		/** When enabled, the pose and world transform are not updated in update() but by the SkeletonBatchUpdater,
+		 * together with the other batched skeletons across the JobSystem workers. Animation state events and the
+		 * update world transforms listeners are still called on the main thread. Disabled by default.
+		 * Listeners should not modify other skeletons of the batch while it is being updated. */
+		void setBatchUpdateEnabled(bool enabled);
+		bool isBatchUpdateEnabled() const;
+
 		SkeletonAnimation();
 		virtual ~SkeletonAnimation();
 		virtual void initialize() override;
 
 	protected:
+		friend class SkeletonBatchUpdater;
+		friend void animationCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+		friend void trackEntryCallback(AnimationState *state, EventType type, TrackEntry *entry, Event *event);
+
+		struct DeferredEvent {
+			TrackEntry *entry;
+			EventType type;
+			Event *event;
+			bool trackEvent;
+		};
+
+		// Applies the animation state and updates the world transform, safe to call from a worker thread
+		// while the events are deferred.
+		void updateSkeleton(float deltaTime);
+		void beginDeferredEvents();
+		void endDeferredEvents();
+		void flushDeferredEvents();
+
 		AnimationState *_state;
 
 		bool _ownsAnimationStateData;
 		bool _updateOnlyIfVisible;
 		bool _firstDraw;
+		bool _batchUpdateEnabled = false;
+		bool _batchUpdatePending = false;
+		bool _deferEvents = false;
+		bool _manualTrackEntryDisposal = false;
+		std::vector<DeferredEvent> _deferredEvents;
 
 		StartListener _startListener;
 		InterruptListener _interruptListener;
@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <spine/SkeletonBatchUpdater.h>
+#include <spine/SkeletonAnimation.h>
+#include <spine/Debug.h>
+
+#include <algorithm>
+#include <climits>
+
+USING_NS_AX;
+
+namespace spine {
+
+	static SkeletonBatchUpdater *instance = nullptr;
+
+	SkeletonBatchUpdater *SkeletonBatchUpdater::getInstance() {
+		if (!instance) instance = new SkeletonBatchUpdater();
+		return instance;
+	}
+
+	void SkeletonBatchUpdater::destroyInstance() {
+		if (instance) {
+			delete instance;
+			instance = nullptr;
+		}
+	}
+
+	SkeletonBatchUpdater::SkeletonBatchUpdater() : _lastBatchSize(0), _registeredFrame(UINT_MAX) {
+	}
+
+	SkeletonBatchUpdater::~SkeletonBatchUpdater() {
+		Director::getInstance()->getScheduler()->unscheduleUpdate(this);
+		for (PendingUpdate &pending : _pending) pending.animation->_batchUpdatePending = false;
+	}
+
+	void SkeletonBatchUpdater::schedule(SkeletonAnimation *animation, float deltaTime) {
+		if (animation->_batchUpdatePending) {
+			// Updated more than once this frame, eg by a custom scheduler.
+			auto it = std::find_if(_pending.begin(), _pending.end(), [animation](const PendingUpdate &pending) { return pending.animation == animation; });
+			if (it != _pending.end()) {
+				it->deltaTime += deltaTime;
+				return;
+			}
+		}
+		auto director = Director::getInstance();
+		if (_registeredFrame != director->getTotalFrames()) {
+			// Registered again by the first skeleton of every frame, since Director::reset unschedules everything.
+			// Runs after all the other scheduled updates, so animations set this frame are applied before the visit.
+			_registeredFrame = director->getTotalFrames();
+			director->getScheduler()->scheduleUpdate(this, INT_MAX, false);
+		}
+		animation->_batchUpdatePending = true;
+		_pending.push_back({animation, deltaTime});
+	}
+
+	void SkeletonBatchUpdater::unschedule(SkeletonAnimation *animation) {
+		auto it = std::find_if(_pending.begin(), _pending.end(), [animation](const PendingUpdate &pending) { return pending.animation == animation; });
+		if (it != _pending.end()) _pending.erase(it);
+		animation->_batchUpdatePending = false;
+	}
+
+	void SkeletonBatchUpdater::update(float delta) {
+		_lastBatchSize = _pending.size();
+		if (_pending.empty()) return;
+
+		// Listeners may schedule skeletons for the next batch, or remove them from the scene.
+		std::vector<PendingUpdate> batch;
+		batch.swap(_pending);
+		for (PendingUpdate &pending : batch) {
+			pending.animation->retain();
+			pending.animation->_batchUpdatePending = false;
+		}
+
+		for (PendingUpdate &pending : batch) {
+			if (pending.animation->_preUpdateListener) pending.animation->_preUpdateListener(pending.animation);
+		}
+
+		auto updateSkeleton = [&batch](size_t index) {
+			SkeletonAnimation *animation = batch[index].animation;
+			animation->beginDeferredEvents();
+			animation->updateSkeleton(batch[index].deltaTime);
+			animation->endDeferredEvents();
+		};
+		// The leak tracking DebugExtension isn't thread safe.
+		if (dynamic_cast<DebugExtension *>(SpineExtension::getInstance())) {
+			for (size_t index = 0; index < batch.size(); ++index) updateSkeleton(index);
+		} else {
+			Director::getInstance()->getJobSystem()->parallelFor(batch.size(), updateSkeleton);
+		}
+
+		// Events are delivered skeleton by skeleton in scheduling order.
+		for (PendingUpdate &pending : batch) {
+			pending.animation->flushDeferredEvents();
+			if (pending.animation->_postUpdateListener) pending.animation->_postUpdateListener(pending.animation);
+		}
+
+		for (PendingUpdate &pending : batch) pending.animation->release();
+	}
+
+}// namespace spine
@@ -0,0 +1,75 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef SPINE_SKELETONBATCHUPDATER_H_
+#define SPINE_SKELETONBATCHUPDATER_H_
+
+#include "axmol.h"
+#include <spine/spine.h>
+#include <vector>
+
+namespace spine {
+
+	class SkeletonAnimation;
+
+	/** Updates the pose and world transform of the SkeletonAnimations with batch update enabled across the JobSystem
+	 * workers, once per frame after all the other scheduled updates and before the scene is visited.
+	 *
+	 * Animation state events raised while a skeleton is updated on a worker are recorded and delivered on the main thread
+	 * afterwards, skeleton by skeleton in the order their update() was called, so the callback order is deterministic.
+	 * The SpineExtension allocator must be thread safe, skeletons are updated serially when the DebugExtension is used. */
+	class SP_API SkeletonBatchUpdater {
+	public:
+		static SkeletonBatchUpdater *getInstance();
+
+		static void destroyInstance();
+
+		/** Queues the skeleton for this frame's batch update, called from SkeletonAnimation::update. */
+		void schedule(SkeletonAnimation *animation, float deltaTime);
+
+		/** Removes the skeleton from this frame's batch update, called when the skeleton is destroyed. */
+		void unschedule(SkeletonAnimation *animation);
+
+		void update(float delta);
+
+		/** Number of skeletons updated by the last batch update. */
+		size_t getLastBatchSize() const { return _lastBatchSize; }
+
+	protected:
+		SkeletonBatchUpdater();
+		virtual ~SkeletonBatchUpdater();
+
+		struct PendingUpdate {
+			SkeletonAnimation *animation;
+			float deltaTime;
+		};
+
+		std::vector<PendingUpdate> _pending;
+		size_t _lastBatchSize;
+		unsigned int _registeredFrame;
+	};
+
+}// namespace spine
+
+#endif /* SPINE_SKELETONBATCHUPDATER_H_ */
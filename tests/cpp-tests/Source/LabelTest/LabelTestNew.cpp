@@ -26,6 +26,8 @@
 #include "../testResource.h"
 #include "renderer/Renderer.h"
 #include "2d/FontAtlasCache.h"
+#include "2d/LabelLayoutCache.h"
+#include <chrono>
 
 USING_NS_AX;
 using namespace ui;
@@ -169,6 +171,8 @@ NewLabelTests::NewLabelTests()
     ADD_TEST_CASE(LabelIssueLineGap);
     ADD_TEST_CASE(LabelIssue17902);
     ADD_TEST_CASE(LabelLetterColorsTest);
+    ADD_TEST_CASE(LabelLayoutCacheTest);
+    ADD_TEST_CASE(LabelBatchDrawTest);
 };
 
 LabelFNTColorAndOpacity::LabelFNTColorAndOpacity()
@@ -3683,3 +3687,165 @@ void LabelLetterColorsTest::setLetterColors(ax::Label* label, const ax::Color3B&
             letter->setColor(color);
     }
 }
+
+//
+// LabelLayoutCacheTest
+//
+LabelLayoutCacheTest::LabelLayoutCacheTest()
+{
+    LabelLayoutCache::resetStats();
+
+    // 64 labels like damage numbers, each cycles through the same 30 strings every frame
+    auto origin = VisibleRect::leftBottom();
+    auto size   = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 64; ++i)
+    {
+        auto label = Label::createWithTTF("", "fonts/arial.ttf", 16);
+        label->setPosition(origin.x + size.width * (0.1f + 0.1f * (i % 9)),
+                           origin.y + size.height * (0.2f + 0.08f * (i / 9)));
+        addChild(label);
+        _labels.push_back(label);
+    }
+
+    auto menuItem = MenuItemFont::create("Layout Cache: ON", [](Object* sender) {
+        auto item = static_cast<MenuItemFont*>(sender);
+        if (LabelLayoutCache::isEnabled())
+        {
+            LabelLayoutCache::setCapacity(0);
+            item->setString("Layout Cache: OFF");
+        }
+        else
+        {
+            LabelLayoutCache::setCapacity(256);
+            item->setString("Layout Cache: ON");
+        }
+        LabelLayoutCache::resetStats();
+    });
+    menuItem->setFontSizeObj(16);
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(VisibleRect::center().x, VisibleRect::top().y - 80);
+    addChild(menu);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(origin.x + 10, origin.y + 10);
+    addChild(_statsLabel);
+
+    scheduleUpdate();
+}
+
+void LabelLayoutCacheTest::onExit()
+{
+    LabelLayoutCache::setCapacity(256);
+    AtlasDemoNew::onExit();
+}
+
+void LabelLayoutCacheTest::update(float /*dt*/)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < _labels.size(); ++i)
+    {
+        _labels[i]->setString(fmt::format("-{}", ((_frame + i) % 30) * 37 + 100));
+        _labels[i]->updateContent();
+    }
+    _updateTime +=
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() /
+        1000.0f;
+
+    if (++_frame % 30 == 0)
+    {
+        auto& stats = LabelLayoutCache::getStats();
+        _statsLabel->setString(fmt::format("hits: {}, misses: {}, hit rate: {:.1f}%, entries: {}, update: {:.3f} ms",
+                                           stats.hits, stats.misses, stats.getHitRate() * 100.f, stats.entries,
+                                           _updateTime / 30));
+        _updateTime = 0.f;
+    }
+}
+
+std::string LabelLayoutCacheTest::title() const
+{
+    return "Label layout cache";
+}
+
+std::string LabelLayoutCacheTest::subtitle() const
+{
+    return "64 labels cycle through 30 strings every frame";
+}
+
+LabelBatchDrawTest::LabelBatchDrawTest()
+{
+    // the labels are rendered into the target only while counting, the scene doesn't draw it
+    _target = RenderTexture::create(256, 256, backend::PixelFormat::RGBA8);
+    _target->setVisible(false);
+    addChild(_target);
+
+    _result = Label::createWithTTF("counting...", "fonts/arial.ttf", 24);
+    _result->setPosition(VisibleRect::center());
+    addChild(_result);
+
+    scheduleOnce([this](float) { runChecks(); }, 0.1f, "count");
+}
+
+Node* LabelBatchDrawTest::createLabels(const std::function<Label*()>& odd)
+{
+    auto content = Node::create();
+    for (int i = 0; i < 8; ++i)
+    {
+        auto label = i == 4 && odd ? odd() : Label::createWithTTF("Batch", "fonts/arial.ttf", 20);
+        label->setPosition(40 + (i % 4) * 50, 60 + (i / 4) * 100);
+        content->addChild(label);
+    }
+    return content;
+}
+
+int LabelBatchDrawTest::countDraws(Node* content)
+{
+    auto renderer = _director->getRenderer();
+
+    // the commands the scene queued so far aren't counted
+    renderer->render();
+    auto before = renderer->getDrawnBatches();
+
+    _target->beginWithClear(0, 0, 0, 0);
+    content->visit();
+    _target->end();
+    renderer->render();
+    return static_cast<int>(renderer->getDrawnBatches() - before);
+}
+
+void LabelBatchDrawTest::runChecks()
+{
+    std::string error;
+
+    auto sameAtlas = countDraws(createLabels(nullptr));
+    if (sameAtlas != 1)
+        error = fmt::format("8 labels of one atlas took {} draws, expected 1", sameAtlas);
+
+    // a label in the middle with another atlas or blend splits the labels around it
+    auto otherAtlas =
+        countDraws(createLabels([]() { return Label::createWithTTF("Batch", "fonts/Marker Felt.ttf", 20); }));
+    if (error.empty() && otherAtlas != 3)
+        error = fmt::format("a label of another atlas: {} draws, expected 3", otherAtlas);
+
+    auto otherBlend = countDraws(createLabels([]() {
+        auto label = Label::createWithTTF("Batch", "fonts/arial.ttf", 20);
+        label->setBlendFunc(BlendFunc::ADDITIVE);
+        return label;
+    }));
+    if (error.empty() && otherBlend != 3)
+        error = fmt::format("a label with another blend: {} draws, expected 3", otherBlend);
+
+    _result->setString(error.empty() ? fmt::format("passed: {}, {} and {} draws", sameAtlas, otherAtlas, otherBlend)
+                                     : fmt::format("failed: {}", error));
+    _result->setTextColor(error.empty() ? Color4B::GREEN : Color4B::RED);
+}
+
+std::string LabelBatchDrawTest::title() const
+{
+    return "Label batched draws";
+}
+
+std::string LabelBatchDrawTest::subtitle() const
+{
+    return "8 labels of one atlas take 1 draw, another atlas or blend in the middle splits them in 3";
+}
@@ -1030,4 +1030,45 @@ private:
     static void setLetterColors(ax::Label* label, const ax::Color3B& color);
 };
 
+class LabelLayoutCacheTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelLayoutCacheTest);
+
+    LabelLayoutCacheTest();
+
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    std::vector<ax::Label*> _labels;
+    ax::Label* _statsLabel = nullptr;
+    int _frame             = 0;
+    float _updateTime      = 0.f;
+};
+
+class LabelBatchDrawTest : public AtlasDemoNew
+{
+public:
+    CREATE_FUNC(LabelBatchDrawTest);
+
+    LabelBatchDrawTest();
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    /** Creates 8 labels sharing a font atlas, the label at index 4 is created by `odd` if set */
+    ax::Node* createLabels(const std::function<ax::Label*()>& odd);
+    /** Returns the draw calls of rendering content */
+    int countDraws(ax::Node* content);
+    void runChecks();
+
+    ax::RenderTexture* _target = nullptr;
+    ax::Label* _result         = nullptr;
+};
+
 #endif
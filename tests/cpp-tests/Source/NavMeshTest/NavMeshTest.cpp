@@ -46,6 +46,8 @@ NavMeshTests::NavMeshTests()
 #else
     ADD_TEST_CASE(NavMeshBasicTestDemo);
     ADD_TEST_CASE(NavMeshAdvanceTestDemo);
+    ADD_TEST_CASE(NavMeshAsyncPathTestDemo);
+    ADD_TEST_CASE(NavMeshTileStreamingTestDemo);
 #endif
 };
 
@@ -436,4 +438,179 @@ void NavMeshAdvanceTestDemo::touchesEnded(const std::vector<ax::Touch*>& touches
     }
 }
 
+NavMeshAsyncPathTestDemo::NavMeshAsyncPathTestDemo()
+    : _statsLabel(nullptr), _pathsFound(0), _pathsFailed(0), _maxUpdateTime(0.0f)
+{}
+
+NavMeshAsyncPathTestDemo::~NavMeshAsyncPathTestDemo() {}
+
+bool NavMeshAsyncPathTestDemo::init()
+{
+    if (!NavMeshBaseTestDemo::init())
+        return false;
+
+    // the default navmesh only holds 128 agents
+    auto navMesh = NavMesh::create("NavMesh/all_tiles_tilecache.bin", "NavMesh/geomset.txt", 1000);
+    navMesh->setDebugDrawEnable(false);
+    navMesh->setPathQueryBudget(0.002f);
+    navMesh->setMaxAgentMoveRequestsPerFrame(64);
+    setNavMesh(navMesh);
+    setNavMeshDebugCamera(_camera);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 15);
+    Vector<MenuItem*> items;
+    float y = VisibleRect::top().y - 50;
+    for (int count : {100, 500, 1000})
+    {
+        auto item = MenuItemLabel::create(Label::createWithTTF(ttfConfig, fmt::format("{} Agents", count)),
+                                          [this, count](Object*) { setAgentCount(count); });
+        item->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+        item->setPosition(Vec2(VisibleRect::left().x, y));
+        items.pushBack(item);
+        y -= 30;
+    }
+    auto replanItem =
+        MenuItemLabel::create(Label::createWithTTF(ttfConfig, "Replan All"), [this](Object*) { replanAll(); });
+    replanItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    replanItem->setPosition(Vec2(VisibleRect::left().x, y));
+    items.pushBack(replanItem);
+
+    auto menu = Menu::createWithArray(items);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu);
+
+    _statsLabel = Label::createWithTTF(ttfConfig, "");
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::bottom().y + 10));
+    addChild(_statsLabel);
+
+    setAgentCount(100);
+
+    return true;
+}
+
+Vec3 NavMeshAsyncPathTestDemo::randomPointOnMesh()
+{
+    float x = ax::random(-50.0f, 50.0f);
+    float z = ax::random(-50.0f, 50.0f);
+    Physics3DWorld::HitResult result;
+    getPhysics3DWorld()->rayCast(Vec3(x, 50.0f, z), Vec3(x, -50.0f, z), &result);
+    return result.hitPosition;
+}
+
+void NavMeshAsyncPathTestDemo::setAgentCount(int count)
+{
+    for (auto&& agent : _benchAgents)
+        agent->getOwner()->removeFromParent();
+    _benchAgents.clear();
+
+    NavMeshAgentParam param;
+    param.radius   = 0.5f;
+    param.height   = 2.0f;
+    param.maxSpeed = 8.0f;
+    for (int i = 0; i < count; ++i)
+    {
+        auto agent = NavMeshAgent::create(param);
+        agent->setSyncFlag(NavMeshAgent::AGENT_TO_NODE);
+        auto node = Node::create();
+        node->setPosition3D(randomPointOnMesh());
+        node->addComponent(agent);
+        this->addChild(node);
+        _benchAgents.emplace_back(agent);
+    }
+    _maxUpdateTime = 0.0f;
+}
+
+void NavMeshAsyncPathTestDemo::replanAll()
+{
+    auto navMesh   = getNavMesh();
+    _pathsFound    = 0;
+    _pathsFailed   = 0;
+    _maxUpdateTime = 0.0f;
+    for (auto&& agent : _benchAgents)
+    {
+        auto destination = randomPointOnMesh();
+        agent->move(destination);
+        navMesh->findPathAsync(agent->getOwner()->getPosition3D(), destination,
+                               [this](unsigned int, bool succeed, const std::vector<Vec3>&) {
+            succeed ? ++_pathsFound : ++_pathsFailed;
+        });
+    }
+}
+
+void NavMeshAsyncPathTestDemo::update(float delta)
+{
+    NavMeshBaseTestDemo::update(delta);
+
+    auto navMesh   = getNavMesh();
+    auto cost      = navMesh->getLastUpdateTime() * 1000.0f;
+    _maxUpdateTime = std::max(_maxUpdateTime, cost);
+    _statsLabel->setString(fmt::format("agents: {}, pending paths: {}, found: {}, failed: {}\n"
+                                       "navmesh update: {:.2f} ms, max: {:.2f} ms",
+                                       _benchAgents.size(), navMesh->getPendingPathRequestCount(), _pathsFound,
+                                       _pathsFailed, cost, _maxUpdateTime));
+}
+
+std::string NavMeshAsyncPathTestDemo::title() const
+{
+    return "Navigation Mesh Test";
+}
+
+std::string NavMeshAsyncPathTestDemo::subtitle() const
+{
+    return "Async Path & Sliced Crowd Benchmark";
+}
+
+NavMeshTileStreamingTestDemo::NavMeshTileStreamingTestDemo() : _anchor(nullptr), _statsLabel(nullptr), _elapsed(0.0f) {}
+
+NavMeshTileStreamingTestDemo::~NavMeshTileStreamingTestDemo() {}
+
+bool NavMeshTileStreamingTestDemo::init()
+{
+    if (!NavMeshBaseTestDemo::init())
+        return false;
+
+    auto navMesh = NavMesh::createWithTileStreaming("NavMesh/all_tiles_tilecache.bin", "NavMesh/geomset.txt", 20.0f);
+    navMesh->setDebugDrawEnable(true);
+    setNavMesh(navMesh);
+    setNavMeshDebugCamera(_camera);
+
+    // the anchor moves around the map, only the tiles near it stay resident
+    _anchor = MeshRenderer::create("MeshRendererTest/cylinder.c3b");
+    _anchor->setScale(0.3f);
+    _anchor->setCameraMask((unsigned short)CameraFlag::USER1);
+    addChild(_anchor);
+    navMesh->addStreamingAnchor(_anchor);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 15);
+    _statsLabel = Label::createWithTTF(ttfConfig, "");
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::bottom().y + 10));
+    addChild(_statsLabel);
+
+    return true;
+}
+
+void NavMeshTileStreamingTestDemo::update(float delta)
+{
+    NavMeshBaseTestDemo::update(delta);
+
+    _elapsed += delta;
+    _anchor->setPosition3D(Vec3(40.0f * sinf(_elapsed * 0.3f), 0.0f, 40.0f * cosf(_elapsed * 0.3f)));
+
+    auto navMesh = getNavMesh();
+    _statsLabel->setString(fmt::format("loaded tiles: {}/{}, navmesh update: {:.2f} ms", navMesh->getLoadedTileCount(),
+                                       navMesh->getTotalTileCount(), navMesh->getLastUpdateTime() * 1000.0f));
+}
+
+std::string NavMeshTileStreamingTestDemo::title() const
+{
+    return "Navigation Mesh Test";
+}
+
+std::string NavMeshTileStreamingTestDemo::subtitle() const
+{
+    return "Tile Streaming";
+}
+
 #endif
@@ -121,6 +121,51 @@ protected:
     ax::Label* _debugLabel;
 };
 
+class NavMeshAsyncPathTestDemo : public NavMeshBaseTestDemo
+{
+public:
+    CREATE_FUNC(NavMeshAsyncPathTestDemo);
+    NavMeshAsyncPathTestDemo();
+    virtual ~NavMeshAsyncPathTestDemo();
+
+    // overrides
+    virtual bool init() override;
+    virtual void update(float delta) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    void setAgentCount(int count);
+    void replanAll();
+    ax::Vec3 randomPointOnMesh();
+
+protected:
+    std::vector<ax::NavMeshAgent*> _benchAgents;
+    ax::Label* _statsLabel;
+    int _pathsFound;
+    int _pathsFailed;
+    float _maxUpdateTime;
+};
+
+class NavMeshTileStreamingTestDemo : public NavMeshBaseTestDemo
+{
+public:
+    CREATE_FUNC(NavMeshTileStreamingTestDemo);
+    NavMeshTileStreamingTestDemo();
+    virtual ~NavMeshTileStreamingTestDemo();
+
+    // overrides
+    virtual bool init() override;
+    virtual void update(float delta) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    ax::Node* _anchor;
+    ax::Label* _statsLabel;
+    float _elapsed;
+};
+
 #endif
 
 #endif
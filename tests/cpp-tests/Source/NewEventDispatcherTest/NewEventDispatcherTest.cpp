@@ -32,6 +32,7 @@
 
 #include "NewEventDispatcherTest.h"
 #include "testResource.h"
+#include <chrono>
 
 USING_NS_AX;
 
@@ -144,6 +145,7 @@ EventDispatcherTests::EventDispatcherTests()
     ADD_TEST_CASE(WindowEventsTest);
     ADD_TEST_CASE(Issue8194);
     ADD_TEST_CASE(Issue9898)
+    ADD_TEST_CASE(CustomEventDispatchBenchmark);
 }
 
 std::string EventDispatcherTestDemo::title() const
@@ -1801,3 +1803,75 @@ std::string Issue9898::subtitle() const
 {
     return "Should not crash if dispatch event after remove\n event listener in callback";
 }
+
+// CustomEventDispatchBenchmark
+void CustomEventDispatchBenchmark::onEnter()
+{
+    EventDispatcherTestDemo::onEnter();
+
+    // 100 listeners for each of 4 events, like the per-frame events of Director
+    static const char* eventNames[] = {"benchmark_before_update", "benchmark_after_update", "benchmark_after_visit",
+                                       "benchmark_after_draw"};
+    for (auto&& eventName : eventNames)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            auto listener = EventListenerCustom::create(eventName, [this](EventCustom*) { ++_received; });
+            _eventDispatcher->addEventListenerWithFixedPriority(listener, 1 + i);
+            _listeners.emplace_back(listener);
+        }
+    }
+
+    constexpr int frames = 1000;
+    auto measure = [this](auto&& frame) {
+        _received  = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i)
+            frame();
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(elapsed / frames, _received / frames);
+    };
+
+    // events created once and dispatched every frame, as Director does
+    std::vector<std::unique_ptr<EventCustom>> events;
+    for (auto&& eventName : eventNames)
+        events.emplace_back(std::make_unique<EventCustom>(eventName));
+    auto prebuilt = measure([this, &events] {
+        for (auto&& event : events)
+            _eventDispatcher->dispatchEvent(event.get());
+    });
+
+    auto byName = measure([this] {
+        for (auto&& eventName : eventNames)
+            _eventDispatcher->dispatchCustomEvent(eventName);
+    });
+
+    auto text = fmt::format(
+        "4 events x 100 listeners, average of {} frames\n"
+        "dispatchEvent(EventCustom*): {:.2f} us/frame ({} calls)\n"
+        "dispatchCustomEvent(name): {:.2f} us/frame ({} calls)",
+        frames, prebuilt.first, prebuilt.second, byName.first, byName.second);
+    AXLOGI("{}", text);
+
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+void CustomEventDispatchBenchmark::onExit()
+{
+    for (auto&& listener : _listeners)
+        _eventDispatcher->removeEventListener(listener);
+    _listeners.clear();
+    EventDispatcherTestDemo::onExit();
+}
+
+std::string CustomEventDispatchBenchmark::title() const
+{
+    return "Custom event dispatch benchmark";
+}
+
+std::string CustomEventDispatchBenchmark::subtitle() const
+{
+    return "Cost of the per-frame custom events";
+}
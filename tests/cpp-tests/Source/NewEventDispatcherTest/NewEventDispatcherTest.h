@@ -311,4 +311,18 @@ private:
     ax::EventListenerCustom* _listener;
 };
 
+class CustomEventDispatchBenchmark : public EventDispatcherTestDemo
+{
+public:
+    CREATE_FUNC(CustomEventDispatchBenchmark);
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    std::vector<ax::EventListenerCustom*> _listeners;
+    int _received = 0;
+};
+
 #endif /* defined(__samples__NewEventDispatcherTest__) */
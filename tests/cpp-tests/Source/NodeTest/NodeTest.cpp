@@ -26,6 +26,7 @@
 
 #include "NodeTest.h"
 #include <regex>
+#include <chrono>
 #include "../testResource.h"
 
 USING_NS_AX;
@@ -73,6 +74,8 @@ CocosNodeTests::CocosNodeTests()
     ADD_TEST_CASE(Issue16100Test);
     ADD_TEST_CASE(Issue16735Test);
     ADD_TEST_CASE(NodeWorldSpace);
+    ADD_TEST_CASE(NodeQueryTest);
+    ADD_TEST_CASE(NodeVisitBenchmark);
 }
 
 TestCocosNodeDemo::TestCocosNodeDemo(void) {}
@@ -1568,3 +1571,184 @@ std::string NodeWorldSpace::subtitle() const
 {
     return "Child sprite (small one) should always stay at the center of screen\nthe child sprite is a child of the moving parent sprite";
 }
+
+//------------------------------------------------------------------
+//
+// NodeQueryTest
+//
+//------------------------------------------------------------------
+
+// how enumerateChildren("//Button.*") used to search: a std::regex for every visited child
+static void enumerateWithRegex(Node* node, const std::string& pattern, int& count)
+{
+    for (auto&& child : node->getChildren())
+    {
+        if (std::regex_match(std::string{child->getName()}, std::regex(pattern)))
+            ++count;
+    }
+    for (auto&& child : node->getChildren())
+        enumerateWithRegex(child, pattern, count);
+}
+
+void NodeQueryTest::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    // 100 panels * 9 rows * 10 items = 10k nodes
+    auto root = Node::create();
+    for (int i = 0; i < 100; ++i)
+    {
+        auto panel = Node::create();
+        root->addChild(panel, 0, fmt::format("Panel{}", i));
+        for (int j = 0; j < 9; ++j)
+        {
+            auto row = Node::create();
+            panel->addChild(row, 0, "Row");
+            for (int k = 0; k < 10; ++k)
+                row->addChild(Node::create(), 0, k < 3 ? fmt::format("Button{}", k) : std::string{"Label"});
+        }
+    }
+
+    constexpr int iterations = 10;
+    auto measure = [](auto&& func) {
+        auto start = std::chrono::steady_clock::now();
+        int count  = 0;
+        for (int i = 0; i < iterations; ++i)
+            count = func();
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return std::make_pair(elapsed / iterations, count);
+    };
+
+    auto regex = measure([root] {
+        int count = 0;
+        enumerateWithRegex(root, "Button.*", count);
+        return count;
+    });
+    auto enumerate = measure([root] {
+        int count = 0;
+        root->enumerateChildren("//Button.*", [&count](Node*) {
+            ++count;
+            return false;
+        });
+        return count;
+    });
+
+    NodeQuery exactQuery("//Button1");
+    auto exact = measure([root, &exactQuery] {
+        int count = 0;
+        exactQuery.evaluate(root, [&count](Node*) {
+            ++count;
+            return false;
+        });
+        return count;
+    });
+
+    NodeNameIndex index(root);
+    auto indexed = measure([root, &exactQuery, &index] {
+        int count = 0;
+        exactQuery.evaluate(
+            root,
+            [&count](Node*) {
+                ++count;
+                return false;
+            },
+            &index);
+        return count;
+    });
+
+    NodeQuery selectQuery("//Button.*");
+    auto cached = measure([root, &selectQuery] { return static_cast<int>(selectQuery.select(root).size()); });
+
+    auto text = fmt::format(
+        "10k nodes, average of {} runs\n"
+        "std::regex per child \"//Button.*\": {:.3f} ms ({} nodes)\n"
+        "enumerateChildren(\"//Button.*\"): {:.3f} ms ({} nodes)\n"
+        "NodeQuery(\"//Button1\"): {:.3f} ms ({} nodes)\n"
+        "NodeQuery(\"//Button1\") with NodeNameIndex: {:.3f} ms ({} nodes)\n"
+        "NodeQuery(\"//Button.*\").select() cached: {:.3f} ms ({} nodes)",
+        iterations, regex.first, regex.second, enumerate.first, enumerate.second, exact.first, exact.second,
+        indexed.first, indexed.second, cached.first, cached.second);
+    AXLOGI("{}", text);
+
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+std::string NodeQueryTest::title() const
+{
+    return "NodeQuery";
+}
+
+std::string NodeQueryTest::subtitle() const
+{
+    return "enumerateChildren() and NodeQuery on 10k nodes";
+}
+
+//
+// NodeVisitBenchmark
+//
+void NodeVisitBenchmark::onEnter()
+{
+    TestCocosNodeDemo::onEnter();
+
+    // 100 groups * 100 nodes, a few of them named or with user data like in a typical scene
+    auto root = Node::create();
+    for (int i = 0; i < 100; ++i)
+    {
+        auto group = Node::create();
+        group->setPosition(static_cast<float>(i), static_cast<float>(i));
+        root->addChild(group);
+        for (int j = 0; j < 100; ++j)
+        {
+            auto node = Node::create();
+            node->setPosition(static_cast<float>(j), static_cast<float>(-j));
+            node->setRotation(static_cast<float>(j));
+            if (j % 10 == 0)
+                node->setName(fmt::format("Node{}", j));
+            group->addChild(node, j % 3);
+        }
+    }
+
+    constexpr int iterations = 20;
+    auto renderer            = _director->getRenderer();
+
+    auto measure = [&](uint32_t flags) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            // the rotation changes the transform of every group
+            if (flags & FLAGS_TRANSFORM_DIRTY)
+                for (auto&& group : root->getChildren())
+                    group->setRotation(static_cast<float>(i));
+            root->visit(renderer, Mat4::IDENTITY, flags);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+               iterations;
+    };
+
+    auto dirty = measure(FLAGS_TRANSFORM_DIRTY);
+    auto clean = measure(0);
+
+    auto text = fmt::format(
+        "sizeof(Node): {} bytes\n"
+        "10k nodes, average of {} visits\n"
+        "transforms dirty: {:.3f} ms ({:.0f} nodes/ms)\n"
+        "transforms clean: {:.3f} ms ({:.0f} nodes/ms)",
+        sizeof(Node), iterations, dirty, 10100 / dirty, clean, 10100 / clean);
+    AXLOGI("{}", text);
+
+    auto label = Label::createWithTTF(text, "fonts/arial.ttf", 14);
+    label->setPosition(VisibleRect::center());
+    addChild(label);
+}
+
+std::string NodeVisitBenchmark::title() const
+{
+    return "Node visit";
+}
+
+std::string NodeVisitBenchmark::subtitle() const
+{
+    return "sizeof(Node) and visit() throughput on 10k nodes";
+}
@@ -369,4 +369,24 @@ public:
     virtual void onExit() override;
 };
 
+class NodeQueryTest : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeQueryTest);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+};
+
+class NodeVisitBenchmark : public TestCocosNodeDemo
+{
+public:
+    CREATE_FUNC(NodeVisitBenchmark);
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    virtual void onEnter() override;
+};
+
 #endif
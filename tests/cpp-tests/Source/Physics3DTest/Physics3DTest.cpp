@@ -65,6 +65,7 @@ Physics3DTests::Physics3DTests()
     ADD_TEST_CASE(Physics3DCollisionCallbackDemo);
     ADD_TEST_CASE(Physics3DColliderDemo);
     ADD_TEST_CASE(Physics3DTerrainDemo);
+    ADD_TEST_CASE(Physics3DMultiThreadedBenchmarkDemo);
 #endif
 };
 
@@ -882,4 +883,101 @@ bool Physics3DColliderDemo::init()
     return true;
 }
 
+static bool s_physics3DMultiThreaded = true;
+
+std::string Physics3DMultiThreadedBenchmarkDemo::subtitle() const
+{
+    return "Physics3D Multithreaded Benchmark (3000 bodies)";
+}
+
+bool Physics3DMultiThreadedBenchmarkDemo::init()
+{
+    if (!Physics3DTestDemo::init())
+        return false;
+
+    // replace the default world before any physics object added
+    Physics3DWorldDes worldDes;
+    worldDes.isMultiThreaded = s_physics3DMultiThreaded;
+    auto world               = Physics3DWorld::create(&worldDes);
+    if (!world)
+        return false;
+    physicsScene->setPhysics3DWorld(world);
+
+    Physics3DRigidBodyDes rbDes;
+    rbDes.mass  = 0.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(60.0f, 1.0f, 60.0f));
+
+    auto floor = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+    floor->setTexture("MeshRendererTest/plane.png");
+    floor->setScaleX(60);
+    floor->setScaleZ(60);
+    this->addChild(floor);
+    floor->setCameraMask((unsigned short)CameraFlag::USER1);
+    floor->syncNodeToPhysics();
+    floor->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::NONE);
+
+    // 15 x 10 x 20 = 3000 boxes
+    rbDes.mass  = 1.f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(0.8f, 0.8f, 0.8f));
+    for (int k = 0; k < 20; k++)
+    {
+        for (int i = 0; i < 15; i++)
+        {
+            for (int j = 0; j < 10; j++)
+            {
+                auto mesh = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+                mesh->setTexture("Images/CyanSquare.png");
+                mesh->setPosition3D(Vec3(1.0f * i - 7.5f, 5.0f + 1.0f * k, 1.0f * j - 5.0f));
+                mesh->syncNodeToPhysics();
+                mesh->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE);
+                mesh->setCameraMask((unsigned short)CameraFlag::USER1);
+                mesh->setScale(0.8f);
+                this->addChild(mesh);
+            }
+        }
+    }
+
+    physicsScene->setPhysics3DDebugCamera(_camera);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 10);
+    auto toggleLabel = Label::createWithTTF(ttfConfig, world->isMultiThreaded() ? "Multithreaded ON" : "Multithreaded OFF");
+    auto toggleItem  = MenuItemLabel::create(toggleLabel, [this](Object* /*ref*/) {
+        s_physics3DMultiThreaded = !s_physics3DMultiThreaded;
+        getTestSuite()->restartCurrTest();
+    });
+    auto menu = Menu::create(toggleItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    toggleItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    toggleItem->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 65));
+    this->addChild(menu);
+
+    _statsLabel = Label::createWithTTF(ttfConfig, "");
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(Vec2(VisibleRect::left().x + 10, VisibleRect::bottom().y + 10));
+    this->addChild(_statsLabel);
+
+    scheduleUpdate();
+
+    return true;
+}
+
+void Physics3DMultiThreadedBenchmarkDemo::update(float delta)
+{
+    auto world = getPhysics3DWorld();
+    if (!world || !_statsLabel)
+        return;
+
+    _simulateTime += world->getLastSimulateTime();
+    _elapsed += delta;
+    ++_frames;
+    if (_elapsed >= 0.5f)
+    {
+        _statsLabel->setString(fmt::format("{}: {:.2f} ms/step", world->isMultiThreaded() ? "MT" : "ST",
+                                           _simulateTime * 1000.0f / _frames));
+        _elapsed      = 0.f;
+        _simulateTime = 0.f;
+        _frames       = 0;
+    }
+}
+
 #endif
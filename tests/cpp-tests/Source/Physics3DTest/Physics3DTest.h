@@ -158,6 +158,25 @@ public:
 private:
 };
 
+class Physics3DMultiThreadedBenchmarkDemo : public Physics3DTestDemo
+{
+public:
+    CREATE_FUNC(Physics3DMultiThreadedBenchmarkDemo);
+    Physics3DMultiThreadedBenchmarkDemo(){};
+    virtual ~Physics3DMultiThreadedBenchmarkDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+    virtual void update(float delta) override;
+
+protected:
+    ax::Label* _statsLabel = nullptr;
+    float _elapsed         = 0.f;
+    float _simulateTime    = 0.f;
+    int _frames            = 0;
+};
+
 #endif
 
 #endif
@@ -37,6 +37,7 @@ RenderTextureTests::RenderTextureTests()
     ADD_TEST_CASE(SpriteRenderTextureBug);
     ADD_TEST_CASE(RenderTexturePartTest);
     ADD_TEST_CASE(Issue16113Test);
+    ADD_TEST_CASE(RenderTextureReadPixelsAsync);
 };
 
 /**
@@ -810,3 +811,86 @@ std::string Issue16113Test::subtitle() const
 {
     return "aaa.png file without white border on iOS";
 }
+
+//
+// RenderTextureReadPixelsAsync
+//
+RenderTextureReadPixelsAsync::RenderTextureReadPixelsAsync()
+{
+    auto s = Director::getInstance()->getWinSize();
+
+    // red bottom half, green top half: the pixels are read back with the top row first
+    _target = RenderTexture::create(64, 64, backend::PixelFormat::RGBA8);
+    _target->setPosition(s.width / 2, s.height / 2);
+    addChild(_target);
+
+    auto top = LayerColor::create(Color4B::GREEN, 64, 32);
+    top->setPosition(0, 32);
+    _target->beginWithClear(1, 0, 0, 1);
+    top->visit();
+    _target->end();
+
+    _result = Label::createWithTTF("reading...", "fonts/arial.ttf", 24);
+    _result->setPosition(s.width / 2, s.height / 2 - 64);
+    addChild(_result);
+
+    MenuItemFont::setFontSize(16);
+    auto item = MenuItemFont::create("Read Again", [this](Object*) { readPixels(); });
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(VisibleRect::rightTop().x - 80, VisibleRect::rightTop().y - 100);
+    addChild(menu);
+
+    scheduleOnce([this](float) { readPixels(); }, 0.1f, "read");
+}
+
+void RenderTextureReadPixelsAsync::readPixels()
+{
+    auto director = Director::getInstance();
+    auto renderer = director->getRenderer();
+    _result->setString("reading...");
+
+    // make sure the render texture commands were executed before reading
+    renderer->render();
+
+    // released once the pixels are read, the scene may be left meanwhile
+    retain();
+    auto requestFrame = director->getTotalFrames();
+    renderer->readPixelsAsync(_target->getRenderTarget(), [this, requestFrame](const backend::PixelBufferDescriptor& pbd) {
+        onPixelsRead(pbd, requestFrame);
+        release();
+    });
+}
+
+void RenderTextureReadPixelsAsync::onPixelsRead(const backend::PixelBufferDescriptor& pbd, unsigned int requestFrame)
+{
+    auto pixelAt = [&pbd](int x, int y) {
+        auto p = pbd._data.getBytes() + (y * pbd._width + x) * 4;
+        return Color4B(p[0], p[1], p[2], p[3]);
+    };
+
+    std::string error;
+    if (!pbd)
+        error = "no pixels";
+    else if (pbd._width != 64 || pbd._height != 64 || pbd._data.getSize() != 64 * 64 * 4)
+        error = fmt::format("unexpected size {}x{}", pbd._width, pbd._height);
+    else if (pixelAt(0, 0) != Color4B::GREEN || pixelAt(63, 31) != Color4B::GREEN)
+        error = "the top rows aren't green";
+    else if (pixelAt(0, 32) != Color4B::RED || pixelAt(63, 63) != Color4B::RED)
+        error = "the bottom rows aren't red";
+
+    // the backends without fences read synchronously
+    const auto latency = Director::getInstance()->getTotalFrames() - requestFrame;
+    _result->setString(error.empty() ? fmt::format("passed, read {} frame(s) later", latency)
+                                     : fmt::format("failed: {}", error));
+    _result->setTextColor(error.empty() ? Color4B::GREEN : Color4B::RED);
+}
+
+std::string RenderTextureReadPixelsAsync::title() const
+{
+    return "Render Texture Read Pixels Async";
+}
+
+std::string RenderTextureReadPixelsAsync::subtitle() const
+{
+    return "Reads a red and green render texture back without stalling";
+}
@@ -182,4 +182,20 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class RenderTextureReadPixelsAsync : public RenderTextureTest
+{
+public:
+    CREATE_FUNC(RenderTextureReadPixelsAsync);
+    RenderTextureReadPixelsAsync();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void readPixels();
+    void onPixelsRead(const ax::backend::PixelBufferDescriptor& pbd, unsigned int requestFrame);
+
+private:
+    ax::RenderTexture* _target = nullptr;
+    ax::Label* _result         = nullptr;
+};
+
 #endif
@@ -72,6 +72,7 @@ SpineTests::SpineTests()
     fu->addSearchPath("spine", true);
 
     ADD_TEST_CASE(BatchingExample);
+    ADD_TEST_CASE(BatchUpdateExample);
     ADD_TEST_CASE(CoinExample);
     ADD_TEST_CASE(GoblinsExample);
     ADD_TEST_CASE(IKExample);
@@ -91,6 +92,7 @@ SpineTests::~SpineTests()
     FileUtils::getInstance()->setSearchPaths(_searchPaths);
     SkeletonBatch::destroyInstance();
     SkeletonTwoColorBatch::destroyInstance();
+    SkeletonBatchUpdater::destroyInstance();
 #ifdef _AX_DEBUG
     debugExtension->reportLeaks();
     delete debugExtension;
@@ -222,6 +224,92 @@ BatchingExample::~BatchingExample()
     delete _atlas;
 }
 
+// BatchUpdateExample
+bool BatchUpdateExample::init()
+{
+    if (!SpineTestLayer::init())
+        return false;
+
+    _title = "Batch update";
+
+    _atlas            = new (__FILE__, __LINE__) Atlas("spineboy.atlas", &textureLoader, true);
+    _attachmentLoader = new (__FILE__, __LINE__) AxmolAtlasAttachmentLoader(_atlas);
+
+    SkeletonJson* json = new (__FILE__, __LINE__) SkeletonJson(_attachmentLoader);
+    json->setScale(0.3f);
+    _skeletonData = json->readSkeletonDataFile("spineboy-pro.json");
+    AXASSERT(_skeletonData,
+             (json->getError().isEmpty() ? json->getError().buffer() : "Error reading skeleton data file."));
+    delete json;
+
+    _stateData = new (__FILE__, __LINE__) AnimationStateData(_skeletonData);
+    _stateData->setMix("walk", "jump", 0.2f);
+    _stateData->setMix("jump", "run", 0.2f);
+
+    int xMin = _contentSize.width * 0.05f, xMax = _contentSize.width * 0.95f;
+    int yMin = 0, yMax = _contentSize.height * 0.75f;
+    for (int i = 0; i < 150; i++)
+    {
+        SkeletonAnimation* skeleton = SkeletonAnimation::createWithData(_skeletonData, false);
+        skeleton->setAnimationStateData(_stateData);
+
+        skeleton->setAnimation(0, "walk", true);
+        skeleton->addAnimation(0, "jump", false, RandomHelper::random_int(0, 300) / 100.0f);
+        skeleton->addAnimation(0, "run", true);
+
+        // Events raised on the workers are delivered here, on the main thread.
+        skeleton->setEventListener([this](TrackEntry* entry, spine::Event* event) { ++_eventCount; });
+        skeleton->setCompleteListener([this](TrackEntry* entry) { ++_eventCount; });
+
+        skeleton->setPosition(Vec2(RandomHelper::random_int(xMin, xMax), RandomHelper::random_int(yMin, yMax)));
+        addChild(skeleton);
+        _skeletons.pushBack(skeleton);
+    }
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(VisibleRect::left() + Vec2(10, -60));
+    addChild(_statsLabel, 1);
+
+    auto listener          = EventListenerTouchOneByOne::create();
+    listener->onTouchBegan = [this](Touch* touch, ax::Event* event) -> bool {
+        setBatchUpdateEnabled(!_batchUpdateEnabled);
+        return true;
+    };
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(listener, this);
+
+    setBatchUpdateEnabled(true);
+    scheduleUpdate();
+    return true;
+}
+
+BatchUpdateExample::~BatchUpdateExample()
+{
+    delete _skeletonData;
+    delete _stateData;
+    delete _attachmentLoader;
+    delete _atlas;
+}
+
+std::string BatchUpdateExample::subtitle() const
+{
+    return "150 skeletons, touch to toggle the multithreaded batch update";
+}
+
+void BatchUpdateExample::setBatchUpdateEnabled(bool enabled)
+{
+    _batchUpdateEnabled = enabled;
+    for (auto skeleton : _skeletons)
+        skeleton->setBatchUpdateEnabled(enabled);
+}
+
+void BatchUpdateExample::update(float deltaTime)
+{
+    _statsLabel->setString(fmt::format("mode: {}\nlast batch: {} skeletons\nevents: {}",
+                                       _batchUpdateEnabled ? "batch update" : "per node update",
+                                       SkeletonBatchUpdater::getInstance()->getLastBatchSize(), _eventCount));
+}
+
 bool CoinExample::init()
 {
 
@@ -80,6 +80,29 @@ protected:
     spine::AnimationStateData* _stateData;
 };
 
+class BatchUpdateExample : public SpineTestLayer
+{
+public:
+    CREATE_FUNC(BatchUpdateExample);
+    ~BatchUpdateExample();
+
+    virtual bool init();
+    virtual std::string subtitle() const override;
+    virtual void update(float deltaTime) override;
+
+protected:
+    void setBatchUpdateEnabled(bool enabled);
+
+    spine::Atlas* _atlas;
+    spine::AttachmentLoader* _attachmentLoader;
+    spine::SkeletonData* _skeletonData;
+    spine::AnimationStateData* _stateData;
+    ax::Vector<spine::SkeletonAnimation*> _skeletons;
+    ax::Label* _statsLabel = nullptr;
+    bool _batchUpdateEnabled = true;
+    int _eventCount          = 0;
+};
+
 class CoinExample : public SpineTestLayer
 {
 public:
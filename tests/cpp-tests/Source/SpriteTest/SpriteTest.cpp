@@ -28,6 +28,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 #include "../testResource.h"
 #include "cocostudio/CocosStudioExtension.h"
@@ -142,6 +143,8 @@ SpriteTests::SpriteTests()
     ADD_TEST_CASE(SpriteWithImageDataTest1);
     ADD_TEST_CASE(SpriteWithImageDataTest2);
     ADD_TEST_CASE(SpriteWithImageDataTest3);
+    ADD_TEST_CASE(SpriteDynamicAtlasTest);
+    ADD_TEST_CASE(SpriteDynamicAtlasPagesTest);
 };
 
 //------------------------------------------------------------------
@@ -5975,3 +5978,211 @@ std::string SpriteWithImageDataTest3::subtitle() const
 {
     return "no sprite due to empty key";
 }
+
+//------------------------------------------------------------------
+//
+// SpriteDynamicAtlasTest
+//
+//------------------------------------------------------------------
+
+// small images drawn in turns, so no two neighbouring sprites share a texture unless they're packed
+static const std::vector<std::string> s_atlasIcons = {
+    s_pathB1, s_pathB2, s_pathR1,    s_pathR2,      s_pathF1,      s_pathF2,
+    s_Ball,   s_Paddle, s_pathClose, s_pathSister1, s_pathSister2, s_pathGrossini,
+};
+
+SpriteDynamicAtlasTest::SpriteDynamicAtlasTest()
+{
+    auto toggle = MenuItemFont::create("Next mode", [this](Object*) {
+        createIcons(_mode == Mode::LOOSE ? Mode::PACKED : _mode == Mode::PACKED ? Mode::REMAPPED : Mode::LOOSE);
+    });
+    toggle->setPosition(VisibleRect::right() + Vec2(-80, -40));
+    auto menu = Menu::create(toggle, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    addChild(menu, 1);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setPosition(VisibleRect::bottom() + Vec2(0, 40));
+    addChild(_statsLabel, 1);
+
+    createIcons(Mode::LOOSE);
+    scheduleUpdate();
+}
+
+void SpriteDynamicAtlasTest::createIcons(Mode mode)
+{
+    if (_icons)
+        _icons->removeFromParent();
+    _icons = Node::create();
+    addChild(_icons);
+    _mode = mode;
+
+    auto dynamicAtlas = DynamicAtlas::getInstance();
+    dynamicAtlas->removeUnusedPages();
+    dynamicAtlas->setEnabled(mode == Mode::PACKED);
+
+    // 800 icons, like a UI built from loose image files
+    auto start  = std::chrono::steady_clock::now();
+    auto origin = VisibleRect::leftBottom();
+    auto size   = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 800; ++i)
+    {
+        auto sprite = Sprite::create(s_atlasIcons[i % s_atlasIcons.size()]);
+        sprite->setScale(0.3f);
+        sprite->setPosition(origin + Vec2((i % 40 + 0.5f) * size.width / 40, (i / 40 + 0.5f) * size.height / 20));
+        _icons->addChild(sprite);
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (mode == Mode::LOOSE)
+        _modeInfo = fmt::format("own textures, created in {:.1f} ms", elapsed);
+    else if (mode == Mode::PACKED)
+        _modeInfo = fmt::format("dynamic atlas, created in {:.1f} ms", elapsed);
+    else
+    {
+        // the icons are packed on the job system and the existing sprites are moved to the pages
+        _modeInfo = "own textures, packing...";
+        retain();
+        start = std::chrono::steady_clock::now();
+        dynamicAtlas->addImagesAsync(s_atlasIcons, [this, start]() {
+            auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (_mode == Mode::REMAPPED)
+            {
+                int count = DynamicAtlas::getInstance()->remapSprites(_icons);
+                _modeInfo = fmt::format("packed in {:.1f} ms, {} sprites remapped", elapsed, count);
+            }
+            release();
+        });
+    }
+    AXLOGI("{}", DynamicAtlas::getInstance()->getDescription());
+}
+
+void SpriteDynamicAtlasTest::update(float dt)
+{
+    // the draws of the last frame, including the labels and the menu
+    _statsLabel->setString(fmt::format("{}\n{} draws, {} atlas pages", _modeInfo,
+                                       _director->getRenderer()->getDrawnBatches(),
+                                       DynamicAtlas::getInstance()->getPageCount()));
+}
+
+void SpriteDynamicAtlasTest::onExit()
+{
+    DynamicAtlas::getInstance()->setEnabled(false);
+    SpriteTestDemo::onExit();
+}
+
+std::string SpriteDynamicAtlasTest::title() const
+{
+    return "Dynamic atlas";
+}
+
+std::string SpriteDynamicAtlasTest::subtitle() const
+{
+    return "800 sprites of 12 image files: own textures, packed on creation, packed and remapped";
+}
+
+//------------------------------------------------------------------
+//
+// SpriteDynamicAtlasPagesTest
+//
+//------------------------------------------------------------------
+
+SpriteDynamicAtlasPagesTest::SpriteDynamicAtlasPagesTest()
+{
+    auto dynamicAtlas = DynamicAtlas::getInstance();
+    auto pageSize     = dynamicAtlas->getPageSize();
+    auto maxImageSize = dynamicAtlas->getMaxImageSize();
+    auto maxPageCount = dynamicAtlas->getMaxPageCount();
+
+    dynamicAtlas->removeAllPages();
+    auto error = runChecks();
+    dynamicAtlas->removeAllPages();
+
+    dynamicAtlas->setPageSize(pageSize);
+    dynamicAtlas->setMaxImageSize(maxImageSize);
+    dynamicAtlas->setMaxPageCount(maxPageCount);
+
+    auto result = Label::createWithTTF(error.empty() ? "passed" : fmt::format("failed: {}", error), "fonts/arial.ttf",
+                                       24);
+    result->setPosition(VisibleRect::center() + Vec2(0, -64));
+    result->setTextColor(error.empty() ? Color4B::GREEN : Color4B::RED);
+    addChild(result);
+}
+
+std::string SpriteDynamicAtlasPagesTest::runChecks()
+{
+    auto dynamicAtlas = DynamicAtlas::getInstance();
+
+    auto first = dynamicAtlas->addImage(s_pathB1);
+    if (!first)
+        return "b1.png isn't packed";
+    if (dynamicAtlas->addImage(s_pathB1) != first || dynamicAtlas->getSpriteFrame(s_pathB1) != first)
+        return "b1.png is packed twice";
+
+    auto second = dynamicAtlas->addImage(s_pathB2);
+    if (!second)
+        return "b2.png isn't packed";
+    if (second->getTexture() == first->getTexture() && second->getRect().intersectsRect(first->getRect()))
+        return "b1.png and b2.png overlap";
+
+    auto firstSize  = first->getRect().size;
+    auto secondSize = second->getRect().size;
+    auto largestSide =
+        static_cast<int>((std::max)({firstSize.width, firstSize.height, secondSize.width, secondSize.height}));
+
+    dynamicAtlas->setMaxImageSize(8);
+    if (dynamicAtlas->addImage(s_pathGrossini))
+        return "grossini.png is packed beyond the maximum image size";
+
+    // a page drawn by a sprite isn't evicted
+    auto sprite = Sprite::createWithSpriteFrame(first);
+    sprite->setPosition(VisibleRect::center());
+    addChild(sprite);
+    dynamicAtlas->removeUnusedPages();
+    if (dynamicAtlas->getSpriteFrame(s_pathB1) != first)
+        return "a page drawn by a sprite was evicted";
+
+    // the sprite keeps the texture of a forgotten page, and the pixels it's restored from
+    auto texture = first->getTexture();
+    dynamicAtlas->removeAllPages();
+    if (dynamicAtlas->getPageCount() != 0 || dynamicAtlas->getSpriteFrame(s_pathB1))
+        return "pages are left after removeAllPages";
+    if (sprite->getTexture() != texture)
+        return "the sprite lost the texture of its page";
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    VolatileTextureMgr::reloadAllTextures();
+#endif
+
+    // a single page which fits one image only: it blocks new pages while in use, and is evicted for them after
+    dynamicAtlas->setPageSize(largestSide + 2);
+    dynamicAtlas->setMaxPageCount(1);
+
+    auto only = dynamicAtlas->addImage(s_pathB1);
+    if (!only)
+        return "b1.png isn't packed into a page of its size";
+    auto onlyTexture = only->getTexture();
+    onlyTexture->retain();
+    auto blocked = dynamicAtlas->addImage(s_pathB2);
+    onlyTexture->release();
+    if (blocked)
+        return "the page limit is exceeded";
+    if (dynamicAtlas->getPageCount() != 1 || dynamicAtlas->getSpriteFrame(s_pathB1) != only)
+        return "a page in use was evicted for a new one";
+
+    if (!dynamicAtlas->addImage(s_pathB2) || dynamicAtlas->getSpriteFrame(s_pathB1))
+        return "the unused page wasn't evicted for a new one";
+    if (dynamicAtlas->getPageCount() != 1)
+        return fmt::format("{} pages, the limit is 1", dynamicAtlas->getPageCount());
+
+    return {};
+}
+
+std::string SpriteDynamicAtlasPagesTest::title() const
+{
+    return "Dynamic atlas pages";
+}
+
+std::string SpriteDynamicAtlasPagesTest::subtitle() const
+{
+    return "Packs, keeps and evicts pages, the sprite draws b1.png from a forgotten page";
+}
@@ -973,4 +973,43 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class SpriteDynamicAtlasTest : public SpriteTestDemo
+{
+public:
+    CREATE_FUNC(SpriteDynamicAtlasTest);
+    SpriteDynamicAtlasTest();
+    virtual void onExit() override;
+    virtual void update(float dt) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    enum class Mode
+    {
+        LOOSE,
+        PACKED,
+        REMAPPED
+    };
+
+    void createIcons(Mode mode);
+
+    ax::Node* _icons       = nullptr;
+    ax::Label* _statsLabel = nullptr;
+    Mode _mode             = Mode::LOOSE;
+    std::string _modeInfo;
+};
+
+class SpriteDynamicAtlasPagesTest : public SpriteTestDemo
+{
+public:
+    CREATE_FUNC(SpriteDynamicAtlasPagesTest);
+    SpriteDynamicAtlasPagesTest();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    /** Returns the first failed check, empty if all passed */
+    std::string runChecks();
+};
+
 #endif
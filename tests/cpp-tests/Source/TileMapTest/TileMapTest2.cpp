@@ -68,6 +68,7 @@ FastTileMapTests::FastTileMapTests()
     ADD_TEST_CASE(TMXGIDObjectsTestNew);
     ADD_TEST_CASE(TileAnimTestNew);
     ADD_TEST_CASE(TileAnimTestNew2);
+    ADD_TEST_CASE(TMXChunkedMapTestNew);
 }
 
 TileDemoNew::TileDemoNew()
@@ -1431,3 +1432,70 @@ void TileAnimTestNew2::onTouchBegan(const std::vector<ax::Touch*>& touches, ax::
     _animStarted = !_animStarted;
     map->setTileAnimEnabled(_animStarted);
 }
+
+//------------------------------------------------------------------
+//
+// TMXChunkedMapTestNew
+//
+//------------------------------------------------------------------
+TMXChunkedMapTestNew::TMXChunkedMapTestNew()
+{
+    // generate a 1024x1024 layer with the binary tile layer format once
+    const int mapSize  = 1024;
+    auto fileUtils     = FileUtils::getInstance();
+    auto tilesFilePath = fileUtils->getWritablePath() + "tmx_chunked_test.axtl";
+    if (!fileUtils->isFileExist(tilesFilePath))
+    {
+        auto layerInfo        = new TMXLayerInfo();
+        layerInfo->_layerSize = Vec2(mapSize, mapSize);
+        layerInfo->_tiles     = axstd::pod_vector<uint32_t>(mapSize * mapSize).release_pointer();
+        for (int i = 0; i < mapSize * mapSize; ++i)
+            layerInfo->_tiles[i] = 1 + (i * 2654435761u >> 16) % 48;
+        layerInfo->saveTilesToBinaryFile(tilesFilePath);
+        layerInfo->release();
+    }
+
+    auto tmxString = fmt::format(R"(<?xml version="1.0" encoding="UTF-8"?>
+<map version="1.0" orientation="orthogonal" width="{0}" height="{0}" tilewidth="32" tileheight="32">
+ <tileset firstgid="1" name="Desert" tilewidth="32" tileheight="32" spacing="1" margin="1">
+  <image source="tmw_desert_spacing.png" width="265" height="199"/>
+ </tileset>
+ <layer name="Ground" width="{0}" height="{0}">
+  <properties>
+   <property name="ax_chunk_size" value="32"/>
+  </properties>
+  <data encoding="axbin" source="{1}"/>
+ </layer>
+</map>)",
+                                 mapSize, tilesFilePath);
+
+    auto map = FastTMXTiledMap::createWithXML(tmxString, "TileMaps");
+    addChild(map, 0, kTagTileMap);
+    _layer = map->getLayer("Ground");
+
+    auto move = MoveBy::create(60, Vec2(-map->getContentSize().width / 2, -map->getContentSize().height / 2));
+    map->runAction(RepeatForever::create(Sequence::create(move, move->reverse(), nullptr)));
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 14);
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_BOTTOM_LEFT);
+    _statsLabel->setPosition(VisibleRect::leftBottom() + Vec2(10, 10));
+    addChild(_statsLabel, 1);
+
+    schedule(AX_SCHEDULE_SELECTOR(TMXChunkedMapTestNew::updateStats), 0.5f);
+}
+
+void TMXChunkedMapTestNew::updateStats(float /*dt*/)
+{
+    if (_layer)
+        _statsLabel->setString(fmt::format("loaded chunks: {}", _layer->getLoadedChunkCount()));
+}
+
+std::string TMXChunkedMapTestNew::title() const
+{
+    return "TMX Chunked Map 1024x1024";
+}
+
+std::string TMXChunkedMapTestNew::subtitle() const
+{
+    return "Binary tile layer, 32x32 tiles chunks built near the camera";
+}
@@ -363,4 +363,19 @@ public:
     void onTouchBegan(const std::vector<ax::Touch*>& touches, ax::Event* event);
 };
 
+class TMXChunkedMapTestNew : public TileDemoNew
+{
+public:
+    CREATE_FUNC(TMXChunkedMapTestNew);
+    TMXChunkedMapTestNew();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void updateStats(float dt);
+
+protected:
+    ax::FastTMXLayer* _layer = nullptr;
+    ax::Label* _statsLabel   = nullptr;
+};
+
 #endif
@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "cocostudio/ArmatureDataManager.h"
 #include "cocostudio/Armature.h"
 
+#include <chrono>
+
 USING_NS_AX;
 using namespace ax::ui;
 
@@ -54,6 +56,8 @@ UIRichTextTests::UIRichTextTests()
     ADD_TEST_CASE(UIRichTextHeaders);
     ADD_TEST_CASE(UIRichTextParagraph);
     ADD_TEST_CASE(UIRichTextScrollTo);
+    ADD_TEST_CASE(UIRichTextAppendBenchmark);
+    ADD_TEST_CASE(UIRichTextIncrementalLayout);
 }
 
 //
@@ -1181,3 +1185,282 @@ void UIRichTextScrollTo::updateScrollViewSize()
     _scrollView->setInnerContainerSize(Size(_scrollView->getInnerContainerSize().width, newHeight));
     _scrollView->scrollToTop(0.f, false);
 }
+
+//
+// UIRichTextAppendBenchmark
+//
+bool UIRichTextAppendBenchmark::init()
+{
+    if (UIRichTextTestBase::init())
+    {
+        auto& widgetSize = _widget->getContentSize();
+
+        constexpr int messageCount = 1000;
+        std::vector<std::string> messages;
+        messages.reserve(messageCount);
+        for (int i = 0; i < messageCount; ++i)
+            messages.emplace_back(fmt::format(R"(<font color="#{:06x}">[player{}]</font> message number {}<br/>)",
+                                              (i * 0x3f2d1b) & 0xffffff, i % 16, i));
+
+        auto createRichText = [this] {
+            auto richText = RichText::create();
+            richText->ignoreContentAdaptWithSize(false);
+            richText->setContentSize(Size(_defaultContentSize.width * 3, 0));
+            return richText;
+        };
+        auto measure = [](auto&& func) {
+            auto start = std::chrono::steady_clock::now();
+            func();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        // a chat log: a message is appended and laid out every frame
+        auto appended = createRichText();
+        auto appendTime = measure([&] {
+            for (auto&& message : messages)
+            {
+                appended->appendString(message);
+                appended->formatText();
+            }
+        });
+
+        auto updated = createRichText();
+        std::string text;
+        auto setStringTime = measure([&] {
+            for (auto&& message : messages)
+            {
+                text += message;
+                updated->setString(text);
+                updated->formatText();
+            }
+        });
+
+        // how it used to be done: the whole text is parsed and laid out for every message
+        auto rebuilt = createRichText();
+        text.clear();
+        auto rebuildTime = measure([&] {
+            for (auto&& message : messages)
+            {
+                text += message;
+                rebuilt->setString("");
+                rebuilt->setString(text);
+                rebuilt->formatText(true);
+            }
+        });
+
+        auto rewrapTime = measure([&] {
+            appended->setContentSize(Size(_defaultContentSize.width * 4, 0));
+            appended->formatText();
+        });
+        auto fullRewrapTime = measure([&] {
+            rebuilt->setContentSize(Size(_defaultContentSize.width * 4, 0));
+            rebuilt->formatText(true);
+        });
+
+        auto result = fmt::format(
+            "{} messages\n"
+            "appendString: {:.1f} ms\n"
+            "setString with the text so far: {:.1f} ms\n"
+            "parse and layout everything: {:.1f} ms\n"
+            "width change: {:.2f} ms, full layout {:.2f} ms",
+            messageCount, appendTime, setStringTime, rebuildTime, rewrapTime, fullRewrapTime);
+        AXLOGI("{}", result);
+
+        Text* alert = Text::create(result, "fonts/arial.ttf", 14);
+        alert->setPosition(Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f));
+        _widget->addChild(alert);
+
+        return true;
+    }
+    return false;
+}
+
+//
+// UIRichTextIncrementalLayout
+//
+namespace
+{
+// exposes the rows to compare the layouts
+class RichTextLayoutProbe : public RichText
+{
+public:
+    static RichTextLayoutProbe* create(float width)
+    {
+        auto richText = new RichTextLayoutProbe();
+        if (richText->init())
+        {
+            richText->autorelease();
+            richText->ignoreContentAdaptWithSize(false);
+            richText->setContentSize(Size(width, 0));
+            richText->setFontFace("fonts/Marker Felt.ttf");
+            richText->setFontSize(16);
+            return richText;
+        }
+        delete richText;
+        return nullptr;
+    }
+
+    const std::vector<Vector<Node*>>& getRows() const { return _elementRenders; }
+};
+
+RichElementText* createTextElement(int tag, const Color3B& color, std::string_view text)
+{
+    return RichElementText::create(tag, color, 255, text, "fonts/Marker Felt.ttf", 16);
+}
+
+// the row count, renderer positions and content size of an incremental layout against a full one
+std::string compareLayouts(RichTextLayoutProbe* incremental, RichTextLayoutProbe* full)
+{
+    incremental->formatText();
+    full->formatText(true);
+
+    auto& rows         = incremental->getRows();
+    auto& expectedRows = full->getRows();
+    if (rows.size() != expectedRows.size())
+        return fmt::format("{} rows instead of {}", rows.size(), expectedRows.size());
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        if (rows[i].size() != expectedRows[i].size())
+            return fmt::format("row {}: {} renderers instead of {}", i, rows[i].size(), expectedRows[i].size());
+
+        for (ssize_t j = 0; j < rows[i].size(); ++j)
+        {
+            auto renderer = rows[i].at(j);
+            auto expected = expectedRows[i].at(j);
+            if (!renderer->getPosition().fuzzyEquals(expected->getPosition(), 0.01f) ||
+                !renderer->getContentSize().equals(expected->getContentSize()))
+                return fmt::format("row {} renderer {}: ({:.1f}, {:.1f}) instead of ({:.1f}, {:.1f})", i, j,
+                                   renderer->getPositionX(), renderer->getPositionY(), expected->getPositionX(),
+                                   expected->getPositionY());
+
+            auto label         = dynamic_cast<Label*>(renderer);
+            auto expectedLabel = dynamic_cast<Label*>(expected);
+            if ((label == nullptr) != (expectedLabel == nullptr) ||
+                (label && label->getString() != expectedLabel->getString()))
+                return fmt::format("row {} renderer {}: different text", i, j);
+        }
+    }
+
+    if (!incremental->getContentSize().equals(full->getContentSize()))
+        return fmt::format("content size {}x{} instead of {}x{}", incremental->getContentSize().width,
+                           incremental->getContentSize().height, full->getContentSize().width,
+                           full->getContentSize().height);
+    return {};
+}
+}  // namespace
+
+bool UIRichTextIncrementalLayout::init()
+{
+    if (UIRichTextTestBase::init())
+    {
+        auto& widgetSize = _widget->getContentSize();
+
+        constexpr float width = 240;
+        std::vector<std::string> messages;
+        for (int i = 0; i < 12; ++i)
+            messages.emplace_back(
+                fmt::format(R"(<font color="#{:06x}">[player{}]</font> message {} long enough to wrap in the row<br/>)",
+                            (i * 0x3f2d1b) & 0xffffff, i, i));
+        auto join = [&messages](size_t count) {
+            std::string text;
+            for (size_t i = 0; i < count; ++i)
+                text += messages[i];
+            return text;
+        };
+
+        std::vector<std::pair<std::string, std::string>> results;
+        auto check = [&results](std::string_view name, RichTextLayoutProbe* incremental, RichTextLayoutProbe* full) {
+            results.emplace_back(name, compareLayouts(incremental, full));
+        };
+
+        {
+            auto incremental = RichTextLayoutProbe::create(width);
+            for (auto&& message : messages)
+            {
+                incremental->appendString(message);
+                incremental->formatText();
+            }
+            auto full = RichTextLayoutProbe::create(width);
+            full->setString(join(messages.size()));
+            check("appendString", incremental, full);
+        }
+
+        {
+            // the appended part only is parsed
+            auto incremental = RichTextLayoutProbe::create(width);
+            incremental->setString(join(6));
+            incremental->formatText();
+            incremental->setString(join(messages.size()));
+
+            auto full = RichTextLayoutProbe::create(width);
+            full->setString(join(messages.size()));
+            check("setString appending", incremental, full);
+
+            // the elements before the changed message keep their layout
+            auto text = join(messages.size());
+            text.replace(text.find("message 7"), 9, "changed message, longer than the others before it");
+            incremental->setString(text);
+            full->setString(text);
+            check("setString shared prefix", incremental, full);
+        }
+
+        {
+            auto incremental = RichTextLayoutProbe::create(width);
+            for (int i = 0; i < 6; ++i)
+            {
+                incremental->pushBackElement(createTextElement(i, Color3B::WHITE, fmt::format("text {} in a row ", i)));
+                if (i % 2)
+                    incremental->pushBackElement(RichElementNewLine::create(100 + i, Color3B::WHITE, 255));
+            }
+            incremental->formatText();
+            incremental->insertElement(createTextElement(10, Color3B::RED, "inserted text, wrapped in the row "), 2);
+            incremental->formatText();
+            incremental->removeElement(5);
+            incremental->removeElement(0);
+
+            // text 0 and 3 removed, the inserted text after text 1
+            auto full = RichTextLayoutProbe::create(width);
+            for (int i = 1; i < 6; ++i)
+            {
+                if (i != 3)
+                    full->pushBackElement(createTextElement(i, Color3B::WHITE, fmt::format("text {} in a row ", i)));
+                if (i == 1)
+                    full->pushBackElement(createTextElement(10, Color3B::RED, "inserted text, wrapped in the row "));
+                if (i % 2)
+                    full->pushBackElement(RichElementNewLine::create(100 + i, Color3B::WHITE, 255));
+            }
+            check("insertElement/removeElement", incremental, full);
+        }
+
+        {
+            auto incremental = RichTextLayoutProbe::create(width);
+            incremental->setString(join(messages.size()));
+            incremental->formatText();
+
+            auto full = RichTextLayoutProbe::create(width);
+            full->setString(join(messages.size()));
+            for (float newWidth : {width / 2, width * 2, width})
+            {
+                incremental->setContentSize(Size(newWidth, 0));
+                full->setContentSize(Size(newWidth, 0));
+                check(fmt::format("width {}", newWidth), incremental, full);
+            }
+        }
+
+        std::string result;
+        for (auto&& [name, error] : results)
+        {
+            auto line = fmt::format("{}: {}", name, error.empty() ? "passed" : error);
+            AXLOGI("{}", line);
+            result.append(line).push_back('\n');
+        }
+
+        Text* alert = Text::create(result, "fonts/arial.ttf", 14);
+        alert->setPosition(Vec2(widgetSize.width / 2.0f, widgetSize.height / 2.0f));
+        _widget->addChild(alert);
+
+        return true;
+    }
+    return false;
+}
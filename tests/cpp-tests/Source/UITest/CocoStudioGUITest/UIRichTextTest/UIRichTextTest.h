@@ -233,4 +233,20 @@ protected:
     ax::ui::ScrollView* _scrollView;
 };
 
+class UIRichTextAppendBenchmark : public UIRichTextTestBase
+{
+public:
+    CREATE_FUNC(UIRichTextAppendBenchmark);
+
+    bool init() override;
+};
+
+class UIRichTextIncrementalLayout : public UIRichTextTestBase
+{
+public:
+    CREATE_FUNC(UIRichTextIncrementalLayout);
+
+    bool init() override;
+};
+
 #endif /* defined(__TestCpp__UIRichTextTest__) */
@@ -0,0 +1,91 @@
+-- checks the value type userdata pushed by the math and color conversions, see set_valuetype_userdata
+local function runChecks()
+    local result = {}
+    local function check(name, passed)
+        result[#result+1] = name..': '..(passed and 'success' or 'failure')
+    end
+
+    set_valuetype_userdata(true)
+    local node = cc.Node:create()
+
+    node:setAnchorPoint(cc.p(0.25, 0.75))
+    local anchor = node:getAnchorPoint()
+    check('Vec2 fields', type(anchor) == 'userdata' and anchor.x == 0.25 and anchor[2] == 0.75 and #anchor == 2)
+    anchor.x = 0.5
+    node:setAnchorPoint(anchor)
+    check('Vec2 round trip', node:getAnchorPoint().x == 0.5 and node:getAnchorPoint() == anchor)
+    check('Vec2 tostring', tostring(anchor) == 'Vec2(0.5, 0.75)')
+
+    node:setContentSize(cc.size(30, 40))
+    local size = node:getContentSize()
+    check('Size fields', size.width == 30 and size.height == 40 and size[1] == 30)
+
+    node:setAnchorPoint(cc.p(0, 0))
+    local rect = node:getBoundingBox()
+    check('Rect fields', #rect == 4 and rect.x == 0 and rect.width == 30 and rect.height == 40)
+
+    node:setColor(cc.c3b(1, 2, 3))
+    local color = node:getColor()
+    check('Color3B fields', #color == 3 and color.r == 1 and color.g == 2 and color.b == 3 and color.a == nil)
+    check('Color3B has no alpha', not pcall(function() color.a = 255 end))
+    color.b = 9
+    node:setColor(color)
+    check('Color3B round trip', node:getColor().b == 9 and tostring(color) == 'Color3B(1, 2, 9)')
+
+    local label = cc.Label:create()
+    label:setTextColor(cc.c4b(4, 5, 6, 7))
+    local textColor = label:getTextColor()
+    check('Color4B fields', #textColor == 4 and textColor.r == 4 and textColor.a == 7)
+    node:setColor(textColor)
+    check('Color4B as Color3B', node:getColor().r == 4 and node:getColor().b == 6)
+    label:setTextColor(color)
+    check('Color3B as Color4B', label:getTextColor().b == 9 and label:getTextColor().a == 255)
+
+    node:setContentSize({width = 1, height = 2})
+    check('tables accepted', node:getContentSize().height == 2)
+
+    set_valuetype_userdata(false)
+    check('tables when disabled', type(node:getContentSize()) == 'table' and type(node:getColor()) == 'table')
+
+    return result
+end
+
+local function TestNode()
+
+    local function title()
+        return "LuaValueTypeTest"
+    end
+    local node = cc.Node:create()
+
+    local function onEnter()
+        local titleLabel = cc.Label:createWithTTF(title(), "fonts/arial.ttf", 32)
+        node:addChild(titleLabel, 1)
+        titleLabel:setAnchorPoint(cc.p(0.5, 0.5))
+        titleLabel:setPosition( cc.p(VisibleRect:center().x, VisibleRect:top().y - 50) )
+        local ok, result = pcall(runChecks)
+        set_valuetype_userdata(false)
+        local text = ok and table.concat(result, '\n') or ('error: '..tostring(result))
+        local label = cc.Label:createWithTTF(text, "fonts/Marker Felt.ttf", 10)
+        node:addChild(label, 1)
+        label:setAnchorPoint(cc.p(0.5, 0.5))
+        label:setPosition(VisibleRect:center())
+    end
+
+    local function onNodeEvent(event)
+        if "enter" == event then
+            onEnter()
+        end
+    end
+
+    node:registerScriptHandler(onNodeEvent)
+
+    return node
+end
+
+function LuaValueTypeMain()
+    cclog("LuaValueTypeMain")
+    local scene = cc.Scene:create()
+    scene:addChild(TestNode())
+    scene:addChild(CreateBackMenuItem())
+    return scene
+end
@@ -63,6 +63,7 @@ require "Scene3DTest/Scene3DTest"
 require "MaterialSystemTest/MaterialSystemTest"
 require "NavMeshTest/NavMeshTest"
 require "LuaLoaderTest/LuaLoaderTest"
+require "LuaValueTypeTest/LuaValueTypeTest"
 
 local LINE_SPACE = 40
 
@@ -120,6 +121,7 @@ local _allTests = {
     { isSupported = true,  name = "LightTest"              , create_func   =                 LightTestMain  },
     { isSupported = true,  name = "LuaBridgeTest"          , create_func   =        LuaBridgeMainTest },
     { isSupported = true,  name = "LuaLoaderTest"          , create_func   =        LuaLoaderMain },
+    { isSupported = true,  name = "LuaValueTypeTest"       , create_func   =        LuaValueTypeMain },
     { isSupported = true,  name = "MaterialSystemTest"     , create_func   =        MaterialSystemTest },
     { isSupported = true,  name = "MenuTest"               , create_func   =                  MenuTestMain  }, 
     { isSupported = true,  name = "MotionStreakTest"       , create_func   =          MotionStreakTest      },
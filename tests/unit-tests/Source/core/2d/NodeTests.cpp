@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/Camera.h"
+#include "2d/NodeQuery.h"
+
+USING_NS_AX;
+
+TEST_SUITE("2d/Node") {
+    TEST_CASE("subtree_camera_mask") {
+        auto root  = Node::create();
+        auto child = Node::create();
+        auto leaf  = Node::create();
+        root->addChild(child);
+        CHECK(root->getSubtreeCameraMask() == 1);
+
+        leaf->setCameraMask((unsigned short)CameraFlag::USER1);
+        child->addChild(leaf);
+        CHECK(child->getSubtreeCameraMask() == (1 | (unsigned short)CameraFlag::USER1));
+        CHECK(root->getSubtreeCameraMask() == (1 | (unsigned short)CameraFlag::USER1));
+
+        leaf->setCameraMask((unsigned short)CameraFlag::USER2);
+        CHECK(root->getSubtreeCameraMask() == (1 | (unsigned short)CameraFlag::USER2));
+
+        root->setCameraMask((unsigned short)CameraFlag::USER3);
+        CHECK(root->getSubtreeCameraMask() == (unsigned short)CameraFlag::USER3);
+
+        leaf->setCameraMask((unsigned short)CameraFlag::USER1);
+        leaf->removeFromParent();
+        CHECK(root->getSubtreeCameraMask() == (unsigned short)CameraFlag::USER3);
+    }
+
+    TEST_CASE("query") {
+        // root
+        //   Panel
+        //     Button1
+        //     Label
+        //       Button2
+        //   Button3
+        auto root    = Node::create();
+        auto panel   = Node::create();
+        auto label   = Node::create();
+        auto button1 = Node::create();
+        auto button2 = Node::create();
+        auto button3 = Node::create();
+        panel->setName("Panel");
+        label->setName("Label");
+        button1->setName("Button1");
+        button2->setName("Button2");
+        button3->setName("Button3");
+        root->addChild(panel);
+        root->addChild(button3);
+        panel->addChild(button1);
+        panel->addChild(label);
+        label->addChild(button2);
+
+        auto names = [](const std::vector<Node*>& nodes) {
+            std::string result;
+            for (auto node : nodes)
+                result.append(node->getName()).append(" ");
+            return result;
+        };
+
+        CHECK(names(NodeQuery("//Button.*").select(root)) == "Button3 Button1 Button2 ");
+        CHECK(names(NodeQuery("//Button[[:digit:]]").select(root)) == "Button3 Button1 Button2 ");
+        CHECK(names(NodeQuery("//Button*", NodeQuery::Syntax::GLOB).select(root)) == "Button3 Button1 Button2 ");
+        CHECK(names(NodeQuery("*/Button?", NodeQuery::Syntax::GLOB).select(root)) == "Button1 ");
+        CHECK(names(NodeQuery("Panel//Button2").select(root)) == "Button2 ");
+        CHECK(names(NodeQuery("//Button.*/..").select(button1)) == "Button1 Button2 ");
+        CHECK(names(NodeQuery("//Button.*/..").select(root)).empty());
+        CHECK(names(NodeQuery("../Button3").select(panel)) == "Button3 ");
+        CHECK(names(NodeQuery("//Button.*/..").select(panel)) == "Button3 Button1 Button2 ");
+        CHECK(names(NodeQuery("Panel/*/../Label", NodeQuery::Syntax::GLOB).select(root)) == "Label ");
+
+        NodeNameIndex index(root);
+        CHECK(names(NodeQuery("//Button2").select(root, &index)) == "Button2 ");
+        CHECK(names(NodeQuery("Panel//Button2").select(root, &index)) == "Button2 ");
+
+        int count = 0;
+        root->enumerateChildren("//Button.*", [&count](Node*) { return ++count == 2; });
+        CHECK(count == 2);
+
+        // the result is kept until the hierarchy below the root changes
+        NodeQuery query("//Button.*");
+        CHECK(names(query.select(root)) == "Button3 Button1 Button2 ");
+        button2->setName("Text");
+        CHECK(names(query.select(root)) == "Button3 Button1 ");
+        CHECK(names(NodeQuery("//Button2").select(root, &index)).empty());
+        button1->removeFromParent();
+        CHECK(names(query.select(root)) == "Button3 ");
+        label->addChild(button1);
+        CHECK(names(query.select(root)) == "Button3 Button1 ");
+    }
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "2d/TMXXMLParser.h"
+#include "platform/FileUtils.h"
+
+USING_NS_AX;
+
+TEST_SUITE("2d/TMXXMLParser") {
+    TEST_CASE("binary_tiles") {
+        auto fu = FileUtils::getInstance();
+
+        TMXLayerInfo source;
+        source._layerSize = Vec2(37, 21);
+        source._tiles     = axstd::pod_vector<uint32_t>(37 * 21).release_pointer();
+        for (uint32_t i = 0; i < 37 * 21; ++i)
+            source._tiles[i] = (i % 5 == 0) ? 0 : (i | (i % 3 == 0 ? kTMXTileHorizontalFlag : 0));
+
+        for (bool compressed : {true, false}) {
+            auto path = fu->getWritablePath() + "unit_test_tiles.axtl";
+            REQUIRE(source.saveTilesToBinaryFile(path, compressed));
+
+            auto data = fu->getDataFromFile(path);
+            TMXLayerInfo loaded;
+            REQUIRE(loaded.loadTilesFromBinary(data.getBytes(), data.getSize()));
+            CHECK(loaded._layerSize == source._layerSize);
+            CHECK(memcmp(loaded._tiles, source._tiles, 37 * 21 * sizeof(uint32_t)) == 0);
+
+            fu->removeFile(path);
+        }
+
+        SUBCASE("layer_size_mismatch") {
+            auto path = fu->getWritablePath() + "unit_test_tiles.axtl";
+            REQUIRE(source.saveTilesToBinaryFile(path));
+            auto data = fu->getDataFromFile(path);
+            fu->removeFile(path);
+
+            TMXLayerInfo loaded;
+            loaded._layerSize = Vec2(21, 37);
+            CHECK_FALSE(loaded.loadTilesFromBinary(data.getBytes(), data.getSize()));
+            CHECK(loaded._tiles == nullptr);
+
+            loaded._layerSize = source._layerSize;
+            CHECK(loaded.loadTilesFromBinary(data.getBytes(), data.getSize()));
+        }
+
+        SUBCASE("invalid") {
+            TMXLayerInfo loaded;
+            const char garbage[] = "AXTM not a tiles file";
+            CHECK_FALSE(loaded.loadTilesFromBinary(garbage, sizeof(garbage)));
+            CHECK_FALSE(loaded.loadTilesFromBinary(garbage, 4));
+            CHECK(loaded._tiles == nullptr);
+        }
+    }
+}
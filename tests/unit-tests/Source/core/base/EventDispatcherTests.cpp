@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/EventDispatcher.h"
+#include "base/EventCustom.h"
+#include "base/EventListenerCustom.h"
+
+USING_NS_AX;
+
+namespace
+{
+struct DispatcherFixture
+{
+    DispatcherFixture()
+    {
+        dispatcher = new EventDispatcher();
+        dispatcher->setEnabled(true);
+    }
+
+    ~DispatcherFixture() { dispatcher->release(); }
+
+    EventListenerCustom* add(std::string_view eventName, int priority, std::function<void(EventCustom*)> callback)
+    {
+        auto listener = EventListenerCustom::create(eventName, std::move(callback));
+        dispatcher->addEventListenerWithFixedPriority(listener, priority);
+        return listener;
+    }
+
+    EventDispatcher* dispatcher;
+    std::vector<int> calls;
+};
+}  // namespace
+
+TEST_SUITE("base/EventDispatcher") {
+    TEST_CASE("intern") {
+        DispatcherFixture f;
+
+        // names nobody listens to aren't interned and don't grow the table
+        f.dispatcher->dispatchCustomEvent("unit_test_not_listened");
+        CHECK(EventCustom::findEventId("unit_test_not_listened") == 0);
+        CHECK(EventCustom("unit_test_not_listened").getEventId() == 0);
+
+        f.add("unit_test_interned", 1, [&f](EventCustom*) { f.calls.push_back(1); });
+        auto eventId = EventCustom::findEventId("unit_test_interned");
+        CHECK(eventId != 0);
+        CHECK(EventCustom::internEventName("unit_test_interned") == eventId);
+        CHECK(EventCustom("unit_test_interned").getEventId() == eventId);
+    }
+
+    TEST_CASE_FIXTURE(DispatcherFixture, "slots") {
+        EventCustom event("unit_test_slots");
+
+        SUBCASE("listener_map_version") {
+            auto first = add("unit_test_slots", 1, [this](EventCustom*) { calls.push_back(1); });
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1});
+
+            // the listener vector is deleted, the cached slot must not keep pointing at it
+            dispatcher->removeEventListener(first);
+            REQUIRE_FALSE(dispatcher->hasEventListener("unit_test_slots"));
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1});
+
+            add("unit_test_slots", 1, [this](EventCustom*) { calls.push_back(2); });
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2});
+        }
+
+        SUBCASE("dirty_version") {
+            auto first = add("unit_test_slots", 1, [this](EventCustom*) { calls.push_back(1); });
+            add("unit_test_slots", 2, [this](EventCustom*) { calls.push_back(2); });
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2});
+
+            // the slot is up to date with the listener vector, but the order changed
+            dispatcher->setPriority(first, 3);
+            calls.clear();
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{2, 1});
+        }
+
+        SUBCASE("pending_changes") {
+            EventListenerCustom* self = nullptr;
+            self = add("unit_test_slots", 1, [this, &self](EventCustom*) {
+                calls.push_back(1);
+                dispatcher->removeEventListener(self);
+            });
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1});
+
+            // removed during the dispatch, the emptied vector is swept by the same dispatch
+            CHECK_FALSE(dispatcher->hasEventListener("unit_test_slots"));
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1});
+
+            // added during the dispatch, called from the next one on
+            add("unit_test_slots", 1, [this](EventCustom*) {
+                calls.push_back(2);
+                if (calls.size() == 2)
+                    add("unit_test_slots", 2, [this](EventCustom*) { calls.push_back(3); });
+            });
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2});
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2, 2, 3});
+        }
+
+        SUBCASE("nested") {
+            // the inner event is interned later and has a larger id, its slot is added while the outer dispatch runs
+            add("unit_test_slots", 1, [this](EventCustom*) {
+                calls.push_back(1);
+                dispatcher->dispatchCustomEvent("unit_test_slots_nested");
+            });
+            add("unit_test_slots", 3, [this](EventCustom*) { calls.push_back(3); });
+            add("unit_test_slots_nested", 1, [this](EventCustom*) { calls.push_back(2); });
+            REQUIRE(EventCustom::findEventId("unit_test_slots_nested") > event.getEventId());
+
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2, 3});
+            dispatcher->dispatchEvent(&event);
+            CHECK(calls == std::vector<int>{1, 2, 3, 1, 2, 3});
+        }
+    }
+}
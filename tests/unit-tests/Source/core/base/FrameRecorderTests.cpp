@@ -0,0 +1,99 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "base/FrameRecorder.h"
+
+USING_NS_AX;
+
+namespace
+{
+class TestRecorder : public FrameRecorder
+{
+public:
+    using FrameRecorder::FrameRecorder;
+
+    // a 2x1 frame filled with the frame index
+    void addFrame(uint64_t frameIndex)
+    {
+        backend::PixelBufferDescriptor pbd;
+        auto bytes = pbd._data.resize(8);
+        memset(bytes, static_cast<int>(frameIndex), 8);
+        pbd._width  = 2;
+        pbd._height = 1;
+        onFrameRead(pbd, frameIndex);
+    }
+};
+}  // namespace
+
+TEST_SUITE("base/FrameRecorder")
+{
+    TEST_CASE("ring")
+    {
+        TestRecorder recorder(3);
+        CHECK(recorder.getMaxFrames() == 3);
+        CHECK(recorder.getFrameCount() == 0);
+
+        recorder.addFrame(1);
+        recorder.addFrame(2);
+        CHECK(recorder.getFrameCount() == 2);
+        CHECK(recorder.getFrame(0).frameIndex == 1);
+        CHECK(recorder.getFrame(1).frameIndex == 2);
+
+        recorder.addFrame(3);
+        const uint8_t* oldest = recorder.getFrame(0).pixels.data();
+
+        // the oldest frame is dropped and its storage reused
+        recorder.addFrame(4);
+        recorder.addFrame(5);
+        REQUIRE(recorder.getFrameCount() == 3);
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            auto& frame = recorder.getFrame(i);
+            CHECK(frame.frameIndex == i + 3);
+            CHECK(frame.width == 2);
+            CHECK(frame.height == 1);
+            REQUIRE(frame.pixels.size() == 8);
+            CHECK(frame.pixels[0] == static_cast<uint8_t>(i + 3));
+            CHECK(frame.pixels[7] == static_cast<uint8_t>(i + 3));
+        }
+        CHECK(recorder.getFrame(1).pixels.data() == oldest);
+
+        recorder.clear();
+        CHECK(recorder.getFrameCount() == 0);
+        recorder.addFrame(6);
+        CHECK(recorder.getFrameCount() == 1);
+        CHECK(recorder.getFrame(0).frameIndex == 6);
+    }
+
+    TEST_CASE("max_frames")
+    {
+        TestRecorder recorder(0);
+        CHECK(recorder.getMaxFrames() == 1);
+
+        recorder.addFrame(1);
+        recorder.addFrame(2);
+        CHECK(recorder.getFrameCount() == 1);
+        CHECK(recorder.getFrame(0).frameIndex == 2);
+    }
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <mutex>
+#include <thread>
+#include "base/Logging.h"
+
+USING_NS_AX;
+
+namespace
+{
+class CaptureLogOutput : public ILogOutput
+{
+public:
+    void write(LogItem& item, const char* /*tag*/) override
+    {
+        std::lock_guard<std::mutex> lck(mutex);
+        messages.emplace_back(item.message());
+        threadIds.emplace_back(std::this_thread::get_id());
+    }
+
+    std::mutex mutex;
+    std::vector<std::string> messages;
+    std::vector<std::thread::id> threadIds;
+};
+}  // namespace
+
+TEST_SUITE("base/Logging") {
+    TEST_CASE("async") {
+        CaptureLogOutput output;
+        setLogOutput(&output);
+        setLogAsync(true);
+        REQUIRE(isLogAsync());
+
+        auto written = getLogStats().written;
+        std::thread worker([] {
+            for (int i = 0; i < 100; ++i)
+                AXLOGI("worker {}", i);
+        });
+        for (int i = 0; i < 100; ++i)
+            AXLOGI("main {}", i);
+        worker.join();
+        flushLog();
+
+        CHECK(getLogStats().written - written == 200);
+        CHECK(getLogStats().dropped == 0);
+        {
+            std::lock_guard<std::mutex> lck(output.mutex);
+            REQUIRE(output.messages.size() == 200);
+            CHECK(output.threadIds.front() != std::this_thread::get_id());
+
+            // records of a thread keep their order
+            int nextMain = 0, nextWorker = 0;
+            for (auto&& message : output.messages)
+            {
+                if (message.find("main ") != std::string::npos)
+                    CHECK(message.ends_with(fmt::format("main {}\n", nextMain++)));
+                else
+                    CHECK(message.ends_with(fmt::format("worker {}\n", nextWorker++)));
+            }
+        }
+
+        setLogAsync(false);
+        CHECK_FALSE(isLogAsync());
+        setLogOutput(nullptr);
+    }
+}
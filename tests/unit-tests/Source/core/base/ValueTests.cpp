@@ -25,6 +25,7 @@
 
 #include <doctest.h>
 #include "base/Value.h"
+#include "base/ValueBinary.h"
 
 USING_NS_AX;
 
@@ -100,4 +101,53 @@ TEST_SUITE("base/Value") {
         CHECK(v11.getType() == Value::Type::INT_KEY_MAP);
         CHECK(!v11.isNull());
     }
+
+    TEST_CASE("binary") {
+        ValueVector vector;
+        vector.emplace_back(Value());
+        vector.emplace_back(Value(-100));
+        vector.emplace_back(Value(100u));
+        vector.emplace_back(Value(int64_t{-(1ll << 40)}));
+        vector.emplace_back(Value(uint64_t{1ull << 63}));
+        vector.emplace_back(Value(101.4f));
+        vector.emplace_back(Value(106.1));
+        vector.emplace_back(Value(true));
+        vector.emplace_back(Value(std::string(300, 'x')));
+
+        ValueMapIntKey intKeyMap;
+        intKeyMap[-1] = Value("minus one");
+        intKeyMap[222] = Value(vector);
+
+        ValueMap map;
+        map["vector"] = Value(vector);
+        map["intKeyMap"] = Value(intKeyMap);
+        map["nested"] = Value(ValueMap{{"empty", Value(ValueMap{})}, {"string", Value("")}});
+
+        std::string encoded;
+        ValueBinary::encode(map, encoded);
+
+        SUBCASE("round_trip") {
+            std::string_view data = encoded;
+            ValueMap decoded;
+            REQUIRE(ValueBinary::decode(data, decoded));
+            CHECK(data.empty());
+            CHECK(Value(decoded) == Value(map));
+            CHECK(decoded["vector"].asValueVector()[3].getType() == Value::Type::INT_I64);
+            CHECK(decoded["vector"].asValueVector()[4].getType() == Value::Type::INT_UI64);
+        }
+
+        SUBCASE("truncated") {
+            for (size_t size = 0; size < encoded.size(); ++size) {
+                std::string_view data{encoded.data(), size};
+                ValueMap decoded;
+                CHECK_FALSE(ValueBinary::decode(data, decoded));
+            }
+        }
+
+        SUBCASE("type_mismatch") {
+            std::string_view data = encoded;
+            ValueVector decoded;
+            CHECK_FALSE(ValueBinary::decode(data, decoded));
+        }
+    }
 }
@@ -426,6 +426,24 @@ TEST_SUITE("platform/FileUtils") {
         CHECK(readValueMap["data5"].asFloat() == 1024.125f);
         CHECK(readValueMap["data6"].asDouble() == 1024.5);
 
+        // The first read cached the parsed file, the later ones come from the cache
+        CHECK(Value(fu->getValueMapFromFile(file)) == Value(readValueMap));
+
+        auto run = AsyncRunner<ValueMap>();
+        fu->getValueMapFromFile(file, [&](ValueMap result) {
+            run.finish(std::move(result));
+        });
+        CHECK(Value(run()) == Value(readValueMap));
+
+        // Changing the file invalidates the cache
+        valueMap["data1"] = Value("changed string");
+        REQUIRE(fu->writeValueMapToFile(valueMap, file));
+        CHECK(fu->getValueMapFromFile(file)["data1"].asString() == "changed string");
+
+        fu->setValueMapCacheEnabled(false);
+        CHECK(fu->getValueMapFromFile(file)["data1"].asString() == "changed string");
+        fu->setValueMapCacheEnabled(true);
+
         CHECK(fu->removeFile(file));
     }
 
@@ -0,0 +1,226 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "TestUtils.h"
+#include "platform/Image.h"
+#include "platform/FileUtils.h"
+#include "base/Utils.h"
+#include "base/etc2.h"
+
+USING_NS_AX;
+
+namespace
+{
+// A PVR v3 RGBA8888 file with 8x8, 4x4 and 2x2 mipmaps and 8 bytes of metadata
+Data makePvr3Rgba8888()
+{
+    const uint32_t header[] = {
+        0x03525650,  // version "PVR\3"
+        0,           // flags
+        0x61626772,  // pixel format RGBA8888, low 32 bits
+        0x08080808,  // pixel format, high 32 bits
+        0,           // color space
+        0,           // channel type
+        8,           // height
+        8,           // width
+        1,           // depth
+        1,           // surfaces
+        1,           // faces
+        3,           // mipmaps
+        8,           // metadata length
+    };
+    static_assert(sizeof(header) == 52, "PVR v3 header is 52 bytes");
+
+    Data data;
+    data.resize(sizeof(header) + 8 + (8 * 8 + 4 * 4 + 2 * 2) * 4);
+    memset(data.getBytes(), 0, data.getSize());
+    memcpy(data.getBytes(), header, sizeof(header));
+    return data;
+}
+
+class ImageAccess : public Image
+{
+public:
+    using Image::decodeETC2;
+
+    bool decode(int width, int height, const std::vector<uint8_t>& pixels, const std::function<int(uint8_t*)>& decoder)
+    {
+        _width  = width;
+        _height = height;
+        return decodeToRGBA8(pixels.data(), pixels.size(), decoder);
+    }
+};
+
+std::vector<uint8_t> makeEtc2Blocks(int format, uint32_t width, uint32_t height)
+{
+    const size_t blockBytes = format == ETC2_RGBA_NO_MIPMAPS ? 16 : 8;
+    std::vector<uint8_t> blocks(((width + 3) / 4) * ((height + 3) / 4) * blockBytes);
+    // every bit pattern is a valid block, so a simple generator covers all the modes
+    uint32_t seed = width * 31 + height;
+    for (auto& value : blocks)
+    {
+        seed  = seed * 1664525 + 1013904223;
+        value = static_cast<uint8_t>(seed >> 24);
+    }
+    return blocks;
+}
+
+std::vector<std::string> listDecodedCache()
+{
+    std::vector<std::string> files;
+    for (auto& file : FileUtils::getInstance()->listFiles(FileUtils::getInstance()->getWritablePath() + "decoded-textures/"))
+    {
+        if (file.ends_with(".rgba"))
+            files.emplace_back(file);
+    }
+    return files;
+}
+
+// the decoded cache is written by the job system
+template <typename Pred>
+bool waitFor(Pred pred)
+{
+    for (int i = 0; i < 500 && !pred(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return pred();
+}
+}  // namespace
+
+TEST_SUITE("platform/Image") {
+    TEST_CASE("mipmap_file_offset") {
+        auto fu   = FileUtils::getInstance();
+        auto path = fu->getWritablePath() + "unit_test_mipmaps.pvr";
+        auto data = makePvr3Rgba8888();
+        REQUIRE(fu->writeDataToFile(data, path));
+
+        SUBCASE("file") {
+            auto image = utils::makeInstance<Image>(&Image::initWithImageFile, path);
+            REQUIRE(image != nullptr);
+            REQUIRE(image->getNumberOfMipmaps() == 3);
+
+            // the levels follow the header and the metadata in the file
+            CHECK(image->getMipmapFileOffset(0) == 52 + 8);
+            CHECK(image->getMipmapFileOffset(1) == 52 + 8 + 8 * 8 * 4);
+            CHECK(image->getMipmapFileOffset(2) == 52 + 8 + 8 * 8 * 4 + 4 * 4 * 4);
+            CHECK(image->getMipmaps()[2].len == 2 * 2 * 4);
+
+            CHECK(image->getMipmapFileOffset(-1) == -1);
+            CHECK(image->getMipmapFileOffset(3) == -1);
+        }
+
+        SUBCASE("memory") {
+            // images that weren't read from a file have no offsets to stream from
+            Image image;
+            REQUIRE(image.initWithImageData(data.getBytes(), data.getSize()));
+            REQUIRE(image.getNumberOfMipmaps() == 3);
+            CHECK(image.getMipmapFileOffset(0) == -1);
+        }
+
+        fu->removeFile(path);
+    }
+
+    TEST_CASE("etc2_strips") {
+        // 16 block rows go to a strip, the heights cover a single strip and a partial last strip
+        const std::pair<uint32_t, uint32_t> sizes[] = {{37, 30}, {64, 64}, {37, 131}, {8, 129}, {4, 256}};
+        for (auto format : {ETC2_RGB_NO_MIPMAPS, ETC2_RGBA_NO_MIPMAPS})
+        {
+            for (auto [width, height] : sizes)
+            {
+                CAPTURE(format);
+                CAPTURE(width);
+                CAPTURE(height);
+                auto blocks = makeEtc2Blocks(format, width, height);
+
+                std::vector<uint8_t> serial(width * height * 4), strips(width * height * 4, 0xcd);
+                REQUIRE(etc2_decode_image(format, blocks.data(), serial.data(), width, height) == 0);
+                REQUIRE(ImageAccess::decodeETC2(format, blocks.data(), strips.data(), width, height) == 0);
+                CHECK(strips == serial);
+            }
+        }
+    }
+
+    TEST_CASE("decoded_cache") {
+        const auto enabled = Image::isDecodedCacheEnabled();
+        const auto limit   = Image::getDecodedCacheLimit();
+        Image::purgeDecodedCache();
+        Image::setDecodedCacheEnabled(true);
+
+        const uint32_t width = 16, height = 12;
+        const auto blocks = makeEtc2Blocks(ETC2_RGB_NO_MIPMAPS, width, height);
+        int decodes       = 0;
+        auto decoder      = [&](const std::vector<uint8_t>& input) {
+            return [&decodes, &input](uint8_t* out) {
+                ++decodes;
+                return etc2_decode_image(ETC2_RGB_NO_MIPMAPS, input.data(), out, width, height);
+            };
+        };
+
+        ImageAccess miss;
+        REQUIRE(miss.decode(width, height, blocks, decoder(blocks)));
+        CHECK(decodes == 1);
+        REQUIRE(waitFor([] { return listDecodedCache().size() == 1; }));
+
+        SUBCASE("hit") {
+            ImageAccess hit;
+            REQUIRE(hit.decode(width, height, blocks, decoder(blocks)));
+            CHECK(decodes == 1);
+            CHECK(hit.getPixelFormat() == backend::PixelFormat::RGBA8);
+            REQUIRE(hit.getDataLen() == miss.getDataLen());
+            CHECK(memcmp(hit.getData(), miss.getData(), miss.getDataLen()) == 0);
+        }
+
+        SUBCASE("other_size") {
+            // the same blocks read as another size aren't the same texture
+            ImageAccess other;
+            REQUIRE(other.decode(height, width, blocks, decoder(blocks)));
+            CHECK(decodes == 2);
+            CHECK(waitFor([] { return listDecodedCache().size() == 2; }));
+        }
+
+        SUBCASE("limit") {
+            // room for a single texture, the least recently used one is removed
+            Image::setDecodedCacheLimit(miss.getDataLen() + 64);
+            auto others = makeEtc2Blocks(ETC2_RGB_NO_MIPMAPS, width, height + 1);
+            others.resize(blocks.size());
+
+            ImageAccess other;
+            const auto first = listDecodedCache();
+            REQUIRE(other.decode(width, height, others, decoder(others)));
+            CHECK(decodes == 2);
+            REQUIRE(waitFor([&] {
+                auto files = listDecodedCache();
+                return files.size() == 1 && files != first;
+            }));
+
+            ImageAccess again;
+            REQUIRE(again.decode(width, height, others, decoder(others)));
+            CHECK(decodes == 2);
+        }
+
+        Image::setDecodedCacheLimit(limit);
+        Image::setDecodedCacheEnabled(enabled);
+        Image::purgeDecodedCache();
+    }
+}
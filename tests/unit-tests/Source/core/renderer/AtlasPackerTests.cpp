@@ -0,0 +1,105 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/AtlasPacker.h"
+
+USING_NS_AX;
+
+namespace
+{
+struct PackedRect
+{
+    int x, y, width, height;
+};
+
+bool overlaps(const PackedRect& a, const PackedRect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+}  // namespace
+
+TEST_SUITE("renderer/AtlasPacker")
+{
+    TEST_CASE("insert")
+    {
+        AtlasPacker packer(64, 64);
+
+        int x = -1, y = -1;
+        CHECK(packer.insert(32, 16, x, y));
+        CHECK_EQ(0, x);
+        CHECK_EQ(0, y);
+
+        // the lowest spot is next to the first rectangle
+        CHECK(packer.insert(32, 32, x, y));
+        CHECK_EQ(32, x);
+        CHECK_EQ(0, y);
+
+        // then on top of the first one
+        CHECK(packer.insert(32, 16, x, y));
+        CHECK_EQ(0, x);
+        CHECK_EQ(16, y);
+
+        CHECK_FALSE(packer.insert(65, 1, x, y));
+        CHECK_FALSE(packer.insert(0, 1, x, y));
+        CHECK_EQ(doctest::Approx(0.5f), packer.getOccupancy());
+    }
+
+    TEST_CASE("full")
+    {
+        AtlasPacker packer(64, 64);
+
+        int x, y;
+        for (int i = 0; i < 16; ++i)
+            CHECK(packer.insert(16, 16, x, y));
+        CHECK_EQ(doctest::Approx(1.0f), packer.getOccupancy());
+        CHECK_FALSE(packer.insert(1, 1, x, y));
+
+        packer.reset(32, 32);
+        CHECK(packer.insert(32, 32, x, y));
+        CHECK_FALSE(packer.insert(1, 1, x, y));
+    }
+
+    TEST_CASE("no overlaps")
+    {
+        AtlasPacker packer(256, 256);
+
+        std::vector<PackedRect> packed;
+        for (int i = 0; i < 200; ++i)
+        {
+            PackedRect rect{0, 0, 4 + (i * 7) % 29, 4 + (i * 13) % 23};
+            if (!packer.insert(rect.width, rect.height, rect.x, rect.y))
+                continue;
+
+            CHECK(rect.x >= 0);
+            CHECK(rect.y >= 0);
+            CHECK(rect.x + rect.width <= 256);
+            CHECK(rect.y + rect.height <= 256);
+            for (auto&& other : packed)
+                CHECK_FALSE(overlaps(rect, other));
+            packed.push_back(rect);
+        }
+        CHECK(packed.size() > 100);
+    }
+}
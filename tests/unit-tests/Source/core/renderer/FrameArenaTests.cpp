@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/FrameArena.h"
+
+USING_NS_AX;
+
+TEST_SUITE("renderer/FrameArena")
+{
+    TEST_CASE("allocate")
+    {
+        FrameArena arena(256);
+
+        auto a = arena.allocate(3, 1);
+        auto b = arena.allocate(8, 16);
+        CHECK_NE(a, b);
+        CHECK_EQ(0, reinterpret_cast<uintptr_t>(b) % 16);
+
+        // larger than a block
+        auto c = arena.allocateArray<float>(1024);
+        REQUIRE(c);
+        c[1023] = 1.0f;
+
+        arena.endFrame();
+        CHECK_EQ(3, arena.getFrameStats().allocations);
+        CHECK_EQ(2, arena.getFrameStats().heapAllocations);
+    }
+
+    TEST_CASE("reset coalesces blocks")
+    {
+        FrameArena arena(64);
+        for (int i = 0; i < 16; ++i)
+            arena.allocate(32);
+        arena.reset();
+        arena.endFrame();
+
+        auto capacity = arena.getCapacity();
+        for (int i = 0; i < 16; ++i)
+            arena.allocate(32);
+        arena.endFrame();
+
+        CHECK_EQ(capacity, arena.getCapacity());
+        CHECK_EQ(0, arena.getFrameStats().heapAllocations);
+        CHECK_EQ(16, arena.getFrameStats().allocations);
+    }
+
+    TEST_CASE("construct")
+    {
+        int destroyed = 0;
+        struct Counter
+        {
+            int* destroyed;
+            int order;
+            ~Counter() { *destroyed = *destroyed * 10 + order; }
+        };
+
+        FrameArena arena;
+        arena.construct<Counter>(Counter{&destroyed, 1});
+        arena.construct<Counter>(Counter{&destroyed, 2});
+        destroyed = 0;  // the temporaries
+        arena.reset();
+
+        // reverse order of construction
+        CHECK_EQ(21, destroyed);
+    }
+}
@@ -0,0 +1,223 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/StreamBuffer.h"
+#include "renderer/backend/Buffer.h"
+#include "renderer/backend/DriverBase.h"
+
+USING_NS_AX;
+
+namespace
+{
+class StubBuffer : public backend::Buffer
+{
+public:
+    StubBuffer(std::size_t size, backend::BufferType type, bool canOrphan)
+        : Buffer(size, type, backend::BufferUsage::STREAM), data(size), canOrphan(canOrphan)
+    {}
+
+    void updateData(const void* source, std::size_t size) override { memcpy(data.data(), source, size); }
+    void updateSubData(const void* source, std::size_t offset, std::size_t size) override
+    {
+        REQUIRE(offset + size <= data.size());
+        memcpy(data.data() + offset, source, size);
+    }
+    void usingDefaultStoredData(bool) override {}
+    bool orphan() override { return canOrphan; }
+
+    std::vector<uint8_t> data;
+    bool canOrphan;
+};
+
+// fences are numbered in order, the GPU finished the frames up to passedFence
+class StubDriver : public backend::DriverBase
+{
+public:
+    backend::CommandBuffer* newCommandBuffer() override { return nullptr; }
+    backend::Buffer* newBuffer(std::size_t size, backend::BufferType type, backend::BufferUsage) override
+    {
+        return new StubBuffer(size, type, canOrphan);
+    }
+    uintptr_t newFence() override { return fences ? ++lastFence : 0; }
+    bool waitFence(uintptr_t fence, uint64_t timeoutNs) override
+    {
+        if (timeoutNs && fence > passedFence)
+            passedFence = fence;
+        return fence <= passedFence;
+    }
+    backend::TextureBackend* newTexture(const backend::TextureDescriptor&) override { return nullptr; }
+    backend::RenderTarget* newDefaultRenderTarget() override { return nullptr; }
+    backend::RenderTarget* newRenderTarget(backend::TextureBackend*,
+                                           backend::TextureBackend*,
+                                           backend::TextureBackend*) override
+    {
+        return nullptr;
+    }
+    backend::DepthStencilState* newDepthStencilState() override { return nullptr; }
+    backend::RenderPipeline* newRenderPipeline() override { return nullptr; }
+    void setFrameBufferOnly(bool) override {}
+    backend::Program* newProgram(std::string_view, std::string_view) override { return nullptr; }
+    const char* getVendor() const override { return ""; }
+    const char* getRenderer() const override { return ""; }
+    const char* getVersion() const override { return ""; }
+    bool checkForFeatureSupported(backend::FeatureType) override { return false; }
+
+    bool fences      = true;
+    bool canOrphan   = false;
+    uintptr_t lastFence   = 0;
+    uintptr_t passedFence = 0;
+
+protected:
+    backend::ShaderModule* newShaderModule(backend::ShaderStage, std::string_view) override { return nullptr; }
+};
+
+// the counters of all frames
+struct Totals
+{
+    unsigned int stalls  = 0;
+    unsigned int orphans = 0;
+    unsigned int grows   = 0;
+
+    void add(const StreamBuffer::Stats& stats)
+    {
+        stalls += stats.stalls;
+        orphans += stats.orphans;
+        grows += stats.grows;
+    }
+};
+}  // namespace
+
+TEST_SUITE("renderer/StreamBuffer") {
+    TEST_CASE("upload") {
+        StubDriver driver;
+        StreamBuffer stream(backend::BufferType::VERTEX, 1000, &driver);
+        CHECK(stream.getCapacity() == 1024);
+
+        const uint8_t bytes[] = {1, 2, 3, 4, 5};
+        auto first            = stream.upload(bytes, 3);
+        REQUIRE(first.buffer != nullptr);
+        CHECK(first.offset == 0);
+
+        auto second = stream.upload(bytes, 5, 16);
+        CHECK(second.offset == 16);
+        auto& data = static_cast<StubBuffer*>(second.buffer)->data;
+        CHECK(memcmp(data.data() + second.offset, bytes, 5) == 0);
+
+        CHECK(stream.upload(bytes, 0).buffer == nullptr);
+        stream.endFrame();
+        CHECK(stream.getFrameStats().uploads == 2);
+        CHECK(stream.getFrameStats().uploadedBytes == 8);
+    }
+
+    TEST_CASE("wrap") {
+        StubDriver driver;
+        StreamBuffer stream(backend::BufferType::VERTEX, 1024, &driver);
+        std::vector<uint8_t> frame(300, 0xAB);
+        Totals totals;
+
+        SUBCASE("gpu_keeps_up") {
+            for (int i = 0; i < 20; ++i)
+            {
+                auto slice = stream.upload(frame.data(), frame.size());
+                REQUIRE(slice.buffer != nullptr);
+                CHECK(slice.offset + frame.size() <= stream.getCapacity());
+                stream.endFrame();
+                totals.add(stream.getFrameStats());
+                driver.passedFence = driver.lastFence;
+            }
+            CHECK(totals.stalls == 0);
+            CHECK(totals.grows == 0);
+            CHECK(stream.getPendingFrameCount() <= 1);
+        }
+
+        SUBCASE("fence_stall") {
+            // the GPU never finishes on its own, the ring waits for the oldest frame once it's full
+            for (int i = 0; i < 5; ++i)
+            {
+                REQUIRE(stream.upload(frame.data(), frame.size()).buffer != nullptr);
+                stream.endFrame();
+                totals.add(stream.getFrameStats());
+            }
+            CHECK(totals.stalls == 2);
+            CHECK(totals.grows == 0);
+            CHECK(stream.getCapacity() == 1024);
+        }
+
+        SUBCASE("orphan_without_fences") {
+            driver.fences    = false;
+            driver.canOrphan = true;
+            for (int i = 0; i < 20; ++i)
+            {
+                REQUIRE(stream.upload(frame.data(), frame.size()).buffer != nullptr);
+                stream.endFrame();
+                totals.add(stream.getFrameStats());
+                CHECK(stream.getPendingFrameCount() <= MAX_INFLIGHT_BUFFER);
+            }
+            CHECK(totals.orphans > 0);
+            CHECK(totals.grows == 0);
+        }
+
+        SUBCASE("retire_without_fences") {
+            // the frames without a fence are released after the frames in flight, not only when the ring wraps
+            driver.fences = false;
+            for (int i = 0; i < 100; ++i)
+            {
+                REQUIRE(stream.upload(frame.data(), 16).buffer != nullptr);
+                stream.endFrame();
+                CHECK(stream.getPendingFrameCount() <= MAX_INFLIGHT_BUFFER);
+            }
+
+            for (int i = 0; i < 20; ++i)
+            {
+                REQUIRE(stream.upload(frame.data(), frame.size()).buffer != nullptr);
+                stream.endFrame();
+                totals.add(stream.getFrameStats());
+            }
+            CHECK(totals.grows == 0);
+            CHECK(totals.orphans == 0);
+        }
+    }
+
+    TEST_CASE("grow") {
+        StubDriver driver;
+        StreamBuffer stream(backend::BufferType::INDEX, 1024, &driver);
+        std::vector<uint8_t> bytes(1500);
+        for (size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<uint8_t>(i);
+
+        // a single frame needs more than the ring holds
+        auto first  = stream.upload(bytes.data(), 800);
+        auto second = stream.upload(bytes.data(), bytes.size());
+        REQUIRE(first.buffer != nullptr);
+        REQUIRE(second.buffer != nullptr);
+        CHECK(stream.getCapacity() >= 2 * bytes.size());
+        auto& data = static_cast<StubBuffer*>(second.buffer)->data;
+        CHECK(memcmp(data.data() + second.offset, bytes.data(), bytes.size()) == 0);
+
+        stream.endFrame();
+        CHECK(stream.getFrameStats().grows == 1);
+        CHECK(stream.getFrameStats().stalls == 0);
+    }
+}
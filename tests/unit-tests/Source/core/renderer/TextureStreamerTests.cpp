@@ -0,0 +1,146 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "renderer/TextureStreamer.h"
+
+USING_NS_AX;
+
+namespace
+{
+// 4 levels of 1024, 256, 64 and 16 bytes, the last 2 are the tail
+StreamedTextureInfo makeInfo(int residentLevel, int requestedLevel, uint32_t lastDrawnFrame)
+{
+    StreamedTextureInfo info{};
+    info.pixelFormat    = backend::PixelFormat::ETC2_RGBA;
+    info.pixelsWide     = 16;
+    info.pixelsHigh     = 16;
+    info.levels         = {{0, 1024}, {1024, 256}, {1280, 64}, {1344, 16}};
+    info.tail.resize(64 + 16);
+    info.tailLevel      = 2;
+    info.residentLevel  = residentLevel;
+    info.requestedLevel = requestedLevel;
+    info.loadingLevel   = -1;
+    info.lastDrawnFrame = lastDrawnFrame;
+    return info;
+}
+
+constexpr size_t FULL_SIZE = 1024 + 256 + 64 + 16;
+constexpr size_t TAIL_SIZE = 64 + 16;
+}  // namespace
+
+TEST_SUITE("renderer/TextureStreamer") {
+    TEST_CASE("drop_order") {
+        std::vector<StreamedTextureInfo> textures = {makeInfo(0, INT32_MAX, 5), makeInfo(0, INT32_MAX, 2),
+                                                     makeInfo(0, INT32_MAX, 8)};
+        std::vector<StreamedTextureInfo*> infos = {&textures[0], &textures[1], &textures[2]};
+        TextureStreamer::UpdatePlan plan;
+
+        SUBCASE("within_budget") {
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 3, 10, 4, plan);
+            CHECK(plan.drops.empty());
+            CHECK(plan.loads.empty());
+        }
+
+        SUBCASE("least_recently_drawn_first") {
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 3 - 1, 10, 4, plan);
+            CHECK(plan.drops == std::vector<size_t>{1});
+
+            TextureStreamer::planUpdate(infos, FULL_SIZE + TAIL_SIZE * 2 - 1, 10, 4, plan);
+            CHECK(plan.drops == std::vector<size_t>{1, 0, 2});
+        }
+
+        SUBCASE("drawn_last") {
+            // drawn this frame, it's the most recently drawn now
+            textures[1].requestedLevel = 0;
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 2 + TAIL_SIZE - 1, 10, 4, plan);
+            CHECK(textures[1].lastDrawnFrame == 10);
+            CHECK(textures[0].lastDrawnFrame == 5);
+            CHECK(plan.drops == std::vector<size_t>{0, 2});
+        }
+
+        SUBCASE("skip_tail_and_loading") {
+            textures[1].residentLevel = textures[1].tailLevel;
+            textures[0].loadingLevel  = 0;
+            textures[0].residentLevel = 1;
+            TextureStreamer::planUpdate(infos, 0, 10, 4, plan);
+            CHECK(plan.drops == std::vector<size_t>{2});
+        }
+    }
+
+    TEST_CASE("load_order") {
+        std::vector<StreamedTextureInfo> textures = {makeInfo(2, 1, 1), makeInfo(2, 0, 1), makeInfo(2, INT32_MAX, 1),
+                                                     makeInfo(1, 1, 1)};
+        std::vector<StreamedTextureInfo*> infos = {&textures[0], &textures[1], &textures[2], &textures[3]};
+        TextureStreamer::UpdatePlan plan;
+
+        SUBCASE("most_blurred_first") {
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 4, 10, 4, plan);
+            CHECK(plan.drops.empty());
+            REQUIRE(plan.loads.size() == 2);
+            CHECK(plan.loads[0] == std::pair<size_t, int>{1, 0});
+            CHECK(plan.loads[1] == std::pair<size_t, int>{0, 1});
+        }
+
+        SUBCASE("load_slots") {
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 4, 10, 1, plan);
+            REQUIRE(plan.loads.size() == 1);
+            CHECK(plan.loads[0] == std::pair<size_t, int>{1, 0});
+
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 4, 10, 0, plan);
+            CHECK(plan.loads.empty());
+        }
+
+        SUBCASE("budget_picks_smaller_level") {
+            // committed: 3 tails and a texture from level 1, level 0 never fits
+            auto committed = TAIL_SIZE * 3 + (FULL_SIZE - 1024);
+            TextureStreamer::planUpdate(infos, committed + 256, 10, 4, plan);
+            REQUIRE(plan.loads.size() == 1);
+            CHECK(plan.loads[0] == std::pair<size_t, int>{1, 1});
+
+            TextureStreamer::planUpdate(infos, committed + 256 * 2, 10, 4, plan);
+            REQUIRE(plan.loads.size() == 2);
+            CHECK(plan.loads[0] == std::pair<size_t, int>{1, 1});
+            CHECK(plan.loads[1] == std::pair<size_t, int>{0, 1});
+        }
+
+        SUBCASE("skip_loading") {
+            textures[1].loadingLevel = 0;
+            TextureStreamer::planUpdate(infos, FULL_SIZE * 4, 10, 4, plan);
+            REQUIRE(plan.loads.size() == 1);
+            CHECK(plan.loads[0] == std::pair<size_t, int>{0, 1});
+        }
+    }
+
+    TEST_CASE("no_reload_after_drop") {
+        // both drawn this frame, over the budget the first one drops and isn't loaded back right away
+        std::vector<StreamedTextureInfo> textures = {makeInfo(1, 0, 1), makeInfo(0, 0, 1)};
+        std::vector<StreamedTextureInfo*> infos = {&textures[0], &textures[1]};
+        TextureStreamer::UpdatePlan plan;
+
+        TextureStreamer::planUpdate(infos, FULL_SIZE + TAIL_SIZE, 10, 4, plan);
+        CHECK(plan.drops == std::vector<size_t>{0});
+        CHECK(plan.loads.empty());
+    }
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "DragonBones/CCArmatureDisplay.h"
+
+USING_NS_AX;
+
+namespace
+{
+// records the modelview matrix of the director when visited, like nodes using Texture2D::drawAtPoint need
+class ModelViewProbe : public Node
+{
+public:
+    CREATE_FUNC(ModelViewProbe);
+
+    void visit(Renderer* /*renderer*/, const Mat4& /*parentTransform*/, uint32_t /*parentFlags*/) override
+    {
+        modelView = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
+
+    Mat4 modelView;
+};
+
+bool isSameMatrix(const Mat4& a, const Mat4& b)
+{
+    return memcmp(a.m, b.m, sizeof(a.m)) == 0;
+}
+}  // namespace
+
+TEST_SUITE("extensions/DragonBones/CCArmatureDisplay") {
+    TEST_CASE("batched_visit_modelview") {
+        auto director = Director::getInstance();
+        auto display  = dragonBones::CCArmatureDisplay::create();
+        auto probe    = ModelViewProbe::create();
+        display->addChild(probe);
+        display->setPosition(Vec2(10, 20));
+        display->setScale(2);
+
+        Mat4 parentTransform;
+        Mat4::createTranslation(Vec3(5, 6, 0), &parentTransform);
+
+        director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        director->loadIdentityMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+
+        for (bool batched : {false, true}) {
+            CAPTURE(batched);
+            display->setBatchEnabled(batched);
+            probe->modelView = Mat4::ZERO;
+            display->visit(director->getRenderer(), parentTransform, Node::FLAGS_TRANSFORM_DIRTY);
+
+            CHECK(isSameMatrix(probe->modelView, parentTransform * display->getNodeToParentTransform()));
+            CHECK(isSameMatrix(director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW), Mat4::IDENTITY));
+        }
+
+        director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    }
+}
@@ -0,0 +1,182 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "cocostudio/ActionTimeline/CSLoader.h"
+#include "cocostudio/ActionTimeline/ActionTimeline.h"
+#include "cocostudio/FlatBuffersSerialize.h"
+#include "platform/FileUtils.h"
+#include "TestUtils.h"
+
+USING_NS_AX;
+
+namespace
+{
+// converts a minimal .csd document to a .csb file in the writable path, returns its full path
+std::string writeCsbFile(std::string_view name, std::string_view nodeName, int duration)
+{
+    CSLoader::getInstance();  // registers the node readers used by the serializer
+
+    auto xml = fmt::format(R"(<GameFile>
+  <PropertyGroup Name="{0}" Type="Node" Version="3.10.0.0" />
+  <Content ctype="GameProjectContent">
+    <Content>
+      <Animation Duration="{2}" Speed="1.0000" />
+      <ObjectData Name="{1}" Tag="7" ctype="GameNodeObjectData">
+        <Size X="0.0000" Y="0.0000" />
+      </ObjectData>
+    </Content>
+  </Content>
+</GameFile>)",
+                           name, nodeName, duration);
+
+    auto path = fmt::format("{}{}.csb", FileUtils::getInstance()->getWritablePath(), name);
+    cocostudio::FlatBuffersSerialize::serializeFlatBuffersWithXMLBuffer(xml, path);
+    return path;
+}
+}  // namespace
+
+TEST_SUITE("extensions/cocostudio/CSLoader") {
+    TEST_CASE("prototype_cache") {
+        auto fu     = FileUtils::getInstance();
+        auto loader = CSLoader::getInstance();
+        auto path   = writeCsbFile("unit_test_prototype", "Root", 10);
+        REQUIRE(fu->isFileExist(path));
+        auto fileSize = static_cast<size_t>(fu->getFileSize(path));
+
+        loader->setPrototypeCacheEnabled(true);
+        REQUIRE(loader->getPrototypeCount() == 0);
+
+        auto first = CSLoader::createNode(path);
+        REQUIRE(first != nullptr);
+        CHECK(first->getName() == "Root");
+        CHECK(first->getTag() == 7);
+        CHECK(loader->getPrototypeCount() == 1);
+        CHECK(loader->getPrototypeMemoryUsage() >= fileSize + path.size() * 2);
+
+        // later instances and timelines are built from the prototype, without reading the file
+        fu->removeFile(path);
+        auto second = CSLoader::createNode(path);
+        REQUIRE(second != nullptr);
+        CHECK(second != first);
+        CHECK(second->getName() == "Root");
+
+        auto timeline1 = CSLoader::createTimeline(path);
+        auto timeline2 = CSLoader::createTimeline(path);
+        REQUIRE(timeline1 != nullptr);
+        REQUIRE(timeline2 != nullptr);
+        CHECK(timeline1 != timeline2);
+        CHECK(timeline1->getDuration() == 10);
+        CHECK(timeline2->getDuration() == 10);
+        CHECK(loader->getPrototypeCount() == 1);
+
+        loader->removePrototype(path);
+        CHECK(loader->getPrototypeCount() == 0);
+        CHECK(loader->getPrototypeMemoryUsage() == 0);
+
+        SUBCASE("disable_purges") {
+            auto other = writeCsbFile("unit_test_prototype_other", "Other", 1);
+            CHECK(loader->preloadPrototype(other));
+            CHECK(loader->getPrototypeCount() == 1);
+            CHECK(loader->getPrototypeMemoryUsage() > 0);
+
+            loader->setPrototypeCacheEnabled(false);
+            CHECK(loader->getPrototypeCount() == 0);
+
+            auto node = CSLoader::createNode(other);
+            REQUIRE(node != nullptr);
+            CHECK(node->getName() == "Other");
+            CHECK(loader->getPrototypeCount() == 0);
+            fu->removeFile(other);
+        }
+
+        loader->setPrototypeCacheEnabled(false);
+    }
+
+    TEST_CASE("createNodeAsync") {
+        auto fu     = FileUtils::getInstance();
+        auto loader = CSLoader::getInstance();
+        auto path   = writeCsbFile("unit_test_async", "Async", 5);
+
+        float lastProgress = 0;
+        auto load          = [&](std::string_view filename) {
+            auto run = AsyncRunner<Node*>();
+            loader->createNodeAsync(
+                filename,
+                [&](Node* node) {
+                    AX_SAFE_RETAIN(node);
+                    run.finish(node);
+                },
+                [&](float value) {
+                    CHECK(value >= lastProgress);
+                    lastProgress = value;
+                });
+            return run();
+        };
+
+        SUBCASE("without_cache") {
+            auto node = load(path);
+            REQUIRE(node != nullptr);
+            CHECK(node->getName() == "Async");
+            CHECK(lastProgress == 1.0f);
+            // the prototypes of the request are dropped after the instantiation
+            CHECK(loader->getPrototypeCount() == 0);
+            node->release();
+        }
+
+        SUBCASE("without_cache_keeps_preloaded") {
+            // a prototype preloaded before isn't the request's to drop
+            auto other = writeCsbFile("unit_test_async_preloaded", "Preloaded", 5);
+            REQUIRE(loader->preloadPrototype(other));
+            auto node = load(path);
+            REQUIRE(node != nullptr);
+            CHECK(loader->getPrototypeCount() == 1);
+
+            loader->removePrototype(other);
+            CHECK(loader->getPrototypeCount() == 0);
+            fu->removeFile(other);
+            node->release();
+        }
+
+        SUBCASE("with_cache") {
+            loader->setPrototypeCacheEnabled(true);
+            auto node = load(path);
+            REQUIRE(node != nullptr);
+            CHECK(loader->getPrototypeCount() == 1);
+
+            // the prototype is used by the following instances
+            fu->removeFile(path);
+            auto instance = CSLoader::createNode(path);
+            REQUIRE(instance != nullptr);
+            CHECK(instance->getName() == "Async");
+            node->release();
+            loader->setPrototypeCacheEnabled(false);
+        }
+
+        SUBCASE("missing") {
+            CHECK(load(fu->getWritablePath() + "unit_test_missing.csb") == nullptr);
+        }
+
+        fu->removeFile(path);
+    }
+}
@@ -0,0 +1,229 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "FairyGUI.h"
+#include "platform/FileUtils.h"
+#include "TestUtils.h"
+
+USING_NS_AX;
+USING_NS_FGUI;
+
+namespace
+{
+// writes the big endian values of the .fui format
+struct PackageWriter
+{
+    std::vector<uint8_t> bytes;
+
+    void writeByte(uint8_t value) { bytes.push_back(value); }
+    void writeShort(uint16_t value)
+    {
+        writeByte(value >> 8);
+        writeByte(value & 0xff);
+    }
+    void writeInt(uint32_t value)
+    {
+        writeShort(value >> 16);
+        writeShort(value & 0xffff);
+    }
+    void writeString(std::string_view value)
+    {
+        writeShort(static_cast<uint16_t>(value.size()));
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+    void patchInt(size_t pos, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            bytes[pos + i] = static_cast<uint8_t>(value >> (24 - i * 8));
+    }
+};
+
+constexpr uint16_t NULL_STRING = 65534;
+
+// a package with the branches "en" & "fr", the misc item "a" is replaced by the item "b" in the "fr" branch,
+// and the empty component "c"
+void writePackageFile(std::string_view filePath)
+{
+    const std::vector<std::string> strings{"en", "fr", "a", "b", "itemA", "itemB", "file.bin", "c", "itemC"};
+
+    PackageWriter writer;
+    writer.writeInt(0x46475549);
+    writer.writeInt(2);  // version
+    writer.writeByte(0);  // compressed
+    writer.writeString("unit_test_id");
+    writer.writeString("unit_test_package");
+    writer.bytes.resize(writer.bytes.size() + 20);
+
+    const size_t indexTablePos = writer.bytes.size();
+    writer.writeByte(5);  // segments
+    writer.writeByte(0);  // int offsets
+    for (int i = 0; i < 5; ++i)
+        writer.writeInt(0);
+    auto beginSegment = [&](int index) {
+        writer.patchInt(indexTablePos + 2 + index * 4, static_cast<uint32_t>(writer.bytes.size() - indexTablePos));
+    };
+
+    // dependencies & branches
+    beginSegment(0);
+    writer.writeShort(0);
+    writer.writeShort(2);
+    writer.writeShort(0);
+    writer.writeShort(1);
+
+    // items
+    beginSegment(1);
+    writer.writeShort(3);
+    for (uint16_t item = 0; item < 2; ++item)
+    {
+        const size_t nextPos = writer.bytes.size();
+        writer.writeInt(0);
+        writer.writeByte(static_cast<uint8_t>(PackageItemType::MISC));
+        writer.writeShort(2 + item);  // id
+        writer.writeShort(4 + item);  // name
+        writer.writeShort(NULL_STRING);  // path
+        writer.writeShort(6);  // file
+        writer.writeByte(1);  // exported
+        writer.writeInt(0);
+        writer.writeInt(0);
+        writer.writeShort(NULL_STRING);  // branch folder
+        if (item == 0)
+        {
+            writer.writeByte(2);
+            writer.writeShort(NULL_STRING);
+            writer.writeShort(3);
+        }
+        else
+            writer.writeByte(0);
+        writer.writeByte(0);  // high resolutions
+        writer.patchInt(nextPos, static_cast<uint32_t>(writer.bytes.size() - nextPos - 4));
+    }
+    {
+        const size_t nextPos = writer.bytes.size();
+        writer.writeInt(0);
+        writer.writeByte(static_cast<uint8_t>(PackageItemType::COMPONENT));
+        writer.writeShort(7);  // id
+        writer.writeShort(8);  // name
+        writer.writeShort(NULL_STRING);  // path
+        writer.writeShort(NULL_STRING);  // file
+        writer.writeByte(1);  // exported
+        writer.writeInt(0);
+        writer.writeInt(0);
+        writer.writeByte(0);  // extension
+        writer.writeInt(0);  // raw data
+        writer.writeShort(NULL_STRING);  // branch folder
+        writer.writeByte(0);  // branches
+        writer.writeByte(0);  // high resolutions
+        writer.patchInt(nextPos, static_cast<uint32_t>(writer.bytes.size() - nextPos - 4));
+    }
+
+    // sprites
+    beginSegment(2);
+    writer.writeShort(0);
+
+    // string table
+    beginSegment(4);
+    writer.writeInt(static_cast<uint32_t>(strings.size()));
+    for (auto& str : strings)
+        writer.writeString(str);
+
+    Data data;
+    data.copy(writer.bytes.data(), writer.bytes.size());
+    REQUIRE(FileUtils::getInstance()->writeDataToFile(data, filePath));
+}
+}  // namespace
+
+TEST_SUITE("extensions/fairygui/UIPackage") {
+    TEST_CASE("addPackageAsync") {
+        auto fu        = FileUtils::getInstance();
+        auto assetPath = fu->getWritablePath() + "unit_test_package";
+        writePackageFile(assetPath + ".fui");
+
+        float lastProgress = 0;
+        auto load = [&](const std::string& path) {
+            auto run = AsyncRunner<UIPackage*>();
+            UIPackage::addPackageAsync(
+                path, [&](UIPackage* pkg) { run.finish(pkg); },
+                [&](float value) {
+                    CHECK(value >= lastProgress);
+                    lastProgress = value;
+                });
+            return run();
+        };
+
+        SUBCASE("branch") {
+            UIPackage::setBranch("fr");
+            auto pkg = load(assetPath);
+            REQUIRE(pkg != nullptr);
+            CHECK(pkg->getId() == "unit_test_id");
+            CHECK(pkg->getName() == "unit_test_package");
+            CHECK(UIPackage::getById("unit_test_id") == pkg);
+            CHECK(lastProgress == 1.0f);
+
+            auto itemA = pkg->getItem("a");
+            REQUIRE(itemA != nullptr);
+            CHECK(itemA->getBranch() == pkg->getItem("b"));
+
+            // already added, completes immediately
+            CHECK(load(assetPath) == pkg);
+            UIPackage::removePackage("unit_test_id");
+        }
+
+        SUBCASE("branch_changed_while_loading") {
+            // the worker reads the branch of the request, the package follows the branch set meanwhile
+            auto run = AsyncRunner<UIPackage*>();
+            UIPackage::setBranch("fr");
+            UIPackage::addPackageAsync(assetPath, [&](UIPackage* pkg) { run.finish(pkg); });
+            UIPackage::setBranch("");
+            auto pkg = run();
+            REQUIRE(pkg != nullptr);
+
+            auto itemA = pkg->getItem("a");
+            REQUIRE(itemA != nullptr);
+            CHECK(itemA->getBranch() == itemA);
+            UIPackage::removePackage("unit_test_id");
+        }
+
+        SUBCASE("extension_set_while_loading") {
+            // the extensions are resolved on the main thread, so one set while the worker parses applies
+            auto run = AsyncRunner<UIPackage*>();
+            UIPackage::addPackageAsync(assetPath, [&](UIPackage* pkg) { run.finish(pkg); });
+            UIObjectFactory::setPackageItemExtension("ui://unit_test_package/itemC", []() { return GComponent::create(); });
+            auto pkg = run();
+            REQUIRE(pkg != nullptr);
+
+            auto itemC = pkg->getItem("c");
+            REQUIRE(itemC != nullptr);
+            CHECK(itemC->extensionCreator != nullptr);
+            UIObjectFactory::setPackageItemExtension("ui://unit_test_package/itemC", nullptr);
+            UIPackage::removePackage("unit_test_id");
+        }
+
+        SUBCASE("missing") {
+            CHECK(load(fu->getWritablePath() + "unit_test_missing_package") == nullptr);
+        }
+
+        UIPackage::setBranch("");
+        fu->removeFile(assetPath + ".fui");
+    }
+}
@@ -0,0 +1,185 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <doctest.h>
+#include "lua-bindings/manual/LuaGCController.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+
+extern "C" {
+#include "lauxlib.h"
+#include "lualib.h"
+}
+
+USING_NS_AX;
+
+namespace
+{
+// leaves at least kb of garbage in the heap
+void makeGarbage(lua_State* L, int kb)
+{
+    lua_getglobal(L, "makeGarbage");
+    lua_pushinteger(L, kb);
+    lua_call(L, 1, 0);
+}
+
+lua_State* newState()
+{
+    auto L = luaL_newstate();
+    luaL_openlibs(L);
+    luaL_dostring(L, R"(
+        function makeGarbage(kb)
+            local t = {}
+            for i = 1, kb do t[i] = string.rep("x", 1024) .. i end
+        end
+    )");
+    return L;
+}
+
+void endFrame()
+{
+    Director::getInstance()->getEventDispatcher()->dispatchCustomEvent(Director::EVENT_AFTER_DRAW);
+}
+}  // namespace
+
+TEST_SUITE("extensions/LuaGCController")
+{
+    TEST_CASE("compute_budget")
+    {
+        // the time left until the next frame, clamped
+        CHECK(LuaGCController::computeBudget(1.f, 0.f, 0.002f, 0.25f, 2.f) == doctest::Approx(1.f));
+        CHECK(LuaGCController::computeBudget(-3.f, 0.f, 0.002f, 0.25f, 2.f) == doctest::Approx(0.25f));
+        CHECK(LuaGCController::computeBudget(10.f, 0.f, 0.002f, 0.25f, 2.f) == doctest::Approx(2.f));
+
+        // raised to collect twice the allocations of a frame, up to the max budget
+        CHECK(LuaGCController::computeBudget(0.1f, 250.f, 0.002f, 0.25f, 2.f) == doctest::Approx(1.f));
+        CHECK(LuaGCController::computeBudget(0.1f, 5000.f, 0.002f, 0.25f, 2.f) == doctest::Approx(2.f));
+    }
+
+    TEST_CASE("compute_step_size")
+    {
+        CHECK(LuaGCController::computeStepSize(1.f, 0.002f) == 500);
+        CHECK(LuaGCController::computeStepSize(0.f, 0.002f) == 1);
+        CHECK(LuaGCController::computeStepSize(1000.f, 0.002f) == 4096);
+    }
+
+    TEST_CASE("step")
+    {
+        auto L = newState();
+        makeGarbage(L, 1024);
+
+        {
+            LuaGCController controller(L);
+
+            // a budget always runs at least one step
+            controller.step(0.0001f);
+            CHECK(controller.getStats().stepSize == 1);
+            CHECK(controller.getStats().stepTime > 0.f);
+
+            // the steps stop at the end of a cycle
+            CHECK(controller.step(10000.f));
+            CHECK(controller.getStats().cycles == 1);
+            CHECK(controller.getStats().stepSize == 4096);
+        }
+
+        lua_close(L);
+    }
+
+    TEST_CASE("pacing")
+    {
+        auto L = newState();
+
+        SUBCASE("settings")
+        {
+            const int pause = lua_gc(L, LUA_GCSETPAUSE, 160);
+            {
+                LuaGCController controller(L);
+                controller.setPause(300);
+                controller.setEnabled(true);
+                CHECK(lua_gc(L, LUA_GCISRUNNING, 0) == 0);
+                CHECK(lua_gc(L, LUA_GCSETPAUSE, 300) == 300);
+
+                controller.setAutoCollect(true);
+                CHECK(lua_gc(L, LUA_GCISRUNNING, 0) != 0);
+                controller.setAutoCollect(false);
+                CHECK(lua_gc(L, LUA_GCISRUNNING, 0) == 0);
+
+                controller.setEnabled(false);
+                CHECK(lua_gc(L, LUA_GCISRUNNING, 0) != 0);
+                CHECK(lua_gc(L, LUA_GCSETPAUSE, 160) == 160);
+            }
+            lua_gc(L, LUA_GCSETPAUSE, pause);
+        }
+
+        SUBCASE("cycles")
+        {
+            LuaGCController controller(L);
+            controller.setPause(200);
+            controller.setHeapLimit(1024 * 1024);
+            controller.setMinBudget(10000.f);
+            controller.setMaxBudget(10000.f);
+            controller.setEnabled(true);
+
+            // finishes the cycle running when enabled
+            makeGarbage(L, 256);
+            endFrame();
+            CHECK(controller.getStats().cycles == 1);
+            CHECK(lua_gc(L, LUA_GCISRUNNING, 0) == 0);
+
+            // the next cycle waits for the heap to grow by the pause
+            const int heapSize = lua_gc(L, LUA_GCCOUNT, 0);
+            endFrame();
+            CHECK(controller.getStats().stepTime == 0.f);
+            CHECK(controller.getStats().cycles == 1);
+
+            makeGarbage(L, heapSize);
+            endFrame();
+            CHECK(controller.getStats().stepTime > 0.f);
+            CHECK(controller.getStats().cycles == 2);
+            CHECK(controller.getStats().fullCollects == 0);
+            CHECK(lua_gc(L, LUA_GCISRUNNING, 0) == 0);
+
+            controller.setEnabled(false);
+        }
+
+        SUBCASE("heap_limit")
+        {
+            LuaGCController controller(L);
+            controller.setMinBudget(0.f);
+            controller.setMaxBudget(0.f);
+            controller.setEnabled(true);
+
+            // no budget, only the limit collects
+            makeGarbage(L, 1024);
+            controller.setHeapLimit(static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) / 2);
+            endFrame();
+            CHECK(controller.getStats().fullCollects == 1);
+            CHECK(controller.getStats().heapSize < controller.getHeapLimit());
+            CHECK(lua_gc(L, LUA_GCISRUNNING, 0) == 0);
+
+            controller.setEnabled(false);
+        }
+
+        lua_close(L);
+    }
+}